@@ -0,0 +1,61 @@
+#!/bin/sh
+
+# Builds and runs the runtime micro-benchmarks and the compiled Scheme program benchmarks
+#
+# Any arguments are passed to both benchmark harnesses. For example, use "--save-baseline FILE" to record a baseline
+# and "--baseline FILE" to compare against it. Separate baseline files are used for each harness by appending
+# ".runtime" and ".programs" to any baseline path. The script fails if any benchmark regressed.
+
+# If anything fails we should fail
+set -e
+
+BUILD_DIR=build/
+PROGRAM_DIR=${BUILD_DIR}benchmarks/
+BENCHMARK_SOURCE_DIR=compiler/src/test/scheme/benchmarks
+
+# Rewrites baseline paths for the named harness
+harness_args() {
+	suffix=$1
+	shift
+
+	while [ $# -gt 0 ]
+	do
+		case $1 in
+			--baseline|--save-baseline)
+				printf '%s\n%s\n' "$1" "$2.$suffix"
+				shift
+				;;
+			*)
+				printf '%s\n' "$1"
+				;;
+		esac
+
+		shift
+	done
+}
+
+mkdir -p $BUILD_DIR
+cd $BUILD_DIR
+
+cmake -GNinja -DCMAKE_BUILD_TYPE=Release -DENABLE_BENCHMARKS=yes ../runtime
+ninja
+
+cd ..
+
+# Compile each Scheme benchmark
+mkdir -p $PROGRAM_DIR
+for source in $BENCHMARK_SOURCE_DIR/*.scm
+do
+	./llambda -O 2 -o "$PROGRAM_DIR$(basename "$source" .scm)" "$source"
+done
+
+regressed=0
+
+OLD_IFS=$IFS
+IFS='
+'
+${BUILD_DIR}runtime-benchmark $(harness_args runtime "$@") || regressed=1
+${BUILD_DIR}program-benchmark $(harness_args programs "$@") $PROGRAM_DIR* || regressed=1
+IFS=$OLD_IFS
+
+exit $regressed
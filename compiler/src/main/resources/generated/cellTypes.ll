@@ -86,83 +86,90 @@
 !47 = !{!"Any::gcState->Number->Flonum", !42}
 !48 = !{!"Flonum::value", !0}
 
+; {supertype, signed numerator, signed denominator}
+%ratnum = type {%number, i64, i64}
+!49 = !{!"Any::typeId->Number->Ratnum", !41}
+!50 = !{!"Any::gcState->Number->Ratnum", !42}
+!51 = !{!"Ratnum::numerator", !0}
+!52 = !{!"Ratnum::denominator", !0}
+
 ; {supertype, unicodeChar}
 %char = type {%any, i32}
-!49 = !{!"Any::typeId->Char", !10}
-!50 = !{!"Any::gcState->Char", !11}
-!51 = !{!"Char::unicodeChar", !0}
+!53 = !{!"Any::typeId->Char", !10}
+!54 = !{!"Any::gcState->Char", !11}
+!55 = !{!"Char::unicodeChar", !0}
 
 ; {supertype, signed length, elements}
 %vector = type {%any, i64, %any**}
-!52 = !{!"Any::typeId->Vector", !10}
-!53 = !{!"Any::gcState->Vector", !11}
-!54 = !{!"Vector::length", !0}
-!55 = !{!"Vector::elements", !0}
+!56 = !{!"Any::typeId->Vector", !10}
+!57 = !{!"Any::gcState->Vector", !11}
+!58 = !{!"Vector::length", !0}
+!59 = !{!"Vector::elements", !0}
 
 ; {supertype, signed length, byteArray}
 %bytevector = type {%any, i64, %sharedByteArray*}
-!56 = !{!"Any::typeId->Bytevector", !10}
-!57 = !{!"Any::gcState->Bytevector", !11}
-!58 = !{!"Bytevector::length", !0}
-!59 = !{!"Bytevector::byteArray", !0}
+!60 = !{!"Any::typeId->Bytevector", !10}
+!61 = !{!"Any::gcState->Bytevector", !11}
+!62 = !{!"Bytevector::length", !0}
+!63 = !{!"Bytevector::byteArray", !0}
 
 ; {supertype, bool dataIsInline, bool isUndefined, unsigned recordClassId, recordData}
 %recordLike = type {%any, i8, i8, i32, i8*}
-!60 = !{!"Any::typeId->RecordLike", !10}
-!61 = !{!"Any::gcState->RecordLike", !11}
-!62 = !{!"RecordLike::dataIsInline", !0}
-!63 = !{!"RecordLike::isUndefined", !0}
-!64 = !{!"RecordLike::recordClassId", !0}
-!65 = !{!"RecordLike::recordData", !0}
+!64 = !{!"Any::typeId->RecordLike", !10}
+!65 = !{!"Any::gcState->RecordLike", !11}
+!66 = !{!"RecordLike::dataIsInline", !0}
+!67 = !{!"RecordLike::isUndefined", !0}
+!68 = !{!"RecordLike::recordClassId", !0}
+!69 = !{!"RecordLike::recordData", !0}
 
 ; {supertype, extraData, entryPoint}
 %procedure = type {%recordLike, [8 x i8], i8*}
-!66 = !{!"Any::typeId->RecordLike->Procedure", !60}
-!67 = !{!"Any::gcState->RecordLike->Procedure", !61}
-!68 = !{!"RecordLike::dataIsInline->Procedure", !62}
-!69 = !{!"RecordLike::isUndefined->Procedure", !63}
-!70 = !{!"RecordLike::recordClassId->Procedure", !64}
-!71 = !{!"RecordLike::recordData->Procedure", !65}
-!72 = !{!"Procedure::extraData", !0}
-!73 = !{!"Procedure::entryPoint", !0}
+!70 = !{!"Any::typeId->RecordLike->Procedure", !64}
+!71 = !{!"Any::gcState->RecordLike->Procedure", !65}
+!72 = !{!"RecordLike::dataIsInline->Procedure", !66}
+!73 = !{!"RecordLike::isUndefined->Procedure", !67}
+!74 = !{!"RecordLike::recordClassId->Procedure", !68}
+!75 = !{!"RecordLike::recordData->Procedure", !69}
+!76 = !{!"Procedure::extraData", !0}
+!77 = !{!"Procedure::entryPoint", !0}
 
 ; {supertype, extraData}
 %record = type {%recordLike, [16 x i8]}
-!74 = !{!"Any::typeId->RecordLike->Record", !60}
-!75 = !{!"Any::gcState->RecordLike->Record", !61}
-!76 = !{!"RecordLike::dataIsInline->Record", !62}
-!77 = !{!"RecordLike::isUndefined->Record", !63}
-!78 = !{!"RecordLike::recordClassId->Record", !64}
-!79 = !{!"RecordLike::recordData->Record", !65}
-!80 = !{!"Record::extraData", !0}
+!78 = !{!"Any::typeId->RecordLike->Record", !64}
+!79 = !{!"Any::gcState->RecordLike->Record", !65}
+!80 = !{!"RecordLike::dataIsInline->Record", !66}
+!81 = !{!"RecordLike::isUndefined->Record", !67}
+!82 = !{!"RecordLike::recordClassId->Record", !68}
+!83 = !{!"RecordLike::recordData->Record", !69}
+!84 = !{!"Record::extraData", !0}
 
 ; {supertype, category, message, irritants}
 %errorObject = type {%any, i16, %string*, %listElement*}
-!81 = !{!"Any::typeId->ErrorObject", !10}
-!82 = !{!"Any::gcState->ErrorObject", !11}
-!83 = !{!"ErrorObject::category", !0}
-!84 = !{!"ErrorObject::message", !0}
-!85 = !{!"ErrorObject::irritants", !0}
+!85 = !{!"Any::typeId->ErrorObject", !10}
+!86 = !{!"Any::gcState->ErrorObject", !11}
+!87 = !{!"ErrorObject::category", !0}
+!88 = !{!"ErrorObject::message", !0}
+!89 = !{!"ErrorObject::irritants", !0}
 
 ; {supertype, port}
 %port = type {%any, i8*}
-!86 = !{!"Any::typeId->Port", !10}
-!87 = !{!"Any::gcState->Port", !11}
-!88 = !{!"Port::port", !0}
+!90 = !{!"Any::typeId->Port", !10}
+!91 = !{!"Any::gcState->Port", !11}
+!92 = !{!"Port::port", !0}
 
 ; {supertype}
 %eofObject = type {%any}
-!89 = !{!"Any::typeId->EofObject", !10}
-!90 = !{!"Any::gcState->EofObject", !11}
+!93 = !{!"Any::typeId->EofObject", !10}
+!94 = !{!"Any::gcState->EofObject", !11}
 
 ; {supertype, mailbox}
 %mailbox = type {%any, i8*}
-!91 = !{!"Any::typeId->Mailbox", !10}
-!92 = !{!"Any::gcState->Mailbox", !11}
-!93 = !{!"Mailbox::mailbox", !0}
+!95 = !{!"Any::typeId->Mailbox", !10}
+!96 = !{!"Any::gcState->Mailbox", !11}
+!97 = !{!"Mailbox::mailbox", !0}
 
 ; {supertype, datumHashTree}
 %hashMap = type {%any, i8*}
-!94 = !{!"Any::typeId->HashMap", !10}
-!95 = !{!"Any::gcState->HashMap", !11}
-!96 = !{!"HashMap::datumHashTree", !0}
+!98 = !{!"Any::typeId->HashMap", !10}
+!99 = !{!"Any::gcState->HashMap", !11}
+!100 = !{!"HashMap::datumHashTree", !0}
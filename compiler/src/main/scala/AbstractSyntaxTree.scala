@@ -3,6 +3,7 @@ import io.llambda
 
 import llambda.compiler.SchemeParser
 import llambda.compiler.SourceLocated
+import llambda.compiler.ExactFraction
 import llambda.compiler.{valuetype => vt}
 import llambda.compiler.valuetype.Implicits._
 
@@ -56,6 +57,23 @@ case class Integer(value: ScalaLong) extends Number {
   override def toString = value.toString
 }
 
+case class Ratnum(numerator: ScalaLong, denominator: ScalaLong) extends Number {
+  val schemeType = vt.RatnumType
+
+  override def toString = s"${numerator}/${denominator}"
+}
+
+object ExactNumber {
+  /** Returns the datum for an exact fraction in lowest terms */
+  def apply(fraction: ExactFraction): Number =
+    if (fraction.isInteger) {
+      Integer(fraction.numerator)
+    }
+    else {
+      Ratnum(fraction.numerator, fraction.denominator)
+    }
+}
+
 case class Flonum(value: ScalaDouble) extends Number {
   val schemeType = vt.FlonumType
 
@@ -0,0 +1,57 @@
+package io.llambda.compiler
+
+
+/** Exact rational in lowest terms with a positive denominator
+  *
+  * This mirrors the runtime's representation of exact numbers. Fractions with a denominator of one are integers while
+  * all others are ratnums.
+  */
+case class ExactFraction(numerator: Long, denominator: Long) {
+  def isInteger: Boolean =
+    denominator == 1
+
+  def toDouble: Double =
+    numerator.toDouble / denominator.toDouble
+
+  def add(other: ExactFraction): Option[ExactFraction] =
+    ExactFraction.reduce(
+      BigInt(numerator) * other.denominator + BigInt(other.numerator) * denominator,
+      BigInt(denominator) * other.denominator
+    )
+
+  def subtract(other: ExactFraction): Option[ExactFraction] =
+    ExactFraction.reduce(
+      BigInt(numerator) * other.denominator - BigInt(other.numerator) * denominator,
+      BigInt(denominator) * other.denominator
+    )
+
+  def multiply(other: ExactFraction): Option[ExactFraction] =
+    ExactFraction.reduce(BigInt(numerator) * other.numerator, BigInt(denominator) * other.denominator)
+
+  /** Divides by a non-zero fraction */
+  def divide(other: ExactFraction): Option[ExactFraction] =
+    ExactFraction.reduce(BigInt(numerator) * other.denominator, BigInt(denominator) * other.numerator)
+}
+
+object ExactFraction {
+  /** Reduces a fraction to lowest terms
+    *
+    * @param  numerator    Numerator of the fraction
+    * @param  denominator  Non-zero denominator of the fraction
+    * @return Reduced fraction or None if its components can't be represented by 64bit integers
+    */
+  def reduce(numerator: BigInt, denominator: BigInt): Option[ExactFraction] = {
+    // Take the denominator's sign so the reduced denominator is always positive
+    val divisor = numerator.gcd(denominator) * denominator.signum
+
+    val reducedNumerator = numerator / divisor
+    val reducedDenominator = denominator / divisor
+
+    if (reducedNumerator.isValidLong && reducedDenominator.isValidLong) {
+      Some(ExactFraction(reducedNumerator.toLong, reducedDenominator.toLong))
+    }
+    else {
+      None
+    }
+  }
+}
@@ -196,7 +196,20 @@ class SchemeParser(sourceString: String, filenameOpt: Option[String]) extends Pa
 
   // Decimal numbers
   def UnradixedDecimalNumber = rule {
-    (RealDatum | IntegerDatum) ~ Whitespace
+    (RatnumDatum | RealDatum | IntegerDatum) ~ Whitespace
+  }
+
+  def RatnumDatum = rule {
+    capture(optional(SignCharacter) ~ oneOrMore(Digit)) ~ '/' ~ capture(oneOrMore(Digit)) ~> ({ (numerator, denominator) =>
+      val fractionOpt = if (BigInt(denominator) == 0) {
+        None
+      }
+      else {
+        ExactFraction.reduce(BigInt(numerator), BigInt(denominator))
+      }
+
+      test(fractionOpt.isDefined) ~ push(ast.ExactNumber(fractionOpt.get))
+    })
   }
 
   def RealDatum = rule {
@@ -44,7 +44,7 @@ sealed abstract class PreconstructedCellType extends ConcreteCellType
 sealed abstract class CellTypeVariant extends CastableValue
 
 object CellType {
-  val nextMetadataIndex = 97L
+  val nextMetadataIndex = 101L
 }
 
 sealed trait AnyFields {
@@ -888,7 +888,7 @@ object NumberCell extends CellType with NumberFields {
   val llvmName = "number"
   val irType = UserDefinedType("number")
   val schemeName = "<number>"
-  val directSubtypes = Set[CellType](IntegerCell, FlonumCell)
+  val directSubtypes = Set[CellType](IntegerCell, FlonumCell, RatnumCell)
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
@@ -1021,6 +1021,95 @@ object FlonumCell extends ConcreteCellType with FlonumFields {
   }
 }
 
+sealed trait RatnumFields extends NumberFields {
+  val irType: FirstClassType
+
+  val numeratorIrType = IntegerType(64)
+  val numeratorTbaaNode: Metadata
+  val numeratorGepIndices: List[Int]
+
+  val denominatorIrType = IntegerType(64)
+  val denominatorTbaaNode: Metadata
+  val denominatorGepIndices: List[Int]
+
+  def genPointerToNumerator(block: IrBlockBuilder)(valueCell: IrValue): IrValue = {
+    if (valueCell.irType != PointerType(irType)) {
+      throw new InternalCompilerErrorException(s"Unexpected type for cell value. Passed ${valueCell.irType}, expected ${PointerType(irType)}")
+    }
+
+    block.getelementptr("numeratorPtr")(
+      elementType=numeratorIrType,
+      basePointer=valueCell,
+      indices=numeratorGepIndices.map(IntegerConstant(IntegerType(32), _)),
+      inbounds=true
+    )
+  }
+
+  def genStoreToNumerator(block: IrBlockBuilder)(toStore: IrValue, valueCell: IrValue, metadata: Map[String, Metadata] = Map())  {
+    val numeratorPtr = genPointerToNumerator(block)(valueCell)
+    val allMetadata = metadata ++ Map("tbaa" -> numeratorTbaaNode)
+    block.store(toStore, numeratorPtr, metadata=allMetadata)
+  }
+
+  def genLoadFromNumerator(block: IrBlockBuilder)(valueCell: IrValue, metadata: Map[String, Metadata] = Map()): IrValue = {
+    val numeratorPtr = genPointerToNumerator(block)(valueCell)
+    val allMetadata = Map("tbaa" -> numeratorTbaaNode, "invariant.load" -> GlobalDefines.emptyMetadataNode) ++ metadata
+    block.load("numerator")(numeratorPtr, metadata=allMetadata)
+  }
+
+  def genPointerToDenominator(block: IrBlockBuilder)(valueCell: IrValue): IrValue = {
+    if (valueCell.irType != PointerType(irType)) {
+      throw new InternalCompilerErrorException(s"Unexpected type for cell value. Passed ${valueCell.irType}, expected ${PointerType(irType)}")
+    }
+
+    block.getelementptr("denominatorPtr")(
+      elementType=denominatorIrType,
+      basePointer=valueCell,
+      indices=denominatorGepIndices.map(IntegerConstant(IntegerType(32), _)),
+      inbounds=true
+    )
+  }
+
+  def genStoreToDenominator(block: IrBlockBuilder)(toStore: IrValue, valueCell: IrValue, metadata: Map[String, Metadata] = Map())  {
+    val denominatorPtr = genPointerToDenominator(block)(valueCell)
+    val allMetadata = metadata ++ Map("tbaa" -> denominatorTbaaNode)
+    block.store(toStore, denominatorPtr, metadata=allMetadata)
+  }
+
+  def genLoadFromDenominator(block: IrBlockBuilder)(valueCell: IrValue, metadata: Map[String, Metadata] = Map()): IrValue = {
+    val denominatorPtr = genPointerToDenominator(block)(valueCell)
+    val allMetadata = Map("tbaa" -> denominatorTbaaNode, "invariant.load" -> GlobalDefines.emptyMetadataNode) ++ metadata
+    block.load("denominator")(denominatorPtr, metadata=allMetadata)
+  }
+}
+
+object RatnumCell extends ConcreteCellType with RatnumFields {
+  val llvmName = "ratnum"
+  val irType = UserDefinedType("ratnum")
+  val schemeName = "<ratnum>"
+  val directSubtypes = Set[CellType]()
+
+  val typeId = 9L
+
+  val typeIdGepIndices = List(0, 0, 0, 0)
+  val gcStateGepIndices = List(0, 0, 0, 1)
+  val numeratorGepIndices = List(0, 1)
+  val denominatorGepIndices = List(0, 2)
+
+  val typeIdTbaaNode = NumberedMetadata(49L)
+  val gcStateTbaaNode = NumberedMetadata(50L)
+  val numeratorTbaaNode = NumberedMetadata(51L)
+  val denominatorTbaaNode = NumberedMetadata(52L)
+
+  def createConstant(numerator: Long, denominator: Long): StructureConstant = {
+    StructureConstant(List(
+      NumberCell.createConstant(typeId=typeId),
+      IntegerConstant(numeratorIrType, numerator),
+      IntegerConstant(denominatorIrType, denominator)
+    ), userDefinedType=Some(irType))
+  }
+}
+
 sealed trait CharFields extends AnyFields {
   val irType: FirstClassType
 
@@ -1060,15 +1149,15 @@ object CharCell extends ConcreteCellType with CharFields {
   val schemeName = "<char>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 9L
+  val typeId = 10L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
   val unicodeCharGepIndices = List(0, 1)
 
-  val typeIdTbaaNode = NumberedMetadata(49L)
-  val gcStateTbaaNode = NumberedMetadata(50L)
-  val unicodeCharTbaaNode = NumberedMetadata(51L)
+  val typeIdTbaaNode = NumberedMetadata(53L)
+  val gcStateTbaaNode = NumberedMetadata(54L)
+  val unicodeCharTbaaNode = NumberedMetadata(55L)
 
   def createConstant(unicodeChar: Long): StructureConstant = {
     StructureConstant(List(
@@ -1146,17 +1235,17 @@ object VectorCell extends ConcreteCellType with VectorFields {
   val schemeName = "<vector>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 10L
+  val typeId = 11L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
   val lengthGepIndices = List(0, 1)
   val elementsGepIndices = List(0, 2)
 
-  val typeIdTbaaNode = NumberedMetadata(52L)
-  val gcStateTbaaNode = NumberedMetadata(53L)
-  val lengthTbaaNode = NumberedMetadata(54L)
-  val elementsTbaaNode = NumberedMetadata(55L)
+  val typeIdTbaaNode = NumberedMetadata(56L)
+  val gcStateTbaaNode = NumberedMetadata(57L)
+  val lengthTbaaNode = NumberedMetadata(58L)
+  val elementsTbaaNode = NumberedMetadata(59L)
 
   def createConstant(length: Long, elements: IrConstant): StructureConstant = {
     if (elements.irType != elementsIrType) {
@@ -1239,17 +1328,17 @@ object BytevectorCell extends ConcreteCellType with BytevectorFields {
   val schemeName = "<bytevector>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 11L
+  val typeId = 12L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
   val lengthGepIndices = List(0, 1)
   val byteArrayGepIndices = List(0, 2)
 
-  val typeIdTbaaNode = NumberedMetadata(56L)
-  val gcStateTbaaNode = NumberedMetadata(57L)
-  val lengthTbaaNode = NumberedMetadata(58L)
-  val byteArrayTbaaNode = NumberedMetadata(59L)
+  val typeIdTbaaNode = NumberedMetadata(60L)
+  val gcStateTbaaNode = NumberedMetadata(61L)
+  val lengthTbaaNode = NumberedMetadata(62L)
+  val byteArrayTbaaNode = NumberedMetadata(63L)
 
   def createConstant(length: Long, byteArray: IrConstant): StructureConstant = {
     if (byteArray.irType != byteArrayIrType) {
@@ -1397,12 +1486,12 @@ object RecordLikeCell extends CellType with RecordLikeFields {
   val recordClassIdGepIndices = List(0, 3)
   val recordDataGepIndices = List(0, 4)
 
-  val typeIdTbaaNode = NumberedMetadata(60L)
-  val gcStateTbaaNode = NumberedMetadata(61L)
-  val dataIsInlineTbaaNode = NumberedMetadata(62L)
-  val isUndefinedTbaaNode = NumberedMetadata(63L)
-  val recordClassIdTbaaNode = NumberedMetadata(64L)
-  val recordDataTbaaNode = NumberedMetadata(65L)
+  val typeIdTbaaNode = NumberedMetadata(64L)
+  val gcStateTbaaNode = NumberedMetadata(65L)
+  val dataIsInlineTbaaNode = NumberedMetadata(66L)
+  val isUndefinedTbaaNode = NumberedMetadata(67L)
+  val recordClassIdTbaaNode = NumberedMetadata(68L)
+  val recordDataTbaaNode = NumberedMetadata(69L)
 
   def createConstant(dataIsInline: Long, isUndefined: Long, recordClassId: Long, recordData: IrConstant, typeId: Long): StructureConstant = {
     if (recordData.irType != recordDataIrType) {
@@ -1487,7 +1576,7 @@ object ProcedureCell extends ConcreteCellType with ProcedureFields {
   val schemeName = "<procedure>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 12L
+  val typeId = 13L
 
   val typeIdGepIndices = List(0, 0, 0, 0)
   val gcStateGepIndices = List(0, 0, 0, 1)
@@ -1498,14 +1587,14 @@ object ProcedureCell extends ConcreteCellType with ProcedureFields {
   val extraDataGepIndices = List(0, 1)
   val entryPointGepIndices = List(0, 2)
 
-  val typeIdTbaaNode = NumberedMetadata(66L)
-  val gcStateTbaaNode = NumberedMetadata(67L)
-  val dataIsInlineTbaaNode = NumberedMetadata(68L)
-  val isUndefinedTbaaNode = NumberedMetadata(69L)
-  val recordClassIdTbaaNode = NumberedMetadata(70L)
-  val recordDataTbaaNode = NumberedMetadata(71L)
-  val extraDataTbaaNode = NumberedMetadata(72L)
-  val entryPointTbaaNode = NumberedMetadata(73L)
+  val typeIdTbaaNode = NumberedMetadata(70L)
+  val gcStateTbaaNode = NumberedMetadata(71L)
+  val dataIsInlineTbaaNode = NumberedMetadata(72L)
+  val isUndefinedTbaaNode = NumberedMetadata(73L)
+  val recordClassIdTbaaNode = NumberedMetadata(74L)
+  val recordDataTbaaNode = NumberedMetadata(75L)
+  val extraDataTbaaNode = NumberedMetadata(76L)
+  val entryPointTbaaNode = NumberedMetadata(77L)
 
   def createConstant(extraData: IrConstant, entryPoint: IrConstant, dataIsInline: Long, isUndefined: Long, recordClassId: Long, recordData: IrConstant): StructureConstant = {
     if (extraData.irType != extraDataIrType) {
@@ -1563,7 +1652,7 @@ object RecordCell extends ConcreteCellType with RecordFields {
   val schemeName = "<record>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 13L
+  val typeId = 14L
 
   val typeIdGepIndices = List(0, 0, 0, 0)
   val gcStateGepIndices = List(0, 0, 0, 1)
@@ -1573,13 +1662,13 @@ object RecordCell extends ConcreteCellType with RecordFields {
   val recordDataGepIndices = List(0, 0, 4)
   val extraDataGepIndices = List(0, 1)
 
-  val typeIdTbaaNode = NumberedMetadata(74L)
-  val gcStateTbaaNode = NumberedMetadata(75L)
-  val dataIsInlineTbaaNode = NumberedMetadata(76L)
-  val isUndefinedTbaaNode = NumberedMetadata(77L)
-  val recordClassIdTbaaNode = NumberedMetadata(78L)
-  val recordDataTbaaNode = NumberedMetadata(79L)
-  val extraDataTbaaNode = NumberedMetadata(80L)
+  val typeIdTbaaNode = NumberedMetadata(78L)
+  val gcStateTbaaNode = NumberedMetadata(79L)
+  val dataIsInlineTbaaNode = NumberedMetadata(80L)
+  val isUndefinedTbaaNode = NumberedMetadata(81L)
+  val recordClassIdTbaaNode = NumberedMetadata(82L)
+  val recordDataTbaaNode = NumberedMetadata(83L)
+  val extraDataTbaaNode = NumberedMetadata(84L)
 
   def createConstant(extraData: IrConstant, dataIsInline: Long, isUndefined: Long, recordClassId: Long, recordData: IrConstant): StructureConstant = {
     if (extraData.irType != extraDataIrType) {
@@ -1690,7 +1779,7 @@ object ErrorObjectCell extends ConcreteCellType with ErrorObjectFields {
   val schemeName = "<error-object>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 14L
+  val typeId = 15L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
@@ -1698,11 +1787,11 @@ object ErrorObjectCell extends ConcreteCellType with ErrorObjectFields {
   val messageGepIndices = List(0, 2)
   val irritantsGepIndices = List(0, 3)
 
-  val typeIdTbaaNode = NumberedMetadata(81L)
-  val gcStateTbaaNode = NumberedMetadata(82L)
-  val categoryTbaaNode = NumberedMetadata(83L)
-  val messageTbaaNode = NumberedMetadata(84L)
-  val irritantsTbaaNode = NumberedMetadata(85L)
+  val typeIdTbaaNode = NumberedMetadata(85L)
+  val gcStateTbaaNode = NumberedMetadata(86L)
+  val categoryTbaaNode = NumberedMetadata(87L)
+  val messageTbaaNode = NumberedMetadata(88L)
+  val irritantsTbaaNode = NumberedMetadata(89L)
 
   def createConstant(category: Long, message: IrConstant, irritants: IrConstant): StructureConstant = {
     if (message.irType != messageIrType) {
@@ -1761,15 +1850,15 @@ object PortCell extends ConcreteCellType with PortFields {
   val schemeName = "<port>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 15L
+  val typeId = 16L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
   val portGepIndices = List(0, 1)
 
-  val typeIdTbaaNode = NumberedMetadata(86L)
-  val gcStateTbaaNode = NumberedMetadata(87L)
-  val portTbaaNode = NumberedMetadata(88L)
+  val typeIdTbaaNode = NumberedMetadata(90L)
+  val gcStateTbaaNode = NumberedMetadata(91L)
+  val portTbaaNode = NumberedMetadata(92L)
 
   def createConstant(port: IrConstant): StructureConstant = {
     if (port.irType != portIrType) {
@@ -1793,13 +1882,13 @@ object EofObjectCell extends PreconstructedCellType with EofObjectFields {
   val schemeName = "<eof-object>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 16L
+  val typeId = 17L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
 
-  val typeIdTbaaNode = NumberedMetadata(89L)
-  val gcStateTbaaNode = NumberedMetadata(90L)
+  val typeIdTbaaNode = NumberedMetadata(93L)
+  val gcStateTbaaNode = NumberedMetadata(94L)
 }
 
 sealed trait MailboxFields extends AnyFields {
@@ -1841,15 +1930,15 @@ object MailboxCell extends ConcreteCellType with MailboxFields {
   val schemeName = "<mailbox>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 17L
+  val typeId = 18L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
   val mailboxGepIndices = List(0, 1)
 
-  val typeIdTbaaNode = NumberedMetadata(91L)
-  val gcStateTbaaNode = NumberedMetadata(92L)
-  val mailboxTbaaNode = NumberedMetadata(93L)
+  val typeIdTbaaNode = NumberedMetadata(95L)
+  val gcStateTbaaNode = NumberedMetadata(96L)
+  val mailboxTbaaNode = NumberedMetadata(97L)
 
   def createConstant(mailbox: IrConstant): StructureConstant = {
     if (mailbox.irType != mailboxIrType) {
@@ -1902,15 +1991,15 @@ object HashMapCell extends ConcreteCellType with HashMapFields {
   val schemeName = "<hash-map>"
   val directSubtypes = Set[CellType]()
 
-  val typeId = 18L
+  val typeId = 19L
 
   val typeIdGepIndices = List(0, 0, 0)
   val gcStateGepIndices = List(0, 0, 1)
   val datumHashTreeGepIndices = List(0, 1)
 
-  val typeIdTbaaNode = NumberedMetadata(94L)
-  val gcStateTbaaNode = NumberedMetadata(95L)
-  val datumHashTreeTbaaNode = NumberedMetadata(96L)
+  val typeIdTbaaNode = NumberedMetadata(98L)
+  val gcStateTbaaNode = NumberedMetadata(99L)
+  val datumHashTreeTbaaNode = NumberedMetadata(100L)
 
   def createConstant(datumHashTree: IrConstant): StructureConstant = {
     if (datumHashTree.irType != datumHashTreeIrType) {
@@ -28,6 +28,7 @@ class ConstantGenerator(generatedTypes: Map[vt.RecordLikeType, GeneratedType]) {
   private val symbolCache = new mutable.HashMap[String, IrConstant]
   private val integerCache = new mutable.LongMap[IrConstant]
   private val flonumCache = new mutable.LongMap[IrConstant]
+  private val ratnumCache = new mutable.HashMap[(Long, Long), IrConstant]
   private val characterCache = new mutable.LongMap[IrConstant]
   private val bytevectorCache = new mutable.HashMap[Vector[Byte], IrConstant]
   private val pairCache = new mutable.HashMap[(IrConstant, IrConstant), IrConstant]
@@ -321,6 +322,18 @@ class ConstantGenerator(generatedTypes: Map[vt.RecordLikeType, GeneratedType]) {
           defineConstantData(module)(flonumCellName, flonumCell)
         })
 
+      case ps.CreateRatnumCell(_, numerator, denominator) =>
+        ratnumCache.getOrElseUpdate((numerator, denominator), {
+          val ratnumCellName = module.nameSource.allocate("schemeRatnum")
+
+          val ratnumCell = ct.RatnumCell.createConstant(
+            numerator=numerator,
+            denominator=denominator
+          )
+
+          defineConstantData(module)(ratnumCellName, ratnumCell)
+        })
+
       case ps.CreateBooleanCell(_, true) =>
         GlobalDefines.trueIrValue
 
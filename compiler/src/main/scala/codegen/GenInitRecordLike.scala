@@ -70,8 +70,10 @@ object GenInitRecordLike {
         // Find the size of the record data
         val irSize = IntegerConstant(IntegerType(32), generatedType.sizeBytes)
 
-        // Allocate it using llcore_record_data_alloc
-        val voidRecordData = block.callDecl(Some("rawRecordData"))(recordDataAllocDecl, List(irSize)).get
+        // Allocate it from the world's storage arena using llcore_record_data_alloc. This doesn't touch the cells
+        // reserved by our current allocation and can't trigger a collection.
+        val worldPtrIr = state.liveTemps(ps.WorldPtrValue)
+        val voidRecordData = block.callDecl(Some("rawRecordData"))(recordDataAllocDecl, List(worldPtrIr, irSize)).get
 
         // Store the record data pointer in the new cell
         cellType.genStoreToRecordData(block)(voidRecordData, recordCell)
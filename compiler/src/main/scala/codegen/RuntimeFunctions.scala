@@ -77,6 +77,7 @@ object RuntimeFunctions {
     result=IrFunction.Result(PointerType(IntegerType(8))),
     name="llcore_record_data_alloc",
     arguments=List(
+      IrFunction.Argument(PointerType(WorldValue.irType)),
       IrFunction.Argument(IntegerType(32))
     ),
     attributes=Set(IrFunction.NoUnwind)
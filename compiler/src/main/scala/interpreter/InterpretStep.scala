@@ -44,6 +44,10 @@ object InterpretStep {
       val datumCell = DatumCell(ast.Flonum(value), ct.FlonumCell)
       state.copy(state.liveTemps + (resultTemp -> datumCell))
 
+    case ps.CreateRatnumCell(resultTemp, numerator, denominator) =>
+      val datumCell = DatumCell(ast.Ratnum(numerator, denominator), ct.RatnumCell)
+      state.copy(state.liveTemps + (resultTemp -> datumCell))
+
     case ps.CreateCharCell(resultTemp, value) =>
       val datumCell = DatumCell(ast.Char(value), ct.CharCell)
       state.copy(state.liveTemps + (resultTemp -> datumCell))
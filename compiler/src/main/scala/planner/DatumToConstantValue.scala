@@ -11,6 +11,7 @@ object DatumToConstantValue {
       case ast.Symbol(content) =>      iv.ConstantSymbolValue(content)
       case ast.Integer(value) =>       iv.ConstantIntegerValue(value)
       case ast.Flonum(value) =>        iv.ConstantFlonumValue(value)
+      case ast.Ratnum(num, denom) =>   iv.ConstantRatnumValue(num, denom)
       case ast.Boolean(value) =>       iv.ConstantBooleanValue(value)
       case ast.Char(value) =>          iv.ConstantCharValue(value)
       case ast.Pair(car, cdr) =>       iv.ConstantPairValue(apply(car), apply(cdr))
@@ -357,6 +357,13 @@ case class CreateFlonumCell(result: TempValue, value: Double) extends CreateCons
     MergeKey(java.lang.Double.doubleToLongBits(value))
 }
 
+case class CreateRatnumCell(result: TempValue, numerator: Long, denominator: Long) extends CreateConstantCell {
+  val inputValues = Set[TempValue]()
+
+  def renamed(f: (TempValue) => TempValue) =
+    CreateRatnumCell(f(result), numerator, denominator).assignLocationFrom(this)
+}
+
 case class CreateCharCell(result: TempValue, value: Int) extends CreateConstantCell {
   val inputValues = Set[TempValue]()
 
@@ -876,7 +883,7 @@ case class InitRecord(
     isUndefined: Boolean,
     stackAllocate: Boolean = false
 ) extends InitRecordLikeStep {
-  lazy val inputValues = fieldValues.map(_._2).toSet
+  lazy val inputValues = fieldValues.map(_._2).toSet + WorldPtrValue
   lazy val outputValues = Set(result)
 
   def asStackAllocated = this.copy(stackAllocate=true).assignLocationFrom(this)
@@ -895,7 +902,7 @@ case class InitInternalProc(
     fieldValues: Map[vt.RecordField, TempValue],
     stackAllocate: Boolean = false
 ) extends InitRecordLikeStep {
-  lazy val inputValues = fieldValues.map(_._2).toSet
+  lazy val inputValues = fieldValues.map(_._2).toSet + WorldPtrValue
   lazy val outputValues = Set(result)
 
   val isUndefined = false
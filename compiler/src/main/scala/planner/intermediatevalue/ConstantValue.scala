@@ -6,7 +6,7 @@ import llambda.compiler.{valuetype => vt}
 import llambda.compiler.valuetype.Implicits._
 import llambda.compiler.planner.{step => ps}
 import llambda.compiler.planner.{PlanWriter, BoxedValue}
-import llambda.compiler.{RuntimeErrorMessage, IntervalSet}
+import llambda.compiler.{RuntimeErrorMessage, IntervalSet, ExactFraction}
 
 
 sealed abstract class ConstantValue(val cellType: ct.ConcreteCellType) extends IntermediateValue with UninvokableValue {
@@ -110,6 +110,23 @@ case class ConstantFlonumValue(value: Double) extends TrivialConstantValue(ct.Fl
   }
 }
 
+case class ConstantRatnumValue(numerator: Long, denominator: Long) extends ConstantValue(ct.RatnumCell) with BoxedOnlyValue {
+  val typeDescription = "constant ratnum"
+
+  def fraction: ExactFraction =
+    ExactFraction(numerator, denominator)
+
+  def doubleValue: Double =
+    fraction.toDouble
+
+  def toBoxedValue()(implicit plan: PlanWriter): BoxedValue = {
+    val constantTemp = ps.TempValue()
+    plan.steps += ps.CreateRatnumCell(constantTemp, numerator, denominator)
+
+    BoxedValue(cellType, constantTemp)
+  }
+}
+
 case class ConstantCharValue(value: Int) extends TrivialConstantValue(ct.CharCell, value, ps.CreateCharCell.apply) with UnboxedValue {
   val typeDescription = "constant character"
   val nativeType = vt.UnicodeChar
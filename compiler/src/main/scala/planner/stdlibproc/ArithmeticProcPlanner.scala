@@ -2,7 +2,7 @@ package io.llambda.compiler.planner.stdlibproc
 import io.llambda
 
 import llambda.compiler.{valuetype => vt}
-import llambda.compiler.{RuntimeErrorMessage, ContextLocated, ErrorCategory}
+import llambda.compiler.{RuntimeErrorMessage, ContextLocated, ErrorCategory, ExactFraction}
 import llambda.compiler.{DivideByZeroException, IntegerOverflowException}
 import llambda.compiler.planner.{step => ps}
 import llambda.compiler.planner.{intermediatevalue => iv}
@@ -14,6 +14,68 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
   private type CheckedInstrBuilder = (ps.TempValue, ps.TempValue, ps.TempValue, RuntimeErrorMessage) => ps.Step
   private type StaticIntegerOp = (BigInt, BigInt) => BigInt
   private type StaticDoubleOp = (Double, Double) => Double
+  private type StaticFractionOp = (ExactFraction, ExactFraction) => Option[ExactFraction]
+
+  /** Matches constant integers and ratnums as exact fractions */
+  private object ConstantExact {
+    def unapply(value: iv.IntermediateValue): Option[ExactFraction] = value match {
+      case iv.ConstantIntegerValue(intValue) =>
+        Some(ExactFraction(intValue, 1))
+
+      case ratnumValue: iv.ConstantRatnumValue =>
+        Some(ratnumValue.fraction)
+
+      case _ =>
+        None
+    }
+  }
+
+  /** Matches any constant number as a double */
+  private object ConstantDouble {
+    def unapply(value: iv.IntermediateValue): Option[Double] = value match {
+      case numberValue: iv.ConstantNumberValue =>
+        Some(numberValue.doubleValue)
+
+      case ratnumValue: iv.ConstantRatnumValue =>
+        Some(ratnumValue.doubleValue)
+
+      case _ =>
+        None
+    }
+  }
+
+  private def exactNumberValue(fraction: ExactFraction): iv.ConstantValue =
+    if (fraction.isInteger) {
+      iv.ConstantIntegerValue(fraction.numerator)
+    }
+    else {
+      iv.ConstantRatnumValue(fraction.numerator, fraction.denominator)
+    }
+
+  /** Folds exact operations involving constant ratnums
+    *
+    * Operations only involving integers and flonums are handled by performBinaryMixedOp(). If any intermediate result
+    * can't be represented this returns None so the runtime can raise the appropriate error.
+    */
+  private def foldRatnumConstants(
+      staticFractionCalc: StaticFractionOp,
+      operands: List[iv.IntermediateValue]
+  ): Option[iv.IntermediateValue] = {
+    if (!operands.exists(_.isInstanceOf[iv.ConstantRatnumValue])) {
+      return None
+    }
+
+    val fractions = operands.collect { case ConstantExact(fraction) => fraction }
+
+    if (fractions.length != operands.length) {
+      // Not every operand is an exact constant
+      return None
+    }
+
+    fractions.tail.foldLeft(Option(fractions.head)) { (accumOpt, fraction) =>
+      accumOpt.flatMap(staticFractionCalc(_, fraction))
+    }.map(exactNumberValue)
+  }
 
   private def performBinaryMixedOp(
       intInstr: CheckedInstrBuilder,
@@ -100,32 +162,33 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
     implicit val inlinePlan = plan.forkPlan()
 
     val resultValue = operands.reduceLeft { (op1: iv.IntermediateValue, op2: iv.IntermediateValue) => (op1, op2) match {
-      case (iv.ConstantIntegerValue(Long.MinValue), iv.ConstantIntegerValue(-1)) =>
-        // This would cause an integer overflow
-        iv.ConstantFlonumValue(Long.MinValue.toDouble / -1.toDouble)
-
-      case (iv.ConstantIntegerValue(numerInt), iv.ConstantIntegerValue(denomInt)) =>
-        if (denomInt == 0) {
+      case (ConstantExact(numerFraction), ConstantExact(denomFraction)) =>
+        if (denomFraction.numerator == 0) {
           throw new DivideByZeroException(plan.activeContextLocated, "Attempted (/) by integer zero")
         }
-        else if ((numerInt % denomInt) == 0) {
-          // This divides exactly
-          iv.ConstantIntegerValue(numerInt / denomInt)
-        }
-        else {
-          // This does not divide exactly
-          iv.ConstantFlonumValue(numerInt.toDouble / denomInt.toDouble)
+
+        numerFraction.divide(denomFraction) match {
+          case Some(quotientFraction) =>
+            exactNumberValue(quotientFraction)
+
+          case None =>
+            // There are no bignums; the runtime performs this as flonum division
+            val bigNumer = BigInt(numerFraction.numerator) * denomFraction.denominator
+            val bigDenom = BigInt(numerFraction.denominator) * denomFraction.numerator
+            val divisor = bigNumer.gcd(bigDenom) * bigDenom.signum
+
+            iv.ConstantFlonumValue((bigNumer / divisor).toDouble / (bigDenom / divisor).toDouble)
         }
 
-      case (numerNumValue: iv.ConstantNumberValue, iv.ConstantIntegerValue(denomIntVal)) =>
-        if (denomIntVal == 0) {
+      case (ConstantDouble(numerDouble), ConstantExact(denomFraction)) =>
+        if (denomFraction.numerator == 0) {
           throw new DivideByZeroException(plan.activeContextLocated, "Attempted (/) by integer zero")
         }
 
-        iv.ConstantFlonumValue(numerNumValue.doubleValue / denomIntVal.toDouble)
+        iv.ConstantFlonumValue(numerDouble / denomFraction.toDouble)
 
-      case (numerNumValue: iv.ConstantNumberValue, iv.ConstantFlonumValue(denomFlonumVal)) =>
-        iv.ConstantFlonumValue(numerNumValue.doubleValue / denomFlonumVal)
+      case (ConstantDouble(numerDouble), iv.ConstantFlonumValue(denomFlonumVal)) =>
+        iv.ConstantFlonumValue(numerDouble / denomFlonumVal)
 
       case (dynamicNumer, dynamicDenom) =>
         val typedNumer = TypedNumberValue.fromIntermediateValue(dynamicNumer)
@@ -261,7 +324,8 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
       )
 
       val argValues = multipleArgs.map(_._2)
-      performBinaryMixedOp(
+
+      foldRatnumConstants(_ add _, argValues) orElse performBinaryMixedOp(
         intInstr=ps.CheckedIntegerAdd.apply,
         flonumInstr=ps.FloatAdd.apply,
         staticIntCalc=_ + _,
@@ -282,7 +346,8 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
 
       // This is a special case that negates the passed value
       val constantZero = iv.ConstantIntegerValue(0)
-      performBinaryMixedOp(
+
+      foldRatnumConstants(_ subtract _, List(constantZero, singleArg)) orElse performBinaryMixedOp(
         intInstr=ps.CheckedIntegerSub.apply,
         flonumInstr=ps.FloatSub.apply,
         staticIntCalc=_ - _,
@@ -298,7 +363,8 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
       )
 
       val argValues = multipleArgs.map(_._2)
-      performBinaryMixedOp(
+
+      foldRatnumConstants(_ subtract _, argValues) orElse performBinaryMixedOp(
         intInstr=ps.CheckedIntegerSub.apply,
         flonumInstr=ps.FloatSub.apply,
         staticIntCalc=_ - _,
@@ -314,7 +380,8 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
       )
 
       val argValues = multipleArgs.map(_._2)
-      performBinaryMixedOp(
+
+      foldRatnumConstants(_ multiply _, argValues) orElse performBinaryMixedOp(
         intInstr=ps.CheckedIntegerMul.apply,
         flonumInstr=ps.FloatMul.apply,
         staticIntCalc=_ * _,
@@ -358,6 +425,24 @@ object ArithmeticProcPlanner extends StdlibProcPlanner {
     case ("round", List((_, iv.ConstantFlonumValue(value)))) =>
       Some(new iv.ConstantFlonumValue(Math.round(value)))
 
+    case ("floor", List((_, iv.ConstantRatnumValue(numerator, denominator)))) =>
+      Some(iv.ConstantIntegerValue(Math.floorDiv(numerator, denominator)))
+
+    case ("ceiling", List((_, iv.ConstantRatnumValue(numerator, denominator)))) =>
+      // Ratnums are never integral so this is always one above the floor
+      Some(iv.ConstantIntegerValue(Math.floorDiv(numerator, denominator) + 1))
+
+    case ("truncate", List((_, iv.ConstantRatnumValue(numerator, denominator)))) =>
+      Some(iv.ConstantIntegerValue(numerator / denominator))
+
+    case ("round", List((_, iv.ConstantRatnumValue(numerator, denominator)))) =>
+      val floorValue = Math.floorDiv(numerator, denominator)
+      val doubledRemainder = BigInt(Math.floorMod(numerator, denominator)) * 2
+
+      // Ties round to the even integer
+      val roundsUp = (doubledRemainder > denominator) || ((doubledRemainder == BigInt(denominator)) && ((floorValue & 1) != 0))
+      Some(iv.ConstantIntegerValue(if (roundsUp) floorValue + 1 else floorValue))
+
     case _ =>
       None
   }
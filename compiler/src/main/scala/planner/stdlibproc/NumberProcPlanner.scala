@@ -37,6 +37,10 @@ object NumberProcPlanner extends StdlibProcPlanner {
         throw new InvalidArgumentException(plan.activeContextLocated, "Attempted to convert non-integral flonum to integer")
       }
 
+    case _: iv.ConstantRatnumValue =>
+      // Ratnums are never integral
+      throw new InvalidArgumentException(plan.activeContextLocated, "Attempted to convert non-integral ratnum to integer")
+
     case _ =>
       None
   }
@@ -52,6 +56,9 @@ object NumberProcPlanner extends StdlibProcPlanner {
       // Statically convert it to a double
       Some(iv.ConstantFlonumValue(constIntegerVal.toDouble))
 
+    case constRatnum: iv.ConstantRatnumValue =>
+      Some(iv.ConstantFlonumValue(constRatnum.doubleValue))
+
     case knownInt if knownInt.hasDefiniteType(vt.IntegerType) =>
       val intTemp = knownInt.toTempValue(vt.Int64)
       val doubleTemp = ps.TempValue()
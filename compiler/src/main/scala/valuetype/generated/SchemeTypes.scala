@@ -13,9 +13,10 @@ object EmptyListType extends SchemeTypeAtom(ct.EmptyListCell)
 object StringType extends SchemeTypeAtom(ct.StringCell)
 object SymbolType extends SchemeTypeAtom(ct.SymbolCell)
 object BooleanType extends SchemeTypeAtom(ct.BooleanCell)
-object NumberType extends UnionType(Set(SchemeTypeAtom(ct.IntegerCell), SchemeTypeAtom(ct.FlonumCell)))
+object NumberType extends UnionType(Set(SchemeTypeAtom(ct.IntegerCell), SchemeTypeAtom(ct.FlonumCell), SchemeTypeAtom(ct.RatnumCell)))
 object IntegerType extends SchemeTypeAtom(ct.IntegerCell)
 object FlonumType extends SchemeTypeAtom(ct.FlonumCell)
+object RatnumType extends SchemeTypeAtom(ct.RatnumCell)
 object CharType extends SchemeTypeAtom(ct.CharCell)
 object VectorType extends SchemeTypeAtom(ct.VectorCell)
 object BytevectorType extends SchemeTypeAtom(ct.BytevectorCell)
@@ -35,6 +36,7 @@ object IntrinsicSchemeTypes {
     (ct.NumberCell.schemeName -> NumberType),
     (ct.IntegerCell.schemeName -> IntegerType),
     (ct.FlonumCell.schemeName -> FlonumType),
+    (ct.RatnumCell.schemeName -> RatnumType),
     (ct.CharCell.schemeName -> CharType),
     (ct.VectorCell.schemeName -> VectorType),
     (ct.BytevectorCell.schemeName -> BytevectorType),
@@ -5,8 +5,8 @@
   (import (llambda duration))
 
   (export act tell forward ask self sender stop graceful-stop mailbox? mailbox-open? poison-pill-object
-          poison-pill-object? become set-supervisor-strategy schedule-once <mailbox> <behaviour> <failure-action>
-          <supervisor-strategy> <poison-pill-object>)
+          poison-pill-object? become set-supervisor-strategy schedule-once schedule-repeatedly cancel-schedule
+          <schedule> schedule? set-mailbox-capacity mailbox-queue-depth <overflow-policy> <mailbox> <behaviour> <failure-action> <supervisor-strategy> <poison-pill-object>)
 
   (begin
     (define-native-library llactor (static-library "ll_llambda_actor"))
@@ -33,6 +33,20 @@
     (define-predicate mailbox? <mailbox>)
     (define mailbox-open? (world-function llactor "llactor_mailbox_is_open" (-> <mailbox> <native-bool>)))
 
+    (define-type <overflow-policy> (U 'block 'drop-newest 'drop-oldest 'fail))
+
+    (define native-set-mailbox-capacity (world-function llactor "llactor_set_mailbox_capacity" (-> <mailbox> <native-int64> <native-int32> <unit>)))
+    (: set-mailbox-capacity (-> <mailbox> <integer> <overflow-policy> <unit>))
+    (define (set-mailbox-capacity mailbox capacity policy)
+      ; These match the values in runtime/actor/OverflowPolicy.h
+      (native-set-mailbox-capacity mailbox capacity (case policy
+                                                      ((block) 0)
+                                                      ((drop-newest) 1)
+                                                      ((drop-oldest) 2)
+                                                      ((fail) 3))))
+
+    (define mailbox-queue-depth (world-function llactor "llactor_mailbox_queue_depth" (-> <mailbox> <native-int64>)))
+
     (define-type <poison-pill-object> (ExternalRecord (native-function llactor "llactor_is_poison_pill_object" (-> <any> <native-bool>))))
     (define poison-pill-object (native-function llactor "llactor_poison_pill_object" (-> <poison-pill-object>)))
     (define-predicate poison-pill-object? <poison-pill-object>)
@@ -41,4 +55,21 @@
 
     (define set-supervisor-strategy (world-function llactor "llactor_set_supervisor_strategy" (-> <supervisor-strategy> <unit>)))
 
-    (define schedule-once (world-function llactor "llactor_schedule_once" (-> <native-int64> <mailbox> <any> <unit>)))))
+    ; Handle to a scheduled message that can be passed to (cancel-schedule)
+    (define-record-type <schedule> (make-schedule timer-id) schedule?
+      ([timer-id : <integer>] schedule-timer-id))
+
+    (define native-schedule-once (world-function llactor "llactor_schedule_once" (-> <native-int64> <mailbox> <any> <native-int64>)))
+    (: schedule-once (-> <duration> <mailbox> <any> <schedule>))
+    (define (schedule-once delay mailbox message)
+      (make-schedule (native-schedule-once delay mailbox message)))
+
+    (define native-schedule-repeatedly (world-function llactor "llactor_schedule_repeatedly" (-> <native-int64> <native-int64> <mailbox> <any> <native-int64>)))
+    (: schedule-repeatedly (-> <duration> <duration> <mailbox> <any> <schedule>))
+    (define (schedule-repeatedly initial-delay interval mailbox message)
+      (make-schedule (native-schedule-repeatedly initial-delay interval mailbox message)))
+
+    (define native-cancel-schedule (native-function llactor "llactor_cancel_schedule" (-> <native-int64> <native-bool>)))
+    (: cancel-schedule (-> <schedule> <boolean>))
+    (define (cancel-schedule schedule)
+      (native-cancel-schedule (schedule-timer-id schedule)))))
@@ -275,10 +275,12 @@
     (define-stdlib number? (make-predicate <number>))
     (define-stdlib flonum? (make-predicate <flonum>))
     (define-stdlib integer? (make-predicate <integer>))
+    (define ratnum? (make-predicate <ratnum>))
 
     (define (rational? [val : <any>])
       (cond
         ((integer? val) #t)
+        ((ratnum? val) #t)
         ((flonum? val)
          ; XXX: This would be more idiomatic as a (memv) but our optimiser has issues getting rid of the temporary list
          (not (or (eqv? val +nan.0) (eqv? val +inf.0) (eqv? val -inf.0))))
@@ -301,31 +303,48 @@
       (if (integer? n) (< n 0) (< n 0.0)))
 
     (define native-floor (native-function system-library "floor" (-> <native-double> <native-double>)))
-    (: floor (All ([N : <number>]) (-> N N)))
+    (define native-ratnum-floor (native-function llbase "llbase_ratnum_floor" (-> <ratnum> <native-int64>) nocapture))
+    (: floor (All ([N : <number>]) (-> N (U N <integer>))))
     (define-stdlib (floor n)
-      (if (integer? n) n (native-floor n)))
+      (cond
+        ((integer? n) n)
+        ((flonum? n) (native-floor n))
+        (else (native-ratnum-floor n))))
 
     (define native-ceil (native-function system-library "ceil" (-> <native-double> <native-double>)))
-    (: ceiling (All ([N : <number>]) (-> N N)))
+    (define native-ratnum-ceiling (native-function llbase "llbase_ratnum_ceiling" (-> <ratnum> <native-int64>) nocapture))
+    (: ceiling (All ([N : <number>]) (-> N (U N <integer>))))
     (define-stdlib (ceiling n)
-      (if (integer? n) n (native-ceil n)))
+      (cond
+        ((integer? n) n)
+        ((flonum? n) (native-ceil n))
+        (else (native-ratnum-ceiling n))))
 
     (define native-trunc (native-function system-library "trunc" (-> <native-double> <native-double>)))
-    (: truncate (All ([N : <number>]) (-> N N)))
+    (define native-ratnum-truncate (native-function llbase "llbase_ratnum_truncate" (-> <ratnum> <native-int64>) nocapture))
+    (: truncate (All ([N : <number>]) (-> N (U N <integer>))))
     (define-stdlib (truncate n)
-      (if (integer? n) n (native-trunc n)))
+      (cond
+        ((integer? n) n)
+        ((flonum? n) (native-trunc n))
+        (else (native-ratnum-truncate n))))
 
     (define native-round (native-function system-library "round" (-> <native-double> <native-double>)))
-    (: round (All ([N : <number>]) (-> N N)))
+    (define native-ratnum-round (native-function llbase "llbase_ratnum_round" (-> <ratnum> <native-int64>) nocapture))
+    (: round (All ([N : <number>]) (-> N (U N <integer>))))
     (define-stdlib (round n)
-      (if (integer? n) n (native-round n)))
+      (cond
+        ((integer? n) n)
+        ((flonum? n) (native-round n))
+        (else (native-ratnum-round n))))
 
     (define-stdlib integer (world-function llbase "llbase_integer" (-> <number> <native-int64>)))
     (define-stdlib flonum (native-function llbase "llbase_flonum" (-> <number> <native-double>) nocapture))
 
-    (define-stdlib + (world-function llbase "llbase_add" (All ([N : <number>]) N * N) nocapture))
-    (define-stdlib - (world-function llbase "llbase_sub" (All ([N : <number>]) N N * N) nocapture))
-    (define-stdlib * (world-function llbase "llbase_mul" (All ([N : <number>]) N * N) nocapture))
+    ; Exact rationals can sum or multiply to integers
+    (define-stdlib + (world-function llbase "llbase_add" (All ([N : <number>]) N * (U N <integer>)) nocapture))
+    (define-stdlib - (world-function llbase "llbase_sub" (All ([N : <number>]) N N * (U N <integer>)) nocapture))
+    (define-stdlib * (world-function llbase "llbase_mul" (All ([N : <number>]) N * (U N <integer>)) nocapture))
     (define-stdlib / (world-function llbase "llbase_div" (-> <number> <number> * <number>)))
 
     (define-stdlib expt (world-function llbase "llbase_expt" (All ([N : <number>]) (-> N N N)) nocapture))
@@ -338,18 +357,24 @@
     (define-stdlib (abs num)
       ; Do a top-level type check to make the compiler generate a specialised version of each branch. The test itself is
       ; semantically a no-op
-      (if (integer? num)
-        (if (< num 0)
-          (- num)
-          num)
-        #| This generates less efficient code than fabs()
-           However, this has two important benefits: it can be statically evaluated without any explicit (abs) planning
-           in the compiler and it avoid a cell allocation for positive values. |#
-        (if (zero? num)
-          0.0
-          (if (< num 0.0)
-            (- num)
-            num))))
+      (cond
+        ((integer? num)
+         (if (< num 0)
+           (- num)
+           num))
+        ((ratnum? num)
+         (if (< num 0)
+           (- num)
+           num))
+        (else
+         #| This generates less efficient code than fabs()
+            However, this has two important benefits: it can be statically evaluated without any explicit (abs) planning
+            in the compiler and it avoid a cell allocation for positive values. |#
+         (if (zero? num)
+           0.0
+           (if (< num 0.0)
+             (- num)
+             num)))))
 
     (define-stdlib truncate/ (world-function llbase "llbase_truncate_div" (-> <native-int64> <native-int64> (Pairof <integer> <integer>))))
     (define-stdlib truncate-quotient (world-function llbase "llbase_truncate_quotient" (-> <native-int64> <native-int64> <native-int64>)))
@@ -368,13 +393,13 @@
     (define-stdlib max (native-function llbase "llbase_max" (All ([N : <number>]) N N * N)))
     (define-stdlib min (native-function llbase "llbase_min" (All ([N : <number>]) N N * N)))
 
-    (define native-gcd (native-function llbase "llbase_gcd" (-> <native-int64> <native-int64> <integer> * <native-int64>) nocapture))
+    (define native-gcd (world-function llbase "llbase_gcd" (-> <native-int64> <native-int64> <integer> * <native-int64>) nocapture))
     (define-stdlib gcd (case-lambda
                        (() 0)
                        (([single : <integer>]) (abs single))
                        (rest (apply native-gcd rest))))
 
-    (define native-lcm (native-function llbase "llbase_lcm" (-> <native-int64> <native-int64> <integer> * <native-int64>) nocapture))
+    (define native-lcm (world-function llbase "llbase_lcm" (-> <native-int64> <native-int64> <integer> * <native-int64>) nocapture))
     (define-stdlib lcm (case-lambda
                        (() 1)
                        (([single : <integer>]) (abs single))
@@ -0,0 +1,10 @@
+(define-library (llambda metrics)
+  (import (llambda nfi))
+  (import (rename (llambda internal primitives) (define-stdlib-procedure define-stdlib)))
+
+  (export runtime-metrics)
+
+  (begin
+    (define-native-library llmetrics (static-library "ll_llambda_metrics"))
+
+    (define-stdlib runtime-metrics (world-function llmetrics "llmetrics_runtime_metrics" (-> (HashMap <symbol> <integer>))))))
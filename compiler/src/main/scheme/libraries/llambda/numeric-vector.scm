@@ -0,0 +1,140 @@
+(define-library (llambda numeric-vector)
+  (import (llambda base))
+  (import (llambda typed))
+  (import (llambda nfi))
+  (import (rename (llambda internal primitives) (define-stdlib-procedure define-stdlib)))
+
+  (export <f64vector> f64vector? make-f64vector f64vector f64vector-length f64vector-ref f64vector-set!
+          f64vector->list list->f64vector)
+  (export f64vector-sum f64vector-dot f64vector-min f64vector-max f64vector-scale f64vector-add f64vector-multiply
+          f64vector-prefix-sum f64vector-mask< f64vector-mask> f64vector-mask=)
+  (export <s64vector> s64vector? make-s64vector s64vector s64vector-length s64vector-ref s64vector-set!
+          s64vector->list list->s64vector)
+  (export s64vector-sum s64vector-min s64vector-max)
+
+  ; Homogeneous numeric vectors from SRFI 4
+  ;
+  ; Elements are stored unboxed in a bytevector wrapped in a record. This lets element access pass native values
+  ; directly to and from the runtime instead of allocating a boxed number for every element.
+  (begin
+    (define-native-library llnumvec (static-library "ll_llambda_numericvector"))
+
+    (define-record-type <f64vector> (bytevector->f64vector bytes) f64vector?
+      ([bytes : <bytevector>] f64vector-bytes))
+
+    (define native-make-f64vector (world-function llnumvec "llnumvec_make_f64vector" (-> <native-int64> <native-double> <bytevector>)))
+    (define-stdlib (make-f64vector [len : <integer>] [fill : <number> 0.0])
+      (bytevector->f64vector (native-make-f64vector len (flonum fill))))
+
+    (define native-f64vector (world-function llnumvec "llnumvec_f64vector" (-> <number> * <bytevector>)))
+    (define-stdlib (f64vector elements : <number> *)
+      (bytevector->f64vector (apply native-f64vector elements)))
+
+    (define native-list->f64vector (world-function llnumvec "llnumvec_list_to_f64vector" (-> (Listof <number>) <bytevector>)))
+    (define-stdlib (list->f64vector [elements : (Listof <number>)])
+      (bytevector->f64vector (native-list->f64vector elements)))
+
+    (define native-f64vector-length (native-function llnumvec "llnumvec_f64vector_length" (-> <bytevector> <native-int64>) nocapture))
+    (define-stdlib (f64vector-length [vec : <f64vector>])
+      (native-f64vector-length (f64vector-bytes vec)))
+
+    (define native-f64vector-ref (world-function llnumvec "llnumvec_f64vector_ref" (-> <bytevector> <native-int64> <native-double>)))
+    (define-stdlib (f64vector-ref [vec : <f64vector>] [k : <integer>])
+      (native-f64vector-ref (f64vector-bytes vec) k))
+
+    (define native-f64vector-set! (world-function llnumvec "llnumvec_f64vector_set" (-> <bytevector> <native-int64> <native-double> <unit>)))
+    (define-stdlib (f64vector-set! [vec : <f64vector>] [k : <integer>] [value : <number>])
+      (native-f64vector-set! (f64vector-bytes vec) k (flonum value)))
+
+    (define native-f64vector->list (world-function llnumvec "llnumvec_f64vector_to_list" (-> <bytevector> (Listof <flonum>))))
+    (define-stdlib (f64vector->list [vec : <f64vector>])
+      (native-f64vector->list (f64vector-bytes vec)))
+
+    ; Bulk operations run as a single vectorised kernel over the unboxed elements
+    (define native-f64vector-sum (native-function llnumvec "llnumvec_f64vector_sum" (-> <bytevector> <native-double>) nocapture))
+    (define-stdlib (f64vector-sum [vec : <f64vector>])
+      (native-f64vector-sum (f64vector-bytes vec)))
+
+    (define native-f64vector-dot (world-function llnumvec "llnumvec_f64vector_dot" (-> <bytevector> <bytevector> <native-double>)))
+    (define-stdlib (f64vector-dot [left : <f64vector>] [right : <f64vector>])
+      (native-f64vector-dot (f64vector-bytes left) (f64vector-bytes right)))
+
+    (define native-f64vector-min (world-function llnumvec "llnumvec_f64vector_min" (-> <bytevector> <native-double>)))
+    (define-stdlib (f64vector-min [vec : <f64vector>])
+      (native-f64vector-min (f64vector-bytes vec)))
+
+    (define native-f64vector-max (world-function llnumvec "llnumvec_f64vector_max" (-> <bytevector> <native-double>)))
+    (define-stdlib (f64vector-max [vec : <f64vector>])
+      (native-f64vector-max (f64vector-bytes vec)))
+
+    (define native-f64vector-scale (world-function llnumvec "llnumvec_f64vector_scale" (-> <bytevector> <native-double> <bytevector>)))
+    (define-stdlib (f64vector-scale [vec : <f64vector>] [factor : <number>])
+      (bytevector->f64vector (native-f64vector-scale (f64vector-bytes vec) (flonum factor))))
+
+    (define native-f64vector-add (world-function llnumvec "llnumvec_f64vector_add" (-> <bytevector> <bytevector> <bytevector>)))
+    (define-stdlib (f64vector-add [left : <f64vector>] [right : <f64vector>])
+      (bytevector->f64vector (native-f64vector-add (f64vector-bytes left) (f64vector-bytes right))))
+
+    (define native-f64vector-multiply (world-function llnumvec "llnumvec_f64vector_multiply" (-> <bytevector> <bytevector> <bytevector>)))
+    (define-stdlib (f64vector-multiply [left : <f64vector>] [right : <f64vector>])
+      (bytevector->f64vector (native-f64vector-multiply (f64vector-bytes left) (f64vector-bytes right))))
+
+    (define native-f64vector-prefix-sum (world-function llnumvec "llnumvec_f64vector_prefix_sum" (-> <bytevector> <bytevector>)))
+    (define-stdlib (f64vector-prefix-sum [vec : <f64vector>])
+      (bytevector->f64vector (native-f64vector-prefix-sum (f64vector-bytes vec))))
+
+    ; Masks are bytevectors containing 1 where the comparison is true and 0 elsewhere
+    (define native-f64vector-mask< (world-function llnumvec "llnumvec_f64vector_less_than_mask" (-> <bytevector> <native-double> <bytevector>)))
+    (define-stdlib (f64vector-mask< [vec : <f64vector>] [operand : <number>])
+      (native-f64vector-mask< (f64vector-bytes vec) (flonum operand)))
+
+    (define native-f64vector-mask> (world-function llnumvec "llnumvec_f64vector_greater_than_mask" (-> <bytevector> <native-double> <bytevector>)))
+    (define-stdlib (f64vector-mask> [vec : <f64vector>] [operand : <number>])
+      (native-f64vector-mask> (f64vector-bytes vec) (flonum operand)))
+
+    (define native-f64vector-mask= (world-function llnumvec "llnumvec_f64vector_equal_mask" (-> <bytevector> <native-double> <bytevector>)))
+    (define-stdlib (f64vector-mask= [vec : <f64vector>] [operand : <number>])
+      (native-f64vector-mask= (f64vector-bytes vec) (flonum operand)))
+
+    (define-record-type <s64vector> (bytevector->s64vector bytes) s64vector?
+      ([bytes : <bytevector>] s64vector-bytes))
+
+    (define native-make-s64vector (world-function llnumvec "llnumvec_make_s64vector" (-> <native-int64> <native-int64> <bytevector>)))
+    (define-stdlib (make-s64vector [len : <integer>] [fill : <integer> 0])
+      (bytevector->s64vector (native-make-s64vector len fill)))
+
+    (define native-s64vector (world-function llnumvec "llnumvec_s64vector" (-> <integer> * <bytevector>)))
+    (define-stdlib (s64vector elements : <integer> *)
+      (bytevector->s64vector (apply native-s64vector elements)))
+
+    (define native-list->s64vector (world-function llnumvec "llnumvec_list_to_s64vector" (-> (Listof <integer>) <bytevector>)))
+    (define-stdlib (list->s64vector [elements : (Listof <integer>)])
+      (bytevector->s64vector (native-list->s64vector elements)))
+
+    (define native-s64vector-length (native-function llnumvec "llnumvec_s64vector_length" (-> <bytevector> <native-int64>) nocapture))
+    (define-stdlib (s64vector-length [vec : <s64vector>])
+      (native-s64vector-length (s64vector-bytes vec)))
+
+    (define native-s64vector-ref (world-function llnumvec "llnumvec_s64vector_ref" (-> <bytevector> <native-int64> <native-int64>)))
+    (define-stdlib (s64vector-ref [vec : <s64vector>] [k : <integer>])
+      (native-s64vector-ref (s64vector-bytes vec) k))
+
+    (define native-s64vector-set! (world-function llnumvec "llnumvec_s64vector_set" (-> <bytevector> <native-int64> <native-int64> <unit>)))
+    (define-stdlib (s64vector-set! [vec : <s64vector>] [k : <integer>] [value : <integer>])
+      (native-s64vector-set! (s64vector-bytes vec) k value))
+
+    (define native-s64vector->list (world-function llnumvec "llnumvec_s64vector_to_list" (-> <bytevector> (Listof <integer>))))
+    (define-stdlib (s64vector->list [vec : <s64vector>])
+      (native-s64vector->list (s64vector-bytes vec)))
+
+    (define native-s64vector-sum (world-function llnumvec "llnumvec_s64vector_sum" (-> <bytevector> <native-int64>)))
+    (define-stdlib (s64vector-sum [vec : <s64vector>])
+      (native-s64vector-sum (s64vector-bytes vec)))
+
+    (define native-s64vector-min (world-function llnumvec "llnumvec_s64vector_min" (-> <bytevector> <native-int64>)))
+    (define-stdlib (s64vector-min [vec : <s64vector>])
+      (native-s64vector-min (s64vector-bytes vec)))
+
+    (define native-s64vector-max (world-function llnumvec "llnumvec_s64vector_max" (-> <bytevector> <native-int64>)))
+    (define-stdlib (s64vector-max [vec : <s64vector>])
+      (native-s64vector-max (s64vector-bytes vec)))))
@@ -0,0 +1,20 @@
+(define-library (llambda parallel)
+  (import (llambda internal primitives))
+  (import (llambda nfi))
+
+  (export parallel-vector-map parallel-vector-fold)
+
+  ; Data-parallel operations over vectors
+  ;
+  ; Large vectors are divided in to partitions which are processed concurrently in private worlds. Each partition
+  ; receives its own clone of the procedure so the procedure must be cloneable in the same way as an actor's closure.
+  ; Mutations the procedure makes to its captured state are not visible to the caller. Small vectors are processed
+  ; directly by the calling thread.
+  (begin
+    (define-native-library llparallel (static-library "ll_llambda_parallel"))
+
+    (define parallel-vector-map (world-function llparallel "llparallel_vector_map" (-> (-> <any> <any>) <vector> <vector>)))
+
+    ; Each partition is folded starting from the initial value before the partition results are combined in order
+    ; with the combining procedure. The initial value should be an identity value for the combining procedure.
+    (define parallel-vector-fold (world-function llparallel "llparallel_vector_fold" (All (A) (-> <any> A A) (-> A A A) A <vector> A)))))
@@ -3,7 +3,7 @@
   (import (rename (llambda internal primitives) (define-stdlib-procedure define-stdlib)))
   (import (only (llambda base) current-input-port))
 
-  (export read <readable>)
+  (export read read-all read-binary open-feed-port feed-port-datum-ready? <readable>)
 
   (begin
     (define-type <readable> (U <pair> <empty-list> <string> <symbol> <boolean> <number> <char> <vector> <bytevector>
@@ -13,4 +13,15 @@
 
     (define native-read (world-function llread "llread_read" (-> <port> (U <readable> <eof-object>))))
     (define-stdlib (read [port : <port> (current-input-port)])
-                 (native-read port))))
+                 (native-read port))
+
+    (define native-read-all (world-function llread "llread_read_all" (-> <port> (Listof <readable>))))
+    (define-stdlib (read-all [port : <port> (current-input-port)])
+                 (native-read-all port))
+
+    (define native-read-binary (world-function llread "llread_read_binary" (-> <port> (U <readable> <eof-object>))))
+    (define-stdlib (read-binary [port : <port> (current-input-port)])
+                 (native-read-binary port))
+
+    (define-stdlib open-feed-port (world-function llread "llread_open_feed_port" (-> <port>)))
+    (define-stdlib feed-port-datum-ready? (world-function llread "llread_feed_port_datum_ready" (-> <port> <native-bool>)))))
@@ -3,7 +3,7 @@
   (import (rename (llambda internal primitives) (define-stdlib-procedure define-stdlib)))
   (import (only (llambda base) current-output-port))
 
-  (export write display)
+  (export write display write-binary)
 
   (begin
     (define-native-library llwrite (static-library "ll_llambda_write"))
@@ -14,4 +14,8 @@
 
     (define native-display (world-function llwrite "llwrite_display" (-> <any> <port> <unit>)))
     (define-stdlib (display [datum : <any>] [port : <port> (current-output-port)])
-                 (native-display datum port))))
+                 (native-display datum port))
+
+    (define native-write-binary (world-function llwrite "llwrite_write_binary" (-> <any> <port> <unit>)))
+    (define-stdlib (write-binary [datum : <any>] [port : <port> (current-output-port)])
+                 (native-write-binary datum port))))
@@ -117,6 +117,17 @@ class SchemeParserSuite extends FunSuite with Inside {
     assertReflexiveParse("9007199254740993", List(ast.Integer(9007199254740993L)))
   }
 
+  test("rationals") {
+    assertReflexiveParse("1/3", List(ast.Ratnum(1, 3)))
+    assertReflexiveParse("-1/3", List(ast.Ratnum(-1, 3)))
+    assertReflexiveParse("+2/6", List(ast.Ratnum(1, 3)))
+    assertReflexiveParse("9/2", List(ast.Ratnum(9, 2)))
+
+    // Rationals with a denominator of one are integers
+    assertReflexiveParse("8/4", List(ast.Integer(2)))
+    assertReflexiveParse("0/5", List(ast.Integer(0)))
+  }
+
   test("reals") {
     assertReflexiveParse("0.0", List(ast.Flonum(0.0)))
     assertReflexiveParse("1.0", List(ast.Flonum(1.0)))
@@ -0,0 +1,4 @@
+package io.llambda.compiler.functional
+
+
+class NumericVectorSuite extends SchemeFunctionalTestRunner("NumericVectorSuite")
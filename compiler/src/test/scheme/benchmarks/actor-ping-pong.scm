@@ -0,0 +1,13 @@
+; Round trips messages to an actor with (ask) to exercise message cloning, mailbox delivery and actor wakeups
+(import (llambda base))
+(import (llambda actor))
+(import (llambda duration))
+
+(define ponger (act (lambda ()
+                      (lambda (msg)
+                        (tell (sender) (+ msg 1))))))
+
+(do ((i 0 (+ i 1))) ((= i 20000))
+  (let ((reply (ask ponger i (seconds 5))))
+    (unless (equal? reply (+ i 1))
+      (error "ping-pong actor returned an unexpected reply" reply))))
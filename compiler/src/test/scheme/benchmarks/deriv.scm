@@ -0,0 +1,37 @@
+; Gabriel's DERIV benchmark performing symbolic differentiation over freshly consed expressions
+(import (llambda base))
+(import (llambda cxr))
+
+(define (deriv a)
+  (cond ((not (pair? a))
+         (if (eqv? a 'x) 1 0))
+        ((eqv? (car a) '+)
+         (cons '+ (map deriv (cdr a))))
+        ((eqv? (car a) '-)
+         (cons '- (map deriv (cdr a))))
+        ((eqv? (car a) '*)
+         (list '*
+               a
+               (cons '+
+                     (map (lambda (a) (list '/ (deriv a) a)) (cdr a)))))
+        ((eqv? (car a) '/)
+         (list '-
+               (list '/ (deriv (cadr a)) (caddr a))
+               (list '/
+                     (cadr a)
+                     (list '* (caddr a) (caddr a) (deriv (caddr a))))))
+        (else
+         (error "deriv cannot differentiate" a))))
+
+(define expression '(+ (* 3 x x) (* a x x) (* b x) 5))
+
+(define expected
+  '(+ (* (* 3 x x) (+ (/ 0 3) (/ 1 x) (/ 1 x)))
+      (* (* a x x) (+ (/ 0 a) (/ 1 x) (/ 1 x)))
+      (* (* b x) (+ (/ 0 b) (/ 1 x)))
+      0))
+
+(do ((i 0 (+ i 1))) ((= i 200000))
+  (let ((result (deriv expression)))
+    (unless (equal? result expected)
+      (error "deriv returned an unexpected result" result))))
@@ -0,0 +1,11 @@
+; Doubly recursive Fibonacci exercising procedure calls and generic arithmetic
+(import (llambda base))
+
+(define (fib n)
+  (if (< n 2)
+    n
+    (+ (fib (- n 1)) (fib (- n 2)))))
+
+(let ((result (fib 30)))
+  (unless (= result 832040)
+    (error "fib returned an unexpected result" result)))
@@ -0,0 +1,35 @@
+; Repeatedly grows and shrinks persistent hash maps to exercise hashing, path copying and collection of old versions
+(import (llambda base))
+(import (llambda hash-map))
+
+(define key-count 20000)
+(define half-key-count 10000)
+
+(define (fill-hash-map hash-map start)
+  (let loop ((i start) (hash-map hash-map))
+    (if (= i (+ start key-count))
+      hash-map
+      (loop (+ i 1) (hash-map-assoc hash-map (number->string i) i)))))
+
+(define (delete-evens hash-map start)
+  (let loop ((i start) (hash-map hash-map))
+    (if (= i (+ start key-count))
+      hash-map
+      (loop (+ i 2) (hash-map-delete hash-map (number->string i))))))
+
+(define (sum-values hash-map start)
+  (let loop ((i start) (sum 0))
+    (if (= i (+ start key-count))
+      sum
+      (loop (+ i 1) (+ sum (hash-map-ref/default hash-map (number->string i) 0))))))
+
+(do ((iteration 0 (+ iteration 1))) ((= iteration 10))
+  (let* ((start (* iteration key-count))
+         (filled (fill-hash-map (make-hash-map) start))
+         (churned (delete-evens filled start))
+         (sum (sum-values churned start))
+         (expected-sum (* half-key-count (+ start half-key-count))))
+    (unless (= (hash-map-size churned) half-key-count)
+      (error "hash map has an unexpected size" (hash-map-size churned)))
+    (unless (= sum expected-sum)
+      (error "hash map values have an unexpected sum" sum))))
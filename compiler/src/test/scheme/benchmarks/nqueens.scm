@@ -0,0 +1,28 @@
+; Gabriel-style N-queens counting all solutions by building and discarding candidate lists
+(import (llambda base))
+
+(define (iota1 n)
+  (let loop ((i n) (l '()))
+    (if (= i 0) l (loop (- i 1) (cons i l)))))
+
+(define (ok? row dist placed)
+  (or (null? placed)
+      (and (not (= (car placed) (+ row dist)))
+           (not (= (car placed) (- row dist)))
+           (ok? row (+ dist 1) (cdr placed)))))
+
+(define (try-queens x y z)
+  (if (null? x)
+    (if (null? y) 1 0)
+    (+ (if (ok? (car x) 1 z)
+         (try-queens (append (cdr x) y) '() (cons (car x) z))
+         0)
+       (try-queens (cdr x) (cons (car x) y) z))))
+
+(define (queens n)
+  (try-queens (iota1 n) '() '()))
+
+(do ((i 0 (+ i 1))) ((= i 20))
+  (let ((result (queens 8)))
+    (unless (= result 92)
+      (error "queens returned an unexpected result" result))))
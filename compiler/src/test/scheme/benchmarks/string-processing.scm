@@ -0,0 +1,51 @@
+; Splits, transforms and reassembles text to exercise string construction, iteration and character procedures
+(import (llambda base))
+(import (llambda char))
+
+(define sentence "The quick brown fox jumps over the lazy dog. Ça coûte 5 €! ")
+
+(define (split-words str)
+  (let loop ((chars (string->list str)) (current '()) (words '()))
+    (cond ((null? chars)
+           (reverse (if (null? current)
+                      words
+                      (cons (list->string (reverse current)) words))))
+          ((char-whitespace? (car chars))
+           (loop (cdr chars)
+                 '()
+                 (if (null? current)
+                   words
+                   (cons (list->string (reverse current)) words))))
+          (else
+           (loop (cdr chars) (cons (car chars) current) words)))))
+
+(define (join-words words)
+  (if (null? words)
+    ""
+    (let loop ((rest (cdr words)) (result (car words)))
+      (if (null? rest)
+        result
+        (loop (cdr rest) (string-append result " " (car rest)))))))
+
+(define (count-alphabetic str)
+  (let ((count 0))
+    (string-for-each (lambda (c)
+                       (when (char-alphabetic? c)
+                         (set! count (+ count 1))))
+                     str)
+    count))
+
+(define text
+  (let loop ((i 0) (result ""))
+    (if (= i 20)
+      result
+      (loop (+ i 1) (string-append result sentence)))))
+
+(do ((i 0 (+ i 1))) ((= i 500))
+  (let* ((words (split-words text))
+         (shouted (join-words (map string-upcase words)))
+         (letters (count-alphabetic shouted)))
+    (unless (= (length words) 260)
+      (error "split-words returned an unexpected number of words" (length words)))
+    (unless (= letters 840)
+      (error "count-alphabetic returned an unexpected result" letters))))
@@ -0,0 +1,14 @@
+; Gabriel's TAK benchmark exercising non-tail calls and fixnum arithmetic
+(import (llambda base))
+
+(define (tak x y z)
+  (if (not (< y x))
+    z
+    (tak (tak (- x 1) y z)
+         (tak (- y 1) z x)
+         (tak (- z 1) x y))))
+
+(do ((i 0 (+ i 1))) ((= i 100))
+  (let ((result (tak 18 12 6)))
+    (unless (= result 7)
+      (error "tak returned an unexpected result" result))))
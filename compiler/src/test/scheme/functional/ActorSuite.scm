@@ -125,7 +125,7 @@
 
   ; Numbers
   (assert-equal 5 (ping-pong (+ (typeless-cell 2) 3)))
-  (assert-equal .5 (ping-pong (/ (typeless-cell 1) 2)))
+  (assert-equal 1/2 (ping-pong (/ (typeless-cell 1) 2)))
 
   ; Characters
   (define test-char (string-ref (typeless-cell "abc") 1))
@@ -671,3 +671,150 @@
 
   (define result (ask test-actor 'get-result (milliseconds 250)))
   (assert-equal '(0 1 2 3 4 5) result)))
+
+(define-test "(schedule-repeatedly)" (expect-success
+  (import (llambda actor))
+  (import (llambda duration))
+
+  (define test-actor (act
+                       (lambda ()
+                         (define tick-count 0)
+                         (define result-sender #f)
+                         (define target-count 5)
+
+                         (define ticker (schedule-repeatedly (milliseconds 0) (milliseconds 10) (self) 'tick))
+                         (assert-true (schedule? ticker))
+
+                         (lambda (msg)
+                           (cond
+                             ((equal? msg 'get-result)
+                              (set! result-sender (sender)))
+                             ((equal? msg 'tick)
+                              (set! tick-count (+ tick-count 1))
+                              (when (= tick-count target-count)
+                                ; The timer was still pending so this should succeed exactly once
+                                (tell result-sender (list tick-count (cancel-schedule ticker) (cancel-schedule ticker))))))))))
+
+  (define result (ask test-actor 'get-result (seconds 2)))
+  (assert-equal '(5 #t #f) result)))
+
+(define-test "(cancel-schedule)" (expect-success
+  (import (llambda actor))
+  (import (llambda duration))
+
+  (define test-actor (act
+                       (lambda ()
+                         (define received-messages '())
+                         (define result-sender #f)
+
+                         ; The cancelled message would have arrived before the kept message
+                         (define cancelled-schedule (schedule-once (milliseconds 20) (self) 'cancelled))
+                         (schedule-once (milliseconds 40) (self) 'kept)
+
+                         (assert-true (cancel-schedule cancelled-schedule))
+                         (assert-false (cancel-schedule cancelled-schedule))
+
+                         (lambda (msg)
+                           (if (equal? msg 'get-result)
+                             (if (member 'kept received-messages)
+                               (tell (sender) received-messages)
+                               (set! result-sender (sender)))
+                             (begin
+                               (set! received-messages (cons msg received-messages))
+                               (when (and result-sender (equal? msg 'kept))
+                                 (tell result-sender received-messages))))))))
+
+  (assert-equal '(kept) (ask test-actor 'get-result (seconds 1)))))
+
+(define-test "late replies aren't delivered to later (ask)s" (expect-success
+  (import (llambda actor))
+  (import (llambda duration))
+  (import (llambda error))
+
+  (define test-actor (act
+                       (lambda ()
+                         (define slow-sender #f)
+
+                         (lambda (msg)
+                           (if (equal? msg 'slow)
+                             (set! slow-sender (sender))
+                             (begin
+                               ; This should be dropped as the (ask) for the slow message has timed out
+                               (tell slow-sender 'late-reply)
+                               (tell (sender) (list msg (mailbox-open? slow-sender)))))))))
+
+  (assert-raises ask-timeout-error?
+                 (ask test-actor 'slow (milliseconds 20)))
+
+  (for-each (lambda (i)
+              (assert-equal (list i #f) (ask test-actor i (seconds 2))))
+            '(1 2 3 4 5))))
+
+(define-test "bounded mailboxes" (expect-success
+  (import (llambda actor))
+  (import (llambda duration))
+  (import (llambda error))
+
+  (define silent-actor (act (lambda ()
+                              (lambda (msg)))))
+
+  ; After replying to 'busy this actor stays busy long enough for its mailbox to fill
+  (define (make-recording-actor)
+    (act (lambda ()
+           (define received '())
+
+           (lambda (msg)
+             (cond
+               ((equal? msg 'busy)
+                (tell (sender) 'busy)
+                (guard (condition ((ask-timeout-error? condition)))
+                  (ask silent-actor 'ignored (milliseconds 200))))
+               ((equal? msg 'get-result)
+                (tell (sender) (reverse received)))
+               (else
+                 (set! received (cons msg received))))))))
+
+  (define (test-policy policy)
+    (define test-actor (make-recording-actor))
+    (set-mailbox-capacity test-actor 2 policy)
+
+    (ask test-actor 'busy (seconds 2))
+    (for-each (lambda (i) (tell test-actor i)) '(1 2 3 4 5))
+    (assert-equal 2 (mailbox-queue-depth test-actor))
+
+    ; Make room for our request
+    (set-mailbox-capacity test-actor 100 'block)
+    (ask test-actor 'get-result (seconds 2)))
+
+  (assert-equal '(1 2) (test-policy 'drop-newest))
+  (assert-equal '(4 5) (test-policy 'drop-oldest))
+
+  (define fail-actor (make-recording-actor))
+  (set-mailbox-capacity fail-actor 2 'fail)
+  (ask fail-actor 'busy (seconds 2))
+
+  (tell fail-actor 1)
+  (tell fail-actor 2)
+  (assert-raises mailbox-full-error?
+                 (tell fail-actor 3))
+
+  ; Requests to a full mailbox are rejected instead of being dropped without a reply
+  (define drop-actor (make-recording-actor))
+  (set-mailbox-capacity drop-actor 2 'drop-newest)
+  (ask drop-actor 'busy (seconds 2))
+
+  (tell drop-actor 1)
+  (tell drop-actor 2)
+  (assert-raises mailbox-full-error?
+                 (ask drop-actor 'get-result (seconds 2)))
+
+  ; Blocked senders should resume once the actor catches up
+  (define block-actor (make-recording-actor))
+  (set-mailbox-capacity block-actor 2 'block)
+  (ask block-actor 'busy (seconds 2))
+
+  (for-each (lambda (i) (tell block-actor i)) '(1 2 3 4 5))
+  (assert-equal '(1 2 3 4 5) (ask block-actor 'get-result (seconds 2)))
+
+  (assert-raises range-error?
+                 (set-mailbox-capacity block-actor 0 'block))))
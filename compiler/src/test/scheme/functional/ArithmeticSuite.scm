@@ -5,13 +5,18 @@
   (assert-equal -435065 (+ 70 -1024589 589454))
   (assert-equal 300.0 (+ 100.5 -0.5 200.0))
   (assert-equal 300.0 (+ 100.5 -0.5 200))
+  (assert-equal 5/6 (+ 1/2 1/3))
+  (assert-equal 1 (+ 1/2 1/3 1/6))
 
   ; This may cause an intermediate integer overflow but it should eventually succeed because the result is a flonum
   (assert-within 9223372036854775807 32.0 (+ 9223372036854775807 9223372036854775807 -9223372036854775807.0))))
 
 (define-test "dynamic (+)" (expect-success
   (assert-equal 8 (+ (typed-dynamic 5 <integer>) 1 2))
-  (assert-equal 8.0 (+ (typed-dynamic 5.0 <flonum>) 1.0 2.0))))
+  (assert-equal 8.0 (+ (typed-dynamic 5.0 <flonum>) 1.0 2.0))
+  (assert-equal 7/2 (+ (typed-dynamic 1/2 <number>) 1 2))
+  (assert-equal 1 (+ (typed-dynamic 2/3 <any>) 1/3))
+  (assert-equal 0.75 (+ (typed-dynamic 1/4 <number>) 0.5))))
 
 (define-test "adding single string fails" (expect-error type-error?
   (+ "Hello!")))
@@ -32,6 +37,8 @@
   (assert-equal -499332738025 (* 4135 -3547 34045))
   (assert-equal -10050.0 (* 100.5 -0.5 200.0))
   (assert-equal 10050.0 (* 100.5 0.5 200))
+  (assert-equal 1/6 (* 1/2 1/3))
+  (assert-equal 2 (* 2/3 3))
 
   ; This may cause an intermediate integer overflow but it should eventually succeed because the result is a flonum
   (assert-within 9223372036854775807 32.0 (* 9223372036854775807 2 0.5))))
@@ -39,11 +46,16 @@
 (define-test "dynamic (*)" (expect-success
   (assert-equal 10 (* (typed-dynamic 5 <integer>) 1 2))
   (assert-equal 10.0 (* (typed-dynamic 5.0 <flonum>) 1.0 2.0))
-  (assert-equal 200.0 (* (typed-dynamic 10 <integer>) 10 2.0))))
+  (assert-equal 200.0 (* (typed-dynamic 10 <integer>) 10 2.0))
+  (assert-equal -3/4 (* (typed-dynamic 1/2 <number>) -3/2))
+  (assert-equal 6 (* (typed-dynamic 3/2 <any>) 4))))
 
 (define-test "multiplying single string fails" (expect-error type-error?
   (* "Hello!")))
 
+(define-test "(+) fails on ratnum overflow" (expect-error integer-overflow-error?
+  (force-evaluation (+ (typed-dynamic 9223372036854775807 <integer>) 1/2))))
+
 (define-test "static (*) fails on integer overflow" (expect-error integer-overflow-error?
   (force-evaluation (* 9223372036854775807 2))))
 
@@ -59,6 +71,8 @@
   (assert-equal -26363 (- 4135 -3547 34045))
   (assert-equal -99.0 (- 100.5 -0.5 200.0))
   (assert-equal -100.0 (- 100.5 0.5 200))
+  (assert-equal -1/2 (- 1/2))
+  (assert-equal 1/6 (- 1/2 1/3))
 
   ; This may cause an intermediate integer overflow but it should eventually succeed because the result is a flonum
   (assert-within 9 32.0 (- -9223372036854775807 9223372036854775807 -9223372036854775807 -9223372036854775807.0))))
@@ -67,7 +81,9 @@
   (assert-equal 2 (- (typed-dynamic 5 <integer>) 1 2))
   (assert-equal -6 (- 1 2 (typed-dynamic 5 <integer>)))
   (assert-equal 2.0 (- (typed-dynamic 5.0 <flonum>) 1.0 2.0))
-  (assert-equal -6.0 (- 1.0 2.0 (typed-dynamic 5.0 <flonum>)))))
+  (assert-equal -6.0 (- 1.0 2.0 (typed-dynamic 5.0 <flonum>)))
+  (assert-equal -2/3 (- (typed-dynamic 2/3 <number>)))
+  (assert-equal 0 (- (typed-dynamic 1/2 <any>) 1/2))))
 
 (define-test "subtracting no numbers fails" (expect-error arity-error?
   (-)))
@@ -94,9 +110,9 @@
   (force-evaluation (- -9223372036854775808 (typed-dynamic 1 <any>)))))
 
 (define-test "static (/)" (expect-static-success
-  (assert-equal 0.125 (/ 8))
+  (assert-equal 1/8 (/ 8))
   (assert-equal -4.0 (/ -0.25))
-  (assert-equal 0.15 (/ 3 4 5))
+  (assert-equal 3/20 (/ 3 4 5))
   (assert-equal 64.0 (/ 128.0 0.25 8))
   (assert-equal -64.0 (/ 128.0 -0.25 8))
   (assert-equal 1 (/ 1))
@@ -105,7 +121,9 @@
   (assert-equal +inf.0 (/ 5 0.0))
   (assert-equal -inf.0 (/ -5 0.0))
   (assert-equal +nan.0 (/ -5 +nan.0))
-  (assert-equal 0.5 (/ 20 5 2 4))
+  (assert-equal 1/2 (/ 20 5 2 4))
+  (assert-equal 3/2 (/ 1/2 1/3))
+  (assert-equal 0.5 (/ 1/4 0.5))
 
   ; This divides exactly
   (assert-equal 2 (/ 20 5 2))
@@ -118,6 +136,9 @@
 
 (define-test "dynamic (/)" (expect-success
   (assert-equal 2.0 (/ 20.0 (typed-dynamic 5.0 <flonum>) 2.0))
+  (assert-equal 1/3 (/ (typed-dynamic 1 <integer>) 3))
+  (assert-equal -3/20 (/ (typed-dynamic 3 <any>) -4 5))
+  (assert-equal 2 (/ (typed-dynamic 1/3 <number>) 1/6))
   (assert-equal 9223372036854775808.0 (/ (typed-dynamic -9223372036854775808 <integer>) -1))
   (assert-equal 9223372036854775808.0 (/ -9223372036854775808 (typed-dynamic -1 <integer>)))))
 
@@ -298,6 +319,7 @@
 
 (define-test "(floor-quotient)" (expect-success
   (assert-equal 2 (floor-quotient 5 2))
+  (assert-equal -1 (floor-quotient -1 3))
   (assert-equal -3 (floor-quotient -5 2))
   (assert-equal -3 (floor-quotient 5 -2))
   (assert-equal 2 (floor-quotient -5 -2))))
@@ -316,6 +338,7 @@
 
 (define-test "(floor-remainder)" (expect-success
   (assert-equal 1 (floor-remainder 5 2))
+  (assert-equal 2 (floor-remainder -1 3))
   (assert-equal 1 (floor-remainder -5 2))
   (assert-equal -1 (floor-remainder 5 -2))
   (assert-equal -1 (floor-remainder -5 -2))
@@ -346,11 +369,26 @@
   ; This is within the range of values we can exactly represent on all platforms
   (assert-true (eqv? (expt 2 53) 9007199254740992))
 
-  (assert-true (eqv? (expt 2 63.0) 9223372036854775808.0))))
+  (assert-true (eqv? (expt 2 63.0) 9223372036854775808.0))
+
+  ; These are beyond the range of integers that can be exactly represented by a double
+  (assert-true (eqv? (expt 3 39) 4052555153018976267))
+  (assert-true (eqv? (expt -2 63) -9223372036854775808))
+
+  ; Exact rationals are raised exactly
+  (assert-equal 1/8 (expt (typed-dynamic 1/2 <number>) 3))
+  (assert-equal 9/4 (expt (typed-dynamic 2/3 <number>) -2))
+  (assert-equal 1 (expt (typed-dynamic 2/3 <number>) 0))))
 
 (define-test "(expt) fails on integer overflow" (expect-error integer-overflow-error?
   (force-evaluation (expt 2 63))))
 
+(define-test "(expt) fails on integer overflow beyond the range of doubles" (expect-error integer-overflow-error?
+  (force-evaluation (expt 3 40))))
+
+(define-test "(expt) with an exact rational power fails" (expect-error implementation-restriction-error?
+  (force-evaluation (expt (typed-dynamic 4 <number>) 1/2))))
+
 (define-test "static rounding procedures" (expect-static-success
   (assert-equal -5.0 (floor -4.3))
   (assert-equal -4   (floor -4))
@@ -362,11 +400,21 @@
   (assert-equal 4.0  (ceiling 3.5))
   (assert-equal 3    (truncate 3))
   (assert-equal 4.0  (round 3.5))
-  (assert-equal 7    (round 7))))
+  (assert-equal 7    (round 7))
+  (assert-equal -2   (floor -3/2))
+  (assert-equal -1   (ceiling -3/2))
+  (assert-equal -1   (truncate -3/2))
+  (assert-equal -2   (round -3/2))
+  (assert-equal 2    (round 5/2))
+  (assert-equal 3    (round 8/3))))
 
 (define-test "dynamic rounding procedures" (expect-success
   (assert-equal -4.0 (truncate -4.3))
-  (assert-equal 3.0  (truncate 3.5))))
+  (assert-equal 3.0  (truncate 3.5))
+  (assert-equal -2   (floor (typed-dynamic -3/2 <number>)))
+  (assert-equal 3    (ceiling (typed-dynamic 5/2 <number>)))
+  (assert-equal 2    (truncate (typed-dynamic 5/2 <number>)))
+  (assert-equal 4    (round (typed-dynamic 7/2 <number>)))))
 
 (define-test "typed procedure adding multiple number types" (expect-success
   (import (llambda typed))
@@ -425,19 +473,35 @@
   (assert-equal +inf.0 (abs +inf.0))
   (assert-equal +inf.0 (abs -inf.0))))
 
+(define-test "(abs) of exact rationals" (expect-success
+  (assert-equal 1/2 (abs (typed-dynamic 1/2 <number>)))
+  (assert-equal 1/2 (abs (typed-dynamic -1/2 <number>)))))
+
 (define-test "(gcd)" (expect-success
   (assert-equal 0 (gcd))
   (assert-equal 5 (gcd 5))
   (assert-equal 5 (gcd -5))
   (assert-equal 4 (gcd 32 -36))
-  (assert-equal 2 (gcd 32 -36 202))))
+  (assert-equal 2 (gcd 32 -36 202))
+  (assert-equal 7 (gcd 0 -7))
+  (assert-equal 0 (gcd 0 0))
+  (assert-equal 2 (gcd -9223372036854775808 6))
+  (assert-equal 1073741824 (gcd -9223372036854775808 3221225472))))
+
+(define-test "(gcd) fails on integer overflow" (expect-error integer-overflow-error?
+  (force-evaluation (gcd -9223372036854775808 0))))
 
 (define-test "(lcm)" (expect-success
   (assert-equal 1 (lcm))
   (assert-equal 5 (lcm 5))
   (assert-equal 5 (lcm -5))
   (assert-equal 288 (lcm 32 -36))
-  (assert-equal 576 (lcm 32 -36 192))))
+  (assert-equal 576 (lcm 32 -36 192))
+  (assert-equal 0 (lcm 0 5))
+  (assert-equal 0 (lcm 0 0))))
+
+(define-test "(lcm) fails on integer overflow" (expect-error integer-overflow-error?
+  (force-evaluation (lcm 4611686018427387904 3))))
 
 (define-test "(integer-sqrt)" (expect-success
   (let* ((result (integer-sqrt 0))
@@ -61,3 +61,43 @@
                (else (test-parameter)))
              (parameterize ((test-parameter 'inner1))
                (raise (list (cons 'c 23)))))))))
+
+(define-test "nested (guard) re-raises to the outer guard" (expect-success
+  (define test-parameter (make-parameter 'default))
+
+  (assert-equal '(outer . 5)
+    (guard (condition
+             ((number? condition) (cons (test-parameter) condition)))
+           (parameterize ((test-parameter 'outer))
+             (guard (condition
+                      ((string? condition) 'inner))
+                    (parameterize ((test-parameter 'inner))
+                      (raise 5))))))
+
+  ; The inner guard is removed once it's exited normally
+  (assert-equal 'outer
+    (guard (condition
+             (else 'outer))
+           (guard (condition
+                    (else 'inner))
+                  'no-except)
+           (raise 'after-inner)))))
+
+(define-test "(guard) catches raises from procedures applied by native code" (expect-success
+  (assert-equal 3
+    (guard (condition
+             ((number? condition) condition))
+           (vector-for-each (lambda (x)
+                              (when (= x 3)
+                                (raise x)))
+                            #(1 2 3 4))))
+
+  ; Raises from the inner guard's handler still reach the outer guard
+  (assert-equal 'from-handler
+    (guard (condition
+             (else condition))
+           (vector-map (lambda (x)
+                         (guard (condition
+                                  (else (raise 'from-handler)))
+                                (raise x)))
+                       #(1 2 3))))))
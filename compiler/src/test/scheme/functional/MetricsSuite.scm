@@ -0,0 +1,34 @@
+(define-test "(runtime-metrics)" (expect-success
+  (import (llambda metrics))
+  (import (llambda hash-map))
+
+  (define metrics (runtime-metrics))
+
+  (assert-true (hash-map? metrics))
+  (assert-true (hash-map-exists? metrics 'llambda_gc_collections_total))
+  (assert-true (hash-map-exists? metrics 'llambda_actor_mailboxes))
+  (assert-true (hash-map-exists? metrics 'llambda_dispatcher_threads))
+
+  (hash-map-for-each (lambda (name value)
+                       (assert-true (symbol? name))
+                       (assert-true (exact-integer? value))) metrics)))
+
+(define-test "(runtime-metrics) counts actor messages" (expect-success
+  (import (llambda metrics))
+  (import (llambda hash-map))
+  (import (llambda actor))
+
+  (define (messages-total)
+    (hash-map-ref (runtime-metrics) 'llambda_actor_messages_total))
+
+  (define initial-messages (messages-total))
+
+  (define echo-actor (act (lambda ()
+                            (lambda (msg)
+                              (tell (sender) msg)))))
+
+  (assert-equal 'one (ask echo-actor 'one))
+  (assert-equal 'two (ask echo-actor 'two))
+
+  ; Each (ask) queues a request and a reply
+  (assert-true (>= (- (messages-total) initial-messages) 4))))
@@ -53,7 +53,12 @@
   (assert-equal "1.0" (number->string 1.0 10))
 
   (assert-equal "-1.0" (number->string -1.0))
-  (assert-equal "-1.0" (number->string -1.0 10))))
+  (assert-equal "-1.0" (number->string -1.0 10))
+
+  (assert-equal "1/3" (number->string 1/3))
+  (assert-equal "-1/3" (number->string -1/3 10))
+  (assert-equal "#b-1/11" (number->string -1/3 2))
+  (assert-equal "#x7/10" (number->string 7/16 16))))
 
 (define-test "(number->string) in radix 3 is an error" (expect-error invalid-argument-error?
   (number->string 17 3)))
@@ -77,6 +82,11 @@
   (assert-equal 0.125 (string->number ".125"))
   (assert-equal -0.25 (string->number "-.25"))
 
+  (assert-equal 1/3 (string->number "2/6"))
+  (assert-equal -5/2 (string->number "-101/10" 2))
+  (assert-equal 2 (string->number "6/3"))
+  (assert-equal #f (string->number "1/0"))
+
   (assert-equal #f (string->number "+" 16))
   (assert-equal #f (string->number "ddy" 16))
   (assert-equal #f (string->number "2 5" 16))
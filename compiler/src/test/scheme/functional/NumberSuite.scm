@@ -11,6 +11,7 @@
 (define-test "(rational?)" (expect-static-success
   (assert-true  (rational? 4))
   (assert-true  (rational? -5.0))
+  (assert-true  (rational? 1/3))
   (assert-false (rational? +inf.0))
   (assert-false (rational? +nan.0))
   (assert-false (rational? '()))))
@@ -36,6 +37,9 @@
 (define-test "dynamic (integer 112.5) fails" (expect-error invalid-argument-error?
   (integer (typed-dynamic 112.5 <flonum>))))
 
+(define-test "(integer 1/2) fails" (expect-error invalid-argument-error?
+  (integer (typed-dynamic 1/2 <number>))))
+
 (define-test "static (flonum)" (expect-static-success
   (assert-equal 567.0 (flonum 567))
   (assert-equal -3289.5 (flonum -3289.5))
@@ -0,0 +1,120 @@
+(define-test "(make-f64vector)" (expect-success
+  (import (llambda numeric-vector))
+
+  (define empty-vec (make-f64vector 0))
+  (assert-true (f64vector? empty-vec))
+  (assert-equal 0 (f64vector-length empty-vec))
+
+  (define zero-vec (make-f64vector 3))
+  (assert-equal '(0.0 0.0 0.0) (f64vector->list zero-vec))
+
+  (define filled-vec (make-f64vector 2 1.5))
+  (assert-equal '(1.5 1.5) (f64vector->list filled-vec))
+
+  ; Integer fills are converted to flonums
+  (assert-equal '(2.0 2.0) (f64vector->list (make-f64vector 2 2)))))
+
+(define-test "(make-f64vector) with a negative length fails" (expect-error range-error?
+  (import (llambda numeric-vector))
+  (make-f64vector -1)))
+
+(define-test "f64vector element access" (expect-success
+  (import (llambda numeric-vector))
+
+  (define test-vec (f64vector 1 2.5 -3.0))
+  (assert-equal 3 (f64vector-length test-vec))
+  (assert-equal 1.0 (f64vector-ref test-vec 0))
+  (assert-equal -3.0 (f64vector-ref test-vec 2))
+
+  (f64vector-set! test-vec 1 100)
+  (assert-equal '(1.0 100.0 -3.0) (f64vector->list test-vec))
+
+  (assert-equal '(0.5 0.25) (f64vector->list (list->f64vector '(0.5 0.25))))))
+
+(define-test "(f64vector-ref) past end fails" (expect-error range-error?
+  (import (llambda numeric-vector))
+  (f64vector-ref (f64vector 1.0 2.0) 2)))
+
+(define-test "s64vector element access" (expect-success
+  (import (llambda numeric-vector))
+
+  (define test-vec (make-s64vector 3 7))
+  (assert-true (s64vector? test-vec))
+  (assert-false (f64vector? test-vec))
+  (assert-equal '(7 7 7) (s64vector->list test-vec))
+
+  (s64vector-set! test-vec 0 -9223372036854775808)
+  (s64vector-set! test-vec 2 9223372036854775807)
+  (assert-equal -9223372036854775808 (s64vector-ref test-vec 0))
+  (assert-equal 9223372036854775807 (s64vector-ref test-vec 2))
+
+  (assert-equal 3 (s64vector-length (s64vector 1 2 3)))
+  (assert-equal '(4 5) (s64vector->list (list->s64vector '(4 5))))))
+
+(define-test "(s64vector) with static flonum element fails" (expect-compile-error type-error?
+  (import (llambda numeric-vector))
+  (s64vector 1 2.0)))
+
+(define-test "(s64vector) with dynamic flonum element fails" (expect-error type-error?
+  (import (llambda numeric-vector))
+  (s64vector 1 (typeless-cell 2.0))))
+
+(define-test "(list->s64vector) with dynamic flonum element fails" (expect-error type-error?
+  (import (llambda numeric-vector))
+  (list->s64vector (list 1 (typeless-cell 2.0)))))
+
+(define-test "(s64vector-set!) past end fails" (expect-error range-error?
+  (import (llambda numeric-vector))
+  (s64vector-set! (make-s64vector 2) -1 0)))
+
+(define-test "f64vector reductions" (expect-success
+  (import (llambda numeric-vector))
+
+  (define test-vec (f64vector 1.5 -2.0 4.0 0.5 3.0))
+  (assert-equal 7.0 (f64vector-sum test-vec))
+  (assert-equal 0.0 (f64vector-sum (make-f64vector 0)))
+  (assert-equal -2.0 (f64vector-min test-vec))
+  (assert-equal 4.0 (f64vector-max test-vec))
+  (assert-equal 11.0 (f64vector-dot (f64vector 1 2 3) (f64vector 3 1 2)))))
+
+(define-test "(f64vector-min) on empty vector fails" (expect-error range-error?
+  (import (llambda numeric-vector))
+  (f64vector-min (make-f64vector 0))))
+
+(define-test "(f64vector-dot) with differing lengths fails" (expect-error invalid-argument-error?
+  (import (llambda numeric-vector))
+  (f64vector-dot (f64vector 1 2) (f64vector 1 2 3))))
+
+(define-test "f64vector element-wise operations" (expect-success
+  (import (llambda numeric-vector))
+
+  (define left (f64vector 1 2 3 4 5))
+  (define right (f64vector 5 4 3 2 1))
+
+  (assert-equal '(2.0 4.0 6.0 8.0 10.0) (f64vector->list (f64vector-scale left 2)))
+  (assert-equal '(6.0 6.0 6.0 6.0 6.0) (f64vector->list (f64vector-add left right)))
+  (assert-equal '(5.0 8.0 9.0 8.0 5.0) (f64vector->list (f64vector-multiply left right)))
+  (assert-equal '(1.0 3.0 6.0 10.0 15.0) (f64vector->list (f64vector-prefix-sum left)))
+
+  ; The inputs are unchanged
+  (assert-equal '(1.0 2.0 3.0 4.0 5.0) (f64vector->list left))))
+
+(define-test "f64vector comparison masks" (expect-success
+  (import (llambda numeric-vector))
+
+  (define test-vec (f64vector 1 2 3 4 5))
+  (assert-equal #u8(1 1 0 0 0) (f64vector-mask< test-vec 3))
+  (assert-equal #u8(0 0 0 1 1) (f64vector-mask> test-vec 3))
+  (assert-equal #u8(0 0 1 0 0) (f64vector-mask= test-vec 3.0))))
+
+(define-test "s64vector reductions" (expect-success
+  (import (llambda numeric-vector))
+
+  (define test-vec (s64vector 10 -20 30 5))
+  (assert-equal 25 (s64vector-sum test-vec))
+  (assert-equal -20 (s64vector-min test-vec))
+  (assert-equal 30 (s64vector-max test-vec))))
+
+(define-test "(s64vector-sum) overflow fails" (expect-error integer-overflow-error?
+  (import (llambda numeric-vector))
+  (s64vector-sum (s64vector 9223372036854775807 1))))
@@ -0,0 +1,62 @@
+(define-test "(parallel-vector-map)" (expect-success
+  (import (llambda parallel))
+
+  (assert-equal #() (parallel-vector-map (lambda (x) (* x 2)) #()))
+  (assert-equal #(2 4 6) (parallel-vector-map (lambda (x) (* x 2)) #(1 2 3)))
+
+  ; This is large enough to be divided in to multiple partitions
+  (define large-vec (make-vector 5000 3))
+  (vector-set! large-vec 4999 4)
+
+  (define mapped-vec (parallel-vector-map (lambda (x) (list x x)) large-vec))
+  (assert-equal 5000 (vector-length mapped-vec))
+  (assert-equal '(3 3) (vector-ref mapped-vec 0))
+  (assert-equal '(3 3) (vector-ref mapped-vec 2500))
+  (assert-equal '(4 4) (vector-ref mapped-vec 4999))))
+
+(define-test "(parallel-vector-map) with captured values" (expect-success
+  (import (llambda parallel))
+
+  (define offset (string-length (symbol->string 'four)))
+  (define large-vec (make-vector 5000 1))
+
+  (define mapped-vec (parallel-vector-map (lambda (x) (+ x offset)) large-vec))
+  (assert-equal 5 (vector-ref mapped-vec 0))
+  (assert-equal 5 (vector-ref mapped-vec 4999))))
+
+(define-test "(parallel-vector-map) propagates errors" (expect-error error-object?
+  (import (llambda parallel))
+
+  (define large-vec (make-vector 5000 1))
+  (vector-set! large-vec 3000 'bad)
+
+  (parallel-vector-map (lambda (x)
+                         (if (eqv? x 'bad)
+                           (error "Bad element" x)
+                           x)) large-vec)))
+
+(define-test "(parallel-vector-fold)" (expect-success
+  (import (llambda parallel))
+
+  (assert-equal 0 (parallel-vector-fold + + 0 #()))
+  (assert-equal 6 (parallel-vector-fold + + 0 #(1 2 3)))
+
+  (define large-vec (make-vector 5000 2))
+  (assert-equal 10000 (parallel-vector-fold + + 0 large-vec))
+
+  ; Partition results are combined in order
+  (define counting-vec (make-vector 1000 #f))
+  (let loop ((i 0))
+    (when (< i 1000)
+      (vector-set! counting-vec i i)
+      (loop (+ i 1))))
+
+  (define folded-list (parallel-vector-fold cons
+                                            (lambda (later-partition earlier-partitions)
+                                              (append later-partition earlier-partitions))
+                                            '()
+                                            counting-vec))
+
+  (assert-equal 1000 (length folded-list))
+  (assert-equal 999 (car folded-list))
+  (assert-equal 0 (list-ref folded-list 999))))
@@ -84,3 +84,98 @@
   (assert-parses #f "#false")
   (assert-parses #t "#t")
   (assert-parses #t "#true")))
+
+(define-test "(read) from feed port" (expect-success
+  (import (llambda read))
+  (import (llambda error))
+
+  (define feed-port (open-feed-port))
+
+  (assert-true (input-port? feed-port))
+  (assert-true (output-port? feed-port))
+
+  ; Nothing has been fed yet
+  (assert-false (feed-port-datum-ready? feed-port))
+  (assert-raises error-object? (read feed-port))
+
+  ; Partial datums aren't consumed
+  (write-string "(hello \"wor" feed-port)
+  (assert-false (feed-port-datum-ready? feed-port))
+  (assert-raises error-object? (read feed-port))
+
+  (write-string "ld\" 1" feed-port)
+  (assert-false (feed-port-datum-ready? feed-port))
+
+  (write-string "23) sym" feed-port)
+  (assert-true (feed-port-datum-ready? feed-port))
+  (assert-equal '(hello "world" 123) (read feed-port))
+
+  ; The symbol may continue in the next chunk
+  (assert-false (feed-port-datum-ready? feed-port))
+
+  (write-string "bol #| comment |# #u8(1 2" feed-port)
+  (assert-equal 'symbol (read feed-port))
+  (assert-false (feed-port-datum-ready? feed-port))
+
+  (write-string " 3) #;(skipped) 'quoted" feed-port)
+  (assert-equal #u8(1 2 3) (read feed-port))
+  (assert-false (feed-port-datum-ready? feed-port))
+
+  ; Closing the output side completes the final atom
+  (close-output-port feed-port)
+  (assert-true (feed-port-datum-ready? feed-port))
+  (assert-equal ''quoted (read feed-port))
+
+  ; Only a closed feed port reaches the end of file
+  (assert-true (feed-port-datum-ready? feed-port))
+  (assert-true (eof-object? (read feed-port)))))
+
+(define-test "(feed-port-datum-ready?) on non-feed port fails" (expect-error invalid-argument-error?
+  (import (llambda read))
+  (import (llambda error))
+
+  (feed-port-datum-ready? (open-input-string "1"))))
+
+(define-test "(read) from feed port with malformed input" (expect-success
+  (import (llambda read))
+  (import (llambda error))
+
+  (define feed-port (open-feed-port))
+  (write-string ") 12 " feed-port)
+
+  (assert-raises read-error? (read feed-port))
+  (assert-equal 12 (read feed-port))))
+
+(define-test "(read-all)" (expect-success
+  (import (llambda read))
+  (import (llambda error))
+
+  (assert-equal '() (read-all (open-input-string "")))
+  (assert-equal '() (read-all (open-input-string "  ; Only a comment")))
+  (assert-equal '(1 (two "three") #(4)) (read-all (open-input-string "1 (two \"three\") #;(skipped) #(4)")))
+
+  (define partially-read-port (open-input-string "1 2 3"))
+  (assert-equal 1 (read partially-read-port))
+  (assert-equal '(2 3) (read-all partially-read-port))
+  (assert-true (eof-object? (read partially-read-port)))
+
+  (assert-raises read-error? (read-all (open-input-string "1 (2")))))
+
+(define-test "(write-binary) and (read-binary)" (expect-success
+  (import (llambda read))
+  (import (llambda write))
+  (import (llambda error))
+
+  (define test-datum '(1 -2.5 #\x "string" symbol #u8(1 2 3) #(#t #f ()) (nested . pair) #!unit))
+
+  (define output-port (open-output-bytevector))
+  (write-binary test-datum output-port)
+  (write-binary 'second output-port)
+
+  (define input-port (open-input-bytevector (get-output-bytevector output-port)))
+  (assert-equal test-datum (read-binary input-port))
+  (assert-equal 'second (read-binary input-port))
+  (assert-true (eof-object? (read-binary input-port)))
+
+  (assert-raises read-error? (read-binary (open-input-bytevector #u8(76 76 66 68 1 5 0 1))))
+  (assert-raises invalid-argument-error? (write-binary (list car) (open-output-bytevector)))))
@@ -1,12 +1,15 @@
 #include "actor/Mailbox.h"
 
+#include <algorithm>
 #include <chrono>
 #include <atomic>
 
 #include "alloc/collector.h"
 #include "core/World.h"
+#include "core/error.h"
 #include "sched/Dispatcher.h"
 #include "actor/Runner.h"
+#include "metrics/Metric.h"
 
 namespace lliby
 {
@@ -18,11 +21,38 @@ namespace
 #ifdef _LLIBY_CHECK_LEAKS
 	std::atomic<std::size_t> allocationCount(0);
 #endif
+
+	/**
+	 * Reply mailbox cached by each thread for reuse by (ask)
+	 *
+	 * Cached mailboxes aren't included in the instance count so they aren't reported as leaks
+	 */
+	struct CachedMailboxDeleter
+	{
+		void operator()(Mailbox *mailbox) const
+		{
+#ifdef _LLIBY_CHECK_LEAKS
+			// Balance the decrement in the destructor
+			allocationCount++;
+#endif
+			delete mailbox;
+		}
+	};
+
+	thread_local std::unique_ptr<Mailbox, CachedMailboxDeleter> cachedReplyMailbox;
+
+	metrics::Metric MailboxesMetric("llambda_actor_mailboxes", "Live actor mailboxes including cached reply mailboxes", metrics::MetricType::Gauge);
+	metrics::Metric QueuedMessagesMetric("llambda_actor_queued_messages", "Messages queued across all mailboxes", metrics::MetricType::Gauge);
+	metrics::Metric EnqueuedMessagesMetric("llambda_actor_messages_total", "Messages queued for delivery", metrics::MetricType::Counter);
+	metrics::Metric DroppedMessagesMetric("llambda_actor_dropped_messages_total", "Messages dropped by full mailboxes", metrics::MetricType::Counter);
+	metrics::Metric RejectedMessagesMetric("llambda_actor_rejected_messages_total", "Messages rejected by full mailboxes", metrics::MetricType::Counter);
 }
 
 Mailbox::Mailbox() :
 	m_requestedLifecycleAction(LifecycleAction::Resume)
 {
+	MailboxesMetric.increment();
+
 #ifdef _LLIBY_CHECK_LEAKS
 	allocationCount++;
 #endif
@@ -37,16 +67,164 @@ Mailbox::~Mailbox()
 		delete msg;
 	}
 
+	QueuedMessagesMetric.add(-static_cast<std::int64_t>(m_messageQueue.size()));
+	MailboxesMetric.decrement();
+
 #ifdef _LLIBY_CHECK_LEAKS
 	allocationCount--;
 #endif
 }
 
-void Mailbox::tell(Message *message)
+std::shared_ptr<Mailbox> Mailbox::acquireReplyMailbox()
+{
+	Mailbox *replyMailbox = cachedReplyMailbox.release();
+
+	if (replyMailbox == nullptr)
+	{
+		replyMailbox = new Mailbox;
+		replyMailbox->m_isReplyMailbox = true;
+	}
+#ifdef _LLIBY_CHECK_LEAKS
+	else
+	{
+		allocationCount++;
+	}
+#endif
+
+	// Give each ask a distinct reference count. This ensures a late reply to a timed out ask can't be delivered to a
+	// later ask reusing the same mailbox.
+	return std::shared_ptr<Mailbox>(replyMailbox, [] (Mailbox *releasedMailbox) {
+		if (cachedReplyMailbox)
+		{
+			delete releasedMailbox;
+			return;
+		}
+
+		// Nothing can reference the mailbox at this point so it's safe to reuse
+		releasedMailbox->discardMessages();
+		cachedReplyMailbox.reset(releasedMailbox);
+
+#ifdef _LLIBY_CHECK_LEAKS
+		allocationCount--;
+#endif
+	});
+}
+
+void Mailbox::discardMessages()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(auto msg : m_messageQueue)
+	{
+		delete msg;
+	}
+
+	QueuedMessagesMetric.add(-static_cast<std::int64_t>(m_messageQueue.size()));
+	m_messageQueue.clear();
+	m_lifecycleActionRequested = false;
+
+	m_capacity = 0;
+	m_overflowPolicy = OverflowPolicy::Block;
+}
+
+bool Mailbox::awaitingReply(const Message *message)
+{
+	std::shared_ptr<Mailbox> sender(message->sender().lock());
+	return sender && sender->m_isReplyMailbox;
+}
+
+bool Mailbox::enqueueMessage(std::unique_lock<std::mutex> &lock, Message *message, bool isRequest)
+{
+	if (message->type() == Message::Type::User)
+	{
+		while((m_capacity != 0) && (m_messageQueue.size() >= m_capacity))
+		{
+			OverflowPolicy policy = m_overflowPolicy;
+
+			if (isRequest && (policy != OverflowPolicy::Block))
+			{
+				// Dropping a request would leave the sender waiting for a reply that never comes
+				policy = OverflowPolicy::Fail;
+			}
+
+			if (policy == OverflowPolicy::Block)
+			{
+				if ((m_state == State::Stopped) || (message->sender().lock().get() == this))
+				{
+					// Blocking would never finish
+					break;
+				}
+
+				m_queueSpaceCond.wait(lock);
+			}
+			else if (policy == OverflowPolicy::DropOldest)
+			{
+				bool hasUserMessage = false;
+
+				auto oldestIt = std::find_if(m_messageQueue.begin(), m_messageQueue.end(), [&] (Message *queued) {
+					if (queued->type() != Message::Type::User)
+					{
+						return false;
+					}
+
+					// Never drop a request with a sender still waiting on its reply
+					hasUserMessage = true;
+					return !awaitingReply(queued);
+				});
+
+				if (oldestIt == m_messageQueue.end())
+				{
+					if (!hasUserMessage)
+					{
+						// Only supervision messages are queued
+						break;
+					}
+
+					// Every queued user message is an outstanding request; drop the new message instead
+					delete message;
+					DroppedMessagesMetric.increment();
+					return true;
+				}
+
+				delete *oldestIt;
+				m_messageQueue.erase(oldestIt);
+
+				DroppedMessagesMetric.increment();
+				QueuedMessagesMetric.decrement();
+			}
+			else
+			{
+				delete message;
+
+				if (policy == OverflowPolicy::Fail)
+				{
+					RejectedMessagesMetric.increment();
+					return false;
+				}
+
+				DroppedMessagesMetric.increment();
+				return true;
+			}
+		}
+	}
+
+	m_messageQueue.push_back(message);
+
+	EnqueuedMessagesMetric.increment();
+	QueuedMessagesMetric.increment();
+
+	return true;
+}
+
+bool Mailbox::tell(Message *message)
 {
 	// Add to the queue
 	std::unique_lock<std::mutex> lock(m_mutex);
-	m_messageQueue.push_back(message);
+
+	if (!enqueueMessage(lock, message))
+	{
+		return false;
+	}
 
 	if (m_sleepingReceiver && (m_state == State::Running))
 	{
@@ -54,11 +232,14 @@ void Mailbox::tell(Message *message)
 		World *toWake = m_sleepingReceiver;
 		m_sleepingReceiver = nullptr;
 
+		// Prefer the worker the receiver last ran on to keep its heap in that CPU's cache
+		const sched::Dispatcher::WorkerId homeWorker = m_homeWorker;
+
 		lock.unlock();
 
 		sched::Dispatcher::defaultInstance().dispatch([=] {
 			Runner::wake(toWake);
-		});
+		}, homeWorker);
 	}
 	else
 	{
@@ -67,6 +248,8 @@ void Mailbox::tell(Message *message)
 		// Notify
 		m_messageQueueCond.notify_one();
 	}
+
+	return true;
 }
 
 void Mailbox::conditionalQueueWake(World *receiver)
@@ -75,15 +258,17 @@ void Mailbox::conditionalQueueWake(World *receiver)
 
 	if (m_lifecycleActionRequested || (!m_messageQueue.empty() && (m_state == State::Running)))
 	{
+		const sched::Dispatcher::WorkerId homeWorker = m_homeWorker;
 		lock.unlock();
 
 		sched::Dispatcher::defaultInstance().dispatch([=] {
 			Runner::wake(receiver);
-		});
+		}, homeWorker);
 	}
 	else
 	{
 		m_sleepingReceiver = receiver;
+		m_homeWorker = sched::Dispatcher::defaultInstance().currentWorkerId();
 	}
 }
 
@@ -102,6 +287,9 @@ Mailbox::ReceiveResult Mailbox::receive(World *sleepingReceiver, Message **msg,
 	{
 		*msg = m_messageQueue.front();
 		m_messageQueue.pop_front();
+		QueuedMessagesMetric.decrement();
+
+		m_queueSpaceCond.notify_one();
 
 		return ReceiveResult::PoppedMessage;
 	}
@@ -110,13 +298,14 @@ Mailbox::ReceiveResult Mailbox::receive(World *sleepingReceiver, Message **msg,
 	assert(sleepingReceiver->actorContext());
 
 	m_sleepingReceiver = sleepingReceiver;
+	m_homeWorker = sched::Dispatcher::defaultInstance().currentWorkerId();
+
 	return ReceiveResult::WentToSleep;
 }
 
 AnyCell* Mailbox::ask(World &world, AnyCell *requestCell, std::int64_t timeoutUsecs)
 {
-	// Create a temporary mailbox
-	std::shared_ptr<actor::Mailbox> senderMailbox(std::make_shared<actor::Mailbox>());
+	std::shared_ptr<actor::Mailbox> senderMailbox(acquireReplyMailbox());
 
 	// Create the request
 	actor::Message *request = actor::Message::createFromCell(requestCell, senderMailbox);
@@ -125,7 +314,11 @@ AnyCell* Mailbox::ask(World &world, AnyCell *requestCell, std::int64_t timeoutUs
 	{
 		std::unique_lock<std::mutex> receiverLock(m_mutex);
 
-		m_messageQueue.push_back(request);
+		if (!enqueueMessage(receiverLock, request, true))
+		{
+			receiverLock.unlock();
+			signalError(world, ErrorCategory::MailboxFull, "(ask) on full mailbox");
+		}
 
 		if (m_sleepingReceiver && (m_state == State::Running))
 		{
@@ -163,6 +356,7 @@ AnyCell* Mailbox::ask(World &world, AnyCell *requestCell, std::int64_t timeoutUs
 		// Get the message
 		Message *reply = senderMailbox->m_messageQueue.front();
 		senderMailbox->m_messageQueue.pop_front();
+		QueuedMessagesMetric.decrement();
 
 		// Release the lock
 		senderLock.unlock();
@@ -208,6 +402,25 @@ void Mailbox::requestLifecycleAction(LifecycleAction action)
 	}
 }
 
+void Mailbox::setCapacity(std::size_t capacity, OverflowPolicy policy)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_capacity = capacity;
+		m_overflowPolicy = policy;
+	}
+
+	// Blocked senders need to re-evaluate the new capacity and policy
+	m_queueSpaceCond.notify_all();
+}
+
+std::size_t Mailbox::queueDepth()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_messageQueue.size();
+}
+
 void Mailbox::setState(State state)
 {
 	{
@@ -216,6 +429,9 @@ void Mailbox::setState(State state)
 	}
 
 	m_stateCond.notify_all();
+
+	// Senders blocked on a stopped mailbox need to give up
+	m_queueSpaceCond.notify_all();
 }
 
 void Mailbox::waitForStop()
@@ -4,10 +4,13 @@
 #include "binding/AnyCell.h"
 #include "actor/Message.h"
 #include "actor/LifecycleAction.h"
+#include "actor/OverflowPolicy.h"
+#include "sched/Dispatcher.h"
 
 #include <cstdint>
 #include <mutex>
 #include <deque>
+#include <memory>
 #include <condition_variable>
 
 namespace lliby
@@ -55,24 +58,45 @@ public:
 	/**
 	 * Pushes a message on the mailbox's message queue
 	 *
-	 * This is asynchronous; it will return as soon as the message is successfully enqueued. The mailbox takes
-	 * ownership of the message.
+	 * This is asynchronous unless the mailbox is full with a blocking overflow policy; it will return as soon as the
+	 * message is successfully enqueued. The mailbox takes ownership of the message.
+	 *
+	 * @return False if the message was rejected by the OverflowPolicy::Fail policy
 	 */
-	void tell(Message *);
+	bool tell(Message *);
 
 	/**
 	 * Asks the mailbox for a synchronous response
 	 *
-	 * This internally creates a temporary mailbox and sends a message from there. If the actor is currently sleeping
-	 * it will be woken synchronously in the current thread.
+	 * This internally sends a message from a reply mailbox cached by the calling thread. If the actor is currently
+	 * sleeping it will be woken synchronously in the current thread.
 	 *
 	 * @param  world         World to receive the response in
 	 * @param  requestCell   Message cell for the initial request
 	 * @param  timeoutUsecs  Ask timeout in microseconds
 	 * @return Response cell in the passed world or nullptr if the timeout was reached
+	 *
+	 * If the mailbox is full and has a dropping overflow policy the request is rejected as if the policy was
+	 * OverflowPolicy::Fail. Queued requests are never dropped to make space for newer messages.
 	 */
 	AnyCell *ask(World &world, AnyCell *requestCell, std::int64_t timeoutUsecs);
 
+	/**
+	 * Limits the number of messages that can be queued
+	 *
+	 * Only user messages are limited; supervision messages are always accepted. Messages an actor sends to itself
+	 * are never blocked as the actor could never make space for them.
+	 *
+	 * @param  capacity  Maximum number of queued messages or 0 for an unbounded mailbox
+	 * @param  policy    Action to take when a message is sent to a full mailbox
+	 */
+	void setCapacity(std::size_t capacity, OverflowPolicy policy);
+
+	/**
+	 * Returns the number of messages waiting to be received
+	 */
+	std::size_t queueDepth();
+
 	/**
 	 * Request the actor peforms the specified lifecycle action
 	 *
@@ -127,12 +151,54 @@ protected:
 	void conditionalQueueWake(World *receiver);
 
 private:
+	/**
+	 * Returns a reply mailbox for a single (ask)
+	 *
+	 * The returned pointer has its own reference count. Once every strong reference has been released any weak
+	 * references held by the receiver expire and the mailbox is returned to the current thread's cache.
+	 */
+	static std::shared_ptr<Mailbox> acquireReplyMailbox();
+
+	/**
+	 * Deletes all queued messages, clears any requested lifecycle action and removes any capacity limit
+	 */
+	void discardMessages();
+
+	/**
+	 * Returns true if the sender of a message is an (ask) waiting for a reply
+	 */
+	static bool awaitingReply(const Message *message);
+
+	/**
+	 * Adds a message to the message queue after applying our overflow policy
+	 *
+	 * @param  lock       Lock holding m_mutex. This may be temporarily released while blocking.
+	 * @param  message    Message to enqueue. This is deleted if it's dropped or rejected.
+	 * @param  isRequest  True if the message is an (ask) request. Requests are rejected instead of being dropped.
+	 * @return False if the message was rejected by the OverflowPolicy::Fail policy
+	 */
+	bool enqueueMessage(std::unique_lock<std::mutex> &lock, Message *message, bool isRequest = false);
+
 	std::mutex m_mutex;
 
 	std::condition_variable m_messageQueueCond;
 	std::deque<Message*> m_messageQueue;
 	World *m_sleepingReceiver = nullptr;
 
+	/**
+	 * Dispatcher worker our receiver last went to sleep on
+	 */
+	sched::Dispatcher::WorkerId m_homeWorker = sched::Dispatcher::NoWorker;
+
+	/**
+	 * True if this mailbox was created to receive the reply to an (ask)
+	 */
+	bool m_isReplyMailbox = false;
+
+	std::size_t m_capacity = 0;
+	OverflowPolicy m_overflowPolicy = OverflowPolicy::Block;
+	std::condition_variable m_queueSpaceCond;
+
 	bool m_lifecycleActionRequested = false;
 	LifecycleAction m_requestedLifecycleAction;
 
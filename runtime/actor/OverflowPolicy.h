@@ -0,0 +1,42 @@
+#ifndef _LLIBY_ACTOR_OVERFLOWPOLICY_H
+#define _LLIBY_ACTOR_OVERFLOWPOLICY_H
+
+#include <cstdint>
+
+namespace lliby
+{
+namespace actor
+{
+
+/**
+ * Action to take when a message is sent to a full mailbox
+ *
+ * The numeric values of these policies are used by (set-mailbox-capacity) in the (llambda actor) library
+ */
+enum class OverflowPolicy : std::int32_t
+{
+	/**
+	 * Blocks the sender until the mailbox has space
+	 */
+	Block = 0,
+
+	/**
+	 * Discards the message being sent
+	 */
+	DropNewest = 1,
+
+	/**
+	 * Discards the oldest queued message to make space for the message being sent
+	 */
+	DropOldest = 2,
+
+	/**
+	 * Rejects the message being sent and signals an error to the sender
+	 */
+	Fail = 3
+};
+
+}
+}
+
+#endif
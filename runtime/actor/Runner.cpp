@@ -16,6 +16,8 @@
 
 #include "actor/LifecycleAction.h"
 
+#include "trace/Trace.h"
+
 namespace lliby
 {
 namespace actor
@@ -134,6 +136,10 @@ void Runner::wake(World *actorWorld)
 	ActorContext *context = actorWorld->actorContext();
 	const std::shared_ptr<Mailbox> &mailbox = context->mailbox();
 
+	// This is recorded when the actor goes to sleep or stops
+	trace::Span runSpan(trace::EventType::ActorRun, actorWorld);
+	std::uint64_t messagesProcessed = 0;
+
 	while(true)
 	{
 		Message *msg;
@@ -148,6 +154,7 @@ void Runner::wake(World *actorWorld)
 		if (result == Mailbox::ReceiveResult::WentToSleep)
 		{
 			// Went to sleep - give up our thread
+			runSpan.setArgs(messagesProcessed);
 			return;
 		}
 		else if (result == Mailbox::ReceiveResult::TookLifecycleAction)
@@ -184,6 +191,10 @@ void Runner::wake(World *actorWorld)
 			// Delete the message
 			delete msg;
 
+			trace::Span messageSpan(trace::EventType::ActorMessage, actorWorld);
+			messageSpan.setArgs(static_cast<std::uint64_t>(type));
+			messagesProcessed++;
+
 			try
 			{
 				if (type == Message::Type::SupervisedFailure)
@@ -228,6 +239,8 @@ void Runner::wake(World *actorWorld)
 		}
 	}
 
+	runSpan.setArgs(messagesProcessed);
+
 	mailbox->setState(Mailbox::State::Stopped);
 	delete actorWorld;
 }
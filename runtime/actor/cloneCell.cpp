@@ -1,5 +1,6 @@
 #include "actor/cloneCell.h"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <unordered_map>
@@ -8,10 +9,12 @@
 #include "core/error.h"
 
 #include "binding/IntegerCell.h"
+#include "binding/EmptyListCell.h"
 #include "binding/ProcedureCell.h"
 #include "binding/RecordCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/BytevectorCell.h"
 #include "binding/CharCell.h"
 #include "binding/VectorCell.h"
@@ -84,7 +87,7 @@ namespace
 
 		if (!dataIsInline)
 		{
-			newData = RecordLikeCell::allocateRecordData(classMap->totalSize);
+			newData = RecordLikeCell::allocateRecordData(heap, classMap->totalSize);
 		}
 
 		// Allocate a new cell
@@ -130,12 +133,6 @@ namespace
 			catch (UnclonableCellException &)
 			{
 				stubCell(cellPlacement);
-
-				if (!dataIsInline)
-				{
-					RecordLikeCell::freeRecordData(newData);
-				}
-
 				throw;
 			}
 		}
@@ -145,23 +142,23 @@ namespace
 
 	VectorCell *cloneVectorCell(alloc::Heap &heap, VectorCell *vectorCell, Context &context)
 	{
-		AnyCell **newData = new AnyCell*[vectorCell->length()];
+		VectorCell *newVector = VectorCell::createUninitialised(heap, vectorCell->length());
 
-		try
+		if (newVector == nullptr)
 		{
-			for(VectorCell::LengthType i = 0; i < vectorCell->length(); i++)
-			{
-				newData[i] = cachedClone(heap, vectorCell->elements()[i], context);
-			}
+			throw std::bad_alloc();
 		}
-		catch (UnclonableCellException &)
+
+		// Make sure the vector is safe to collect if cloning an element fails
+		AnyCell **newData = newVector->elements();
+		std::fill(newData, newData + vectorCell->length(), EmptyListCell::instance());
+
+		for(VectorCell::LengthType i = 0; i < vectorCell->length(); i++)
 		{
-			delete[] newData;
-			throw;
+			newData[i] = cachedClone(heap, vectorCell->elements()[i], context);
 		}
 
-		auto placement = heap.allocate();
-		return new (placement) VectorCell(newData, vectorCell->length());
+		return newVector;
 	}
 
 	PairCell *clonePair(alloc::Heap &heap, PairCell *pairCell, Context &context)
@@ -207,6 +204,11 @@ namespace
 	{
 		if (auto integerCell = cell_cast<IntegerCell>(cell))
 		{
+			if (IntegerCell *preconstructed = IntegerCell::preconstructedInstance(integerCell->value()))
+			{
+				return preconstructed;
+			}
+
 			auto placement = heap.allocate();
 			return new (placement) IntegerCell(integerCell->value());
 		}
@@ -215,8 +217,18 @@ namespace
 			auto placement = heap.allocate();
 			return new (placement) FlonumCell(flonumCell->value());
 		}
+		else if (auto ratnumCell = cell_cast<RatnumCell>(cell))
+		{
+			auto placement = heap.allocate();
+			return new (placement) RatnumCell(ratnumCell->numerator(), ratnumCell->denominator());
+		}
 		else if (auto charCell = cell_cast<CharCell>(cell))
 		{
+			if (CharCell *preconstructed = CharCell::preconstructedInstance(charCell->unicodeChar()))
+			{
+				return preconstructed;
+			}
+
 			auto placement = heap.allocate();
 			return new (placement) CharCell(charCell->unicodeChar());
 		}
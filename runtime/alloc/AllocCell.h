@@ -38,6 +38,56 @@ private:
 	MemoryBlock *m_nextSegment;
 };
 
+// This is a special cell that starts a run of cells storing data for the cell before it
+// The data begins at DataOffset and continues contiguously through the rest of the run
+class InlineStorageCell : public AnyCell
+{
+public:
+	static const std::size_t DataOffset = 8;
+
+	InlineStorageCell(std::uint32_t storageCells) :
+		AnyCell(CellTypeId::Invalid, GarbageState::InlineStorageCell),
+		m_storageCells(storageCells)
+	{
+	}
+
+	/**
+	 * Returns the number of cells in the run including this header
+	 */
+	std::uint32_t storageCells() const
+	{
+		return m_storageCells;
+	}
+
+	void *data()
+	{
+		return reinterpret_cast<std::uint8_t*>(this) + DataOffset;
+	}
+
+	/**
+	 * Returns the storage cell header for a pointer previously returned by data()
+	 */
+	static InlineStorageCell *fromData(void *data)
+	{
+		return reinterpret_cast<InlineStorageCell*>(static_cast<std::uint8_t*>(data) - DataOffset);
+	}
+
+	/**
+	 * Returns the number of cells required to store the passed number of bytes including the header
+	 */
+	static std::size_t storageCellsForBytes(std::size_t bytes);
+
+private:
+	std::uint32_t m_storageCells;
+};
+
+static_assert(sizeof(InlineStorageCell) <= InlineStorageCell::DataOffset, "Inline storage header overlaps its data");
+
+inline std::size_t InlineStorageCell::storageCellsForBytes(std::size_t bytes)
+{
+	return (DataOffset + bytes + sizeof(AllocCell) - 1) / sizeof(AllocCell);
+}
+
 // This is a special cell that terminates an entire
 class HeapTerminatorCell : public AnyCell
 {
@@ -0,0 +1,230 @@
+#include "alloc/AllocationSampler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "alloc/AllocCell.h"
+#include "platform/backtrace.h"
+
+namespace lliby
+{
+namespace alloc
+{
+
+std::size_t AllocationSampler::m_sampleIntervalCells = 0;
+
+namespace
+{
+	const std::size_t DefaultSampleIntervalCells = 4096;
+
+	/**
+	 * Frames belonging to takeSample() and the heap's slow path
+	 */
+	const int SamplerFrames = 2;
+
+	std::string profileFilename;
+
+	/**
+	 * Aggregated sample weights keyed by backtrace and cell type
+	 */
+	using ProfileKey = std::pair<std::vector<void*>, CellTypeId>;
+
+	std::mutex profileMutex;
+	std::map<ProfileKey, std::uint64_t> profile;
+
+	const char *cellTypeName(CellTypeId typeId)
+	{
+		switch(typeId)
+		{
+		case CellTypeId::Unit:
+			return "unit";
+		case CellTypeId::Pair:
+			return "pair";
+		case CellTypeId::EmptyList:
+			return "empty-list";
+		case CellTypeId::String:
+			return "string";
+		case CellTypeId::Symbol:
+			return "symbol";
+		case CellTypeId::Boolean:
+			return "boolean";
+		case CellTypeId::Integer:
+			return "integer";
+		case CellTypeId::Flonum:
+			return "flonum";
+		case CellTypeId::Ratnum:
+			return "ratnum";
+		case CellTypeId::Char:
+			return "char";
+		case CellTypeId::Vector:
+			return "vector";
+		case CellTypeId::Bytevector:
+			return "bytevector";
+		case CellTypeId::Procedure:
+			return "procedure";
+		case CellTypeId::Record:
+			return "record";
+		case CellTypeId::ErrorObject:
+			return "error-object";
+		case CellTypeId::Port:
+			return "port";
+		case CellTypeId::EofObject:
+			return "eof-object";
+		case CellTypeId::Mailbox:
+			return "mailbox";
+		case CellTypeId::HashMap:
+			return "hash-map";
+		case CellTypeId::Invalid:
+			break;
+		}
+
+		return "unknown";
+	}
+}
+
+void AllocationSampler::init()
+{
+	const char *filename = getenv("LLAMBDA_ALLOC_PROFILE");
+
+	if (filename == nullptr)
+	{
+		return;
+	}
+
+	std::size_t sampleIntervalCells = DefaultSampleIntervalCells;
+
+	if (const char *intervalString = getenv("LLAMBDA_ALLOC_PROFILE_INTERVAL"))
+	{
+		sampleIntervalCells = strtoull(intervalString, nullptr, 10);
+
+		if (sampleIntervalCells == 0)
+		{
+			std::cerr << "Invalid LLAMBDA_ALLOC_PROFILE_INTERVAL \"" << intervalString << "\"; expected a positive number of cells" << std::endl;
+			return;
+		}
+	}
+
+	if (!enabled())
+	{
+		// Write from exit() so programs that call (exit) or die from an unhandled exception are covered
+		atexit(writeProfileIfEnabled);
+	}
+
+	profileFilename = filename;
+	m_sampleIntervalCells = sampleIntervalCells;
+}
+
+void AllocationSampler::takeSample(AllocationSampleList &samples, AllocCell *allocation, std::size_t cellCount)
+{
+	samples.emplace_back();
+	AllocationSample &sample(samples.back());
+
+	sample.allocation = allocation;
+	sample.cellCount = cellCount;
+	sample.weight = std::max(m_sampleIntervalCells, cellCount);
+	sample.frameCount = platform::captureBacktrace(sample.frames, AllocationSample::MaxFrames, SamplerFrames);
+}
+
+void AllocationSampler::resolveSamples(AllocationSampleList &samples)
+{
+	if (samples.empty())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(profileMutex);
+
+	for(const AllocationSample &sample : samples)
+	{
+		if (sample.cellCount == 0)
+		{
+			// All of the sampled cells were returned to the heap
+			continue;
+		}
+
+		std::vector<void*> frames(sample.frames, sample.frames + sample.frameCount);
+
+		// Spread the sample's weight over each of its cells
+		const std::uint64_t cellWeight = std::max<std::uint64_t>(1, sample.weight / sample.cellCount);
+
+		AllocCell *cell = sample.allocation;
+		AllocCell *allocationEnd = sample.allocation + sample.cellCount;
+
+		while(cell < allocationEnd)
+		{
+			if (cell->gcState() == GarbageState::InlineStorageCell)
+			{
+				const std::uint32_t storageCells = reinterpret_cast<InlineStorageCell*>(cell)->storageCells();
+
+				if (storageCells >= 1)
+				{
+					// This is data belonging to the previous cell
+					cell += storageCells;
+					continue;
+				}
+			}
+
+			const CellTypeId typeId = (cell->gcState() == GarbageState::HeapAllocatedCell) ? cell->typeId() : CellTypeId::Invalid;
+			profile[ProfileKey(frames, typeId)] += cellWeight;
+
+			cell++;
+		}
+	}
+
+	samples.clear();
+}
+
+void AllocationSampler::writeFoldedProfile(std::ostream &out)
+{
+	std::lock_guard<std::mutex> lock(profileMutex);
+	std::map<void*, std::string> symbolNames;
+
+	for(const auto &entry : profile)
+	{
+		const std::vector<void*> &frames(entry.first.first);
+
+		// Folded stacks are outermost frame first
+		for(auto frameIt = frames.rbegin(); frameIt != frames.rend(); frameIt++)
+		{
+			auto nameIt = symbolNames.find(*frameIt);
+
+			if (nameIt == symbolNames.end())
+			{
+				nameIt = symbolNames.emplace(*frameIt, platform::symbolNameForAddress(*frameIt)).first;
+			}
+
+			out << nameIt->second << ";";
+		}
+
+		out << cellTypeName(entry.first.second) << " " << entry.second << "\n";
+	}
+
+	out.flush();
+}
+
+void AllocationSampler::writeProfileIfEnabled()
+{
+	if (!enabled())
+	{
+		return;
+	}
+
+	std::ofstream profileFile(profileFilename, std::ios::out | std::ios::trunc);
+
+	if (!profileFile)
+	{
+		std::cerr << "Unable to open allocation profile \"" << profileFilename << "\"" << std::endl;
+		return;
+	}
+
+	writeFoldedProfile(profileFile);
+}
+
+}
+}
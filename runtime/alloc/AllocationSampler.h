@@ -0,0 +1,109 @@
+#ifndef _LLIBY_ALLOC_ALLOCATIONSAMPLER_H
+#define _LLIBY_ALLOC_ALLOCATIONSAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace lliby
+{
+namespace alloc
+{
+
+class AllocCell;
+
+/**
+ * Allocation sampled by the AllocationSampler
+ *
+ * The types of the sampled cells aren't known until the cells have been constructed. Samples are held by their heap
+ * until it's collected or finalized.
+ */
+struct AllocationSample
+{
+	static const int MaxFrames = 24;
+
+	AllocCell *allocation;
+	std::size_t cellCount;
+	std::size_t weight;
+
+	int frameCount;
+	void *frames[MaxFrames];
+};
+
+using AllocationSampleList = std::vector<AllocationSample>;
+
+/**
+ * Opt-in sampling profiler for cell allocations
+ *
+ * When enabled each heap limits its bump allocation window to the sampling interval. This forces both runtime
+ * allocations and the compiler's inline allocations on to the heap's slow path roughly every interval cells where a
+ * native backtrace is recorded. Once the sampled cells have been constructed their types are resolved and the sample
+ * is aggregated by backtrace and cell type.
+ *
+ * Sampling is enabled by setting LLAMBDA_ALLOC_PROFILE to the path of an output file. The aggregated samples are
+ * written there at exit in the folded stack format used by flame graph tools. LLAMBDA_ALLOC_PROFILE_INTERVAL can be
+ * set to the sampling interval in cells; it defaults to 4096 cells.
+ */
+class AllocationSampler
+{
+public:
+	/**
+	 * Configures sampling from the environment
+	 */
+	static void init();
+
+	/**
+	 * Returns true if sampling is enabled
+	 */
+	static bool enabled()
+	{
+		return m_sampleIntervalCells != 0;
+	}
+
+	/**
+	 * Returns the number of cells to allocate between samples or 0 if sampling is disabled
+	 */
+	static std::size_t sampleIntervalCells()
+	{
+		return m_sampleIntervalCells;
+	}
+
+	/**
+	 * Records a sample for an allocation of the calling thread
+	 *
+	 * @param  samples     List to add the pending sample to
+	 * @param  allocation  Start of the allocated cells
+	 * @param  cellCount   Number of cells allocated
+	 */
+	static void takeSample(AllocationSampleList &samples, AllocCell *allocation, std::size_t cellCount);
+
+	/**
+	 * Resolves the cell types of pending samples and aggregates them in to the profile
+	 *
+	 * All allocated cells in the pending samples must be constructed and not yet collected. Samples must already be
+	 * truncated to the cells that remain allocated. The sample list will be cleared.
+	 */
+	static void resolveSamples(AllocationSampleList &samples);
+
+	/**
+	 * Writes the aggregated profile in folded stack format
+	 *
+	 * Each line contains the outermost to innermost native frames and the allocated cell type separated by semicolons
+	 * followed by the estimated number of cells allocated
+	 */
+	static void writeFoldedProfile(std::ostream &out);
+
+	/**
+	 * Writes the aggregated profile to the file named by LLAMBDA_ALLOC_PROFILE if sampling is enabled
+	 */
+	static void writeProfileIfEnabled();
+
+private:
+	static std::size_t m_sampleIntervalCells;
+};
+
+}
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/StringCell.h"
 #include "binding/SymbolCell.h"
 #include "binding/BytevectorCell.h"
@@ -116,6 +117,7 @@ public:
 			cell_cast<BooleanCell>(*rootCellRef) ||
 			cell_cast<IntegerCell>(*rootCellRef) ||
 			cell_cast<FlonumCell>(*rootCellRef) ||
+			cell_cast<RatnumCell>(*rootCellRef) ||
 			cell_cast<StringCell>(*rootCellRef) ||
 			cell_cast<SymbolCell>(*rootCellRef) ||
 			cell_cast<BytevectorCell>(*rootCellRef) ||
@@ -133,36 +135,20 @@ public:
 	}
 
 	/**
-	 * Visits a dynamic state
+	 * Visits a dynamic state and its ancestors
+	 *
+	 * Parameter values are visited through their parameter procedures; this only visits the values saved by each state
 	 */
 	template<typename T>
 	void visitDynamicState(dynamic::State *state, T visitor)
 	{
-		dynamic::State::ParameterValueMap rebuiltMap;
-		const std::size_t valueCount = state->selfValues().size();
-
-		if (valueCount > 0)
+		for(; state != nullptr; state = state->parent())
 		{
-			// The new map will be the exact size of the old map
-			rebuiltMap.reserve(valueCount);
-
-			for(auto valueItem : state->selfValues())
+			for(auto &savedValue : state->savedValues())
 			{
-				dynamic::ParameterProcedureCell *paramProc = valueItem.first;
-				AnyCell *value = valueItem.second;
-
-				visitCell(reinterpret_cast<AnyCell**>(&paramProc), visitor);
-				visitCell(reinterpret_cast<AnyCell**>(&value), visitor);
-
-				rebuiltMap[paramProc] = value;
+				visitCell(reinterpret_cast<AnyCell**>(&savedValue.parameterProc), visitor);
+				visitCell(&savedValue.value, visitor);
 			}
-
-			state->setSelfValues(rebuiltMap);
-		}
-
-		if (state->parent() != nullptr)
-		{
-			visitDynamicState(state->parent(), visitor);
 		}
 	}
 
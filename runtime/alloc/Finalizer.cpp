@@ -8,25 +8,37 @@
 #include "alloc/AllocCell.h"
 #include "alloc/MemoryBlock.h"
 #include "sched/Dispatcher.h"
+#include "metrics/Metric.h"
 
 namespace lliby
 {
 namespace alloc
 {
 
-void Finalizer::finalizeHeapAsync(Heap &heap)
+namespace
+{
+	metrics::Metric PendingHeapsMetric("llambda_finalizer_pending_heaps", "Collected heaps waiting to be finalized", metrics::MetricType::Gauge);
+	metrics::Metric FinalizedSegmentsMetric("llambda_finalizer_segments_total", "Heap segments finalized and freed", metrics::MetricType::Counter);
+}
+
+void Finalizer::finalizeHeapAsync(Heap &heap, World *world)
 {
 	if (heap.isEmpty())
 	{
 		return;
 	}
 
+	heap.resolveAllocationSamples();
 	terminateHeap(heap);
 
 	MemoryBlock *rootSegment = heap.rootSegment();
+	const trace::Subject traceSubject = trace::enabled() ? trace::Subject::forWorld(world) : trace::Subject{0, 0};
+
+	PendingHeapsMetric.increment();
 
 	sched::Dispatcher::defaultInstance().dispatch([=]() {
-		finalizeSegment(rootSegment);
+		finalizeSegment(rootSegment, traceSubject);
+		PendingHeapsMetric.decrement();
 	});
 
 	// Detach all segments from the heap now that we've queued the finalization. This prevents us finalizing the heap
@@ -34,53 +46,74 @@ void Finalizer::finalizeHeapAsync(Heap &heap)
 	heap.detach();
 }
 
-void Finalizer::finalizeHeapSync(Heap &heap)
+void Finalizer::finalizeHeapSync(Heap &heap, World *world)
 {
 	if (heap.isEmpty())
 	{
 		return;
 	}
 
+	heap.resolveAllocationSamples();
 	terminateHeap(heap);
-	finalizeSegment(heap.rootSegment());
+	finalizeSegment(heap.rootSegment(), trace::enabled() ? trace::Subject::forWorld(world) : trace::Subject{0, 0});
 
 	heap.detach();
 }
 
-void Finalizer::finalizeSegment(MemoryBlock *rootSegment)
+void Finalizer::finalizeSegment(MemoryBlock *rootSegment, trace::Subject traceSubject)
 {
-	auto nextCell = static_cast<AllocCell*>(rootSegment->startPointer());
+	trace::Span finalizeSpan(trace::EventType::Finalization, traceSubject);
 
-	while((nextCell->gcState() != GarbageState::HeapTerminator) &&
-			(nextCell->gcState() != GarbageState::SegmentTerminator))
+	std::uint64_t segmentsFreed = 0;
+	std::uint64_t bytesReclaimed = 0;
+
+	MemoryBlock *segment = rootSegment;
+
+	while(segment != nullptr)
 	{
-		// Make sure our garbage state is valid
-		// If a cell is written past its end it can corrupt the garbage state of the next cell
-		assert(nextCell->gcState() <= GarbageState::MaximumGarbageState);
+		auto startCell = static_cast<AllocCell*>(segment->startPointer());
+		auto nextCell = startCell;
 
-		if (nextCell->gcState() != GarbageState::ForwardingCell)
+		while((nextCell->gcState() != GarbageState::HeapTerminator) &&
+				(nextCell->gcState() != GarbageState::SegmentTerminator))
 		{
-			// This value is no longer referenced
-			nextCell->finalize();
+			// Make sure our garbage state is valid
+			// If a cell is written past its end it can corrupt the garbage state of the next cell
+			assert(nextCell->gcState() <= GarbageState::MaximumGarbageState);
+
+			if (nextCell->gcState() == GarbageState::InlineStorageCell)
+			{
+				// This is data belonging to the previous cell; skip over it
+				nextCell += reinterpret_cast<InlineStorageCell*>(nextCell)->storageCells();
+				continue;
+			}
+			else if (nextCell->gcState() != GarbageState::ForwardingCell)
+			{
+				// This value is no longer referenced
+				nextCell->finalize();
+			}
+
+			nextCell++;
 		}
 
-		nextCell++;
-	}
+		MemoryBlock *nextSegment = nullptr;
 
-	MemoryBlock *nextSegment = nullptr;
+		if (nextCell->gcState() == GarbageState::SegmentTerminator)
+		{
+			nextSegment = reinterpret_cast<SegmentTerminatorCell*>(nextCell)->nextSegment();
+		}
 
-	if (nextCell->gcState() == GarbageState::SegmentTerminator)
-	{
-		nextSegment = reinterpret_cast<SegmentTerminatorCell*>(nextCell)->nextSegment();
-	}
+		segmentsFreed++;
+		bytesReclaimed += (nextCell - startCell) * sizeof(AllocCell);
 
-	// Actually free the block
-	delete rootSegment;
+		// Actually free the block
+		delete segment;
+		FinalizedSegmentsMetric.increment();
 
-	if (nextSegment != nullptr)
-	{
-		finalizeSegment(nextSegment);
+		segment = nextSegment;
 	}
+
+	finalizeSpan.setArgs(segmentsFreed, bytesReclaimed);
 }
 
 void Finalizer::terminateHeap(Heap &heap)
@@ -1,8 +1,12 @@
 #ifndef _LLIBY_ALLOC_FINALIZER_H
 #define _LLIBY_ALLOC_FINALIZER_H
 
+#include "trace/Trace.h"
+
 namespace lliby
 {
+class World;
+
 namespace alloc
 {
 
@@ -13,11 +17,17 @@ class MemoryBlock;
 class Finalizer
 {
 public:
-	static void finalizeHeapAsync(Heap &heap);
-	static void finalizeHeapSync(Heap &heap);
+	/**
+	 * Finalizes the cells in a heap on a dispatcher thread and frees its segments
+	 *
+	 * @param  heap   Heap to finalize. This will be empty on return.
+	 * @param  world  World the heap was collected from or nullptr if unknown. This is used for tracing.
+	 */
+	static void finalizeHeapAsync(Heap &heap, World *world = nullptr);
+	static void finalizeHeapSync(Heap &heap, World *world = nullptr);
 
 private:
-	static void finalizeSegment(MemoryBlock *rootSegment);
+	static void finalizeSegment(MemoryBlock *rootSegment, trace::Subject subject);
 	static void terminateHeap(Heap &heap);
 };
 
@@ -58,7 +58,17 @@ enum class GarbageState : std::uint8_t
 	 */
 	HeapTerminator = 5,
 
-	MaximumGarbageState = HeapTerminator
+	/**
+	 * Header of a run of cells holding data for the preceding cell
+	 *
+	 * The header records the number of cells in the run so they can be skipped when walking a heap segment. The data
+	 * in the run belongs to the preceding cell and is moved along with it by the garbage collector.
+	 *
+	 * These aren't actual cells; they're only used internally by the allocator
+	 */
+	InlineStorageCell = 6,
+
+	MaximumGarbageState = InlineStorageCell
 };
 
 }
@@ -1,5 +1,6 @@
 #include "alloc/Heap.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 
@@ -27,12 +28,20 @@ void Heap::detach()
 {
 	m_allocNext = nullptr;
 	m_allocEnd = nullptr;
+	m_segmentEnd = nullptr;
 
 	m_nextSegmentSize = m_initialSegmentSize;
 	m_rootSegment = nullptr;
 
 	m_currentSegmentStart = nullptr;
 	m_allocationCounterBase = 0;
+
+	m_storageNext = nullptr;
+	m_storageEnd = nullptr;
+	m_nextStorageSegmentSize = m_initialSegmentSize;
+
+	// Any remaining samples can no longer be resolved
+	m_pendingSamples.clear();
 }
 
 Heap::~Heap()
@@ -40,6 +49,29 @@ Heap::~Heap()
 	Finalizer::finalizeHeapSync(*this);
 }
 
+AllocCell* Heap::allocateSlowPath(std::size_t count)
+{
+	AllocCell *allocation = m_allocNext;
+
+	if ((m_allocNext != nullptr) && (m_allocNext + count <= m_segmentEnd))
+	{
+		// We only reached the end of the sampling window
+		m_allocNext += count;
+	}
+	else
+	{
+		allocation = addNewSegment(count);
+	}
+
+	if (AllocationSampler::enabled())
+	{
+		AllocationSampler::takeSample(m_pendingSamples, allocation, count);
+		m_allocEnd = std::min(m_segmentEnd, m_allocNext + AllocationSampler::sampleIntervalCells());
+	}
+
+	return allocation;
+}
+
 AllocCell* Heap::addNewSegment(std::size_t reserveCount)
 {
 	const std::size_t minimumBytes = (sizeof(AllocCell) * reserveCount) + sizeof(SegmentTerminatorCell);
@@ -83,11 +115,64 @@ AllocCell* Heap::addNewSegment(std::size_t reserveCount)
 	// Find the number of cells we can fit in the segment with room for a segment terminator
 	const std::size_t usableCellCount = (newSegment->size(newSegmentSize) - sizeof(SegmentTerminatorCell)) / sizeof(AllocCell);
 
-	m_allocEnd = reinterpret_cast<AllocCell*>(newSegment->startPointer()) + usableCellCount;
+	m_segmentEnd = reinterpret_cast<AllocCell*>(newSegment->startPointer()) + usableCellCount;
+	m_allocEnd = m_segmentEnd;
 
 	return m_currentSegmentStart;
 }
 
+InlineStorageCell* Heap::allocateStorage(std::size_t storageCells)
+{
+	if ((m_storageNext == nullptr) || (m_storageNext + storageCells > m_storageEnd))
+	{
+		addNewStorageSegment(storageCells);
+	}
+
+	auto storageCell = new (m_storageNext) InlineStorageCell(storageCells);
+	m_storageNext += storageCells;
+
+	if (m_storageNext < m_storageEnd)
+	{
+		// Cover the rest of the segment so the finalizer can skip over it
+		new (m_storageNext) InlineStorageCell(m_storageEnd - m_storageNext);
+	}
+
+	m_allocationCounterBase += storageCells;
+	return storageCell;
+}
+
+void Heap::addNewStorageSegment(std::size_t reserveCount)
+{
+	if (m_rootSegment == nullptr)
+	{
+		// We need a cell segment to terminate the storage segment chain
+		addNewSegment(0);
+	}
+
+	const std::size_t minimumBytes = (sizeof(AllocCell) * reserveCount) + sizeof(SegmentTerminatorCell);
+	std::size_t newSegmentSize;
+
+	if (minimumBytes > m_nextStorageSegmentSize)
+	{
+		newSegmentSize = minimumBytes;
+	}
+	else
+	{
+		newSegmentSize = m_nextStorageSegmentSize;
+		m_nextStorageSegmentSize = std::min(m_nextStorageSegmentSize * SegmentGrowthFactor, SegmentMaximumSize);
+	}
+
+	auto newSegment = MemoryBlock::create(newSegmentSize);
+	const std::size_t usableCellCount = (newSegment->size(newSegmentSize) - sizeof(SegmentTerminatorCell)) / sizeof(AllocCell);
+
+	m_storageNext = static_cast<AllocCell*>(newSegment->startPointer());
+	m_storageEnd = m_storageNext + usableCellCount;
+
+	// Link the segment in front of our current root
+	new (m_storageEnd) SegmentTerminatorCell(m_rootSegment);
+	m_rootSegment = newSegment;
+}
+
 void Heap::splice(Heap &other)
 {
 	if (other.m_rootSegment == nullptr)
@@ -113,14 +198,41 @@ void Heap::splice(Heap &other)
 		// Intentionally don't copy m_initialSegmentSize - this is a per-Heap tuning value
 		m_allocNext = other.m_allocNext;
 		m_allocEnd = other.m_allocEnd;
+		m_segmentEnd = other.m_segmentEnd;
 		m_nextSegmentSize = other.m_nextSegmentSize;
 		m_currentSegmentStart = other.m_currentSegmentStart;
 		m_allocationCounterBase = -currentSegmentAllocations();
+
+		m_storageNext = other.m_storageNext;
+		m_storageEnd = other.m_storageEnd;
+		m_nextStorageSegmentSize = other.m_nextStorageSegmentSize;
 	}
 
+	// Take over the other heap's pending samples
+	other.truncatePendingSamples();
+	m_pendingSamples.insert(m_pendingSamples.end(), other.m_pendingSamples.begin(), other.m_pendingSamples.end());
+
 	// Destroy the other heap for safety
 	other.detach();
 }
 
+void Heap::resolveAllocationSamples()
+{
+	truncatePendingSamples();
+	AllocationSampler::resolveSamples(m_pendingSamples);
+}
+
+void Heap::truncatePendingSamples()
+{
+	for(AllocationSample &sample : m_pendingSamples)
+	{
+		if ((sample.allocation >= m_currentSegmentStart) && (sample.allocation < m_segmentEnd))
+		{
+			const std::size_t allocatedCells = std::max<ptrdiff_t>(0, m_allocNext - sample.allocation);
+			sample.cellCount = std::min(sample.cellCount, allocatedCells);
+		}
+	}
+}
+
 }
 }
@@ -5,6 +5,7 @@
 #include <cstddef>
 
 #include "alloc/AllocCell.h"
+#include "alloc/AllocationSampler.h"
 
 namespace lliby
 {
@@ -56,8 +57,8 @@ public:
 
 		if (newAllocNext > m_allocEnd)
 		{
-			// This adds a new segment and updates m_allocNext
-			allocation = addNewSegment(count);
+			// This updates m_allocNext
+			allocation = allocateSlowPath(count);
 		}
 		else
 		{
@@ -67,6 +68,17 @@ public:
 		return allocation;
 	}
 
+	/**
+	 * Allocates a run of cells to store data belonging to a cell
+	 *
+	 * The run is taken from a separate storage arena so it doesn't disturb cells that generated code has reserved with
+	 * allocate() but not yet initialised. It begins with an InlineStorageCell header so the finalizer can walk over it.
+	 * This never triggers a collection but the cells count towards the allocation counter.
+	 *
+	 * This cannot fail. The program will be aborted if more memory cannot be allocated
+	 */
+	InlineStorageCell *allocateStorage(std::size_t storageCells);
+
 	/**
 	 * Returns the number of allocated cells in the heap since the last call to resetAllocationCounter()
 	 */
@@ -111,6 +123,14 @@ public:
 	 */
 	void splice(Heap &other);
 
+	/**
+	 * Resolves the cell types of allocation samples taken from this heap
+	 *
+	 * This must be called while all cells in the heap are constructed and before they're moved by the garbage
+	 * collector. It does nothing if allocation sampling is disabled.
+	 */
+	void resolveAllocationSamples();
+
 	/**
 	 * Detaches all memory segments from this heap
 	 *
@@ -124,10 +144,37 @@ private:
 		return m_allocNext - m_currentSegmentStart;
 	}
 
+	/**
+	 * Allocates cells once m_allocEnd has been reached
+	 *
+	 * This either adds a new segment or, when allocation sampling is enabled, samples the allocation and moves
+	 * m_allocEnd to the end of the next sampling window
+	 */
+	AllocCell* allocateSlowPath(std::size_t count);
+
 	AllocCell* addNewSegment(std::size_t reserveCount);
 
+	/**
+	 * Adds a new segment to the storage arena
+	 *
+	 * Storage segments are chained in front of the root segment. This keeps the last segment in the chain a cell
+	 * segment so it can be terminated at m_allocNext.
+	 */
+	void addNewStorageSegment(std::size_t reserveCount);
+
+	/**
+	 * Truncates pending samples to the cells that are still allocated
+	 *
+	 * Generated code returns the unused cells of an allocation by moving m_allocNext back. Only the current segment can
+	 * have its allocations shortened this way.
+	 */
+	void truncatePendingSamples();
+
+	// These are accessed directly by generated code. m_allocEnd is the end of the current segment unless allocation
+	// sampling has moved it earlier.
 	alloc::AllocCell *m_allocNext;
 	alloc::AllocCell *m_allocEnd;
+	alloc::AllocCell *m_segmentEnd;
 
 	// Size of the next segment to allocate
 	// Note that if an oversized segment has been allocated this might not be the actual size of the current segment
@@ -137,6 +184,13 @@ private:
 
 	alloc::AllocCell *m_currentSegmentStart;
 	std::size_t m_allocationCounterBase;
+
+	// Storage arena. Any unused cells before m_storageEnd are covered by an InlineStorageCell header.
+	alloc::AllocCell *m_storageNext;
+	alloc::AllocCell *m_storageEnd;
+	std::size_t m_nextStorageSegmentSize;
+
+	AllocationSampleList m_pendingSamples;
 };
 
 }
@@ -1,5 +1,6 @@
 #include "alloc/allocator.h"
 
+#include <chrono>
 #include <cstdlib>
 
 #include "core/World.h"
@@ -9,11 +10,13 @@
 #include "alloc/Finalizer.h"
 #include "alloc/collector.h"
 
+#include "metrics/Metric.h"
+#include "trace/Trace.h"
+
 #ifdef _LLIBY_CHECK_LEAKS
 #include <iostream>
 
 #include "sched/Dispatcher.h"
-#include "binding/RecordLikeCell.h"
 #include "binding/SharedByteArray.h"
 #include "actor/Mailbox.h"
 #endif
@@ -31,6 +34,11 @@ namespace
 #ifndef _LLIBY_ALWAYS_GC
 	const std::size_t MaxAllocBeforeForceGc = 1024 * 1024;
 #endif
+
+	metrics::Metric CollectionsMetric("llambda_gc_collections_total", "Garbage collections performed", metrics::MetricType::Counter);
+	metrics::Metric CollectionNanosecondsMetric("llambda_gc_collection_nanoseconds_total", "Time spent in garbage collection", metrics::MetricType::Counter);
+	metrics::Metric AllocatedCellsMetric("llambda_gc_allocated_cells_total", "Cells allocated before being garbage collected", metrics::MetricType::Counter);
+	metrics::Metric ReachableCellsMetric("llambda_gc_reachable_cells_total", "Cells surviving garbage collection", metrics::MetricType::Counter);
 }
 
 void reportGlobalLeaks()
@@ -45,12 +53,6 @@ void reportGlobalLeaks()
 		exit(-1);
 	}
 
-	if (RecordLikeCell::recordDataInstanceCount() != 0)
-	{
-		std::cerr << "Record data instances leaked on exit!" << std::endl;
-		exit(-1);
-	}
-
 	if (actor::Mailbox::instanceCount())
 	{
 		std::cerr << "Actor mailboxes leaked on exit!" << std::endl;
@@ -86,9 +88,17 @@ void conditionalCollection(World &world)
 
 std::size_t forceCollection(World &world)
 {
+	const auto startTime = std::chrono::steady_clock::now();
+	const std::size_t allocatedCells = world.cellHeap.allocationCounter();
+
+	trace::Span collectionSpan(trace::EventType::GarbageCollection, &world);
+
 	// Make a new cell heap
 	Heap nextCellHeap(World::InitialHeapSegmentSize);
 
+	// Sampled cells are about to be moved or finalized
+	world.cellHeap.resolveAllocationSamples();
+
 	// Collect in to the new world
 	const std::size_t reachableCells = collect(world, nextCellHeap);
 
@@ -97,9 +107,9 @@ std::size_t forceCollection(World &world)
 	 * from collection.
 	 */
 #if !defined(_LLIBY_ALWAYS_GC)
-	Finalizer::finalizeHeapAsync(world.cellHeap);
+	Finalizer::finalizeHeapAsync(world.cellHeap, &world);
 #else
-	Finalizer::finalizeHeapSync(world.cellHeap);
+	Finalizer::finalizeHeapSync(world.cellHeap, &world);
 #endif
 
 	// The finalizer should've emptied us
@@ -111,6 +121,15 @@ std::size_t forceCollection(World &world)
 	// We should have zero allocation counter now
 	assert(world.cellHeap.allocationCounter() == 0);
 
+	const auto collectionTime = std::chrono::steady_clock::now() - startTime;
+
+	CollectionsMetric.increment();
+	CollectionNanosecondsMetric.add(std::chrono::duration_cast<std::chrono::nanoseconds>(collectionTime).count());
+	AllocatedCellsMetric.add(allocatedCells);
+	ReachableCellsMetric.add(reachableCells);
+
+	collectionSpan.setArgs(allocatedCells, reachableCells);
+
 	return reachableCells;
 }
 
@@ -13,6 +13,9 @@
 #include "actor/ActorContext.h"
 
 #include "binding/AnyCell.h"
+#include "binding/PairCell.h"
+#include "binding/VectorCell.h"
+#include "binding/RecordLikeCell.h"
 
 #include "dynamic/State.h"
 
@@ -31,8 +34,9 @@ namespace
 	class ForwardingCell : public AnyCell
 	{
 	public:
-		ForwardingCell(AnyCell *newLocation) :
+		ForwardingCell(AnyCell *newLocation, bool childrenPending = false) :
 			AnyCell(CellTypeId::Invalid, GarbageState::ForwardingCell),
+			m_childrenPending(childrenPending),
 			m_newLocation(newLocation)
 		{
 		}
@@ -42,7 +46,21 @@ namespace
 			return m_newLocation;
 		}
 
+		/**
+		 * Returns true if the relocated cell's children haven't been visited yet
+		 *
+		 * This is only true for the first visit to a cell that was relocated ahead of the walker reaching it
+		 */
+		bool takeChildrenPending()
+		{
+			const bool wasPending = m_childrenPending;
+			m_childrenPending = false;
+
+			return wasPending;
+		}
+
 	private:
+		bool m_childrenPending;
 		AnyCell *m_newLocation;
 	};
 }
@@ -66,9 +84,11 @@ std::size_t collect(World &world, Heap &newHeap)
 		else if (gcState == GarbageState::ForwardingCell)
 		{
 			// This has already been moved to the new semi-space
-			// Update the reference and stop visiting
-			*cellRef = static_cast<ForwardingCell*>(oldCellLocation)->newLocation();
-			return false;
+			// Update the reference and stop visiting unless this was moved along with a list spine
+			auto forwardingCell = static_cast<ForwardingCell*>(oldCellLocation);
+
+			*cellRef = forwardingCell->newLocation();
+			return forwardingCell->takeChildrenPending();
 		}
 		else if (gcState == GarbageState::StackAllocatedCell)
 		{
@@ -80,9 +100,63 @@ std::size_t collect(World &world, Heap &newHeap)
 		// It must be HeapAllocatedCell otherwise we have memory corruption
 		assert(gcState == GarbageState::HeapAllocatedCell);
 
+		if (cell_cast<PairCell>(oldCellLocation))
+		{
+			// Move the rest of the list's spine now so it stays contiguous in the new heap. The car values of the
+			// following pairs are visited when the walker reaches each pair through its forwarding cell.
+			AnyCell *oldPairLocation = oldCellLocation;
+			bool childrenPending = false;
+
+			do
+			{
+				AnyCell *nextPairLocation = cell_unchecked_cast<PairCell>(oldPairLocation)->cdr();
+
+				AnyCell *newPairLocation = static_cast<AnyCell*>(newHeap.allocate(1));
+				memcpy(newPairLocation, oldPairLocation, sizeof(AllocCell));
+
+				new (oldPairLocation) ForwardingCell(newPairLocation, childrenPending);
+				childrenPending = true;
+
+				reachableCells++;
+				oldPairLocation = nextPairLocation;
+			}
+			while(cell_cast<PairCell>(oldPairLocation) && (oldPairLocation->gcState() == GarbageState::HeapAllocatedCell));
+
+			*cellRef = static_cast<ForwardingCell*>(oldCellLocation)->newLocation();
+
+			// Visit the first pair's children
+			return true;
+		}
+
+		// Small vectors keep their elements in the cells directly following them; these move as one block
+		std::size_t cellCount = 1;
+		auto vectorCell = cell_cast<VectorCell>(oldCellLocation);
+
+		if (vectorCell && vectorCell->elementsAreInline())
+		{
+			cellCount += VectorCell::inlineStorageCells(vectorCell->length());
+		}
+		else
+		{
+			vectorCell = nullptr;
+		}
+
 		// Move the cell to the new location
-		AnyCell *newCellLocation = static_cast<AnyCell*>(newHeap.allocate(1));
-		memcpy(newCellLocation, oldCellLocation, sizeof(AllocCell));
+		AnyCell *newCellLocation = static_cast<AnyCell*>(newHeap.allocate(cellCount));
+		memcpy(newCellLocation, oldCellLocation, sizeof(AllocCell) * cellCount);
+
+		if (vectorCell)
+		{
+			static_cast<VectorCell*>(newCellLocation)->relocateInlineElements();
+		}
+		else if (auto recordLikeCell = cell_cast<RecordLikeCell>(newCellLocation))
+		{
+			// Out-of-line record data lives in the heap's storage arena; evacuate it along with the cell
+			if (!recordLikeCell->dataIsInline())
+			{
+				recordLikeCell->relocateRecordData(newHeap);
+			}
+		}
 
 		// Update the reference to it
 		*cellRef = newCellLocation;
@@ -10,6 +10,7 @@
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/CharCell.h"
 #include "binding/VectorCell.h"
 #include "binding/BytevectorCell.h"
@@ -35,6 +36,7 @@ static_assert(sizeof(lliby::HeapSymbolCell) <= sizeof(AllocCell), "HeapSymbolCel
 static_assert(sizeof(lliby::BooleanCell) <= sizeof(AllocCell), "BooleanCell does not fit in to a cell");
 static_assert(sizeof(lliby::IntegerCell) <= sizeof(AllocCell), "IntegerCell does not fit in to a cell");
 static_assert(sizeof(lliby::FlonumCell) <= sizeof(AllocCell), "FlonumCell does not fit in to a cell");
+static_assert(sizeof(lliby::RatnumCell) <= sizeof(AllocCell), "RatnumCell does not fit in to a cell");
 static_assert(sizeof(lliby::CharCell) <= sizeof(AllocCell), "CharCell does not fit in to a cell");
 static_assert(sizeof(lliby::VectorCell) <= sizeof(AllocCell), "VectorCell does not fit in to a cell");
 static_assert(sizeof(lliby::BytevectorCell) <= sizeof(AllocCell), "BytevectorCell does not fit in to a cell");
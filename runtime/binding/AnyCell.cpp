@@ -5,6 +5,7 @@
 
 #include "IntegerCell.h"
 #include "FlonumCell.h"
+#include "RatnumCell.h"
 #include "SymbolCell.h"
 #include "ProcedureCell.h"
 #include "PairCell.h"
@@ -106,6 +107,15 @@ bool AnyCell::isEqv(const AnyCell *other) const
 			return thisFlonum->value() == otherFlonum->value();
 		}
 	}
+	else if (auto thisRatnum = cell_cast<RatnumCell>(this))
+	{
+		if (auto otherRatnum = cell_cast<RatnumCell>(other))
+		{
+			// Ratnums are always in lowest terms so their components must match
+			return (thisRatnum->numerator() == otherRatnum->numerator()) &&
+				   (thisRatnum->denominator() == otherRatnum->denominator());
+		}
+	}
 	else if (auto thisSymbol = cell_cast<SymbolCell>(this))
 	{
 		if (auto otherSymbol = cell_cast<SymbolCell>(other))
@@ -279,10 +289,6 @@ void AnyCell::finalize()
 	{
 		thisBytevector->finalizeBytevector();
 	}
-	else if (auto thisRecordLike = cell_cast<RecordLikeCell>(this))
-	{
-		thisRecordLike->finalizeRecordLike();
-	}
 	else if (auto thisPort = cell_cast<PortCell>(this))
 	{
 		thisPort->finalizePort();
@@ -92,6 +92,19 @@ public:
 		return byteArray()->data()[offset];
 	}
 
+	/**
+	 * Returns a pointer to the bytevector's data suitable for modification
+	 *
+	 * This breaks any sharing of the underlying byte array with other bytevectors
+	 */
+	std::uint8_t* writableData()
+	{
+		assert(!isGlobalConstant());
+
+		m_byteArray = m_byteArray->asWritable(length());
+		return byteArray()->data();
+	}
+
 	bool setByteAt(LengthType offset, std::uint8_t value)
 	{
 		assert(!isGlobalConstant());
@@ -7,6 +7,11 @@ namespace lliby
 
 CharCell* CharCell::createInstance(World &world, UnicodeChar unicodeChar)
 {
+	if (CharCell *preconstructed = preconstructedInstance(unicodeChar))
+	{
+		return preconstructed;
+	}
+
 	void *cellPlacement = alloc::allocateCells(world);
 	return new (cellPlacement) CharCell(unicodeChar);
 }
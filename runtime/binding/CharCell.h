@@ -3,6 +3,7 @@
 
 #include "AnyCell.h"
 #include "unicode/UnicodeChar.h"
+#include "core/constinstances.h"
 
 namespace lliby
 {
@@ -12,12 +13,27 @@ class CharCell : public AnyCell
 {
 #include "generated/CharCellMembers.h"
 public:
-	explicit CharCell(UnicodeChar unicodeChar) :
-		AnyCell(CellTypeId::Char),
+	explicit CharCell(UnicodeChar unicodeChar, GarbageState gcState = GarbageState::HeapAllocatedCell) :
+		AnyCell(CellTypeId::Char, gcState),
 		m_unicodeChar(unicodeChar)
 	{
 	}
 
+	/**
+	 * Returns the preconstructed constant cell for a character or nullptr if it has no preconstructed cell
+	 */
+	static CharCell* preconstructedInstance(UnicodeChar unicodeChar)
+	{
+		const UnicodeChar::CodePoint codePoint = unicodeChar.codePoint();
+
+		if ((codePoint >= 0) && (static_cast<std::size_t>(codePoint) < SmallCharCount))
+		{
+			return const_cast<CharCell*>(&llcore_small_char_values[codePoint]);
+		}
+
+		return nullptr;
+	}
+
 	static CharCell* createInstance(World &world, UnicodeChar unicodeChar);
 
 	static CharCell* createInstance(World &world, std::int32_t codePoint)
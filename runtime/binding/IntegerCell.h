@@ -19,11 +19,24 @@ public:
 	{
 	}
 
+	/**
+	 * Returns the preconstructed constant cell for a value or nullptr if the value is out of the preconstructed range
+	 */
+	static IntegerCell* preconstructedInstance(std::int64_t value)
+	{
+		if ((value >= SmallIntegerMinimum) && (value <= SmallIntegerMaximum))
+		{
+			return const_cast<IntegerCell*>(&llcore_small_integer_values[value - SmallIntegerMinimum]);
+		}
+
+		return nullptr;
+	}
+
 	static IntegerCell* fromValue(World &world, std::int64_t value)
 	{
-		if ((value >= 0) && (value < SmallIntegerCount))
+		if (IntegerCell *preconstructed = preconstructedInstance(value))
 		{
-			return const_cast<IntegerCell*>(&llcore_small_integer_values[value]);
+			return preconstructed;
 		}
 
 		void *cellLocation = alloc::allocateCells(world);
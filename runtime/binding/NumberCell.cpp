@@ -1,6 +1,7 @@
 #include "NumberCell.h"
 #include "IntegerCell.h"
 #include "FlonumCell.h"
+#include "RatnumCell.h"
 
 #include <limits>
 #include <cassert>
@@ -16,6 +17,10 @@ namespace
 		{
 			return integer->value();
 		}
+		else if (auto ratnum = cell_cast<const RatnumCell>(value))
+		{
+			return static_cast<T>(ratnum->numerator()) / static_cast<T>(ratnum->denominator());
+		}
 		else
 		{
 			auto flonum = cell_unchecked_cast<const FlonumCell>(value);
@@ -11,4 +11,26 @@ PairCell* PairCell::createInstance(World &world, AnyCell *car, AnyCell *cdr)
 	return new (cellPlacement) PairCell(car, cdr);
 }
 
+const AnyCell* PairCell::advance(const AnyCell *head, std::uint32_t &count)
+{
+	while(count > 0)
+	{
+		auto pair = cell_cast<PairCell>(head);
+
+		if (pair == nullptr)
+		{
+			break;
+		}
+
+		// Skip the entire run and leave through the cdr of its final pair
+		const std::uint32_t runLength = pair->contiguousRunLength(count);
+		auto lastPair = reinterpret_cast<const PairCell*>(reinterpret_cast<const alloc::AllocCell*>(pair) + (runLength - 1));
+
+		head = lastPair->cdr();
+		count -= runLength;
+	}
+
+	return head;
+}
+
 }
@@ -2,6 +2,8 @@
 #define _LLIBY_BINDING_PAIRCELL_H
 
 #include "ListElementCell.h"
+#include "alloc/AllocCell.h"
+
 #include <cassert>
 #include <utility>
 
@@ -31,6 +33,55 @@ public:
 	 */
 	static PairCell* createInstance(World &world, AnyCell *car, AnyCell *cdr);
 
+	/**
+	 * Number of cells ahead to prefetch while walking a contiguous run of pairs
+	 */
+	static const std::uint32_t RunPrefetchDistance = 8;
+
+	/**
+	 * Returns the number of pairs in the contiguous run starting at this pair
+	 *
+	 * A contiguous run is a sequence of pairs where each pair's cdr is the cell immediately following it. The runtime
+	 * builds lists this way whenever it allocates a list at once and the garbage collector preserves it. Each pair's
+	 * membership in the run is proven by the previous pair's cdr but the address of the next pair doesn't depend on
+	 * that load. This lets runs be scanned without the latency of chasing each cdr pointer in turn.
+	 *
+	 * @param  maximum  Maximum run length to return. This must be at least 1.
+	 */
+	std::uint32_t contiguousRunLength(std::uint32_t maximum) const
+	{
+		auto runCells = reinterpret_cast<const alloc::AllocCell*>(this);
+		std::uint32_t length = 1;
+
+		while(length < maximum)
+		{
+			__builtin_prefetch(runCells + length + RunPrefetchDistance);
+
+			auto lastPair = reinterpret_cast<const PairCell*>(runCells + (length - 1));
+
+			if ((lastPair->cdr() != &runCells[length]) || (runCells[length].typeId() != CellTypeId::Pair))
+			{
+				break;
+			}
+
+			length++;
+		}
+
+		return length;
+	}
+
+	/**
+	 * Advances through a list by up to the passed number of pairs
+	 *
+	 * Contiguous runs of pairs are skipped using contiguousRunLength()
+	 *
+	 * @param  head   List element to start from
+	 * @param  count  Number of pairs to advance. On return this is the number of pairs that couldn't be advanced
+	 *                due to reaching the end of the list.
+	 * @return List element reached after advancing
+	 */
+	static const AnyCell* advance(const AnyCell *head, std::uint32_t &count);
+
 	void setCar(AnyCell *obj)
 	{
 		assert(!isGlobalConstant());
@@ -8,6 +8,7 @@
 #include "alloc/RangeAlloc.h"
 
 #include <iterator>
+#include <limits>
 
 namespace lliby
 {
@@ -53,6 +54,9 @@ namespace lliby
 				auto pairHead = cell_unchecked_cast<const PairCell>(m_head);
 				m_head = cell_unchecked_cast<const ListElementCell>(pairHead->cdr());
 
+				// Contiguously allocated lists continue in the following cells; start loading them early
+				__builtin_prefetch(reinterpret_cast<const alloc::AllocCell*>(m_head) + PairCell::RunPrefetchDistance);
+
 				return *this;
 			}
 
@@ -113,7 +117,10 @@ namespace lliby
 			}
 
 			// Calculate it manually
-			return std::distance(begin(), end());
+			std::uint32_t remaining = std::numeric_limits<std::uint32_t>::max();
+			PairCell::advance(this, remaining);
+
+			return std::numeric_limits<std::uint32_t>::max() - remaining;
 		}
 
 		/**
@@ -164,13 +171,17 @@ namespace lliby
 
 			alloc::RangeAlloc allocation = alloc::allocateRange(world, values.size() * 2);
 
-			auto allocIt = allocation.begin();
+			// Place the pairs before the values so the list's spine is a single contiguous run
+			auto pairIt = allocation.begin();
+			auto valueCellIt = allocation.begin();
+			std::advance(valueCellIt, values.size());
+
 			auto valueIt = values.begin();
 			for(auto left = values.size(); left; left--)
 			{
-				void *pairCell = *allocIt++;
-				void *valueCell = *allocIt++;
-				auto cdr = (left == 1) ? EmptyListCell::instance() : static_cast<AnyCell*>(*allocIt);
+				void *pairCell = *pairIt++;
+				void *valueCell = *valueCellIt++;
+				auto cdr = (left == 1) ? EmptyListCell::instance() : static_cast<AnyCell*>(*pairIt);
 
 				new (pairCell) PairCell(new (valueCell) T(*valueIt++), cdr, left);
 			}
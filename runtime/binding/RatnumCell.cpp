@@ -0,0 +1,54 @@
+#include "RatnumCell.h"
+#include "IntegerCell.h"
+
+#include "util/binaryGcd.h"
+
+#include <limits>
+
+namespace lliby
+{
+
+namespace
+{
+	std::uint64_t integerMagnitude(std::int64_t value)
+	{
+		// Negate as unsigned to avoid overflowing on the minimum value
+		return (value < 0) ? (std::uint64_t(0) - static_cast<std::uint64_t>(value)) : static_cast<std::uint64_t>(value);
+	}
+}
+
+NumberCell* RatnumCell::fromFraction(World &world, std::int64_t numerator, std::int64_t denominator)
+{
+	const bool negative = (numerator < 0) != (denominator < 0);
+
+	std::uint64_t numeratorMagnitude = integerMagnitude(numerator);
+	std::uint64_t denominatorMagnitude = integerMagnitude(denominator);
+
+	const std::uint64_t gcd = binaryGcd(numeratorMagnitude, denominatorMagnitude);
+	numeratorMagnitude /= gcd;
+	denominatorMagnitude /= gcd;
+
+	const auto maxMagnitude = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+
+	if ((denominatorMagnitude > maxMagnitude) || (numeratorMagnitude > (maxMagnitude + negative)))
+	{
+		return nullptr;
+	}
+
+	const auto reducedNumerator = static_cast<std::int64_t>(negative ? (0 - numeratorMagnitude) : numeratorMagnitude);
+
+	if (denominatorMagnitude == 1)
+	{
+		return IntegerCell::fromValue(world, reducedNumerator);
+	}
+
+	void *cellPlacement = alloc::allocateCells(world);
+	return new (cellPlacement) RatnumCell(reducedNumerator, denominatorMagnitude);
+}
+
+bool RatnumCell::isReducedFraction(std::int64_t numerator, std::int64_t denominator)
+{
+	return (denominator > 1) && (binaryGcd(integerMagnitude(numerator), denominator) == 1);
+}
+
+}
@@ -0,0 +1,54 @@
+#ifndef _LLIBY_BINDING_RATNUMCELL_H
+#define _LLIBY_BINDING_RATNUMCELL_H
+
+#include "NumberCell.h"
+
+#include "alloc/allocator.h"
+
+namespace lliby
+{
+
+/**
+ * Exact non-integral rational number
+ *
+ * Ratnums are always in lowest terms with a denominator greater than one. Exact fractions that reduce to integers are
+ * represented as IntegerCells instead.
+ */
+class RatnumCell : public NumberCell
+{
+#include "generated/RatnumCellMembers.h"
+public:
+	/**
+	 * Constructs a ratnum directly from its components
+	 *
+	 * The fraction must already be in lowest terms with a denominator greater than one
+	 */
+	RatnumCell(std::int64_t numerator, std::int64_t denominator) :
+		NumberCell(CellTypeId::Ratnum),
+		m_numerator(numerator),
+		m_denominator(denominator)
+	{
+	}
+
+	/**
+	 * Returns the exact number for a fraction
+	 *
+	 * The fraction is reduced to lowest terms and given a positive denominator. If it reduces to an integer an
+	 * IntegerCell is returned instead of a RatnumCell.
+	 *
+	 * @param  world        World to allocate the cell in
+	 * @param  numerator    Numerator of the fraction
+	 * @param  denominator  Denominator of the fraction. This must be non-zero.
+	 * @return Exact number or nullptr if the reduced fraction's components do not fit in 64bit integers
+	 */
+	static NumberCell* fromFraction(World &world, std::int64_t numerator, std::int64_t denominator);
+
+	/**
+	 * Returns true if the passed components are a valid ratnum in lowest terms
+	 */
+	static bool isReducedFraction(std::int64_t numerator, std::int64_t denominator);
+};
+
+}
+
+#endif
@@ -1,9 +1,11 @@
 #include "RecordLikeCell.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <vector>
-#include <atomic>
 
+#include "alloc/AllocCell.h"
+#include "alloc/Heap.h"
 #include "classmap/RecordClassMap.h"
 #include "dynamic/State.h"
 
@@ -14,44 +16,24 @@ namespace
 {
 	const std::uint32_t RuntimeRecordClassFlag = 1 << 31;
 	std::vector<RecordClassMap *> runtimeRecordClassMaps;
-
-#ifdef _LLIBY_CHECK_LEAKS
-	std::atomic<std::size_t> recordDataAllocCount(0);
-#endif
 }
 
-void* RecordLikeCell::allocateRecordData(std::size_t bytes)
+void* RecordLikeCell::allocateRecordData(alloc::Heap &heap, std::size_t bytes)
 {
-#ifdef _LLIBY_CHECK_LEAKS
-	recordDataAllocCount.fetch_add(1, std::memory_order_relaxed);
-#endif
-
-	return malloc(bytes);
+	const std::size_t storageCells = alloc::InlineStorageCell::storageCellsForBytes(bytes);
+	return heap.allocateStorage(storageCells)->data();
 }
 
-void RecordLikeCell::freeRecordData(void *data)
+void RecordLikeCell::relocateRecordData(alloc::Heap &newHeap)
 {
-#ifdef _LLIBY_CHECK_LEAKS
-		recordDataAllocCount.fetch_sub(1, std::memory_order_relaxed);
-#endif
-		free(data);
-}
+	auto oldStorageCell = alloc::InlineStorageCell::fromData(m_recordData);
+	const std::size_t storageCells = oldStorageCell->storageCells();
 
-void RecordLikeCell::finalizeRecordLike()
-{
-	if (!dataIsInline())
-	{
-		freeRecordData(m_recordData);
-	}
-}
+	auto newStorageCell = newHeap.allocateStorage(storageCells);
+	const std::size_t dataBytes = (storageCells * sizeof(alloc::AllocCell)) - alloc::InlineStorageCell::DataOffset;
+	memcpy(newStorageCell->data(), m_recordData, dataBytes);
 
-std::size_t RecordLikeCell::recordDataInstanceCount()
-{
-#ifdef _LLIBY_CHECK_LEAKS
-	return recordDataAllocCount.load(std::memory_order_relaxed);
-#else
-	return 0;
-#endif
+	m_recordData = newStorageCell->data();
 }
 
 const RecordClassMap* RecordLikeCell::classMap() const
@@ -12,6 +12,10 @@ extern "C"
 
 namespace lliby
 {
+namespace alloc
+{
+class Heap;
+}
 
 enum class RecordLikeDataStorage
 {
@@ -26,8 +30,21 @@ class RecordLikeCell : public AnyCell
 public:
 	using RecordClassIdType = decltype(m_recordClassId);
 
-	static void *allocateRecordData(std::size_t bytes);
-	static void freeRecordData(void *);
+	/**
+	 * Allocates out-of-line record data from the passed heap
+	 *
+	 * The data is stored in a run of cells from the heap's storage arena. It's moved along with the record-like cell by
+	 * the garbage collector and released in bulk with the rest of the heap so it doesn't need to be explicitly freed.
+	 * This doesn't disturb any cells reserved by generated code and never triggers a collection.
+	 */
+	static void *allocateRecordData(alloc::Heap &heap, std::size_t bytes);
+
+	/**
+	 * Moves the out-of-line data of a record-like cell in to the passed heap
+	 *
+	 * This is used by the garbage collector after relocating the record-like cell itself
+	 */
+	void relocateRecordData(alloc::Heap &newHeap);
 
 	// Used by the garbage collector to update any references to record data stored inline
 	void** recordDataRef()
@@ -70,8 +87,6 @@ public:
 	const RecordClassMap* classMap() const;
 	RecordLikeDataStorage dataStorage() const;
 
-	void finalizeRecordLike();
-
 	/**
 	 * Registers a runtime-created record-like class
 	 *
@@ -86,17 +101,6 @@ public:
 		m_recordData = newData;
 	}
 
-	/**
-	 * Returns the number of active record data allocations
-	 *
-	 * If leak checking is disabled this always returns 0
-	 *
-	 * This is not synchronized with other threads. For that reason this value is only accurate when there is no
-	 * concurrent instance creation or destruction and any other previously modifying threads have been synchronized
-	 * with through another mechanism.
-	 */
-	static std::size_t recordDataInstanceCount();
-
 	// TypeGenerator.scala always allocates this first
 	static const RecordClassIdType EmptyRecordLikeClassId = 0;
 
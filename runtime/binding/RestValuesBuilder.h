@@ -0,0 +1,159 @@
+#ifndef _LLIBY_BINDING_RESTVALUESBUILDER_H
+#define _LLIBY_BINDING_RESTVALUESBUILDER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#include "ProperList.h"
+#include "EmptyListCell.h"
+#include "PairCell.h"
+#include "IntegerCell.h"
+
+#include "alloc/allocator.h"
+#include "alloc/AllocCell.h"
+#include "alloc/RangeAlloc.h"
+
+namespace lliby
+{
+
+/**
+ * Builds the rest argument lists for procedures applied repeatedly by the runtime
+ *
+ * Procedures such as (map) and (fold) pass one value from each of their input sequences to the applied procedure. The
+ * values after the fixed arguments must be passed as a freshly allocated rest argument list as the procedure may
+ * retain it. Instead of allocating each list individually this allocates the cells for a batch of lists at once and
+ * then carves each list out of the batch. Each list's pairs are contiguous.
+ *
+ * Batches start with a single list and double in size up to MaximumBatchLists. This means callers that stop early,
+ * such as (any), don't pay for lists they never build and callers don't need to measure their inputs up front.
+ *
+ * Every list built by an instance has the same length. An instance should only be used with one of create() or
+ * emplaceValues().
+ */
+class RestValuesBuilder
+{
+public:
+	/**
+	 * Maximum number of lists to allocate cells for at once
+	 */
+	static const std::size_t MaximumBatchLists = 64;
+
+	/**
+	 * Creates a new builder
+	 *
+	 * @param  world         World to allocate the lists in
+	 * @param  listLength    Number of values in each list
+	 * @param  maximumLists  Upper bound on the number of lists to be built if it's already known. Cells won't be
+	 *                       allocated for lists past this bound. Building more lists than this is still allowed.
+	 */
+	RestValuesBuilder(World &world, std::size_t listLength, std::size_t maximumLists = std::numeric_limits<std::size_t>::max()) :
+		m_world(world),
+		m_listLength(listLength),
+		m_remainingLists(maximumLists)
+	{
+	}
+
+	/**
+	 * Returns a new rest argument list containing the passed values
+	 *
+	 * @param  values  Array of listLength values
+	 */
+	template<class T = AnyCell>
+	RestValues<T>* create(T *const *values)
+	{
+		if (m_listLength == 0)
+		{
+			return EmptyListCell::asProperList<T>();
+		}
+
+		alloc::AllocCell *pairCells = takeCells(m_listLength);
+
+		for(std::size_t i = 0; i < m_listLength; i++)
+		{
+			buildPair(pairCells, i, values[i]);
+		}
+
+		return reinterpret_cast<RestValues<T>*>(pairCells);
+	}
+
+	/**
+	 * Returns a new rest argument list containing new cells constructed from the passed values
+	 *
+	 * This is analogous to ProperList::emplaceValues()
+	 *
+	 * @param  values  Array of listLength values to pass to the constructor of T
+	 */
+	template<class T, typename V>
+	RestValues<T>* emplaceValues(const V *values)
+	{
+		if (m_listLength == 0)
+		{
+			return EmptyListCell::asProperList<T>();
+		}
+
+		// The value cells follow all of the pairs
+		alloc::AllocCell *pairCells = takeCells(m_listLength * 2);
+		alloc::AllocCell *valueCells = pairCells + m_listLength;
+
+		for(std::size_t i = 0; i < m_listLength; i++)
+		{
+			buildPair(pairCells, i, new (&valueCells[i]) T(values[i]));
+		}
+
+		return reinterpret_cast<RestValues<T>*>(pairCells);
+	}
+
+private:
+	void buildPair(alloc::AllocCell *pairCells, std::size_t index, AnyCell *car)
+	{
+		const std::size_t tailLength = m_listLength - index;
+		AnyCell *cdr = (tailLength == 1) ? static_cast<AnyCell*>(EmptyListCell::instance()) : &pairCells[index + 1];
+
+		new (&pairCells[index]) PairCell(car, cdr, tailLength);
+	}
+
+	alloc::AllocCell* takeCells(std::size_t count)
+	{
+		if (m_nextCell == m_endCell)
+		{
+			const std::size_t batchLists = std::min(m_nextBatchLists, std::max<std::size_t>(m_remainingLists, 1));
+
+			m_nextCell = alloc::allocateCells(m_world, batchLists * count);
+			m_endCell = m_nextCell + (batchLists * count);
+
+			// Stub the entire batch so the heap can be safely collected or finalised before every list is built. This
+			// can't be deferred to a destructor as errors can unwind past us without running destructors.
+			for(void *placement : alloc::RangeAlloc(m_nextCell, m_endCell))
+			{
+				new (placement) IntegerCell(0);
+			}
+
+			// Copy to a local so std::min() doesn't require an out-of-line definition
+			const std::size_t maximumBatchLists = MaximumBatchLists;
+			m_nextBatchLists = std::min(m_nextBatchLists * 2, maximumBatchLists);
+		}
+
+		if (m_remainingLists > 0)
+		{
+			m_remainingLists--;
+		}
+
+		alloc::AllocCell *cells = m_nextCell;
+		m_nextCell += count;
+
+		return cells;
+	}
+
+	World &m_world;
+	std::size_t m_listLength;
+	std::size_t m_remainingLists;
+	std::size_t m_nextBatchLists = 1;
+
+	alloc::AllocCell *m_nextCell = nullptr;
+	alloc::AllocCell *m_endCell = nullptr;
+};
+
+}
+
+#endif
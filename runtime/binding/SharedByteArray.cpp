@@ -1,6 +1,7 @@
 #include "SharedByteArray.h"
 
 #include "platform/memory.h"
+#include "metrics/Metric.h"
 
 #include <cstring>
 #include <cassert>
@@ -15,6 +16,8 @@ namespace
 	std::atomic<std::size_t> allocationCount(0);
 #endif
 
+	metrics::Metric InstancesMetric("llambda_shared_byte_arrays", "Live shared byte arrays backing strings, symbols and bytevectors", metrics::MetricType::Gauge);
+
 	std::size_t objectSizeForBytes(std::size_t bytes)
 	{
 		return sizeof(SharedByteArray) + bytes;
@@ -135,18 +138,26 @@ bool SharedByteArray::unref()
 	return false;
 }
 
-#ifdef _LLIBY_CHECK_LEAKS
-
 SharedByteArray::~SharedByteArray()
 {
+	InstancesMetric.decrement();
+
+#ifdef _LLIBY_CHECK_LEAKS
 	allocationCount.fetch_sub(1, std::memory_order_relaxed);
+#endif
 }
 
 void SharedByteArray::incrementInstanceCount()
 {
+	InstancesMetric.increment();
+
+#ifdef _LLIBY_CHECK_LEAKS
 	allocationCount.fetch_add(1, std::memory_order_relaxed);
+#endif
 }
 
+#ifdef _LLIBY_CHECK_LEAKS
+
 std::size_t SharedByteArray::instanceCount()
 {
 	return allocationCount.load(std::memory_order_relaxed);
@@ -154,10 +165,6 @@ std::size_t SharedByteArray::instanceCount()
 
 #else
 
-void SharedByteArray::incrementInstanceCount()
-{
-}
-
 std::size_t SharedByteArray::instanceCount()
 {
 	return 0;
@@ -183,9 +183,7 @@ private:
 
 	void incrementInstanceCount();
 
-#ifdef _LLIBY_CHECK_LEAKS
 	~SharedByteArray();
-#endif
 
 	std::atomic<RefCountType> m_refCount;
 	mutable HashValueType m_cachedHashValue;
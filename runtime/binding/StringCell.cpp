@@ -22,8 +22,11 @@ namespace lliby
 
 StringCell* StringCell::createUninitialised(World &world, ByteLengthType byteLength, CharLengthType charLength)
 {
-	void *cellPlacement = alloc::allocateCells(world);
+	return createUninitialised(alloc::allocateCells(world), byteLength, charLength);
+}
 
+StringCell* StringCell::createUninitialised(void *cellPlacement, ByteLengthType byteLength, CharLengthType charLength)
+{
 	if (byteLength <= inlineDataSize())
 	{
 		// We can fit this string inline
@@ -103,6 +106,17 @@ StringCell* StringCell::fromUtf8Data(World &world, const std::uint8_t *data, Byt
 	return StringCell::fromValidatedUtf8Data(world, data, byteLength, charLength);
 }
 
+StringCell* StringCell::fromUtf8Data(void *cellPlacement, const std::uint8_t *data, ByteLengthType byteLength)
+{
+	// Find the character length before touching the placement - this can throw an exception
+	std::size_t charLength = utf8::validateData(data, data + byteLength);
+
+	auto newString = StringCell::createUninitialised(cellPlacement, byteLength, charLength);
+	memcpy(newString->utf8Data(), data, byteLength);
+
+	return newString;
+}
+
 StringCell* StringCell::fromFill(World &world, CharLengthType length, UnicodeChar fill)
 {
 	// Figure out how many bytes we'll need
@@ -49,8 +49,33 @@ public:
 	static StringCell* fromUtf8StdString(World &world, const std::string &str);
 
 	static StringCell* fromUtf8Data(World &world, const std::uint8_t *data, ByteLengthType byteLength);
+
+	/**
+	 * Creates a new string from UTF-8 data in an already allocated cell
+	 *
+	 * The data is validated before the cell is constructed. If the data is invalid then
+	 * utf8::InvalidByteSequenceException is thrown and the cell placement is left untouched.
+	 */
+	static StringCell* fromUtf8Data(void *cellPlacement, const std::uint8_t *data, ByteLengthType byteLength);
+
 	static StringCell* fromValidatedUtf8Data(World &world, const std::uint8_t *data, ByteLengthType byteLength, CharLengthType charLength);
 
+	/**
+	 * Creates a new string by writing ASCII directly in to its storage
+	 *
+	 * @param  byteLength  Length of the string in bytes and characters
+	 * @param  writer      Function passed a char* to write exactly byteLength ASCII bytes to. This must not allocate
+	 *                     cells.
+	 */
+	template<typename F>
+	static StringCell* fromAsciiWriter(World &world, ByteLengthType byteLength, F writer)
+	{
+		StringCell *newString = createUninitialised(world, byteLength, byteLength);
+		writer(reinterpret_cast<char*>(newString->utf8Data()));
+
+		return newString;
+	}
+
 	/**
 	 * Creates a StringCell using a SharedByteArray
 	 *
@@ -142,6 +167,7 @@ protected:
 
 	// Creates an uninitialized cell with the given size
 	static StringCell* createUninitialised(World &world, ByteLengthType byteLength, CharLengthType charLength);
+	static StringCell* createUninitialised(void *cellPlacement, ByteLengthType byteLength, CharLengthType charLength);
 
 	const std::uint8_t *charPointer(CharLengthType charOffset, const std::uint8_t *startFrom, ByteLengthType startOffset);
 	const std::uint8_t *charPointer(CharLengthType charOffset);
@@ -38,14 +38,21 @@ SymbolCell* SymbolCell::fromUtf8StdString(World &world, const std::string &str)
 
 SymbolCell* SymbolCell::fromUtf8Data(World &world, const std::uint8_t *data, ByteLengthType byteLength)
 {
-	const std::uint8_t *scanPtr = data;
-	const std::uint8_t *endPtr = data + byteLength;
+	// Validate the UTF-8 data before allocating
+	const std::size_t charLength = utf8::validateData(data, data + byteLength);
 
-	// Validate the UTF-8 data
-	const std::size_t charLength = utf8::validateData(scanPtr, endPtr);
+	return fromValidatedUtf8Data(alloc::allocateCells(world), data, byteLength, charLength);
+}
 
-	void *cellPlacement = alloc::allocateCells(world);
+SymbolCell* SymbolCell::fromUtf8Data(void *cellPlacement, const std::uint8_t *data, ByteLengthType byteLength)
+{
+	const std::size_t charLength = utf8::validateData(data, data + byteLength);
 
+	return fromValidatedUtf8Data(cellPlacement, data, byteLength, charLength);
+}
+
+SymbolCell* SymbolCell::fromValidatedUtf8Data(void *cellPlacement, const std::uint8_t *data, ByteLengthType byteLength, std::size_t charLength)
+{
 	if (byteLength <= inlineDataSize())
 	{
 		auto inlineSymbol = new (cellPlacement) InlineSymbolCell(byteLength, charLength);
@@ -40,6 +40,14 @@ public:
 	 */
 	static SymbolCell* fromUtf8Data(World &world, const std::uint8_t *data, ByteLengthType byteLength);
 
+	/**
+	 * Creates a new symbol from raw UTF-8 data in an already allocated cell
+	 *
+	 * The data is validated before the cell is constructed. If the data is invalid then
+	 * utf8::InvalidByteSequenceException is thrown and the cell placement is left untouched.
+	 */
+	static SymbolCell* fromUtf8Data(void *cellPlacement, const std::uint8_t *data, ByteLengthType byteLength);
+
 	/**
 	 * Creates a new symbol from a string
 	 */
@@ -92,6 +100,8 @@ protected:
 	{
 	}
 
+	static SymbolCell* fromValidatedUtf8Data(void *cellPlacement, const std::uint8_t *data, ByteLengthType byteLength, std::size_t charLength);
+
 	static std::size_t inlineDataSize();
 	bool dataIsInline() const;
 };
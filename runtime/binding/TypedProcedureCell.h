@@ -5,10 +5,10 @@
 #include "ProperList.h"
 
 #include "alloc/allocator.h"
+#include "dynamic/NativeApplyScope.h"
 
 namespace lliby
 {
-class World;
 
 /**
  * ProcedureCell with an explicitly known type
@@ -56,6 +56,8 @@ public:
 	R apply(World &world, Args... args)
 	{
 		auto castEntryPoint = reinterpret_cast<TypedEntryPoint>(entryPoint());
+
+		dynamic::NativeApplyScope applyScope(world);
 		return castEntryPoint(world, this, args...);
 	}
 
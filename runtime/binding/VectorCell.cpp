@@ -5,6 +5,10 @@
 #include <string.h>
 
 #include "alloc/allocator.h"
+#include "alloc/AllocCell.h"
+#include "alloc/Heap.h"
+
+#include "core/World.h"
 
 #include "util/adjustSlice.h"
 
@@ -34,8 +38,18 @@ VectorCell* VectorCell::fromElements(World &world, AnyCell **elements, LengthTyp
 	return new (cellPlacement) VectorCell(elements, length);
 }
 
-VectorCell* VectorCell::fromFill(World &world, LengthType length, AnyCell *fill)
+VectorCell* VectorCell::createUninitialised(alloc::Heap &heap, LengthType length)
 {
+	if (length <= MaximumInlineLength)
+	{
+		// Allocate our storage in the same range as the vector cell
+		const std::size_t storageCells = inlineStorageCells(length);
+		auto placement = static_cast<alloc::AllocCell*>(heap.allocate(1 + storageCells));
+
+		auto storageCell = new (placement + 1) alloc::InlineStorageCell(storageCells);
+		return new (placement) VectorCell(static_cast<AnyCell**>(storageCell->data()), length);
+	}
+
 	AnyCell **newElements;
 
 	try
@@ -47,8 +61,23 @@ VectorCell* VectorCell::fromFill(World &world, LengthType length, AnyCell *fill)
 		return nullptr;
 	}
 
-	void *cellPlacement = alloc::allocateCells(world);
-	auto newVector = new (cellPlacement) VectorCell(newElements, length);
+	void *cellPlacement = heap.allocate();
+	return new (cellPlacement) VectorCell(newElements, length);
+}
+
+VectorCell* VectorCell::createUninitialised(World &world, LengthType length)
+{
+	return createUninitialised(world.cellHeap, length);
+}
+
+VectorCell* VectorCell::fromFill(World &world, LengthType length, AnyCell *fill)
+{
+	auto newVector = createUninitialised(world, length);
+
+	if (newVector == nullptr)
+	{
+		return nullptr;
+	}
 
 	if (fill == nullptr)
 	{
@@ -74,8 +103,14 @@ VectorCell* VectorCell::fromAppended(World &world, const std::vector<const Vecto
 		return nullptr;
 	}
 
-	auto newElements = new AnyCell*[totalLength];
-	AnyCell **copyPtr = newElements;
+	auto newVector = createUninitialised(world, totalLength);
+
+	if (newVector == nullptr)
+	{
+		return nullptr;
+	}
+
+	AnyCell **copyPtr = newVector->elements();
 
 	for(auto vector : vectors)
 	{
@@ -85,8 +120,7 @@ VectorCell* VectorCell::fromAppended(World &world, const std::vector<const Vecto
 		copyPtr += vector->length();
 	}
 
-	void *cellPlacement = alloc::allocateCells(world);
-	return new (cellPlacement) VectorCell(newElements, totalLength);
+	return newVector;
 }
 
 VectorCell* VectorCell::copy(World &world, SliceIndexType start, SliceIndexType end)
@@ -97,12 +131,16 @@ VectorCell* VectorCell::copy(World &world, SliceIndexType start, SliceIndexType
 	}
 
 	LengthType newLength = end - start;
-	auto newElements = new AnyCell*[newLength];
+	auto newVector = createUninitialised(world, newLength);
 
-	memcpy(newElements, &elements()[start], newLength * sizeof(AnyCell*));
+	if (newVector == nullptr)
+	{
+		return nullptr;
+	}
 
-	void *cellPlacement = alloc::allocateCells(world);
-	return new (cellPlacement) VectorCell(newElements, newLength);
+	memcpy(newVector->elements(), &elements()[start], newLength * sizeof(AnyCell*));
+
+	return newVector;
 }
 
 bool VectorCell::replace(SliceIndexType offset, const VectorCell *from, SliceIndexType fromStart, SliceIndexType fromEnd)
@@ -127,7 +165,10 @@ bool VectorCell::replace(SliceIndexType offset, const VectorCell *from, SliceInd
 
 void VectorCell::finalizeVector()
 {
-	delete[] m_elements;
+	if (!elementsAreInline())
+	{
+		delete[] m_elements;
+	}
 }
 
 }
@@ -2,6 +2,7 @@
 #define _LLIBY_BINDING_VECTORCELL_H
 
 #include "AnyCell.h"
+#include "alloc/AllocCell.h"
 
 #include <vector>
 #include <limits>
@@ -10,6 +11,10 @@
 
 namespace lliby
 {
+namespace alloc
+{
+class Heap;
+}
 
 class VectorCell : public AnyCell
 {
@@ -57,6 +62,49 @@ public:
 		return true;
 	}
 
+	/**
+	 * Maximum length of vectors that store their elements inline in the cell heap
+	 */
+	static const LengthType MaximumInlineLength = 16;
+
+	/**
+	 * Creates a new vector with uninitialised elements
+	 *
+	 * Vectors of up to MaximumInlineLength elements store their elements in cells directly following the vector cell.
+	 * This avoids a separate allocation and keeps the elements next to the vector. Longer vectors allocate their
+	 * elements with new[].
+	 *
+	 * If the required memory cannot be allocated then nullptr is returned
+	 */
+	static VectorCell* createUninitialised(alloc::Heap &heap, LengthType length);
+	static VectorCell* createUninitialised(World &world, LengthType length);
+
+	/**
+	 * Returns the number of heap cells used to store the elements of an inline vector of the passed length
+	 */
+	static std::size_t inlineStorageCells(LengthType length)
+	{
+		return alloc::InlineStorageCell::storageCellsForBytes(length * sizeof(AnyCell*));
+	}
+
+	/**
+	 * Returns true if this vector's elements are stored inline following the vector cell
+	 *
+	 * This is only meaningful for heap allocated vectors
+	 */
+	bool elementsAreInline() const
+	{
+		return m_elements == inlineElements();
+	}
+
+	/**
+	 * Points the vector at its inline elements after the garbage collector has moved it with its storage
+	 */
+	void relocateInlineElements()
+	{
+		m_elements = inlineElements();
+	}
+
 	/**
 	 * Constructs a vector cell from the passed array of elements
 	 *
@@ -79,6 +127,14 @@ public:
 	bool fill(AnyCell *fill, SliceIndexType start = 0, SliceIndexType end = -1);
 
 	void finalizeVector();
+
+private:
+	AnyCell **inlineElements() const
+	{
+		// Our storage run starts in the cell directly following us
+		const std::uintptr_t storageCell = reinterpret_cast<std::uintptr_t>(this) + sizeof(alloc::AllocCell);
+		return reinterpret_cast<AnyCell**>(storageCell + alloc::InlineStorageCell::DataOffset);
+	}
 };
 
 }
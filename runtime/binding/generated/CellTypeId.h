@@ -21,16 +21,17 @@ enum class CellTypeId : std::uint8_t
 	Boolean = 6,
 	Integer = 7,
 	Flonum = 8,
-	Char = 9,
-	Vector = 10,
-	Bytevector = 11,
-	Procedure = 12,
-	Record = 13,
-	ErrorObject = 14,
-	Port = 15,
-	EofObject = 16,
-	Mailbox = 17,
-	HashMap = 18,
+	Ratnum = 9,
+	Char = 10,
+	Vector = 11,
+	Bytevector = 12,
+	Procedure = 13,
+	Record = 14,
+	ErrorObject = 15,
+	Port = 16,
+	EofObject = 17,
+	Mailbox = 18,
+	HashMap = 19,
 };
 
 }
@@ -45,6 +45,8 @@ const char *schemeNameForErrorCategory(ErrorCategory category)
 		return "ask-timeout-error";
 	case ErrorCategory::Match:
 		return "match-error";
+	case ErrorCategory::MailboxFull:
+		return "mailbox-full-error";
 	}
 }
 
@@ -0,0 +1,29 @@
+/************************************************************
+ * This file is generated by typegen. Do not edit manually. *
+ ************************************************************/
+
+public:
+	std::int64_t numerator() const
+	{
+		return m_numerator;
+	}
+
+	std::int64_t denominator() const
+	{
+		return m_denominator;
+	}
+
+public:
+	static bool typeIdIsTypeOrSubtype(CellTypeId typeId)
+	{
+		return typeId == CellTypeId::Ratnum;
+	}
+
+	static bool isInstance(const AnyCell *cell)
+	{
+		return typeIdIsTypeOrSubtype(cell->typeId());
+	}
+
+private:
+	std::int64_t m_numerator;
+	std::int64_t m_denominator;
@@ -24,6 +24,7 @@ class BooleanCell;
 class NumberCell;
 class IntegerCell;
 class FlonumCell;
+class RatnumCell;
 class CharCell;
 class VectorCell;
 class BytevectorCell;
@@ -12,17 +12,13 @@
 
 using namespace lliby;
 
-namespace
-{
-	dynamic::State sharedRootState(nullptr);
-}
-
 namespace lliby
 {
 
 World::World() :
 	cellHeap(InitialHeapSegmentSize),
-	m_activeState(&sharedRootState)
+	m_rootState(new dynamic::State(nullptr)),
+	m_activeState(m_rootState.get())
 {
 }
 
@@ -46,12 +42,17 @@ World::~World()
 		}
 	}
 
+	// Leave any dynamic states left active by an exception so they no longer root their saved values
+	dynamic::State::popUntilState(*this, m_rootState.get());
+
 #ifdef _LLIBY_CHECK_LEAKS
 	if (alloc::forceCollection(*this) > 0)
 	{
 		fatalError("Cells leaked from world on exit");
 	}
 #endif
+
+	dynamic::State::releaseFreeStates(*this);
 }
 
 void World::addChildActor(const std::weak_ptr<actor::Mailbox> &childActor)
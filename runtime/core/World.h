@@ -3,6 +3,7 @@
 
 #include "alloc/Heap.h"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -18,6 +19,7 @@ class Mailbox;
 namespace dynamic
 {
 class State;
+struct GuardFrame;
 }
 
 class World
@@ -66,6 +68,49 @@ public: // Normal C++ API
 		m_activeState = state;
 	}
 
+	/**
+	 * Returns the first state on the world's list of popped dynamic states available for reuse
+	 *
+	 * This is intended for use by dynamic::State
+	 */
+	dynamic::State* freeStates()
+	{
+		return m_freeStates;
+	}
+
+	void setFreeStates(dynamic::State *state)
+	{
+		m_freeStates = state;
+	}
+
+	/**
+	 * Returns the number of native frames currently applying a Scheme procedure in this world
+	 *
+	 * This is maintained by dynamic::NativeApplyScope
+	 */
+	std::uint32_t nativeApplyDepth() const
+	{
+		return m_nativeApplyDepth;
+	}
+
+	void setNativeApplyDepth(std::uint32_t depth)
+	{
+		m_nativeApplyDepth = depth;
+	}
+
+	/**
+	 * Returns the innermost (guard) that can be escaped to without unwinding or nullptr if none exists
+	 */
+	dynamic::GuardFrame* innermostGuard()
+	{
+		return m_innermostGuard;
+	}
+
+	void setInnermostGuard(dynamic::GuardFrame *guardFrame)
+	{
+		m_innermostGuard = guardFrame;
+	}
+
 	/**
 	 * Sets the world's actor context
 	 *
@@ -92,7 +137,12 @@ public: // Normal C++ API
 	void addChildActor(const std::weak_ptr<actor::Mailbox> &childActor);
 
 private:
+	std::unique_ptr<dynamic::State> m_rootState;
 	dynamic::State *m_activeState;
+	dynamic::State *m_freeStates = nullptr;
+
+	std::uint32_t m_nativeApplyDepth = 0;
+	dynamic::GuardFrame *m_innermostGuard = nullptr;
 
 	actor::ActorContext *m_actorContext = nullptr;
 	std::vector<std::weak_ptr<actor::Mailbox>> m_childActors;
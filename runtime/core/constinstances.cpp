@@ -5,13 +5,31 @@
 #include "binding/EmptyListCell.h"
 #include "binding/EofObjectCell.h"
 #include "binding/IntegerCell.h"
+#include "binding/CharCell.h"
 #include "alloc/GarbageState.h"
 
-extern "C"
-{
+#include <utility>
 
 using namespace lliby;
 
+namespace
+{
+	template<std::size_t... Offsets>
+	std::array<IntegerCell, sizeof...(Offsets)> makeSmallIntegerValues(std::index_sequence<Offsets...>)
+	{
+		return {{IntegerCell(SmallIntegerMinimum + static_cast<std::int64_t>(Offsets), GarbageState::GlobalConstant)...}};
+	}
+
+	template<std::size_t... CodePoints>
+	std::array<CharCell, sizeof...(CodePoints)> makeSmallCharValues(std::index_sequence<CodePoints...>)
+	{
+		return {{CharCell(UnicodeChar(CodePoints), GarbageState::GlobalConstant)...}};
+	}
+}
+
+extern "C"
+{
+
 // These are constant values that must be referenced through these preconstructed instances. This provides two benefits:
 // 1) They can be tested for equality without dereferencing their pointer. Dereferencing still works as expected but
 //    this can be used as an optimisation
@@ -22,23 +40,10 @@ const BooleanCell llcore_true_value;
 const EmptyListCell llcore_empty_list_value;
 const EofObjectCell llcore_eof_object_value;
 
-const IntegerCell llcore_small_integer_values[SmallIntegerCount] = {
-	IntegerCell(0, GarbageState::GlobalConstant),
-	IntegerCell(1, GarbageState::GlobalConstant),
-	IntegerCell(2, GarbageState::GlobalConstant),
-	IntegerCell(3, GarbageState::GlobalConstant),
-	IntegerCell(4, GarbageState::GlobalConstant),
-	IntegerCell(5, GarbageState::GlobalConstant),
-	IntegerCell(6, GarbageState::GlobalConstant),
-	IntegerCell(7, GarbageState::GlobalConstant),
-	IntegerCell(8, GarbageState::GlobalConstant),
-	IntegerCell(9, GarbageState::GlobalConstant),
-	IntegerCell(10, GarbageState::GlobalConstant),
-	IntegerCell(11, GarbageState::GlobalConstant),
-	IntegerCell(12, GarbageState::GlobalConstant),
-	IntegerCell(13, GarbageState::GlobalConstant),
-	IntegerCell(14, GarbageState::GlobalConstant),
-	IntegerCell(15, GarbageState::GlobalConstant),
-};
+const std::array<IntegerCell, SmallIntegerCount> llcore_small_integer_values =
+	makeSmallIntegerValues(std::make_index_sequence<SmallIntegerCount>());
+
+const std::array<CharCell, SmallCharCount> llcore_small_char_values =
+	makeSmallCharValues(std::make_index_sequence<SmallCharCount>());
 
 }
@@ -1,7 +1,9 @@
 #ifndef _LLIBY_CORE_CONSTINSTANCES_H
 #define _LLIBY_CORE_CONSTINSTANCES_H
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 
 namespace lliby
 {
@@ -10,19 +12,36 @@ namespace lliby
 	class EmptyListCell;
 	class EofObjectCell;
 	class IntegerCell;
+	class CharCell;
 }
 
 extern "C"
 {
 
-static const std::size_t SmallIntegerCount = 16;
+/**
+ * Range of integers with preconstructed cells
+ *
+ * Boxing a value in this range returns a shared constant cell instead of allocating. Boxed values are always cell
+ * pointers; values outside of these ranges are allocated on the heap as usual.
+ */
+static const std::int64_t SmallIntegerMinimum = -128;
+static const std::int64_t SmallIntegerMaximum = 1023;
+static const std::size_t SmallIntegerCount = SmallIntegerMaximum - SmallIntegerMinimum + 1;
+
+/**
+ * Number of characters with preconstructed cells starting from U+0000
+ *
+ * This covers all of Latin-1
+ */
+static const std::size_t SmallCharCount = 256;
 
 extern const lliby::UnitCell llcore_unit_value;
 extern const lliby::BooleanCell llcore_false_value;
 extern const lliby::BooleanCell llcore_true_value;
 extern const lliby::EmptyListCell llcore_empty_list_value;
 extern const lliby::EofObjectCell llcore_eof_object_value;
-extern const lliby::IntegerCell llcore_small_integer_values[SmallIntegerCount];
+extern const std::array<lliby::IntegerCell, SmallIntegerCount> llcore_small_integer_values;
+extern const std::array<lliby::CharCell, SmallCharCount> llcore_small_char_values;
 
 }
 
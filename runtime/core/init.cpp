@@ -5,9 +5,13 @@
 #include "core/error.h"
 #include "alloc/allocator.h"
 #include "alloc/MemoryBlock.h"
+#include "alloc/AllocationSampler.h"
 
 #include "dynamic/SchemeException.h"
 
+#include "metrics/dump.h"
+#include "trace/Trace.h"
+
 namespace lliby
 {
 namespace
@@ -32,6 +36,9 @@ void llcore_run(void (*entryPoint)(lliby::World &), int argc, char **argv, bool
 	initArguments = {argc, argv};
 
 	dynamic::init();
+	metrics::initDumping();
+	trace::initTracing();
+	alloc::AllocationSampler::init();
 
 	{
 		// Make sure the world is alive for the exception handler
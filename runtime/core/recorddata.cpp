@@ -2,15 +2,16 @@
 #include <cstdint>
 
 #include "binding/RecordLikeCell.h"
+#include "core/World.h"
 
 extern "C"
 {
 
 using namespace lliby;
 
-void *llcore_record_data_alloc(std::uint32_t size)
+void *llcore_record_data_alloc(World *world, std::uint32_t size)
 {
-	return RecordLikeCell::allocateRecordData(size);
+	return RecordLikeCell::allocateRecordData(world->cellHeap, size);
 }
 
 }
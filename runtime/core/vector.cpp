@@ -13,19 +13,14 @@ VectorCell* llcore_vector_alloc(World &world, std::int64_t length)
 {
 	assertLengthValid(world, "(make-vector)", "vector length", VectorCell::maximumLength(), length);
 
-	AnyCell **elements;
+	VectorCell *newVector = VectorCell::createUninitialised(world, length);
 
-	try
-	{
-		elements = new AnyCell*[length];
-	}
-	catch(std::bad_alloc &)
+	if (newVector == nullptr)
 	{
 		signalError(world, ErrorCategory::OutOfMemory, "Out of memory while constructing vector");
 	}
 
-	void *cellPlacement = alloc::allocateCells(world);
-	return new (cellPlacement) VectorCell(elements, length);
+	return newVector;
 }
 
 }
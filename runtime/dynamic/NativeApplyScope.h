@@ -0,0 +1,41 @@
+#ifndef _LLIBY_DYNAMIC_NATIVEAPPLYSCOPE_H
+#define _LLIBY_DYNAMIC_NATIVEAPPLYSCOPE_H
+
+#include "core/World.h"
+
+namespace lliby
+{
+namespace dynamic
+{
+
+/**
+ * Marks a native frame as applying a Scheme procedure for the lifetime of the scope
+ *
+ * Native frames may hold resources that need to be released by C++ unwinding. Counting them allows raise() to tell if
+ * the innermost (guard) can be reached by jumping directly to it instead.
+ */
+class NativeApplyScope
+{
+public:
+	explicit NativeApplyScope(World &world) :
+		m_world(world)
+	{
+		m_world.setNativeApplyDepth(m_world.nativeApplyDepth() + 1);
+	}
+
+	~NativeApplyScope()
+	{
+		m_world.setNativeApplyDepth(m_world.nativeApplyDepth() - 1);
+	}
+
+	NativeApplyScope(const NativeApplyScope &) = delete;
+	NativeApplyScope &operator=(const NativeApplyScope &) = delete;
+
+private:
+	World &m_world;
+};
+
+}
+}
+
+#endif
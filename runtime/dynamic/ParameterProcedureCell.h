@@ -29,15 +29,25 @@ public:
 	static ParameterProcedureCell *createInstance(World &world, AnyCell *initialValue);
 
 	/**
-	 * Returns the initial value for this parameter
+	 * Returns the current value for this parameter
 	 *
-	 * This is used whenever the parameter hasn't explicitly been parameterized
+	 * This is the initial value unless the parameter is being parameterized by the world's active dynamic state
 	 */
-	AnyCell* initialValue() const
+	AnyCell* value() const
 	{
 		return static_cast<AnyCell*>(recordData());
 	}
 
+	/**
+	 * Sets the current value for this parameter
+	 *
+	 * This is intended for use by dynamic::State
+	 */
+	void setValue(AnyCell *newValue)
+	{
+		setRecordData(newValue);
+	}
+
 	/**
 	 * Returns true if the passed cell is a ParameterProcedureCell
 	 */
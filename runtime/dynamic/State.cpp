@@ -1,5 +1,7 @@
 #include "dynamic/State.h"
 
+#include <cassert>
+
 #include "core/World.h"
 #include "core/error.h"
 #include "dynamic/ParameterProcedureCell.h"
@@ -19,25 +21,15 @@ State::State(State *parent) :
 
 AnyCell* State::valueForParameter(ParameterProcedureCell *param) const
 {
-	ParameterValueMap::const_iterator valueIt = m_selfValues.find(param);
-
-	if (valueIt != m_selfValues.end())
-	{
-		return valueIt->second;
-	}
-	else if (m_parent)
-	{
-		return m_parent->valueForParameter(param);
-	}
-	else
-	{
-		return param->initialValue();
-	}
+	return param->value();
 }
 
 void State::setValueForParameter(World &world, ParameterProcedureCell *param, AnyCell *value)
 {
-	m_selfValues[param] = value;
+	assert(world.activeState() == this);
+
+	m_savedValues.push_back({param, param->value()});
+	param->setValue(value);
 }
 
 State* State::activeState(World &world)
@@ -47,17 +39,41 @@ State* State::activeState(World &world)
 
 void State::pushActiveState(World &world)
 {
-	// Create a state and associate it with the dynamic state
-	world.setActiveState(new State(world.activeState()));
+	State *newState = world.freeStates();
+
+	if (newState != nullptr)
+	{
+		// Reuse a popped state. Free states are linked through their parent pointer.
+		world.setFreeStates(newState->m_parent);
+		newState->m_parent = world.activeState();
+	}
+	else
+	{
+		newState = new State(world.activeState());
+	}
+
+	world.setActiveState(newState);
 }
 
 void State::popActiveState(World &world)
 {
 	State *oldActiveState = world.activeState();
 
-	// Make the old state active and reference it
+	// Restore in reverse order in case the same parameter was set multiple times
+	SavedValueList &savedValues = oldActiveState->m_savedValues;
+
+	for(auto it = savedValues.rbegin(); it != savedValues.rend(); it++)
+	{
+		it->parameterProc->setValue(it->value);
+	}
+
+	// This keeps the capacity of the list for the next push
+	savedValues.clear();
+
 	world.setActiveState(oldActiveState->parent());
-	delete oldActiveState;
+
+	oldActiveState->m_parent = world.freeStates();
+	world.setFreeStates(oldActiveState);
 }
 
 void State::popUntilState(World &world, State *targetState)
@@ -66,7 +82,21 @@ void State::popUntilState(World &world, State *targetState)
 	{
 		popActiveState(world);
 	}
+}
+
+void State::releaseFreeStates(World &world)
+{
+	State *freeState = world.freeStates();
+
+	while(freeState != nullptr)
+	{
+		State *nextFreeState = freeState->m_parent;
+		delete freeState;
+
+		freeState = nextFreeState;
+	}
 
+	world.setFreeStates(nullptr);
 }
 
 }
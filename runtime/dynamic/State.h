@@ -5,7 +5,7 @@
 #include "binding/ProcedureCell.h"
 #include "binding/TypedProcedureCell.h"
 
-#include <unordered_map>
+#include <vector>
 
 namespace lliby
 {
@@ -19,30 +19,43 @@ class ParameterProcedureCell;
  *
  * This can be viewed as a parallel stack the the program's call stack. Arbitrary values can be attached to the state
  * with (make-parameter) and (parameterize)
+ *
+ * Parameter values are stored directly in their ParameterProcedureCell so looking up a value is a single load. Each
+ * state instead keeps an undo log of the values it replaced which are restored when the state is popped. Popped states
+ * are kept on a per-world free list and reused along with the capacity of their undo log.
  */
 class State
 {
 public:
-	typedef std::unordered_map<ParameterProcedureCell*, AnyCell*> ParameterValueMap;
+	/**
+	 * Value a parameter had before it was parameterized by a state
+	 */
+	struct SavedValue
+	{
+		ParameterProcedureCell *parameterProc;
+		AnyCell *value;
+	};
+
+	typedef std::vector<SavedValue> SavedValueList;
 
 	/**
-	 * Creates a new state with a specified parent and before/after procedures
+	 * Creates a new state with a specified parent
 	 *
 	 * @param  parent  Pointer to the parent state or nullptr if this is a root state.
 	 */
-	State(State *parent = nullptr);
+	explicit State(State *parent = nullptr);
 
 	/**
 	 * Returns the value for the passed parameter
 	 *
-	 * This will recurse up this state's ancestors. If no value is found the parameter's initial value will be returned.
+	 * This is only meaningful for the active state of the world owning the parameter
 	 */
 	AnyCell *valueForParameter(ParameterProcedureCell *param) const;
 
 	/**
 	 * Sets the value for the passed parameter
 	 *
-	 * This only sets the value for this State instance; ancestor states are unmodified
+	 * This must be the active state of the world. The previous value is restored when the state is popped.
 	 */
 	void setValueForParameter(World &world, ParameterProcedureCell *param, AnyCell *value);
 
@@ -55,23 +68,13 @@ public:
 	}
 
 	/**
-	 * Returns the values of this state, excluding any ancestor states
+	 * Returns the parameter values replaced by this state in the order they were replaced
 	 *
-	 * This is intended for use by the garbage collector
+	 * This is intended for use by the garbage collector which updates the entries in place
 	 */
-	const ParameterValueMap& selfValues() const
+	SavedValueList& savedValues()
 	{
-		return m_selfValues;
-	}
-
-	/**
-	 * Sets the parameter values of this state
-	 *
-	 * This is intended for use by the garbage collector
-	 */
-	void setSelfValues(const ParameterValueMap &newValues)
-	{
-		m_selfValues = newValues;
+		return m_savedValues;
 	}
 
 	/**
@@ -82,6 +85,8 @@ public:
 	/**
 	 * Creates a child active of the currently active state and makes it active
 	 *
+	 * This reuses a previously popped state if one is available
+	 *
 	 * @param  world   World the state is being pushed in to
 	 */
 	static void pushActiveState(World &world);
@@ -89,22 +94,27 @@ public:
 	/**
 	 * Makes the parent of the currently active state active
 	 *
-	 * @param  world   World the state is being popped from
+	 * Any parameter values set in the active state are reverted
 	 *
-	 * This may re-enter Scheme and invoke the garbage collector
+	 * @param  world   World the state is being popped from
 	 */
 	static void popActiveState(World &world);
 
 	/**
-	 * Switches to the specified state cell
-	 *
-	 * All "after" procedures for exiting states will be called followed by all "before" procedures for entering states.
+	 * Pops states until the specified state is active
 	 */
 	static void popUntilState(World &world, State *);
 
+	/**
+	 * Destroys all states on the world's free list
+	 *
+	 * This is intended for use by World's destructor
+	 */
+	static void releaseFreeStates(World &world);
+
 private:
 	State *m_parent;
-	ParameterValueMap m_selfValues;
+	SavedValueList m_savedValues;
 };
 
 }
@@ -0,0 +1,76 @@
+#include "dynamic/raise.h"
+
+#include "core/World.h"
+#include "dynamic/State.h"
+#include "dynamic/SchemeException.h"
+
+namespace lliby
+{
+namespace dynamic
+{
+
+void raise(World &world, AnyCell *object)
+{
+	GuardFrame *guardFrame = world.innermostGuard();
+
+	// The guard's application of its thunk is the only native frame allowed between us and the guard
+	if ((guardFrame != nullptr) && (world.nativeApplyDepth() == (guardFrame->nativeApplyDepth + 1)))
+	{
+		guardFrame->raisedObject = object;
+		siglongjmp(guardFrame->jumpBuffer, 1);
+	}
+
+	throw SchemeException(object);
+}
+
+AnyCell *applyWithGuard(World &world, ThunkProcedureCell *thunk, GuardHandlerProcedureCell *handler)
+{
+	State *handlerState = world.activeState();
+
+	GuardFrame guardFrame;
+	guardFrame.outer = world.innermostGuard();
+	guardFrame.nativeApplyDepth = world.nativeApplyDepth();
+
+	AnyCell *raisedObject;
+
+	// Don't save the signal mask; it's never changed by Scheme code and saving it requires a system call
+	if (sigsetjmp(guardFrame.jumpBuffer, 0) == 0)
+	{
+		world.setInnermostGuard(&guardFrame);
+
+		try
+		{
+			AnyCell *result = thunk->apply(world);
+			world.setInnermostGuard(guardFrame.outer);
+
+			return result;
+		}
+		catch(SchemeException &except)
+		{
+			world.setInnermostGuard(guardFrame.outer);
+			raisedObject = except.object();
+		}
+		catch(...)
+		{
+			world.setInnermostGuard(guardFrame.outer);
+			throw;
+		}
+	}
+	else
+	{
+		// We jumped here from raise(). The thunk's NativeApplyScope was skipped so restore its depth.
+		world.setInnermostGuard(guardFrame.outer);
+		world.setNativeApplyDepth(guardFrame.nativeApplyDepth);
+
+		raisedObject = guardFrame.raisedObject;
+	}
+
+	// Switch to the guard's dynamic state
+	State::popUntilState(world, handlerState);
+
+	// This will re-raise if no clause matches
+	return handler->apply(world, raisedObject);
+}
+
+}
+}
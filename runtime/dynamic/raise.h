@@ -0,0 +1,75 @@
+#ifndef _LLIBY_DYNAMIC_RAISE_H
+#define _LLIBY_DYNAMIC_RAISE_H
+
+#include <csetjmp>
+#include <cstdint>
+
+#include "binding/TypedProcedureCell.h"
+
+namespace lliby
+{
+class World;
+class AnyCell;
+
+namespace dynamic
+{
+
+/**
+ * Escape target for a (guard) that can be reached without unwinding
+ *
+ * Guard frames form a stack through the world. A raise can jump directly to the innermost guard frame if the only
+ * native frame between them is the guard's own application of its body. Compiled Scheme frames have no cleanups so
+ * skipping them is equivalent to unwinding through them.
+ */
+struct GuardFrame
+{
+	sigjmp_buf jumpBuffer;
+
+	/**
+	 * Next outermost guard frame or nullptr if this is the outermost frame
+	 */
+	GuardFrame *outer;
+
+	/**
+	 * World's native apply depth when the guard frame was entered
+	 */
+	std::uint32_t nativeApplyDepth;
+
+	/**
+	 * Object raised when jumping to this frame
+	 */
+	AnyCell *raisedObject;
+};
+
+using GuardHandlerProcedureCell = TypedProcedureCell<AnyCell*, AnyCell*>;
+
+/**
+ * Raises a Scheme exception
+ *
+ * If the innermost guard can be reached without crossing any native frames this jumps directly to it. Otherwise a
+ * SchemeException is thrown. This must only be called from frames without cleanups; native code that may hold
+ * resources should use signalError() or throw a SchemeException directly.
+ *
+ * @param  world   World the exception is being raised in
+ * @param  object  Object to raise
+ */
+[[noreturn]]
+void raise(World &world, AnyCell *object);
+
+/**
+ * Applies a thunk and passes any raised object to a handler
+ *
+ * The handler is called in the dynamic state active when the guard was entered. Raises that reach the guard without
+ * crossing a native frame skip C++ unwinding entirely.
+ *
+ * @param  world    World to apply the thunk in
+ * @param  thunk    Body of the guard
+ * @param  handler  Procedure to apply to any raised object. This is responsible for re-raising unhandled objects.
+ * @return Result of the thunk or handler
+ */
+AnyCell *applyWithGuard(World &world, ThunkProcedureCell *thunk, GuardHandlerProcedureCell *handler);
+
+}
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef _LLIBY_FLONUM_PARSEDECIMAL_H
+#define _LLIBY_FLONUM_PARSEDECIMAL_H
+
+#include <cstdint>
+#include <string>
+
+namespace lliby
+{
+namespace flonum
+{
+
+/**
+ * Converts a decimal significand and exponent to the nearest double
+ *
+ * Values with up to 19 significant digits are converted with Clinger's exact fast path or the Eisel-Lemire algorithm.
+ * Longer significands and the rare values Eisel-Lemire can't correctly round are handed to strtod(). Values too large
+ * to be represented return infinity and values too small return zero.
+ *
+ * @param  digits    ASCII decimal digits of the significand without a sign or decimal point
+ * @param  exponent  Power of ten to multiply the significand by
+ */
+double parseDecimal(const std::string &digits, std::int64_t exponent);
+
+}
+}
+
+#endif
@@ -0,0 +1,427 @@
+#include "shortestDecimal.h"
+
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+
+namespace lliby
+{
+namespace flonum
+{
+
+namespace
+{
+	/**
+	 * Do-it-yourself floating point value with a 64bit significand and an unbiased binary exponent
+	 */
+	struct DiyFp
+	{
+		std::uint64_t f;
+		int e;
+	};
+
+	const std::uint64_t SignificandMask = 0x000FFFFFFFFFFFFFULL;
+	const std::uint64_t HiddenBit = 0x0010000000000000ULL;
+	const int SignificandBits = 52;
+	const int ExponentBias = 0x3FF + SignificandBits;
+
+	/**
+	 * Normalised powers of ten from 10^-348 to 10^340 in steps of 8
+	 *
+	 * Each entry is rounded to the nearest 64bit significand. These were generated with exact rational arithmetic.
+	 */
+	const DiyFp CachedPowers[] = {
+		{0xfa8fd5a0081c0288ULL, -1220}, // 10^-348
+		{0xbaaee17fa23ebf76ULL, -1193}, // 10^-340
+		{0x8b16fb203055ac76ULL, -1166}, // 10^-332
+		{0xcf42894a5dce35eaULL, -1140}, // 10^-324
+		{0x9a6bb0aa55653b2dULL, -1113}, // 10^-316
+		{0xe61acf033d1a45dfULL, -1087}, // 10^-308
+		{0xab70fe17c79ac6caULL, -1060}, // 10^-300
+		{0xff77b1fcbebcdc4fULL, -1034}, // 10^-292
+		{0xbe5691ef416bd60cULL, -1007}, // 10^-284
+		{0x8dd01fad907ffc3cULL, -980}, // 10^-276
+		{0xd3515c2831559a83ULL, -954}, // 10^-268
+		{0x9d71ac8fada6c9b5ULL, -927}, // 10^-260
+		{0xea9c227723ee8bcbULL, -901}, // 10^-252
+		{0xaecc49914078536dULL, -874}, // 10^-244
+		{0x823c12795db6ce57ULL, -847}, // 10^-236
+		{0xc21094364dfb5637ULL, -821}, // 10^-228
+		{0x9096ea6f3848984fULL, -794}, // 10^-220
+		{0xd77485cb25823ac7ULL, -768}, // 10^-212
+		{0xa086cfcd97bf97f4ULL, -741}, // 10^-204
+		{0xef340a98172aace5ULL, -715}, // 10^-196
+		{0xb23867fb2a35b28eULL, -688}, // 10^-188
+		{0x84c8d4dfd2c63f3bULL, -661}, // 10^-180
+		{0xc5dd44271ad3cdbaULL, -635}, // 10^-172
+		{0x936b9fcebb25c996ULL, -608}, // 10^-164
+		{0xdbac6c247d62a584ULL, -582}, // 10^-156
+		{0xa3ab66580d5fdaf6ULL, -555}, // 10^-148
+		{0xf3e2f893dec3f126ULL, -529}, // 10^-140
+		{0xb5b5ada8aaff80b8ULL, -502}, // 10^-132
+		{0x87625f056c7c4a8bULL, -475}, // 10^-124
+		{0xc9bcff6034c13053ULL, -449}, // 10^-116
+		{0x964e858c91ba2655ULL, -422}, // 10^-108
+		{0xdff9772470297ebdULL, -396}, // 10^-100
+		{0xa6dfbd9fb8e5b88fULL, -369}, // 10^-92
+		{0xf8a95fcf88747d94ULL, -343}, // 10^-84
+		{0xb94470938fa89bcfULL, -316}, // 10^-76
+		{0x8a08f0f8bf0f156bULL, -289}, // 10^-68
+		{0xcdb02555653131b6ULL, -263}, // 10^-60
+		{0x993fe2c6d07b7facULL, -236}, // 10^-52
+		{0xe45c10c42a2b3b06ULL, -210}, // 10^-44
+		{0xaa242499697392d3ULL, -183}, // 10^-36
+		{0xfd87b5f28300ca0eULL, -157}, // 10^-28
+		{0xbce5086492111aebULL, -130}, // 10^-20
+		{0x8cbccc096f5088ccULL, -103}, // 10^-12
+		{0xd1b71758e219652cULL, -77}, // 10^-4
+		{0x9c40000000000000ULL, -50}, // 10^4
+		{0xe8d4a51000000000ULL, -24}, // 10^12
+		{0xad78ebc5ac620000ULL, 3}, // 10^20
+		{0x813f3978f8940984ULL, 30}, // 10^28
+		{0xc097ce7bc90715b3ULL, 56}, // 10^36
+		{0x8f7e32ce7bea5c70ULL, 83}, // 10^44
+		{0xd5d238a4abe98068ULL, 109}, // 10^52
+		{0x9f4f2726179a2245ULL, 136}, // 10^60
+		{0xed63a231d4c4fb27ULL, 162}, // 10^68
+		{0xb0de65388cc8ada8ULL, 189}, // 10^76
+		{0x83c7088e1aab65dbULL, 216}, // 10^84
+		{0xc45d1df942711d9aULL, 242}, // 10^92
+		{0x924d692ca61be758ULL, 269}, // 10^100
+		{0xda01ee641a708deaULL, 295}, // 10^108
+		{0xa26da3999aef774aULL, 322}, // 10^116
+		{0xf209787bb47d6b85ULL, 348}, // 10^124
+		{0xb454e4a179dd1877ULL, 375}, // 10^132
+		{0x865b86925b9bc5c2ULL, 402}, // 10^140
+		{0xc83553c5c8965d3dULL, 428}, // 10^148
+		{0x952ab45cfa97a0b3ULL, 455}, // 10^156
+		{0xde469fbd99a05fe3ULL, 481}, // 10^164
+		{0xa59bc234db398c25ULL, 508}, // 10^172
+		{0xf6c69a72a3989f5cULL, 534}, // 10^180
+		{0xb7dcbf5354e9beceULL, 561}, // 10^188
+		{0x88fcf317f22241e2ULL, 588}, // 10^196
+		{0xcc20ce9bd35c78a5ULL, 614}, // 10^204
+		{0x98165af37b2153dfULL, 641}, // 10^212
+		{0xe2a0b5dc971f303aULL, 667}, // 10^220
+		{0xa8d9d1535ce3b396ULL, 694}, // 10^228
+		{0xfb9b7cd9a4a7443cULL, 720}, // 10^236
+		{0xbb764c4ca7a44410ULL, 747}, // 10^244
+		{0x8bab8eefb6409c1aULL, 774}, // 10^252
+		{0xd01fef10a657842cULL, 800}, // 10^260
+		{0x9b10a4e5e9913129ULL, 827}, // 10^268
+		{0xe7109bfba19c0c9dULL, 853}, // 10^276
+		{0xac2820d9623bf429ULL, 880}, // 10^284
+		{0x80444b5e7aa7cf85ULL, 907}, // 10^292
+		{0xbf21e44003acdd2dULL, 933}, // 10^300
+		{0x8e679c2f5e44ff8fULL, 960}, // 10^308
+		{0xd433179d9c8cb841ULL, 986}, // 10^316
+		{0x9e19db92b4e31ba9ULL, 1013}, // 10^324
+		{0xeb96bf6ebadf77d9ULL, 1039}, // 10^332
+		{0xaf87023b9bf0ee6bULL, 1066}, // 10^340
+	};
+
+	const int CachedPowersFirstExponent = -348;
+	const int CachedPowersExponentStep = 8;
+
+	const std::uint32_t PowersOfTen32[] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+	};
+
+	DiyFp diyFpFromDouble(double value)
+	{
+		std::uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		const int biasedExponent = static_cast<int>(bits >> SignificandBits);
+		const std::uint64_t significand = bits & SignificandMask;
+
+		if (biasedExponent != 0)
+		{
+			return DiyFp{significand + HiddenBit, biasedExponent - ExponentBias};
+		}
+
+		// Subnormal
+		return DiyFp{significand, 1 - ExponentBias};
+	}
+
+	DiyFp normalize(DiyFp value)
+	{
+		while(!(value.f & (1ULL << 63)))
+		{
+			value.f <<= 1;
+			value.e--;
+		}
+
+		return value;
+	}
+
+	DiyFp subtract(DiyFp a, DiyFp b)
+	{
+		assert(a.e == b.e);
+		assert(a.f >= b.f);
+
+		return DiyFp{a.f - b.f, a.e};
+	}
+
+	/**
+	 * Multiplies two values returning the upper 64bits of the product rounded to nearest
+	 */
+	DiyFp multiply(DiyFp a, DiyFp b)
+	{
+		const unsigned __int128 product = static_cast<unsigned __int128>(a.f) * b.f;
+
+		std::uint64_t high = static_cast<std::uint64_t>(product >> 64);
+		const std::uint64_t low = static_cast<std::uint64_t>(product);
+
+		// Round
+		high += (low >> 63);
+
+		return DiyFp{high, a.e + b.e + 64};
+	}
+
+	/**
+	 * Calculates the normalised boundaries between the passed value and its neighbouring doubles
+	 */
+	void normalizedBoundaries(DiyFp value, DiyFp *minus, DiyFp *plus)
+	{
+		DiyFp upper{(value.f << 1) + 1, value.e - 1};
+
+		// Normalise to the significand width then to 64 bits
+		while(!(upper.f & (HiddenBit << 1)))
+		{
+			upper.f <<= 1;
+			upper.e--;
+		}
+
+		upper.f <<= (64 - SignificandBits - 2);
+		upper.e -= (64 - SignificandBits - 2);
+
+		// The lower boundary is closer if we're an exact power of two
+		DiyFp lower = (value.f == HiddenBit) ?
+			DiyFp{(value.f << 2) - 1, value.e - 2} :
+			DiyFp{(value.f << 1) - 1, value.e - 1};
+
+		lower.f <<= lower.e - upper.e;
+		lower.e = upper.e;
+
+		*plus = upper;
+		*minus = lower;
+	}
+
+	/**
+	 * Returns a cached power of ten that scales a value with the passed binary exponent in to our digit generation range
+	 *
+	 * @param  binaryExponent   Binary exponent of the value to scale
+	 * @param  decimalExponent  Set to the negated decimal exponent of the returned power
+	 */
+	DiyFp cachedPowerForBinaryExponent(int binaryExponent, int *decimalExponent)
+	{
+		// This is ceil((-61 - e) * log10(2)) offset so it's always positive
+		const double approxDecimal = (-61 - binaryExponent) * 0.30102999566398114 + 347;
+		int k = static_cast<int>(approxDecimal);
+
+		if ((approxDecimal - k) > 0.0)
+		{
+			k++;
+		}
+
+		const unsigned int index = static_cast<unsigned int>((k >> 3) + 1);
+		assert(index < (sizeof(CachedPowers) / sizeof(CachedPowers[0])));
+
+		*decimalExponent = -(CachedPowersFirstExponent + static_cast<int>(index) * CachedPowersExponentStep);
+		return CachedPowers[index];
+	}
+
+	int decimalDigitCount(std::uint32_t value)
+	{
+		for(int i = 1; i < 10; i++)
+		{
+			if (value < PowersOfTen32[i])
+			{
+				return i;
+			}
+		}
+
+		return 10;
+	}
+
+	/**
+	 * Moves the last generated digit closer to the exact value while it remains within the safe interval
+	 *
+	 * All distances are scaled in the same units as rest. unit is the maximum error of our scaled values in those units.
+	 *
+	 * @return True if the digits are guaranteed to be the closest shortest representation
+	 */
+	bool roundWeed(char *digits, int length, std::uint64_t distanceTooHighValue, std::uint64_t unsafeInterval,
+			std::uint64_t rest, std::uint64_t tenKappa, std::uint64_t unit)
+	{
+		const std::uint64_t smallDistance = distanceTooHighValue - unit;
+		const std::uint64_t bigDistance = distanceTooHighValue + unit;
+
+		while((rest < smallDistance) && ((unsafeInterval - rest) >= tenKappa) &&
+		      (((rest + tenKappa) < smallDistance) || ((smallDistance - rest) >= (rest + tenKappa - smallDistance))))
+		{
+			digits[length - 1]--;
+			rest += tenKappa;
+		}
+
+		// If a lower digit could also be closer to the value we can't decide between them
+		if ((rest < bigDistance) && ((unsafeInterval - rest) >= tenKappa) &&
+		    (((rest + tenKappa) < bigDistance) || ((bigDistance - rest) > (rest + tenKappa - bigDistance))))
+		{
+			return false;
+		}
+
+		// Make sure we're safely inside the rounding interval
+		return ((2 * unit) <= rest) && (rest <= (unsafeInterval - 4 * unit));
+	}
+
+	/**
+	 * Generates the shortest digits inside the interval between the scaled boundaries
+	 *
+	 * This is the digit generation from Loitsch's Grisu3. The interval is widened by the maximum error of our scaled
+	 * values and the result is rejected if that error could change the outcome.
+	 *
+	 * @return True if the generated digits are the shortest representation
+	 */
+	bool generateDigits(DiyFp low, DiyFp value, DiyFp high, DecimalDigits &result, int *kappa)
+	{
+		assert((low.e == value.e) && (value.e == high.e));
+
+		std::uint64_t unit = 1;
+		const DiyFp tooLow{low.f - unit, low.e};
+		const DiyFp tooHigh{high.f + unit, high.e};
+
+		std::uint64_t unsafeInterval = subtract(tooHigh, tooLow).f;
+		const DiyFp one{1ULL << -value.e, value.e};
+
+		// Split the upper boundary in to integral and fractional parts
+		std::uint32_t integrals = static_cast<std::uint32_t>(tooHigh.f >> -one.e);
+		std::uint64_t fractionals = tooHigh.f & (one.f - 1);
+
+		// Our cached powers guarantee the integral part is non-zero
+		assert(integrals != 0);
+
+		*kappa = decimalDigitCount(integrals);
+		result.length = 0;
+
+		while(*kappa > 0)
+		{
+			const std::uint32_t divisor = PowersOfTen32[*kappa - 1];
+
+			result.digits[result.length++] = '0' + (integrals / divisor);
+			integrals %= divisor;
+
+			(*kappa)--;
+
+			const std::uint64_t rest = (static_cast<std::uint64_t>(integrals) << -one.e) + fractionals;
+
+			if (rest < unsafeInterval)
+			{
+				return roundWeed(result.digits, result.length, subtract(tooHigh, value).f, unsafeInterval, rest,
+						static_cast<std::uint64_t>(divisor) << -one.e, unit);
+			}
+		}
+
+		while(true)
+		{
+			fractionals *= 10;
+			unit *= 10;
+			unsafeInterval *= 10;
+
+			result.digits[result.length++] = '0' + static_cast<char>(fractionals >> -one.e);
+			fractionals &= one.f - 1;
+
+			(*kappa)--;
+
+			if (fractionals < unsafeInterval)
+			{
+				return roundWeed(result.digits, result.length, subtract(tooHigh, value).f * unit, unsafeInterval,
+						fractionals, one.f, unit);
+			}
+
+			if (result.length == DecimalDigits::MaximumDigits)
+			{
+				// This shouldn't happen but don't overrun our buffer
+				return false;
+			}
+		}
+	}
+
+	/**
+	 * Finds the shortest representation by formatting with increasing precision
+	 *
+	 * This is slow but exact. It's only used for the small fraction of values Grisu3 can't handle.
+	 */
+	DecimalDigits slowShortestDecimal(double value)
+	{
+		DecimalDigits result;
+
+		for(int precision = 1; precision <= DecimalDigits::MaximumDigits; precision++)
+		{
+			// Formats as d.ddde[+-]xx
+			char formatted[32];
+			snprintf(formatted, sizeof(formatted), "%.*e", precision - 1, value);
+
+			if ((strtod(formatted, nullptr) != value) && (precision != DecimalDigits::MaximumDigits))
+			{
+				continue;
+			}
+
+			result.length = 0;
+			const char *scanPtr = formatted;
+
+			for(; *scanPtr != 'e'; scanPtr++)
+			{
+				if (*scanPtr != '.')
+				{
+					result.digits[result.length++] = *scanPtr;
+				}
+			}
+
+			result.exponent = atoi(scanPtr + 1) - (result.length - 1);
+			break;
+		}
+
+		// Strip trailing zeros
+		while((result.length > 1) && (result.digits[result.length - 1] == '0'))
+		{
+			result.length--;
+			result.exponent++;
+		}
+
+		return result;
+	}
+}
+
+DecimalDigits shortestDecimal(double value)
+{
+	assert(value > 0.0);
+
+	const DiyFp diyValue = diyFpFromDouble(value);
+
+	DiyFp lowerBoundary, upperBoundary;
+	normalizedBoundaries(diyValue, &lowerBoundary, &upperBoundary);
+
+	const DiyFp normalizedValue = normalize(diyValue);
+	assert(normalizedValue.e == upperBoundary.e);
+
+	int cachedPowerExponent;
+	const DiyFp cachedPower = cachedPowerForBinaryExponent(upperBoundary.e, &cachedPowerExponent);
+
+	DecimalDigits result;
+	int kappa;
+
+	if (!generateDigits(multiply(lowerBoundary, cachedPower), multiply(normalizedValue, cachedPower),
+				multiply(upperBoundary, cachedPower), result, &kappa))
+	{
+		return slowShortestDecimal(value);
+	}
+
+	result.exponent = cachedPowerExponent + kappa;
+	return result;
+}
+
+}
+}
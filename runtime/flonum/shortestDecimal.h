@@ -0,0 +1,51 @@
+#ifndef _LLIBY_FLONUM_SHORTESTDECIMAL_H
+#define _LLIBY_FLONUM_SHORTESTDECIMAL_H
+
+#include <cstdint>
+
+namespace lliby
+{
+namespace flonum
+{
+
+/**
+ * Decimal representation of a double in the form digits * 10^exponent
+ */
+struct DecimalDigits
+{
+	/**
+	 * Maximum number of significant digits required to uniquely identify a double
+	 */
+	static const int MaximumDigits = 17;
+
+	/**
+	 * ASCII significand digits without a trailing NULL
+	 */
+	char digits[MaximumDigits + 1];
+
+	/**
+	 * Number of significand digits
+	 */
+	int length;
+
+	/**
+	 * Power of ten to multiply the significand by
+	 */
+	int exponent;
+};
+
+/**
+ * Finds the shortest decimal representation that reads back as exactly the passed value
+ *
+ * If multiple representations have the same length the one closest to the value is returned. This uses Florian
+ * Loitsch's Grisu3 algorithm with 64bit integer arithmetic. Grisu3 rejects the roughly 0.5% of values it can't prove
+ * are correct; these fall back to a much slower search using the C library.
+ *
+ * @param  value  Positive, finite, non-zero value to convert
+ */
+DecimalDigits shortestDecimal(double value);
+
+}
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/ProcedureCell.h"
 #include "binding/CharCell.h"
 #include "binding/BytevectorCell.h"
@@ -94,6 +95,10 @@ DatumHash::ResultType DatumHash::operator()(AnyCell *datum) const
 
 		return convertToResultType(floatValue) ^ 0x8bc111e4;
 	}
+	else if (auto ratnumCell = cell_cast<RatnumCell>(datum))
+	{
+		return (convertToResultType(ratnumCell->numerator()) * 31) ^ convertToResultType(ratnumCell->denominator()) ^ 0x2a5cb6e1;
+	}
 	else if (auto procCell = cell_cast<ProcedureCell>(datum))
 	{
 		return convertToResultType(procCell->entryPoint()) ^ hashRecordLike(procCell) ^ 0x466e8954;
@@ -0,0 +1,63 @@
+#include "metrics/Metric.h"
+
+namespace lliby
+{
+namespace metrics
+{
+
+namespace
+{
+	std::vector<Metric*> &mutableRegisteredMetrics()
+	{
+		// This is intentionally leaked so metrics can be read while other static objects are being destroyed
+		static auto registeredMetrics = new std::vector<Metric*>;
+		return *registeredMetrics;
+	}
+
+	std::atomic<int> nextShardIndex(0);
+	thread_local int threadShardIndex = -1;
+}
+
+Metric::Metric(const char *name, const char *help, MetricType type) :
+	m_name(name),
+	m_help(help),
+	m_type(type)
+{
+	for(auto &shard : m_shards)
+	{
+		shard.value.store(0, std::memory_order_relaxed);
+	}
+
+	mutableRegisteredMetrics().push_back(this);
+}
+
+std::int64_t Metric::value() const
+{
+	std::int64_t total = 0;
+
+	for(auto &shard : m_shards)
+	{
+		total += shard.value.load(std::memory_order_relaxed);
+	}
+
+	return total;
+}
+
+const std::vector<Metric*> &Metric::registeredMetrics()
+{
+	return mutableRegisteredMetrics();
+}
+
+int Metric::currentShardIndex()
+{
+	if (threadShardIndex < 0)
+	{
+		// Assign shards to threads round-robin
+		threadShardIndex = nextShardIndex.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+	}
+
+	return threadShardIndex;
+}
+
+}
+}
@@ -0,0 +1,118 @@
+#ifndef _LLIBY_METRICS_METRIC_H
+#define _LLIBY_METRICS_METRIC_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace lliby
+{
+namespace metrics
+{
+
+enum class MetricType
+{
+	/**
+	 * Monotonically increasing count of events
+	 */
+	Counter,
+
+	/**
+	 * Current value of a quantity that can increase or decrease
+	 */
+	Gauge
+};
+
+/**
+ * Named runtime metric
+ *
+ * Metrics are always enabled so updating them must be cheap. Each metric is split in to a number of cache line sized
+ * shards and each thread updates its own shard with relaxed atomics. This avoids threads contending on the same cache
+ * line at the cost of making reads sum every shard. Reads aren't synchronised with updates so the value of a metric
+ * being concurrently updated is approximate.
+ *
+ * Metrics register themselves on construction and must have static storage duration.
+ */
+class Metric
+{
+public:
+	Metric(const char *name, const char *help, MetricType type);
+
+	Metric(const Metric &) = delete;
+	Metric& operator=(const Metric &) = delete;
+
+	/**
+	 * Adds a delta to the metric's value
+	 *
+	 * Counters should only be passed non-negative deltas
+	 */
+	void add(std::int64_t delta)
+	{
+		m_shards[currentShardIndex()].value.fetch_add(delta, std::memory_order_relaxed);
+	}
+
+	void increment()
+	{
+		add(1);
+	}
+
+	void decrement()
+	{
+		add(-1);
+	}
+
+	/**
+	 * Returns the current value of the metric
+	 */
+	std::int64_t value() const;
+
+	/**
+	 * Returns the name of the metric
+	 *
+	 * This follows the Prometheus naming conventions. Counters end in "_total" and all names are prefixed with
+	 * "llambda_".
+	 */
+	const char *name() const
+	{
+		return m_name;
+	}
+
+	/**
+	 * Returns a one line description of the metric
+	 */
+	const char *help() const
+	{
+		return m_help;
+	}
+
+	MetricType type() const
+	{
+		return m_type;
+	}
+
+	/**
+	 * Returns every registered metric in registration order
+	 */
+	static const std::vector<Metric*> &registeredMetrics();
+
+private:
+	static const int ShardCount = 16;
+
+	struct alignas(64) Shard
+	{
+		std::atomic<std::int64_t> value;
+	};
+
+	static int currentShardIndex();
+
+	const char *m_name;
+	const char *m_help;
+	MetricType m_type;
+
+	Shard m_shards[ShardCount];
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,175 @@
+#include "metrics/dump.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "metrics/Metric.h"
+
+namespace lliby
+{
+namespace metrics
+{
+
+namespace
+{
+	bool dumpEnabled = false;
+	DumpFormat dumpFormat;
+	std::string dumpFilename;
+
+	/**
+	 * Serialises dumps from the signal thread and process exit
+	 */
+	std::mutex dumpMutex;
+
+	/**
+	 * Self-pipe used to hand signals to the dump thread
+	 *
+	 * Dumping allocates and takes locks so it can't be done from the signal handler itself
+	 */
+	int signalPipe[2] = {-1, -1};
+
+	void handleDumpSignal(int)
+	{
+		const char signalByte = 0;
+		ssize_t ignoredResult = write(signalPipe[1], &signalByte, 1);
+		(void)ignoredResult;
+	}
+
+	void dumpThread()
+	{
+		char signalByte;
+
+		while(read(signalPipe[0], &signalByte, 1) != 0)
+		{
+			dumpIfEnabled();
+		}
+	}
+
+	const char *prometheusTypeName(MetricType type)
+	{
+		switch(type)
+		{
+		case MetricType::Counter:
+			return "counter";
+		case MetricType::Gauge:
+			return "gauge";
+		}
+
+		return "untyped";
+	}
+}
+
+void writeMetrics(std::ostream &out, DumpFormat format)
+{
+	if (format == DumpFormat::Json)
+	{
+		bool first = true;
+		out << "{";
+
+		for(auto metric : Metric::registeredMetrics())
+		{
+			if (!first)
+			{
+				out << ",";
+			}
+
+			// Metric names are restricted to characters that don't need escaping
+			out << "\"" << metric->name() << "\":" << metric->value();
+			first = false;
+		}
+
+		out << "}" << std::endl;
+	}
+	else
+	{
+		for(auto metric : Metric::registeredMetrics())
+		{
+			out << "# HELP " << metric->name() << " " << metric->help() << "\n";
+			out << "# TYPE " << metric->name() << " " << prometheusTypeName(metric->type()) << "\n";
+			out << metric->name() << " " << metric->value() << "\n";
+		}
+
+		out.flush();
+	}
+}
+
+void initDumping()
+{
+	const char *formatName = getenv("LLAMBDA_METRICS_DUMP");
+
+	if (formatName == nullptr)
+	{
+		return;
+	}
+	else if (!strcmp(formatName, "json"))
+	{
+		dumpFormat = DumpFormat::Json;
+	}
+	else if (!strcmp(formatName, "prometheus"))
+	{
+		dumpFormat = DumpFormat::Prometheus;
+	}
+	else
+	{
+		std::cerr << "Unknown LLAMBDA_METRICS_DUMP format \"" << formatName << "\"; expected \"json\" or \"prometheus\"" << std::endl;
+		return;
+	}
+
+	if (const char *filename = getenv("LLAMBDA_METRICS_DUMP_FILE"))
+	{
+		dumpFilename = filename;
+	}
+
+	dumpEnabled = true;
+
+	// Dump from exit() so programs that call (exit) or die from an unhandled exception are covered
+	atexit(dumpIfEnabled);
+
+	if (pipe(signalPipe) != 0)
+	{
+		// We can still dump at exit
+		return;
+	}
+
+	std::thread(dumpThread).detach();
+
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+
+	action.sa_handler = handleDumpSignal;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+
+	sigaction(SIGUSR1, &action, nullptr);
+}
+
+void dumpIfEnabled()
+{
+	if (!dumpEnabled)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(dumpMutex);
+
+	if (dumpFilename.empty())
+	{
+		writeMetrics(std::cerr, dumpFormat);
+	}
+	else
+	{
+		std::ofstream dumpFile(dumpFilename, std::ios::out | std::ios::trunc);
+		writeMetrics(dumpFile, dumpFormat);
+	}
+}
+
+}
+}
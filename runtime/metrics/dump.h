@@ -0,0 +1,48 @@
+#ifndef _LLIBY_METRICS_DUMP_H
+#define _LLIBY_METRICS_DUMP_H
+
+#include <ostream>
+
+namespace lliby
+{
+namespace metrics
+{
+
+enum class DumpFormat
+{
+	/**
+	 * Single line JSON object mapping each metric name to its value
+	 */
+	Json,
+
+	/**
+	 * Prometheus text exposition format
+	 */
+	Prometheus
+};
+
+/**
+ * Writes the current value of every registered metric to the passed stream
+ */
+void writeMetrics(std::ostream &out, DumpFormat format);
+
+/**
+ * Configures metrics dumping from the environment
+ *
+ * If LLAMBDA_METRICS_DUMP is set to "json" or "prometheus" the metrics will be dumped in that format at exit and every
+ * time the process receives SIGUSR1. Dumps are written to stderr unless LLAMBDA_METRICS_DUMP_FILE is set; in that case
+ * the file is replaced with each dump.
+ *
+ * The exit dump is registered with atexit() so it's also written when the program calls exit() directly.
+ */
+void initDumping();
+
+/**
+ * Dumps the metrics if dumping has been enabled by initDumping()
+ */
+void dumpIfEnabled();
+
+}
+}
+
+#endif
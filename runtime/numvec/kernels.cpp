@@ -0,0 +1,339 @@
+#include "numvec/kernels.h"
+
+#include <cstring>
+#include <limits>
+
+namespace lliby
+{
+namespace numvec
+{
+
+namespace
+{
+	const std::size_t Lanes = 2;
+
+	// 16 byte vectors map directly to SSE2 and NEON registers which are available on all of our 64bit targets
+	typedef double DoubleLanes __attribute__((vector_size(Lanes * sizeof(double))));
+	typedef std::int64_t IntegerLanes __attribute__((vector_size(Lanes * sizeof(std::int64_t))));
+	typedef std::uint64_t UnsignedLanes __attribute__((vector_size(Lanes * sizeof(std::uint64_t))));
+
+	// Element storage is only aligned to the element size; memcpy() compiles to unaligned vector loads and stores
+	template<typename V, typename T>
+	V loadLanes(const T *source)
+	{
+		V value;
+		memcpy(&value, source, sizeof(V));
+		return value;
+	}
+
+	template<typename V, typename T>
+	void storeLanes(T *dest, V value)
+	{
+		memcpy(dest, &value, sizeof(V));
+	}
+
+	template<typename V>
+	bool anyLaneSet(V lanes)
+	{
+		bool result = false;
+
+		for(std::size_t lane = 0; lane < Lanes; lane++)
+		{
+			result |= (lanes[lane] != 0);
+		}
+
+		return result;
+	}
+
+	template<typename Operation>
+	void elementWise(double *out, const double *left, const double *right, std::size_t count, Operation op)
+	{
+		std::size_t i = 0;
+
+		for(; (i + Lanes) <= count; i += Lanes)
+		{
+			storeLanes(out + i, op(loadLanes<DoubleLanes>(left + i), loadLanes<DoubleLanes>(right + i)));
+		}
+
+		for(; i < count; i++)
+		{
+			out[i] = op(left[i], right[i]);
+		}
+	}
+
+	template<typename Select>
+	double extremum(const double *values, std::size_t count, Select select)
+	{
+		double result = values[0];
+		std::size_t i = 1;
+
+		if (count >= Lanes)
+		{
+			DoubleLanes laneResult = loadLanes<DoubleLanes>(values);
+			IntegerLanes nanLanes = (laneResult != laneResult);
+
+			for(i = Lanes; (i + Lanes) <= count; i += Lanes)
+			{
+				const DoubleLanes current = loadLanes<DoubleLanes>(values + i);
+
+				nanLanes |= (current != current);
+				laneResult = select(current, laneResult) ? current : laneResult;
+			}
+
+			if (anyLaneSet(nanLanes))
+			{
+				return std::numeric_limits<double>::quiet_NaN();
+			}
+
+			result = laneResult[0];
+
+			for(std::size_t lane = 1; lane < Lanes; lane++)
+			{
+				if (select(laneResult[lane], result))
+				{
+					result = laneResult[lane];
+				}
+			}
+		}
+		else if (result != result)
+		{
+			return result;
+		}
+
+		for(; i < count; i++)
+		{
+			if (values[i] != values[i])
+			{
+				return values[i];
+			}
+			else if (select(values[i], result))
+			{
+				result = values[i];
+			}
+		}
+
+		return result;
+	}
+
+	template<typename Select>
+	std::int64_t extremum(const std::int64_t *values, std::size_t count, Select select)
+	{
+		std::int64_t result = values[0];
+		std::size_t i = 1;
+
+		if (count >= Lanes)
+		{
+			IntegerLanes laneResult = loadLanes<IntegerLanes>(values);
+
+			for(i = Lanes; (i + Lanes) <= count; i += Lanes)
+			{
+				const IntegerLanes current = loadLanes<IntegerLanes>(values + i);
+				laneResult = select(current, laneResult) ? current : laneResult;
+			}
+
+			result = laneResult[0];
+
+			for(std::size_t lane = 1; lane < Lanes; lane++)
+			{
+				if (select(laneResult[lane], result))
+				{
+					result = laneResult[lane];
+				}
+			}
+		}
+
+		for(; i < count; i++)
+		{
+			if (select(values[i], result))
+			{
+				result = values[i];
+			}
+		}
+
+		return result;
+	}
+
+	auto lessThan = [] (auto left, auto right) { return left < right; };
+	auto greaterThan = [] (auto left, auto right) { return left > right; };
+}
+
+double sum(const double *values, std::size_t count)
+{
+	// Negative zero is the additive identity for IEEE 754; positive zero would turn a sum of -0.0 in to 0.0
+	DoubleLanes laneSums = {-0.0, -0.0};
+	std::size_t i = 0;
+
+	for(; (i + Lanes) <= count; i += Lanes)
+	{
+		laneSums += loadLanes<DoubleLanes>(values + i);
+	}
+
+	double result = laneSums[0] + laneSums[1];
+
+	for(; i < count; i++)
+	{
+		result += values[i];
+	}
+
+	return result;
+}
+
+double dot(const double *left, const double *right, std::size_t count)
+{
+	DoubleLanes laneSums = {-0.0, -0.0};
+	std::size_t i = 0;
+
+	for(; (i + Lanes) <= count; i += Lanes)
+	{
+		laneSums += loadLanes<DoubleLanes>(left + i) * loadLanes<DoubleLanes>(right + i);
+	}
+
+	double result = laneSums[0] + laneSums[1];
+
+	for(; i < count; i++)
+	{
+		result += left[i] * right[i];
+	}
+
+	return result;
+}
+
+double minimum(const double *values, std::size_t count)
+{
+	return extremum(values, count, lessThan);
+}
+
+double maximum(const double *values, std::size_t count)
+{
+	return extremum(values, count, greaterThan);
+}
+
+void scale(double *out, const double *values, std::size_t count, double factor)
+{
+	std::size_t i = 0;
+
+	for(; (i + Lanes) <= count; i += Lanes)
+	{
+		storeLanes(out + i, loadLanes<DoubleLanes>(values + i) * factor);
+	}
+
+	for(; i < count; i++)
+	{
+		out[i] = values[i] * factor;
+	}
+}
+
+void add(double *out, const double *left, const double *right, std::size_t count)
+{
+	elementWise(out, left, right, count, [] (auto left, auto right) { return left + right; });
+}
+
+void multiply(double *out, const double *left, const double *right, std::size_t count)
+{
+	elementWise(out, left, right, count, [] (auto left, auto right) { return left * right; });
+}
+
+void prefixSum(double *out, const double *values, std::size_t count)
+{
+	double runningSum = -0.0;
+
+	for(std::size_t i = 0; i < count; i++)
+	{
+		runningSum += values[i];
+		out[i] = runningSum;
+	}
+}
+
+void compareMask(std::uint8_t *out, const double *values, std::size_t count, Comparison comparison, double operand)
+{
+	// Keep the comparison out of the inner loop so each loop can be vectorised
+	switch(comparison)
+	{
+	case Comparison::LessThan:
+		for(std::size_t i = 0; i < count; i++)
+		{
+			out[i] = values[i] < operand;
+		}
+		break;
+
+	case Comparison::GreaterThan:
+		for(std::size_t i = 0; i < count; i++)
+		{
+			out[i] = values[i] > operand;
+		}
+		break;
+
+	case Comparison::Equal:
+		for(std::size_t i = 0; i < count; i++)
+		{
+			out[i] = values[i] == operand;
+		}
+		break;
+	}
+}
+
+bool sum(const std::int64_t *values, std::size_t count, std::int64_t &result)
+{
+	// Sum in wrapping unsigned arithmetic and track any signed overflow in each lane
+	UnsignedLanes laneSums = {0, 0};
+	UnsignedLanes overflowLanes = {0, 0};
+	std::size_t i = 0;
+
+	for(; (i + Lanes) <= count; i += Lanes)
+	{
+		const UnsignedLanes current = loadLanes<UnsignedLanes>(values + i);
+		const UnsignedLanes newSums = laneSums + current;
+
+		// Signed addition overflowed if both operands have a different sign to the result
+		overflowLanes |= (laneSums ^ newSums) & (current ^ newSums);
+		laneSums = newSums;
+	}
+
+	bool overflowed = anyLaneSet(overflowLanes >> 63);
+	std::int64_t scalarResult = 0;
+
+	for(std::size_t lane = 0; (lane < Lanes) && !overflowed; lane++)
+	{
+		overflowed = __builtin_add_overflow(scalarResult, static_cast<std::int64_t>(laneSums[lane]), &scalarResult);
+	}
+
+	for(; (i < count) && !overflowed; i++)
+	{
+		overflowed = __builtin_add_overflow(scalarResult, values[i], &scalarResult);
+	}
+
+	if (!overflowed)
+	{
+		result = scalarResult;
+		return true;
+	}
+
+	// The partial sums can overflow even if the total doesn't. Sum exactly to find out.
+	__int128 exactSum = 0;
+
+	for(std::size_t j = 0; j < count; j++)
+	{
+		exactSum += values[j];
+	}
+
+	if ((exactSum < std::numeric_limits<std::int64_t>::min()) || (exactSum > std::numeric_limits<std::int64_t>::max()))
+	{
+		return false;
+	}
+
+	result = static_cast<std::int64_t>(exactSum);
+	return true;
+}
+
+std::int64_t minimum(const std::int64_t *values, std::size_t count)
+{
+	return extremum(values, count, lessThan);
+}
+
+std::int64_t maximum(const std::int64_t *values, std::size_t count)
+{
+	return extremum(values, count, greaterThan);
+}
+
+}
+}
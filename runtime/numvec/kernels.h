@@ -0,0 +1,82 @@
+#ifndef _LLIBY_NUMVEC_KERNELS_H
+#define _LLIBY_NUMVEC_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Bulk kernels over contiguous unboxed numeric elements
+ *
+ * These operate on raw element arrays so they can be used on the storage of homogeneous numeric vectors without any
+ * per-element dispatch or boxing. Pointers must be aligned to their element size but don't need any additional alignment for vector
+ * loads. Output arrays may alias their inputs.
+ *
+ * Reductions use a fixed number of independent lanes that are combined in a fixed order. This allows them to be
+ * vectorised while still producing identical results on every platform.
+ */
+namespace lliby
+{
+namespace numvec
+{
+
+enum class Comparison
+{
+	LessThan,
+	GreaterThan,
+	Equal
+};
+
+double sum(const double *values, std::size_t count);
+double dot(const double *left, const double *right, std::size_t count);
+
+/**
+ * Returns the minimum element
+ *
+ * If any element is NaN then NaN is returned. count must be non-zero.
+ */
+double minimum(const double *values, std::size_t count);
+
+/**
+ * Returns the maximum element
+ *
+ * If any element is NaN then NaN is returned. count must be non-zero.
+ */
+double maximum(const double *values, std::size_t count);
+
+void scale(double *out, const double *values, std::size_t count, double factor);
+void add(double *out, const double *left, const double *right, std::size_t count);
+void multiply(double *out, const double *left, const double *right, std::size_t count);
+
+/**
+ * Calculates the inclusive prefix sum of the passed values
+ *
+ * This is calculated sequentially so each element is rounded identically to a sequential loop
+ */
+void prefixSum(double *out, const double *values, std::size_t count);
+
+/**
+ * Sets each output byte to 1 if the corresponding element compares true against the operand or 0 otherwise
+ */
+void compareMask(std::uint8_t *out, const double *values, std::size_t count, Comparison comparison, double operand);
+
+/**
+ * Sums integer elements
+ *
+ * @return  True if the sum was calculated or false on signed overflow
+ */
+bool sum(const std::int64_t *values, std::size_t count, std::int64_t &result);
+
+/**
+ * Returns the minimum element; count must be non-zero
+ */
+std::int64_t minimum(const std::int64_t *values, std::size_t count);
+
+/**
+ * Returns the maximum element; count must be non-zero
+ */
+std::int64_t maximum(const std::int64_t *values, std::size_t count);
+
+}
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "platform/backtrace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#define _LLIBY_HAVE_EXECINFO
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#endif
+
+namespace lliby
+{
+namespace platform
+{
+
+namespace
+{
+	const int MaxCapturedFrames = 128;
+}
+
+int captureBacktrace(void **frames, int maxFrames, int skipFrames)
+{
+#ifdef _LLIBY_HAVE_EXECINFO
+	// Capture our skipped frames and our own frame in to a temporary buffer
+	const int totalSkipFrames = skipFrames + 1;
+	void *allFrames[MaxCapturedFrames];
+
+	const int capturedFrames = backtrace(allFrames, std::min(totalSkipFrames + maxFrames, MaxCapturedFrames));
+
+	if (capturedFrames <= totalSkipFrames)
+	{
+		return 0;
+	}
+
+	for(int i = totalSkipFrames; i < capturedFrames; i++)
+	{
+		frames[i - totalSkipFrames] = allFrames[i];
+	}
+
+	return capturedFrames - totalSkipFrames;
+#else
+	return 0;
+#endif
+}
+
+std::string symbolNameForAddress(void *address)
+{
+#ifdef _LLIBY_HAVE_EXECINFO
+	Dl_info info;
+
+	if (dladdr(address, &info) && (info.dli_sname != nullptr))
+	{
+		int status;
+		char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+		if (demangled != nullptr)
+		{
+			std::string demangledName(demangled);
+			free(demangled);
+
+			return demangledName;
+		}
+
+		return info.dli_sname;
+	}
+#endif
+
+	std::ostringstream addressStream;
+	addressStream << address;
+
+	return addressStream.str();
+}
+
+}
+}
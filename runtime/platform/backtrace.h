@@ -0,0 +1,31 @@
+#ifndef _LLIBY_PLATFORM_BACKTRACE_H
+#define _LLIBY_PLATFORM_BACKTRACE_H
+
+#include <string>
+
+namespace lliby
+{
+namespace platform
+{
+
+/**
+ * Captures the return addresses of the calling thread's stack frames
+ *
+ * @param  frames     Array to store the return addresses in. The innermost frame is stored first.
+ * @param  maxFrames  Maximum number of frames to capture
+ * @param  skipFrames Number of innermost frames to skip in addition to the frame for this function
+ * @return Number of frames captured. This is 0 if backtraces are unsupported on this platform.
+ */
+int captureBacktrace(void **frames, int maxFrames, int skipFrames = 0);
+
+/**
+ * Returns a human readable name for a code address
+ *
+ * This is the demangled name of the nearest exported symbol if one can be found or the hexadecimal address otherwise
+ */
+std::string symbolNameForAddress(void *address);
+
+}
+}
+
+#endif
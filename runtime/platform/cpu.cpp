@@ -0,0 +1,32 @@
+#include "platform/cpu.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace lliby
+{
+namespace platform
+{
+
+bool pinCurrentThreadToCpu(unsigned int cpuIndex)
+{
+#if defined(__linux__)
+	const unsigned int cpuCount = std::max(1u, std::thread::hardware_concurrency());
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpuIndex % cpuCount, &cpuSet);
+
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+	return false;
+#endif
+}
+
+}
+}
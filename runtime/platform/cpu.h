@@ -0,0 +1,20 @@
+#ifndef _LLIBY_PLATFORM_CPU_H
+#define _LLIBY_PLATFORM_CPU_H
+
+namespace lliby
+{
+namespace platform
+{
+
+/**
+ * Restricts the calling thread to running on a single CPU
+ *
+ * @param  cpuIndex  Index of the CPU to run on. This is taken modulo the number of CPUs.
+ * @return True if the thread was pinned or false if pinning is unsupported on this platform
+ */
+bool pinCurrentThreadToCpu(unsigned int cpuIndex);
+
+}
+}
+
+#endif
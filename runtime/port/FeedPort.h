@@ -0,0 +1,89 @@
+#ifndef _LLIBY_PORT_FEEDPORT_H
+#define _LLIBY_PORT_FEEDPORT_H
+
+#include "AbstractPort.h"
+
+#include <sstream>
+
+#include "reader/IncrementalDatumReader.h"
+
+namespace lliby
+{
+
+/**
+ * Port that buffers data written to it for incremental reading
+ *
+ * Data written to the port's output side is fed to an IncrementalDatumReader. Reading never blocks or consumes partial
+ * input; callers should check IncrementalDatumReader::datumReady() before reading. The end-of-file object is only
+ * returned once the output side has been closed and all buffered datums have been read.
+ */
+class FeedPort : public AbstractPort
+{
+public:
+	bool isInputPort() const override
+	{
+		return true;
+	}
+
+	bool isInputPortOpen() const override
+	{
+		return m_inputOpen;
+	}
+
+	void closeInputPort() override
+	{
+		m_inputOpen = false;
+	}
+
+	std::istream *inputStream() override
+	{
+		return &incrementalReader().inputStream();
+	}
+
+	bool isOutputPort() const override
+	{
+		return true;
+	}
+
+	bool isOutputPortOpen() const override
+	{
+		return !m_reader.isFinished();
+	}
+
+	void closeOutputPort() override
+	{
+		incrementalReader().finish();
+	}
+
+	std::ostream *outputStream() override
+	{
+		return &m_pendingOutput;
+	}
+
+	/**
+	 * Returns the incremental reader for this port
+	 *
+	 * Any data written to the port since the last call is fed to the reader before it's returned
+	 */
+	IncrementalDatumReader& incrementalReader()
+	{
+		const std::string pendingData(m_pendingOutput.str());
+
+		if (!pendingData.empty())
+		{
+			m_reader.feed(pendingData.data(), pendingData.size());
+			m_pendingOutput.str("");
+		}
+
+		return m_reader;
+	}
+
+private:
+	bool m_inputOpen = true;
+	std::ostringstream m_pendingOutput;
+	IncrementalDatumReader m_reader;
+};
+
+}
+
+#endif
@@ -0,0 +1,197 @@
+#include "BulkDatumReader.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <algorithm>
+
+#include "core/World.h"
+
+#include "binding/EofObjectCell.h"
+
+#include "reader/DatumReader.h"
+#include "reader/DatumBoundaryScanner.h"
+#include "reader/MemoryInputBuffer.h"
+
+#include "sched/Dispatcher.h"
+
+namespace lliby
+{
+
+namespace
+{
+	/**
+	 * Contiguous range of top-level datums parsed by a single thread
+	 */
+	struct Chunk
+	{
+		std::size_t startOffset;
+		std::size_t endOffset;
+
+		std::unique_ptr<World> world;
+		std::vector<AnyCell*> datums;
+		std::exception_ptr error;
+	};
+
+	/**
+	 * Parses every datum in the passed range in to a vector
+	 */
+	void parseRange(World &world, const char *data, std::size_t startOffset, std::size_t endOffset,
+			std::vector<AnyCell*> &datums)
+	{
+		MemoryInputBuffer inputBuffer(data + startOffset, data + endOffset, startOffset);
+		std::istream inputStream(&inputBuffer);
+
+		DatumReader reader(world, inputStream);
+
+		while(true)
+		{
+			AnyCell *datum = reader.parse();
+
+			if (datum == EofObjectCell::instance())
+			{
+				return;
+			}
+
+			datums.push_back(datum);
+		}
+	}
+
+	void parseChunk(Chunk &chunk, const char *data)
+	{
+		try
+		{
+			parseRange(*chunk.world, data, chunk.startOffset, chunk.endOffset, chunk.datums);
+		}
+		catch(...)
+		{
+			chunk.error = std::current_exception();
+		}
+	}
+}
+
+BulkDatumReader::BulkDatumReader(World &world, const char *data, std::size_t length, sched::Dispatcher &dispatcher,
+		std::size_t chunkLimit) :
+	m_world(world),
+	m_data(data),
+	m_length(length),
+	m_dispatcher(dispatcher),
+	m_chunkLimit(chunkLimit)
+{
+	if (m_chunkLimit == 0)
+	{
+		m_chunkLimit = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+std::vector<std::size_t> BulkDatumReader::findDatumBoundaries() const
+{
+	std::vector<std::size_t> boundaries;
+	DatumBoundaryScanner scanner;
+
+	std::size_t scanOffset = 0;
+
+	while(scanOffset < m_length)
+	{
+		scanOffset += scanner.scan(&m_data[scanOffset], m_length - scanOffset);
+
+		if (scanner.datumComplete())
+		{
+			boundaries.push_back(scanOffset);
+		}
+	}
+
+	// Any trailing data belongs to the final chunk; this includes unterminated datums which the reader will report
+	if (boundaries.empty() || (boundaries.back() != m_length))
+	{
+		boundaries.push_back(m_length);
+	}
+
+	return boundaries;
+}
+
+ProperList<AnyCell>* BulkDatumReader::parseAll()
+{
+	std::vector<AnyCell*> datums;
+
+	const std::size_t maximumChunks = std::min(m_chunkLimit, std::max<std::size_t>(1, m_length / MinimumChunkBytes));
+
+	if (maximumChunks <= 1)
+	{
+		// Not worth parallelising; skip the pre-scan and parse directly in to our world
+		m_chunkCount = 1;
+		parseRange(m_world, m_data, 0, m_length, datums);
+
+		return ProperList<AnyCell>::create(m_world, datums);
+	}
+
+	// Divide the datums in to chunks of roughly equal size
+	const std::vector<std::size_t> boundaries(findDatumBoundaries());
+	const std::size_t targetChunkBytes = m_length / maximumChunks;
+
+	std::vector<Chunk> chunks;
+	std::size_t chunkStart = 0;
+
+	for(std::size_t boundary : boundaries)
+	{
+		if (((boundary - chunkStart) >= targetChunkBytes) || (boundary == m_length))
+		{
+			chunks.push_back(Chunk{chunkStart, boundary, std::unique_ptr<World>(new World)});
+			chunkStart = boundary;
+		}
+	}
+
+	m_chunkCount = chunks.size();
+
+	// Parse every chunk but the first on the dispatcher
+	std::mutex completionMutex;
+	std::condition_variable completionCond;
+	std::size_t pendingChunks = chunks.size() - 1;
+
+	for(std::size_t i = 1; i < chunks.size(); i++)
+	{
+		Chunk *chunk = &chunks[i];
+		const char *data = m_data;
+
+		m_dispatcher.dispatch([=, &completionMutex, &completionCond, &pendingChunks] {
+			parseChunk(*chunk, data);
+
+			std::lock_guard<std::mutex> lock(completionMutex);
+
+			if (--pendingChunks == 0)
+			{
+				completionCond.notify_one();
+			}
+		});
+	}
+
+	// Parse the first chunk on this thread while we wait
+	parseChunk(chunks[0], m_data);
+
+	{
+		std::unique_lock<std::mutex> lock(completionMutex);
+		completionCond.wait(lock, [&] { return pendingChunks == 0; });
+	}
+
+	// Take ownership of every chunk's cells before we report any errors
+	for(auto &chunk : chunks)
+	{
+		m_world.cellHeap.splice(chunk.world->cellHeap);
+	}
+
+	for(auto &chunk : chunks)
+	{
+		if (chunk.error)
+		{
+			std::rethrow_exception(chunk.error);
+		}
+
+		datums.insert(datums.end(), chunk.datums.begin(), chunk.datums.end());
+	}
+
+	return ProperList<AnyCell>::create(m_world, datums);
+}
+
+}
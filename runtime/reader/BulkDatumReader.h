@@ -0,0 +1,89 @@
+#ifndef _LLIBY_READER_BULKDATUMREADER_H
+#define _LLIBY_READER_BULKDATUMREADER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "binding/ProperList.h"
+
+namespace lliby
+{
+
+class World;
+
+namespace sched
+{
+class Dispatcher;
+}
+
+/**
+ * Reads every datum from a buffer of external form data in parallel
+ *
+ * The buffer is first pre-scanned with DatumBoundaryScanner to find the boundaries between top-level datums. The
+ * datums are then divided in to contiguous chunks which are parsed concurrently on Dispatcher threads. Each chunk is
+ * parsed in to a private World whose heap is spliced in to the destination World once parsing has finished.
+ *
+ * Datum labels are scoped to the chunk they appear in. As chunks only split between top-level datums this only affects
+ * labels referenced from a later top-level datum than they were defined in.
+ */
+class BulkDatumReader
+{
+public:
+	/**
+	 * Creates a new bulk reader for the passed data
+	 *
+	 * The data is not copied and must remain valid until parseAll() returns
+	 *
+	 * @param  world       World to return the parsed datums in
+	 * @param  data        Pointer to the data to parse
+	 * @param  length      Length of the data in bytes
+	 * @param  dispatcher  Dispatcher to run parallel parsing on
+	 * @param  chunkLimit  Maximum number of chunks to parse concurrently. If this is 0 the number of hardware threads
+	 *                     is used.
+	 */
+	BulkDatumReader(World &world, const char *data, std::size_t length, sched::Dispatcher &dispatcher,
+			std::size_t chunkLimit = 0);
+
+	/**
+	 * Parses all datums in the data and returns them in order
+	 *
+	 * If any datum is invalid then ReadErrorException or utf8::InvalidByteSequenceException will be thrown for the
+	 * first invalid datum.
+	 */
+	ProperList<AnyCell>* parseAll();
+
+	/**
+	 * Returns the number of chunks the data was parsed in
+	 *
+	 * This is only valid after parseAll() has been called. It's primarily intended for testing.
+	 */
+	std::size_t chunkCount() const
+	{
+		return m_chunkCount;
+	}
+
+	/**
+	 * Minimum size in bytes of a chunk to parse in parallel
+	 *
+	 * Smaller chunks aren't worth the overhead of dispatching and splicing
+	 */
+	static const std::size_t MinimumChunkBytes = 64 * 1024;
+
+private:
+	/**
+	 * Returns the end offset of every top-level datum in the data
+	 */
+	std::vector<std::size_t> findDatumBoundaries() const;
+
+	World &m_world;
+	const char *m_data;
+	std::size_t m_length;
+	sched::Dispatcher &m_dispatcher;
+	std::size_t m_chunkLimit;
+
+	std::size_t m_chunkCount = 0;
+};
+
+}
+
+#endif
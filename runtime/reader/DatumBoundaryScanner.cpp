@@ -0,0 +1,364 @@
+#include "DatumBoundaryScanner.h"
+
+namespace lliby
+{
+
+namespace
+{
+	bool isWhitespace(char c)
+	{
+		return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\f');
+	}
+
+	/**
+	 * Returns true if the character terminates an atom
+	 *
+	 * This mirrors the characters DatumReader refuses to include in identifiers with the exception of #. This is used
+	 * inside literals such as #t or datum label references.
+	 */
+	bool isAtomDelimiter(char c)
+	{
+		return isWhitespace(c) ||
+			(c == '(') || (c == ')') || (c == '[') || (c == ']') ||
+			(c == '"') || (c == ';') || (c == '|') ||
+			(c == '\'') || (c == '`') || (c == ',');
+	}
+
+	bool isDigit(char c)
+	{
+		return (c >= '0') && (c <= '9');
+	}
+}
+
+void DatumBoundaryScanner::reset()
+{
+	m_state = State::Whitespace;
+	m_hashToken = HashToken::None;
+	m_pendingPrefix = false;
+	m_datumComplete = false;
+
+	m_depth = 0;
+	m_blockCommentDepth = 0;
+	m_skipDatums = 0;
+}
+
+bool DatumBoundaryScanner::closeDatum()
+{
+	if (m_depth > 0)
+	{
+		// Still inside a list or vector
+		return false;
+	}
+
+	if (m_skipDatums > 0)
+	{
+		// This datum was commented out with #;
+		m_skipDatums--;
+		return false;
+	}
+
+	m_pendingPrefix = false;
+	m_datumComplete = true;
+	return true;
+}
+
+bool DatumBoundaryScanner::closeAtom(char delimiter, bool *openedList)
+{
+	const HashToken hashToken = m_hashToken;
+
+	m_state = State::Whitespace;
+	m_hashToken = HashToken::None;
+
+	if (((delimiter == '(') && ((hashToken == HashToken::Hash) || (hashToken == HashToken::HashU8))))
+	{
+		// This is a #( vector or #u8( bytevector
+		m_depth++;
+		*openedList = true;
+
+		return false;
+	}
+	else if (hashToken == HashToken::Label)
+	{
+		// Datum label definitions prefix the datum they label
+		m_pendingPrefix = true;
+		return false;
+	}
+
+	return closeDatum();
+}
+
+std::size_t DatumBoundaryScanner::scan(const char *data, std::size_t length)
+{
+	m_datumComplete = false;
+
+	std::size_t i = 0;
+
+	while(i < length)
+	{
+		const char c = data[i];
+
+		switch(m_state)
+		{
+		case State::Whitespace:
+			if (isWhitespace(c))
+			{
+				break;
+			}
+			else if ((c == '(') || (c == '['))
+			{
+				m_depth++;
+			}
+			else if ((c == ')') || (c == ']'))
+			{
+				if (m_depth == 0)
+				{
+					// Unbalanced close; let the reader report it
+					if (closeDatum())
+					{
+						return i + 1;
+					}
+				}
+				else
+				{
+					m_depth--;
+
+					if (closeDatum())
+					{
+						return i + 1;
+					}
+				}
+			}
+			else if (c == ';')
+			{
+				m_state = State::LineComment;
+			}
+			else if (c == '"')
+			{
+				m_state = State::String;
+			}
+			else if (c == '|')
+			{
+				m_state = State::EnclosedSymbol;
+			}
+			else if (c == '#')
+			{
+				m_state = State::Hash;
+			}
+			else if ((c == '\'') || (c == '`'))
+			{
+				m_pendingPrefix = true;
+			}
+			else if (c == ',')
+			{
+				m_pendingPrefix = true;
+				m_state = State::Unquote;
+			}
+			else
+			{
+				m_hashToken = HashToken::None;
+				m_state = State::Atom;
+			}
+
+			break;
+
+		case State::Atom:
+			if (isAtomDelimiter(c))
+			{
+				bool openedList = false;
+
+				if (closeAtom(c, &openedList))
+				{
+					// Don't consume the delimiter
+					return i;
+				}
+
+				if (!openedList)
+				{
+					// Process the delimiter in the whitespace state
+					continue;
+				}
+			}
+			else
+			{
+				switch(m_hashToken)
+				{
+				case HashToken::None:
+					break;
+				case HashToken::Hash:
+					m_hashToken = (c == 'u') ? HashToken::HashU : (isDigit(c) ? HashToken::LabelDigits : HashToken::None);
+					break;
+				case HashToken::HashU:
+					m_hashToken = (c == '8') ? HashToken::HashU8 : HashToken::None;
+					break;
+				case HashToken::LabelDigits:
+					m_hashToken = isDigit(c) ? HashToken::LabelDigits : ((c == '=') ? HashToken::Label : HashToken::None);
+					break;
+				case HashToken::HashU8:
+				case HashToken::Label:
+					m_hashToken = HashToken::None;
+					break;
+				}
+			}
+
+			break;
+
+		case State::Hash:
+			if (c == '|')
+			{
+				m_blockCommentDepth = 1;
+				m_state = State::BlockComment;
+			}
+			else if (c == ';')
+			{
+				// Datum comments only affect top-level datums when they appear at the top level
+				if (m_depth == 0)
+				{
+					m_skipDatums++;
+				}
+
+				m_state = State::Whitespace;
+			}
+			else if (c == '\\')
+			{
+				m_state = State::CharLiteral;
+			}
+			else
+			{
+				// Treat the # as the start of an atom and reprocess this character
+				m_hashToken = HashToken::Hash;
+				m_state = State::Atom;
+				continue;
+			}
+
+			break;
+
+		case State::CharLiteral:
+			// The first character is always part of the literal even if it's a delimiter. Any following characters are
+			// part of the character name.
+			m_hashToken = HashToken::None;
+			m_state = State::Atom;
+			break;
+
+		case State::Unquote:
+			m_state = State::Whitespace;
+
+			if (c != '@')
+			{
+				continue;
+			}
+
+			break;
+
+		case State::String:
+			if (c == '\\')
+			{
+				m_state = State::StringEscape;
+			}
+			else if (c == '"')
+			{
+				m_state = State::Whitespace;
+
+				if (closeDatum())
+				{
+					return i + 1;
+				}
+			}
+
+			break;
+
+		case State::StringEscape:
+			m_state = State::String;
+			break;
+
+		case State::EnclosedSymbol:
+			if (c == '\\')
+			{
+				m_state = State::EnclosedSymbolEscape;
+			}
+			else if (c == '|')
+			{
+				m_state = State::Whitespace;
+
+				if (closeDatum())
+				{
+					return i + 1;
+				}
+			}
+
+			break;
+
+		case State::EnclosedSymbolEscape:
+			m_state = State::EnclosedSymbol;
+			break;
+
+		case State::LineComment:
+			if (c == '\n')
+			{
+				m_state = State::Whitespace;
+			}
+
+			break;
+
+		case State::BlockComment:
+			if (c == '#')
+			{
+				m_state = State::BlockCommentHash;
+			}
+			else if (c == '|')
+			{
+				m_state = State::BlockCommentBar;
+			}
+
+			break;
+
+		case State::BlockCommentHash:
+			if (c == '|')
+			{
+				m_blockCommentDepth++;
+				m_state = State::BlockComment;
+			}
+			else if (c != '#')
+			{
+				m_state = State::BlockComment;
+			}
+
+			break;
+
+		case State::BlockCommentBar:
+			if (c == '#')
+			{
+				if (--m_blockCommentDepth == 0)
+				{
+					m_state = State::Whitespace;
+				}
+				else
+				{
+					m_state = State::BlockComment;
+				}
+			}
+			else if (c != '|')
+			{
+				m_state = State::BlockComment;
+			}
+
+			break;
+		}
+
+		i++;
+	}
+
+	return length;
+}
+
+void DatumBoundaryScanner::finish()
+{
+	m_datumComplete = false;
+
+	if ((m_state == State::Atom) || (m_state == State::Hash))
+	{
+		bool openedList = false;
+		closeAtom(' ', &openedList);
+	}
+}
+
+}
@@ -0,0 +1,128 @@
+#ifndef _LLIBY_READER_DATUMBOUNDARYSCANNER_H
+#define _LLIBY_READER_DATUMBOUNDARYSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lliby
+{
+
+/**
+ * Resumable scanner for finding the end of top-level datums in external form
+ *
+ * This performs a lightweight lexical pass over datum source without allocating any cells. It tracks strings, enclosed
+ * symbols, character literals, line comments, nested block comments, datum comments and list nesting. Input can be
+ * passed in arbitrarily sized chunks; the scanner's state is preserved between calls to scan().
+ *
+ * The scanner is conservative: it will never report a datum as complete before DatumReader could parse it without
+ * reaching the end of input. It does not validate the datum's syntax; malformed data is reported as complete so the
+ * reader can signal the appropriate error.
+ */
+class DatumBoundaryScanner
+{
+public:
+	DatumBoundaryScanner()
+	{
+		reset();
+	}
+
+	/**
+	 * Scans a chunk of input for the end of the next top-level datum
+	 *
+	 * Scanning stops immediately after the first complete top-level datum. If no datum was completed then the entire
+	 * chunk is consumed and scanning can be resumed by passing the input that follows it.
+	 *
+	 * @param  data    Pointer to the input to scan
+	 * @param  length  Length of the input in bytes
+	 * @return Number of bytes consumed from the input
+	 */
+	std::size_t scan(const char *data, std::size_t length);
+
+	/**
+	 * Signals the end of input
+	 *
+	 * An atom at the end of input has no trailing delimiter. This completes any such atom.
+	 */
+	void finish();
+
+	/**
+	 * Returns true if the last call to scan() or finish() completed a top-level datum
+	 */
+	bool datumComplete() const
+	{
+		return m_datumComplete;
+	}
+
+	/**
+	 * Returns true if the scanner is between datums with no partially scanned input
+	 *
+	 * This can be used to determine if only whitespace and comments have been scanned since the last complete datum
+	 */
+	bool isIdle() const
+	{
+		return (m_state == State::Whitespace) && (m_depth == 0) && (m_skipDatums == 0) && !m_pendingPrefix;
+	}
+
+	/**
+	 * Resets the scanner to its initial state
+	 */
+	void reset();
+
+private:
+	enum class State : std::uint8_t
+	{
+		Whitespace,
+		Atom,
+		Hash,
+		CharLiteral,
+		Unquote,
+		String,
+		StringEscape,
+		EnclosedSymbol,
+		EnclosedSymbolEscape,
+		LineComment,
+		BlockComment,
+		BlockCommentHash,
+		BlockCommentBar
+	};
+
+	/**
+	 * Classifies atoms beginning with # that can prefix another datum
+	 */
+	enum class HashToken : std::uint8_t
+	{
+		None,
+		Hash,
+		HashU,
+		HashU8,
+		LabelDigits,
+		Label
+	};
+
+	/**
+	 * Called when a datum has been closed
+	 *
+	 * Returns true if this completes a top-level datum
+	 */
+	bool closeDatum();
+
+	/**
+	 * Called when an atom has been terminated by the passed delimiter
+	 *
+	 * Returns true if this completes a top-level datum. If the atom instead opened a list then openedList is set.
+	 */
+	bool closeAtom(char delimiter, bool *openedList);
+
+	State m_state;
+	HashToken m_hashToken;
+	bool m_pendingPrefix;
+	bool m_datumComplete;
+
+	std::uint32_t m_depth;
+	std::uint32_t m_blockCommentDepth;
+	std::uint32_t m_skipDatums;
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "ParserHelpers.h"
 
 #include <cassert>
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <string>
@@ -11,6 +12,7 @@
 
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/EofObjectCell.h"
 #include "binding/BooleanCell.h"
 #include "binding/SymbolCell.h"
@@ -25,6 +27,8 @@
 #include "unicode/utf8.h"
 #include "unicode/utf8/InvalidByteSequenceException.h"
 
+#include "flonum/parseDecimal.h"
+
 namespace lliby
 {
 
@@ -175,7 +179,7 @@ namespace
 
 		if (numberString.empty())
 		{
-			if (!signChar)
+			if (signChar)
 			{
 				rdbuf->sputbackc(signChar);
 			}
@@ -353,23 +357,20 @@ int DatumReader::consumeWhitespace()
 			peekChar = rdbuf()->sgetc();
 			if (peekChar == ';')
 			{
-				// Discard the commented out datum
+				// Discard the commented out datum and continue consuming any whitespace after it
 				rdbuf()->sbumpc();
-				consumeWhitespace();
 				parse();
 			}
 			else if (peekChar == '|')
 			{
 				rdbuf()->sbumpc();
 				consumeBlockComment();
-				consumeWhitespace();
 			}
 			else
 			{
 				rdbuf()->sputbackc('#');
+				return '#';
 			}
-
-			return peekChar;
 		}
 		else
 		{
@@ -393,15 +394,20 @@ void DatumReader::consumeBlockComment()
 		}
 		else if (firstChar == '#')
 		{
-			if (rdbuf()->sbumpc() == '|')
+			// Only consume the next character if it's part of the delimiter. Otherwise it could begin another
+			// delimiter such as in "#|#"
+			if (rdbuf()->sgetc() == '|')
 			{
+				rdbuf()->sbumpc();
 				++commentDepth;
 			}
 		}
 		else if (firstChar == '|')
 		{
-			if (rdbuf()->sbumpc() == '#')
+			if (rdbuf()->sgetc() == '#')
 			{
+				rdbuf()->sbumpc();
+
 				if (--commentDepth == 0)
 				{
 					return;
@@ -713,7 +719,7 @@ AnyCell* DatumReader::parseUnradixedNumber(int radix, bool negative)
 {
 	std::string numberString;
 
-	takeWhile(rdbuf(), numberString, [=] (char c) -> bool {
+	auto isRadixDigit = [=] (char c) -> bool {
 		if ((c >= '0') && (c <= ('0' + std::min(10, radix) - 1)))
 		{
 			return true;
@@ -727,7 +733,9 @@ AnyCell* DatumReader::parseUnradixedNumber(int radix, bool negative)
 		{
 			return false;
 		}
-	});
+	};
+
+	takeWhile(rdbuf(), numberString, isRadixDigit);
 
 	// Allow decimal numbers to start with a decimal point
 	if (numberString.empty() && !((rdbuf()->sgetc() == '.') && (radix == 10)))
@@ -738,17 +746,17 @@ AnyCell* DatumReader::parseUnradixedNumber(int radix, bool negative)
 
 	if (radix == 10)
 	{
-		int peekChar = rdbuf()->sgetc();
+		std::size_t fractionDigits = 0;
 
-		if (peekChar == '.')
+		if (rdbuf()->sgetc() == '.')
 		{
-			// Add the .
-			numberString.push_back(rdbuf()->sbumpc());
+			// Take the . but leave it out of our significand digits
+			rdbuf()->sbumpc();
 
-			const auto previousSize = numberString.size();
+			const auto integralDigits = numberString.size();
 			takeDecimal(rdbuf(), numberString);
 
-			if (numberString.size() == 1)
+			if (numberString.empty())
 			{
 				// We just contain the "." - this isn't a valid number
 				// This should re-parse as a symbol
@@ -756,34 +764,25 @@ AnyCell* DatumReader::parseUnradixedNumber(int radix, bool negative)
 				throw MalformedDatumException(inputOffset(rdbuf()), "Decimal point with no trailing numbers");
 			}
 
-			if (previousSize != numberString.size())
-			{
-				// We took more numbers after the decimal place - we're a flonum
-				double doubleValue;
-
-				try
-				{
-					doubleValue = std::stod(numberString, nullptr);
-				}
-				catch (std::out_of_range)
-				{
-					throw new MalformedDatumException(inputOffset(rdbuf()), "Floating point value out-of-range");
-				}
+			fractionDigits = numberString.size() - integralDigits;
+		}
 
-				if (negative)
-				{
-					doubleValue = -doubleValue;
-				}
+		const double exponentValue = takeExponent(rdbuf());
 
-				double exponentValue = takeExponent(rdbuf());
+		if ((fractionDigits > 0) || !std::isnan(exponentValue))
+		{
+			// We're a flonum. Clamp the exponent well outside the range of a double so it can't overflow.
+			const double clampedExponent = std::isnan(exponentValue) ? 0.0 : std::max(-1e9, std::min(1e9, exponentValue));
+			const std::int64_t exponent = static_cast<std::int64_t>(clampedExponent) - static_cast<std::int64_t>(fractionDigits);
 
-				if (!std::isnan(exponentValue))
-				{
-					doubleValue *= std::pow(10, exponentValue);
-				}
+			double doubleValue = flonum::parseDecimal(numberString, exponent);
 
-				return FlonumCell::fromValue(m_world, doubleValue);
+			if (negative)
+			{
+				doubleValue = -doubleValue;
 			}
+
+			return FlonumCell::fromValue(m_world, doubleValue);
 		}
 	}
 
@@ -803,16 +802,41 @@ AnyCell* DatumReader::parseUnradixedNumber(int radix, bool negative)
 		intValue = -intValue;
 	}
 
-	if (radix == 10)
+	if (rdbuf()->sgetc() == '/')
 	{
-		double exponentValue = takeExponent(rdbuf());
+		// This is an exact rational
+		rdbuf()->sbumpc();
+
+		std::string denominatorString;
+		takeWhile(rdbuf(), denominatorString, isRadixDigit);
 
-		if (!std::isnan(exponentValue))
+		if (denominatorString.empty())
 		{
-			// We have an exponent - we're a flonum
-			double doubleValue = intValue * std::pow(10, exponentValue);
-			return FlonumCell::fromValue(m_world, doubleValue);
+			throw MalformedDatumException(inputOffset(rdbuf()), "Rational with no denominator");
+		}
+
+		std::int64_t denominatorValue;
+
+		try
+		{
+			denominatorValue = std::stoll(denominatorString, nullptr, radix);
+		}
+		catch(std::out_of_range)
+		{
+			throw MalformedDatumException(inputOffset(rdbuf()), "Rational denominator out-of-range");
 		}
+
+		if (denominatorValue == 0)
+		{
+			throw MalformedDatumException(inputOffset(rdbuf()), "Rational with zero denominator");
+		}
+
+		if (NumberCell *rational = RatnumCell::fromFraction(m_world, intValue, denominatorValue))
+		{
+			return rational;
+		}
+
+		throw MalformedDatumException(inputOffset(rdbuf()), "Rational value out-of-range");
 	}
 
 	return IntegerCell::fromValue(m_world, intValue);
@@ -931,10 +955,10 @@ AnyCell* DatumReader::parseVector()
 	}
 
 	const auto elementCount = elementRefs.size();
-	auto *newElements = new AnyCell*[elementCount];
-	std::memcpy(newElements, elementRefs.data(), sizeof(AnyCell*) * elementCount);
+	VectorCell *newVector = VectorCell::createUninitialised(m_world, elementCount);
+	std::memcpy(newVector->elements(), elementRefs.data(), sizeof(AnyCell*) * elementCount);
 
-	return VectorCell::fromElements(m_world, newElements, elementCount);
+	return newVector;
 }
 
 AnyCell* DatumReader::parseBytevector()
@@ -0,0 +1,171 @@
+#include "IncrementalDatumReader.h"
+
+#include "reader/DatumReader.h"
+#include "reader/ReadErrorException.h"
+
+#include "binding/EofObjectCell.h"
+
+#include "unicode/utf8/InvalidByteSequenceException.h"
+
+namespace lliby
+{
+
+namespace
+{
+	// Compact the buffer once this much input has been consumed. This keeps memory bounded without moving the
+	// remaining input after every datum.
+	const std::size_t MinimumCompactionBytes = 4096;
+}
+
+IncrementalDatumReader::IncrementalDatumReader() :
+	m_inputStream(&m_inputBuffer)
+{
+	syncInputStream();
+}
+
+void IncrementalDatumReader::feed(const char *data, std::size_t length)
+{
+	syncInputStream();
+
+	if (m_finished)
+	{
+		return;
+	}
+
+	m_buffer.append(data, length);
+
+	// Appending may have reallocated our buffer
+	syncInputStream();
+}
+
+void IncrementalDatumReader::finish()
+{
+	syncInputStream();
+	m_finished = true;
+}
+
+std::istream& IncrementalDatumReader::inputStream()
+{
+	syncInputStream();
+	return m_inputStream;
+}
+
+void IncrementalDatumReader::syncInputStream()
+{
+	const std::size_t consumedBytes = m_inputBuffer.consumedBytes();
+
+	if (consumedBytes > 0)
+	{
+		consume(consumedBytes);
+	}
+
+	char *bufferStart = &m_buffer[0];
+	m_inputBuffer.setRange(bufferStart + m_readOffset, bufferStart + m_buffer.size());
+	m_inputStream.clear();
+}
+
+void IncrementalDatumReader::consume(std::size_t bytes)
+{
+	m_readOffset += bytes;
+
+	// Our scanner state is only valid for input scanned from the previous read offset
+	m_scanner.reset();
+	m_scanOffset = m_readOffset;
+
+	if (m_readOffset == m_buffer.size())
+	{
+		m_buffer.clear();
+		m_readOffset = m_scanOffset = 0;
+	}
+	else if ((m_readOffset >= MinimumCompactionBytes) && (m_readOffset >= (m_buffer.size() / 2)))
+	{
+		m_buffer.erase(0, m_readOffset);
+		m_readOffset = m_scanOffset = 0;
+	}
+
+	m_inputBuffer.setRange(nullptr, nullptr);
+}
+
+void IncrementalDatumReader::scanPendingInput()
+{
+	syncInputStream();
+
+	if (!m_scanner.datumComplete())
+	{
+		// Resume scanning where we left off
+		m_scanOffset += m_scanner.scan(&m_buffer[m_scanOffset], m_buffer.size() - m_scanOffset);
+
+		if (!m_scanner.datumComplete() && m_finished)
+		{
+			m_scanner.finish();
+		}
+	}
+}
+
+bool IncrementalDatumReader::datumReady()
+{
+	scanPendingInput();
+	return m_scanner.datumComplete() || m_finished;
+}
+
+AnyCell* IncrementalDatumReader::parse(World &world)
+{
+	scanPendingInput();
+
+	if (!m_scanner.datumComplete())
+	{
+		if (!m_finished)
+		{
+			return nullptr;
+		}
+		else if (m_scanner.isIdle())
+		{
+			// Nothing but whitespace and comments remain
+			consume(m_buffer.size() - m_readOffset);
+			return EofObjectCell::instance();
+		}
+
+		// Let the reader report the unterminated datum
+	}
+
+	DatumReader reader(world, m_inputStream);
+
+	try
+	{
+		AnyCell *datum = reader.parse();
+
+		if ((datum == EofObjectCell::instance()) && !m_finished)
+		{
+			// The reader disagreed with the scanner about the datum being complete. Leave the input in place.
+			m_inputBuffer.setRange(nullptr, nullptr);
+			return nullptr;
+		}
+
+		consume(m_inputBuffer.consumedBytes());
+		return datum;
+	}
+	catch(const UnexpectedEofException &)
+	{
+		if (m_finished)
+		{
+			consume(m_buffer.size() - m_readOffset);
+			throw;
+		}
+
+		// Leave the input in place until more arrives
+		m_inputBuffer.setRange(nullptr, nullptr);
+		return nullptr;
+	}
+	catch(const ReadErrorException &)
+	{
+		consume(m_inputBuffer.consumedBytes());
+		throw;
+	}
+	catch(const utf8::InvalidByteSequenceException &)
+	{
+		consume(m_inputBuffer.consumedBytes());
+		throw;
+	}
+}
+
+}
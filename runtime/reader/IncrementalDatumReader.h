@@ -0,0 +1,108 @@
+#ifndef _LLIBY_READER_INCREMENTALDATUMREADER_H
+#define _LLIBY_READER_INCREMENTALDATUMREADER_H
+
+#include <istream>
+#include <string>
+
+#include "reader/DatumBoundaryScanner.h"
+#include "reader/MemoryInputBuffer.h"
+
+#include "binding/generated/declaretypes.h"
+
+namespace lliby
+{
+
+class World;
+
+/**
+ * Datum reader that can be fed input incrementally
+ *
+ * Unlike DatumReader this never blocks waiting for input or consumes a partial datum. Input is buffered internally and
+ * scanned with DatumBoundaryScanner as it arrives. Scanning resumes where the previous call left off so each byte of
+ * input is only scanned once while waiting for a datum to complete.
+ */
+class IncrementalDatumReader
+{
+public:
+	IncrementalDatumReader();
+
+	// The input stream references our own buffer
+	IncrementalDatumReader(const IncrementalDatumReader &) = delete;
+	IncrementalDatumReader& operator=(const IncrementalDatumReader &) = delete;
+
+	/**
+	 * Appends input to the reader's buffer
+	 *
+	 * This has no effect if finish() has been called.
+	 */
+	void feed(const char *data, std::size_t length);
+
+	/**
+	 * Signals that no more input will be fed to the reader
+	 */
+	void finish();
+
+	/**
+	 * Returns true if finish() has been called
+	 */
+	bool isFinished() const
+	{
+		return m_finished;
+	}
+
+	/**
+	 * Returns true if parse() will return a datum or the end-of-file object
+	 *
+	 * This is true once a complete datum has been buffered or finish() has been called
+	 */
+	bool datumReady();
+
+	/**
+	 * Parses the next complete datum from the buffered input
+	 *
+	 * If the buffered input doesn't contain a complete datum then nullptr is returned and no input is consumed. If
+	 * finish() has been called and only whitespace or comments remain then EofObjectCell::instance() is returned.
+	 *
+	 * Syntactically invalid data will cause ReadErrorException or utf8::InvalidByteSequenceException to be thrown.
+	 * The invalid input is consumed so parsing can resume after the error.
+	 */
+	AnyCell* parse(World &world);
+
+	/**
+	 * Returns a stream for directly reading the unconsumed input
+	 *
+	 * Any input consumed through this stream is discarded from the reader. The stream is invalidated by the next call
+	 * to any other method of this instance.
+	 */
+	std::istream& inputStream();
+
+private:
+	/**
+	 * Resumes scanning any buffered input for the end of the next datum
+	 */
+	void scanPendingInput();
+
+	/**
+	 * Discards any input consumed through our input stream and resets the stream to our unconsumed input
+	 */
+	void syncInputStream();
+
+	/**
+	 * Discards the passed number of bytes from the start of the unconsumed input
+	 */
+	void consume(std::size_t bytes);
+
+	std::string m_buffer;
+	std::size_t m_readOffset = 0;
+	std::size_t m_scanOffset = 0;
+
+	DatumBoundaryScanner m_scanner;
+	bool m_finished = false;
+
+	MemoryInputBuffer m_inputBuffer;
+	std::istream m_inputStream;
+};
+
+}
+
+#endif
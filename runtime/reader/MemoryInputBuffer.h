@@ -0,0 +1,67 @@
+#ifndef _LLIBY_READER_MEMORYINPUTBUFFER_H
+#define _LLIBY_READER_MEMORYINPUTBUFFER_H
+
+#include <streambuf>
+#include <ios>
+
+namespace lliby
+{
+
+/**
+ * Stream buffer reading directly from a region of memory
+ *
+ * The memory is not copied and must remain valid while the buffer is in use.
+ */
+class MemoryInputBuffer : public std::streambuf
+{
+public:
+	MemoryInputBuffer()
+	{
+	}
+
+	MemoryInputBuffer(const char *begin, const char *end, std::streamoff baseOffset = 0)
+	{
+		setRange(begin, end, baseOffset);
+	}
+
+	/**
+	 * Sets the region of memory to read from
+	 *
+	 * @param  begin       Pointer to the first byte to read
+	 * @param  end         Pointer past the last byte to read
+	 * @param  baseOffset  Stream offset of the first byte. This is used to report meaningful offsets when reading a
+	 *                     region of a larger input.
+	 */
+	void setRange(const char *begin, const char *end, std::streamoff baseOffset = 0)
+	{
+		m_baseOffset = baseOffset;
+		setg(const_cast<char*>(begin), const_cast<char*>(begin), const_cast<char*>(end));
+	}
+
+	/**
+	 * Returns the number of bytes read since the range was set
+	 */
+	std::size_t consumedBytes() const
+	{
+		return gptr() - eback();
+	}
+
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		// Only support querying the current offset
+		if ((off != 0) || (dir != std::ios_base::cur) || !(which & std::ios_base::in))
+		{
+			return pos_type(off_type(-1));
+		}
+
+		return pos_type(m_baseOffset + consumedBytes());
+	}
+
+private:
+	std::streamoff m_baseOffset = 0;
+};
+
+}
+
+#endif
@@ -1,7 +1,13 @@
 #include "sched/Dispatcher.h"
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "platform/cpu.h"
+#include "metrics/Metric.h"
 
 namespace lliby
 {
@@ -10,11 +16,29 @@ namespace sched
 
 namespace
 {
-	Dispatcher DefaultInstance;
+	bool affinityRequestedByEnvironment()
+	{
+		const char *value = getenv("LLAMBDA_DISPATCHER_AFFINITY");
+		return (value != nullptr) && !strcmp(value, "1");
+	}
+
+	metrics::Metric WorkerThreadsMetric("llambda_dispatcher_threads", "Running dispatcher worker threads", metrics::MetricType::Gauge);
+	metrics::Metric IdleWorkerThreadsMetric("llambda_dispatcher_idle_threads", "Dispatcher worker threads waiting for work", metrics::MetricType::Gauge);
+	metrics::Metric DispatchedWorkMetric("llambda_dispatcher_work_total", "Work functions dispatched", metrics::MetricType::Counter);
+	metrics::Metric HomeWorkerHitsMetric("llambda_dispatcher_home_worker_hits_total", "Work functions run on their requested home worker", metrics::MetricType::Counter);
+	metrics::Metric ThreadLaunchesMetric("llambda_dispatcher_thread_launches_total", "Dispatcher worker threads launched", metrics::MetricType::Counter);
+
+	Dispatcher DefaultInstance(affinityRequestedByEnvironment());
+
+	/**
+	 * Dispatcher and worker ID for the current thread if it's a worker thread
+	 */
+	thread_local const Dispatcher *currentDispatcher = nullptr;
+	thread_local Dispatcher::WorkerId currentWorker = Dispatcher::NoWorker;
 }
 
-Dispatcher::Dispatcher() :
-	m_idleThreads(0),
+Dispatcher::Dispatcher(bool pinWorkers) :
+	m_pinWorkers(pinWorkers),
 	m_runningThreads(0)
 {
 }
@@ -29,41 +53,112 @@ Dispatcher& Dispatcher::defaultInstance()
 	return DefaultInstance;
 }
 
+Dispatcher::WorkerId Dispatcher::currentWorkerId() const
+{
+	return (currentDispatcher == this) ? currentWorker : NoWorker;
+}
+
 void Dispatcher::dispatch(const WorkFunction &work)
 {
+	dispatch(work, NoWorker);
+}
+
+void Dispatcher::dispatch(const WorkFunction &work, WorkerId homeWorker)
+{
+	DispatchedWorkMetric.increment();
+
 	std::unique_lock<std::mutex> lock(m_mutex);
 
-	if (m_idleThreads < 1)
+	if (!m_idleWorkers.empty())
 	{
-		m_runningThreads++;
+		Worker *worker = takeIdleWorker(homeWorker);
+		worker->pendingWork = work;
+
 		lock.unlock();
 
-		try
-		{
-			// We need to launch a new thread - pass it the initial work to do to avoid queue contention
-			std::thread newThread(&Dispatcher::workerThread, this, work);
-			newThread.detach();
+		worker->wakeCond.notify_one();
+		return;
+	}
 
-			return;
-		}
-		catch(std::system_error &)
-		{
-			// Failed to launch a thread. This can happen on low resource situations. Fall back to queuing
-			lock.lock();
-			m_runningThreads--;
+	// Allocate a worker, reusing the lowest free ID so pinned workers are spread across CPUs
+	Worker *worker;
 
-			m_drainCond.notify_all();
-		}
+	if (m_freeWorkerIds.empty())
+	{
+		m_workers.emplace_back(new Worker);
+
+		worker = m_workers.back().get();
+		worker->workerId = m_workers.size() - 1;
 	}
+	else
+	{
+		auto lowestIt = std::min_element(m_freeWorkerIds.begin(), m_freeWorkerIds.end());
 
-	m_workQueue.push(work);
+		worker = m_workers[*lowestIt].get();
+		m_freeWorkerIds.erase(lowestIt);
+	}
+
+	m_runningThreads++;
+	WorkerThreadsMetric.increment();
+	ThreadLaunchesMetric.increment();
 	lock.unlock();
 
-	m_workQueueCond.notify_one();
+	try
+	{
+		// We need to launch a new thread - pass it the initial work to do to avoid queue contention
+		std::thread newThread(&Dispatcher::workerThread, this, worker, work);
+		newThread.detach();
+
+		return;
+	}
+	catch(std::system_error &)
+	{
+		// Failed to launch a thread. This can happen on low resource situations. Fall back to queuing
+		lock.lock();
+		m_runningThreads--;
+		WorkerThreadsMetric.decrement();
+		m_freeWorkerIds.push_back(worker->workerId);
+
+		m_drainCond.notify_all();
+	}
+
+	// This will be picked up by the next worker to finish its work
+	m_workQueue.push(work);
+}
+
+Dispatcher::Worker* Dispatcher::takeIdleWorker(WorkerId homeWorker)
+{
+	auto idleIt = m_idleWorkers.end() - 1;
+
+	if (homeWorker != NoWorker)
+	{
+		auto homeIt = std::find_if(m_idleWorkers.begin(), m_idleWorkers.end(), [=] (Worker *worker) {
+			return worker->workerId == homeWorker;
+		});
+
+		if (homeIt != m_idleWorkers.end())
+		{
+			idleIt = homeIt;
+		}
+	}
+
+	Worker *worker = *idleIt;
+	m_idleWorkers.erase(idleIt);
+	IdleWorkerThreadsMetric.decrement();
+
+	return worker;
 }
 
-void Dispatcher::workerThread(WorkFunction initialWork)
+void Dispatcher::workerThread(Worker *worker, WorkFunction initialWork)
 {
+	currentDispatcher = this;
+	currentWorker = worker->workerId;
+
+	if (m_pinWorkers)
+	{
+		platform::pinCurrentThreadToCpu(worker->workerId);
+	}
+
 	// Do our initial work
 	initialWork();
 
@@ -71,34 +166,55 @@ void Dispatcher::workerThread(WorkFunction initialWork)
 	{
 		std::unique_lock<std::mutex> lock(m_mutex);
 
-		// We're now idle
-		m_idleThreads++;
+		WorkFunction nextWork;
 
-		// Wait until we we either timeout or start draining
-		std::chrono::seconds timeout(5);
-		m_workQueueCond.wait_for(lock, timeout, [=]{return m_draining || !m_workQueue.empty();});
-
-		// We're no longer idle
-		m_idleThreads--;
+		if (!m_workQueue.empty())
+		{
+			nextWork = m_workQueue.front();
+			m_workQueue.pop();
+		}
+		else if (!m_draining)
+		{
+			// We're now idle
+			m_idleWorkers.push_back(worker);
+			IdleWorkerThreadsMetric.increment();
+
+			// Wait until we either timeout, receive work or start draining
+			std::chrono::seconds timeout(5);
+			worker->wakeCond.wait_for(lock, timeout, [=]{return m_draining || worker->pendingWork;});
+
+			if (worker->pendingWork)
+			{
+				// The dispatcher removed us from the idle list when it gave us work
+				nextWork = std::move(worker->pendingWork);
+				worker->pendingWork = nullptr;
+			}
+			else
+			{
+				m_idleWorkers.erase(std::find(m_idleWorkers.begin(), m_idleWorkers.end(), worker));
+				IdleWorkerThreadsMetric.decrement();
+			}
+		}
 
-		if (m_workQueue.empty())
+		if (!nextWork)
 		{
 			// Nothing to do; give up our thread
+			m_freeWorkerIds.push_back(worker->workerId);
 			m_runningThreads--;
+			WorkerThreadsMetric.decrement();
 			m_drainCond.notify_all();
 
+			currentDispatcher = nullptr;
+			currentWorker = NoWorker;
+
 			return;
 		}
 
-		// Grab the work
-		WorkFunction queuedWork(m_workQueue.front());
-		m_workQueue.pop();
-
 		// Release the lock
 		lock.unlock();
 
-		// Run the queued work outside of the lock
-		queuedWork();
+		// Run the work outside of the lock
+		nextWork();
 	}
 }
 
@@ -109,8 +225,11 @@ void Dispatcher::waitForDrain()
 	// Signal that we want to drain
 	m_draining = true;
 
-	// Wake up all of our worker threads so they notice we're draining
-	m_workQueueCond.notify_all();
+	// Wake up all of our idle workers so they notice we're draining
+	for(auto idleWorker : m_idleWorkers)
+	{
+		idleWorker->wakeCond.notify_one();
+	}
 
 	// Wait for all of the threads to stop
 	m_drainCond.wait(lock, [=]{
@@ -3,8 +3,10 @@
 
 #include <functional>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 #include <condition_variable>
 
 namespace lliby
@@ -12,19 +14,42 @@ namespace lliby
 namespace sched
 {
 
+/**
+ * Elastic pool of worker threads
+ *
+ * Work is handed directly to an idle worker if one exists; otherwise a new worker thread is launched. Workers exit
+ * after being idle for a period of time.
+ *
+ * Work can be dispatched with a preferred home worker. If that worker is idle it will receive the work, otherwise the
+ * work is stolen by whichever worker would have received it normally. This allows work operating on the same data,
+ * such as the messages for an actor, to stay on one worker and keep its data in that CPU's cache.
+ */
 class Dispatcher
 {
 public:
 	using WorkFunction = std::function<void()>;
 
+	/**
+	 * Identifies a worker thread within a dispatcher
+	 *
+	 * Worker IDs are small non-negative integers that are reused after their worker exits
+	 */
+	using WorkerId = std::int32_t;
+
+	static const WorkerId NoWorker = -1;
+
 	/**
 	 * Creates a new standlone dispatcher
+	 *
+	 * @param  pinWorkers  If true each worker will be pinned to the CPU matching its worker ID
 	 */
-	Dispatcher();
+	explicit Dispatcher(bool pinWorkers = false);
 	~Dispatcher();
 
 	/**
 	 * Returns a shared instance of the dispatcher
+	 *
+	 * Its workers are pinned to CPUs if the LLAMBDA_DISPATCHER_AFFINITY environment variable is set to 1
 	 */
 	static Dispatcher &defaultInstance();
 
@@ -33,6 +58,27 @@ public:
 	 */
 	void dispatch(const WorkFunction &work);
 
+	/**
+	 * Dispatches work preferring the passed home worker
+	 *
+	 * @param  work        Work function to dispatch
+	 * @param  homeWorker  Worker to run the work on if it's idle or NoWorker for no preference
+	 */
+	void dispatch(const WorkFunction &work, WorkerId homeWorker);
+
+	/**
+	 * Returns the ID of the calling worker thread or NoWorker if the caller isn't one of our workers
+	 */
+	WorkerId currentWorkerId() const;
+
+	/**
+	 * Returns true if our worker threads are pinned to CPUs
+	 */
+	bool pinsWorkers() const
+	{
+		return m_pinWorkers;
+	}
+
 	/**
 	 * Waits for the scheduler to drain all queued work and all worker threads to exit
 	 *
@@ -45,14 +91,41 @@ public:
 	void waitForDrain();
 
 private:
-	void workerThread(WorkFunction initialWork);
+	struct Worker
+	{
+		WorkerId workerId;
+
+		/**
+		 * Work handed to the worker while it was idle
+		 */
+		WorkFunction pendingWork;
+		std::condition_variable wakeCond;
+	};
+
+	/**
+	 * Removes a worker from the idle list, preferring the passed home worker
+	 */
+	Worker *takeIdleWorker(WorkerId homeWorker);
+
+	void workerThread(Worker *worker, WorkFunction initialWork);
+
+	const bool m_pinWorkers;
 
 	std::mutex m_mutex;
 
-	std::int32_t m_idleThreads;
 	std::int32_t m_runningThreads;
 
-	std::condition_variable m_workQueueCond;
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::vector<WorkerId> m_freeWorkerIds;
+
+	/**
+	 * Idle workers with the most recently idle worker last
+	 */
+	std::vector<Worker*> m_idleWorkers;
+
+	/**
+	 * Work that couldn't be given its own thread
+	 */
 	std::queue<WorkFunction> m_workQueue;
 
 	bool m_draining = false;
@@ -1,12 +1,32 @@
 #include "sched/TimerList.h"
 #include "sched/Dispatcher.h"
 
+#include <cassert>
+#include <limits>
+
 namespace lliby
 {
 namespace sched
 {
 
-TimerList::TimerList()
+namespace
+{
+	const std::uint64_t SlotMask = TimerList::SlotsPerLevel - 1;
+
+	/**
+	 * Largest delay in ticks that can be stored without being clamped to the top level
+	 */
+	const std::uint64_t MaximumWheelDelta = (std::uint64_t(1) << (TimerList::SlotBits * TimerList::WheelLevels)) - 1;
+
+	const std::uint64_t NoWakeTick = std::numeric_limits<std::uint64_t>::max();
+}
+
+constexpr std::chrono::milliseconds TimerList::TickDuration;
+
+TimerList::TimerList(Dispatcher &dispatcher) :
+	m_dispatcher(dispatcher),
+	m_epoch(Clock::now()),
+	m_scheduledWakeTick(NoWakeTick)
 {
 	// Now that we're initialised start the fire thread
 	m_fireThread = std::thread(&TimerList::fireThreadLoop, this);
@@ -15,21 +35,189 @@ TimerList::TimerList()
 TimerList::~TimerList()
 {
 	// We need to make sure our fire thread is shut down before we free ourselves
-	m_requestShutdown = true;
-	m_earlyWakeCond.notify_one();
+	{
+		std::unique_lock<std::mutex> locker(m_mutex);
+		m_requestShutdown = true;
+	}
 
+	m_earlyWakeCond.notify_one();
 	m_fireThread.join();
 }
 
 TimerList& TimerList::defaultInstance()
 {
-	static TimerList instance;
+	static TimerList instance(Dispatcher::defaultInstance());
 	return instance;
 }
 
+TimerList::Tick TimerList::elapsedTicks(Clock::time_point timePoint) const
+{
+	if (timePoint <= m_epoch)
+	{
+		return 0;
+	}
+
+	return (timePoint - m_epoch) / TickDuration;
+}
+
+TimerList::Clock::time_point TimerList::tickTime(Tick tick) const
+{
+	return m_epoch + (tick * TickDuration);
+}
+
+void TimerList::insertEntry(TimerEntry *entry)
+{
+	assert(entry->expiryTick >= m_currentTick);
+	const Tick delta = entry->expiryTick - m_currentTick;
+
+	TimerEntry **slotHead = nullptr;
+
+	for(unsigned int level = 0; level < WheelLevels; level++)
+	{
+		const unsigned int levelShift = SlotBits * level;
+
+		if (delta < (Tick(1) << (levelShift + SlotBits)))
+		{
+			slotHead = &m_slots[level][(entry->expiryTick >> levelShift) & SlotMask];
+			break;
+		}
+	}
+
+	if (slotHead == nullptr)
+	{
+		// Park the entry in the furthest slot of the top level. It will be reinserted when that slot is cascaded.
+		const unsigned int topShift = SlotBits * (WheelLevels - 1);
+		slotHead = &m_slots[WheelLevels - 1][((m_currentTick + MaximumWheelDelta) >> topShift) & SlotMask];
+	}
+
+	entry->slotHead = slotHead;
+	entry->prev = nullptr;
+	entry->next = *slotHead;
+
+	if (entry->next)
+	{
+		entry->next->prev = entry;
+	}
+
+	*slotHead = entry;
+}
+
+void TimerList::unlinkEntry(TimerEntry *entry)
+{
+	if (entry->prev)
+	{
+		entry->prev->next = entry->next;
+	}
+	else
+	{
+		*entry->slotHead = entry->next;
+	}
+
+	if (entry->next)
+	{
+		entry->next->prev = entry->prev;
+	}
+
+	entry->slotHead = nullptr;
+	entry->prev = entry->next = nullptr;
+}
+
+void TimerList::cascadeSlot(unsigned int level, unsigned int slot)
+{
+	TimerEntry *entry = m_slots[level][slot];
+	m_slots[level][slot] = nullptr;
+
+	while(entry)
+	{
+		TimerEntry *next = entry->next;
+		insertEntry(entry);
+
+		entry = next;
+	}
+}
+
+void TimerList::advanceTo(Tick targetTick, std::vector<WorkFunction> &expiredWork)
+{
+	while(m_currentTick < targetTick)
+	{
+		if (m_entries.empty())
+		{
+			// Nothing can expire; skip straight to the target
+			m_currentTick = targetTick;
+			break;
+		}
+
+		m_currentTick++;
+
+		// Move entries down from any higher level slots that have come due
+		for(unsigned int level = 1; level < WheelLevels; level++)
+		{
+			const unsigned int levelShift = SlotBits * level;
+
+			if ((m_currentTick & ((Tick(1) << levelShift) - 1)) != 0)
+			{
+				break;
+			}
+
+			cascadeSlot(level, (m_currentTick >> levelShift) & SlotMask);
+		}
+
+		TimerEntry *entry = m_slots[0][m_currentTick & SlotMask];
+		m_slots[0][m_currentTick & SlotMask] = nullptr;
+
+		while(entry)
+		{
+			TimerEntry *next = entry->next;
+			assert(entry->expiryTick == m_currentTick);
+
+			if (entry->intervalTicks == 0)
+			{
+				expiredWork.push_back(std::move(entry->work));
+				m_entries.erase(entry->timerId);
+			}
+			else
+			{
+				const TimerId timerId = entry->timerId;
+				const RepeatingWorkFunction repeatingWork(entry->repeatingWork);
+
+				expiredWork.push_back([=] () {
+					if (!repeatingWork())
+					{
+						cancel(timerId);
+					}
+				});
+
+				entry->expiryTick += entry->intervalTicks;
+				insertEntry(entry);
+			}
+
+			entry = next;
+		}
+	}
+}
+
+TimerList::Tick TimerList::nextWakeTick() const
+{
+	if (m_entries.empty())
+	{
+		return NoWakeTick;
+	}
+
+	// Look for the next occupied slot up to the end of the current level 0 rotation. We need to wake at the end of
+	// the rotation regardless to cascade the higher levels.
+	for(Tick tick = m_currentTick + 1; ; tick++)
+	{
+		if (((tick & SlotMask) == 0) || m_slots[0][tick & SlotMask])
+		{
+			return tick;
+		}
+	}
+}
+
 void TimerList::fireThreadLoop()
 {
 	std::unique_lock<std::mutex> locker(m_mutex);
+	std::vector<WorkFunction> expiredWork;
 
 	while(true)
 	{
@@ -39,55 +227,121 @@ void TimerList::fireThreadLoop()
 			break;
 		}
 
-		auto now = Clock::now();
+		advanceTo(elapsedTicks(Clock::now()), expiredWork);
 
-		// Fire all expired timers
-		while(m_timerQueue.size() && (m_timerQueue.top().fireTime <= now))
+		if (!expiredWork.empty())
 		{
-			auto &toFire = m_timerQueue.top();
+			// Dispatch without the lock held so work can schedule or cancel timers
+			locker.unlock();
+
+			for(auto &work : expiredWork)
+			{
+				m_dispatcher.dispatch(work);
+			}
+
+			expiredWork.clear();
+			locker.lock();
 
-			toFire.work();
-			m_timerQueue.pop();
+			continue;
 		}
 
-		if (!m_timerQueue.size())
+		m_scheduledWakeTick = nextWakeTick();
+
+		if (m_scheduledWakeTick == NoWakeTick)
 		{
 			// Nothing to wait on
 			m_earlyWakeCond.wait(locker);
 		}
 		else
 		{
-			m_earlyWakeCond.wait_until(locker, m_timerQueue.top().fireTime);
+			m_earlyWakeCond.wait_until(locker, tickTime(m_scheduledWakeTick));
 		}
 	}
 }
 
-void TimerList::enqueueDelayedWork(const WorkFunction &work, Clock::duration delay)
+TimerList::TimerId TimerList::addEntry(std::unique_ptr<TimerEntry> entry, Clock::duration delay)
 {
 	bool needsEarlyWake;
-	Clock::time_point fireTime = Clock::now() + delay;
+	const Clock::time_point fireTime = Clock::now() + delay;
+
+	// Round up so we never fire early
+	Tick expiryTick = elapsedTicks(fireTime);
+
+	if (tickTime(expiryTick) < fireTime)
+	{
+		expiryTick++;
+	}
+
+	TimerId timerId;
 
 	{
 		std::unique_lock<std::mutex> locker(m_mutex);
 
-		if (m_timerQueue.size() == 0)
-		{
-			// There's no enqueued work; perform an early wakeup
-			needsEarlyWake = true;
-		}
-		else
+		if (m_entries.empty())
 		{
-			// The next enqueued fire is before this fire; perform an early wakeup
-			needsEarlyWake = m_timerQueue.top().fireTime < fireTime;
+			// The wheel is empty so we can catch up without walking each tick
+			m_currentTick = std::max(m_currentTick, elapsedTicks(Clock::now()));
 		}
 
-		m_timerQueue.emplace(DelayedWork{work, fireTime});
+		timerId = m_nextTimerId++;
+
+		entry->timerId = timerId;
+		entry->expiryTick = std::max(expiryTick, m_currentTick + 1);
+
+		needsEarlyWake = entry->expiryTick < m_scheduledWakeTick;
+
+		TimerEntry *entryPtr = entry.get();
+		m_entries.emplace(timerId, std::move(entry));
+		insertEntry(entryPtr);
 	}
 
 	if (needsEarlyWake)
 	{
 		m_earlyWakeCond.notify_one();
 	}
+
+	return timerId;
+}
+
+TimerList::TimerId TimerList::enqueueDelayedWork(const WorkFunction &work, Clock::duration delay)
+{
+	std::unique_ptr<TimerEntry> entry(new TimerEntry);
+	entry->intervalTicks = 0;
+	entry->work = work;
+
+	return addEntry(std::move(entry), delay);
+}
+
+TimerList::TimerId TimerList::enqueueRepeatingWork(const RepeatingWorkFunction &work, Clock::duration initialDelay, Clock::duration interval)
+{
+	std::unique_ptr<TimerEntry> entry(new TimerEntry);
+	entry->intervalTicks = std::max<Tick>(1, (interval + TickDuration - Clock::duration(1)) / TickDuration);
+	entry->repeatingWork = work;
+
+	return addEntry(std::move(entry), initialDelay);
+}
+
+bool TimerList::cancel(TimerId timerId)
+{
+	std::unique_lock<std::mutex> locker(m_mutex);
+
+	auto entryIt = m_entries.find(timerId);
+
+	if (entryIt == m_entries.end())
+	{
+		return false;
+	}
+
+	unlinkEntry(entryIt->second.get());
+	m_entries.erase(entryIt);
+
+	return true;
+}
+
+std::size_t TimerList::pendingCount()
+{
+	std::unique_lock<std::mutex> locker(m_mutex);
+	return m_entries.size();
 }
 
 }
@@ -1,23 +1,32 @@
 #ifndef _LLIBY_SCHED_TIMERLIST_H
 #define _LLIBY_SCHED_TIMERLIST_H
 
-#include <queue>
 #include <functional>
 #include <chrono>
 #include <mutex>
 #include <condition_variable>
-#include <vector>
+#include <cstdint>
+#include <memory>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace lliby
 {
 namespace sched
 {
+class Dispatcher;
 
 /**
- * Basic timer list implementation
+ * Hierarchical timer wheel supporting one-shot and repeating timers with cancellation
  *
- * This is very simple without support for repeating timers or cancellation.
+ * Time is divided in to ticks of TickDuration. Pending timers are stored in intrusive lists in one of WheelLevels
+ * wheels of SlotsPerLevel slots. Each level covers SlotsPerLevel times the range of the previous level. Inserting and
+ * cancelling a timer is O(1) regardless of the number of pending timers. Timers are moved down a level when their
+ * slot on a higher level comes due.
+ *
+ * Expired work is handed to a Dispatcher after the timer list lock has been released. Work functions may run
+ * concurrently with each other and may freely call back in to the timer list.
  */
 class TimerList
 {
@@ -29,53 +38,146 @@ public:
 
 	using WorkFunction = std::function<void()>;
 
+	/**
+	 * Work function for repeating timers
+	 *
+	 * Returning false cancels the timer
+	 */
+	using RepeatingWorkFunction = std::function<bool()>;
+
+	/**
+	 * Opaque identifier for a scheduled timer
+	 *
+	 * Timer IDs are never reused during the lifetime of a timer list and are never zero
+	 */
+	using TimerId = std::uint64_t;
+
+	/**
+	 * Resolution of the timer list
+	 *
+	 * Delays are rounded up to the next tick
+	 */
+	static constexpr std::chrono::milliseconds TickDuration = std::chrono::milliseconds(1);
+
+	static const unsigned int SlotBits = 8;
+	static const unsigned int SlotsPerLevel = 1 << SlotBits;
+	static const unsigned int WheelLevels = 4;
+
 	/**
 	 * Creates a new timer list
 	 *
 	 * This will create a dedicated timer thread that will live for the duration of the instance.
+	 *
+	 * @param  dispatcher  Dispatcher to run expired work on
 	 */
-	TimerList();
+	explicit TimerList(Dispatcher &dispatcher);
 
 	~TimerList();
 
 	/**
-	 * Returns a shared instance of the timer list
+	 * Returns a shared instance of the timer list using the default dispatcher
 	 */
 	static TimerList &defaultInstance();
 
 	/**
-	 * Enqueues work to be run at a later time
+	 * Enqueues work to be run once at a later time
 	 *
-	 * @param  work   Work function to be called after the specified delay. This is called in shared timer callback
-	 *                thread with the timer list lock held. For this reason any work taking more than a trivial amount
-	 *                of time should be triggered asynchronously from this function.
+	 * @param  work   Work function to be dispatched after the specified delay
 	 * @param  delay  Amount of time to delay the call of the work function for.
+	 * @return Identifier for the timer that can be passed to cancel()
+	 */
+	TimerId enqueueDelayedWork(const WorkFunction &work, Clock::duration delay);
+
+	/**
+	 * Enqueues work to be run periodically
+	 *
+	 * Repeats are scheduled relative to the previous scheduled fire time so slow work functions don't cause the timer
+	 * to drift. If a work function is still running when the next repeat is due the repeat is dispatched concurrently.
+	 *
+	 * @param  work          Work function to be dispatched on each repeat. If this returns false the timer is
+	 *                       cancelled.
+	 * @param  initialDelay  Delay before the first call of the work function
+	 * @param  interval      Interval between subsequent calls. This is rounded up to at least one tick.
+	 * @return Identifier for the timer that can be passed to cancel()
+	 */
+	TimerId enqueueRepeatingWork(const RepeatingWorkFunction &work, Clock::duration initialDelay, Clock::duration interval);
+
+	/**
+	 * Cancels a pending timer
+	 *
+	 * Work that has already been dispatched is unaffected but a cancelled repeating timer won't be dispatched again.
+	 *
+	 * @return True if the timer was pending, false if it had already fired or been cancelled
 	 */
-	void enqueueDelayedWork(const WorkFunction &work, Clock::duration delay);
+	bool cancel(TimerId timerId);
+
+	/**
+	 * Returns the number of pending timers
+	 */
+	std::size_t pendingCount();
 
 private:
-	struct DelayedWork
+	using Tick = std::uint64_t;
+
+	struct TimerEntry
 	{
+		TimerId timerId;
+		Tick expiryTick;
+
+		/**
+		 * Interval in ticks for repeating timers or 0 for one-shot timers
+		 */
+		Tick intervalTicks;
+
 		WorkFunction work;
-		Clock::time_point fireTime;
-		std::uint64_t timerId;
-	};
+		RepeatingWorkFunction repeatingWork;
 
-	class CompareWork
-	{
-	public:
-		bool operator()(const DelayedWork &a, const DelayedWork &b)
-		{
-			// This orders the work so the next firing time is the head of the queue
-			return a.fireTime > b.fireTime;
-		}
+		TimerEntry **slotHead;
+		TimerEntry *prev;
+		TimerEntry *next;
 	};
 
+	/**
+	 * Returns the number of whole ticks between the epoch and the passed time point
+	 */
+	Tick elapsedTicks(Clock::time_point timePoint) const;
+	Clock::time_point tickTime(Tick tick) const;
+
+	TimerId addEntry(std::unique_ptr<TimerEntry> entry, Clock::duration delay);
+
+	void insertEntry(TimerEntry *entry);
+	void unlinkEntry(TimerEntry *entry);
+
+	/**
+	 * Moves all entries in a slot down to lower levels
+	 */
+	void cascadeSlot(unsigned int level, unsigned int slot);
+
+	/**
+	 * Advances the current tick to the passed tick and collects all expired work
+	 */
+	void advanceTo(Tick targetTick, std::vector<WorkFunction> &expiredWork);
+
+	/**
+	 * Returns the next tick where work may expire or a slot needs to be cascaded
+	 */
+	Tick nextWakeTick() const;
+
 	void fireThreadLoop();
 
+	Dispatcher &m_dispatcher;
+	const Clock::time_point m_epoch;
+
 	std::mutex m_mutex;
-	std::priority_queue<DelayedWork, std::vector<DelayedWork>, CompareWork> m_timerQueue;
+
+	Tick m_currentTick = 0;
+	TimerId m_nextTimerId = 1;
+
+	TimerEntry *m_slots[WheelLevels][SlotsPerLevel] = {};
+	std::unordered_map<TimerId, std::unique_ptr<TimerEntry>> m_entries;
+
 	std::condition_variable m_earlyWakeCond;
+	Tick m_scheduledWakeTick = 0;
 
 	bool m_requestShutdown = false;
 	std::thread m_fireThread;
@@ -0,0 +1,155 @@
+#include "WorldPartitioner.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include "core/World.h"
+
+#include "actor/cloneCell.h"
+
+#include "dynamic/State.h"
+
+#include "sched/Dispatcher.h"
+
+namespace lliby
+{
+namespace sched
+{
+
+namespace
+{
+	/**
+	 * Contiguous range of items processed by a single thread
+	 */
+	struct Partition
+	{
+		std::size_t start;
+		std::size_t end;
+
+		std::unique_ptr<World> world;
+		AnyCell *proc;
+		std::exception_ptr error;
+	};
+
+	void runPartition(Partition &partition, std::size_t partitionIndex, const WorldPartitioner::PartitionFunction &partitionFunc)
+	{
+		World &partitionWorld = *partition.world;
+		dynamic::State *initialState = partitionWorld.activeState();
+
+		try
+		{
+			partitionFunc(partitionWorld, partition.proc, partitionIndex, partition.start, partition.end);
+		}
+		catch(...)
+		{
+			// Leave any dynamic states the procedure entered
+			dynamic::State::popUntilState(partitionWorld, initialState);
+			partition.error = std::current_exception();
+		}
+	}
+}
+
+WorldPartitioner::WorldPartitioner(World &world, Dispatcher &dispatcher, std::size_t partitionLimit) :
+	m_world(world),
+	m_dispatcher(dispatcher),
+	m_partitionLimit(partitionLimit)
+{
+	if (m_partitionLimit == 0)
+	{
+		m_partitionLimit = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+std::size_t WorldPartitioner::partitionCount(std::size_t itemCount) const
+{
+	return std::min(m_partitionLimit, std::max<std::size_t>(1, itemCount / MinimumPartitionItems));
+}
+
+void WorldPartitioner::run(AnyCell *proc, std::size_t itemCount, const PartitionFunction &partitionFunc)
+{
+	const std::size_t totalPartitions = partitionCount(itemCount);
+
+	if (totalPartitions <= 1)
+	{
+		// Not worth parallelising; run directly in our world
+		partitionFunc(m_world, proc, 0, 0, itemCount);
+		return;
+	}
+
+	std::vector<Partition> partitions;
+	partitions.reserve(totalPartitions);
+
+	// Take ownership of every partition's cells before we report any errors
+	auto splicePartitions = [&] {
+		for(auto &partition : partitions)
+		{
+			m_world.cellHeap.splice(partition.world->cellHeap);
+		}
+	};
+
+	try
+	{
+		for(std::size_t i = 0; i < totalPartitions; i++)
+		{
+			const std::size_t start = (itemCount * i) / totalPartitions;
+			const std::size_t end = (itemCount * (i + 1)) / totalPartitions;
+
+			partitions.push_back(Partition{start, end, std::unique_ptr<World>(new World), nullptr});
+
+			Partition &partition = partitions.back();
+			partition.proc = actor::cloneCell(partition.world->cellHeap, proc, m_world.activeState());
+		}
+	}
+	catch(actor::UnclonableCellException &)
+	{
+		splicePartitions();
+		throw;
+	}
+
+	// Run every partition but the first on the dispatcher
+	std::mutex completionMutex;
+	std::condition_variable completionCond;
+	std::size_t pendingPartitions = partitions.size() - 1;
+
+	for(std::size_t i = 1; i < partitions.size(); i++)
+	{
+		Partition *partition = &partitions[i];
+
+		m_dispatcher.dispatch([=, &partitionFunc, &completionMutex, &completionCond, &pendingPartitions] {
+			runPartition(*partition, i, partitionFunc);
+
+			std::lock_guard<std::mutex> lock(completionMutex);
+
+			if (--pendingPartitions == 0)
+			{
+				completionCond.notify_one();
+			}
+		});
+	}
+
+	// Run the first partition on this thread while we wait
+	runPartition(partitions[0], 0, partitionFunc);
+
+	{
+		std::unique_lock<std::mutex> lock(completionMutex);
+		completionCond.wait(lock, [&] { return pendingPartitions == 0; });
+	}
+
+	splicePartitions();
+
+	for(auto &partition : partitions)
+	{
+		if (partition.error)
+		{
+			std::rethrow_exception(partition.error);
+		}
+	}
+}
+
+}
+}
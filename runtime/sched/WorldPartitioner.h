@@ -0,0 +1,92 @@
+#ifndef _LLIBY_SCHED_WORLDPARTITIONER_H
+#define _LLIBY_SCHED_WORLDPARTITIONER_H
+
+#include <cstddef>
+#include <functional>
+
+namespace lliby
+{
+
+class World;
+class AnyCell;
+
+namespace sched
+{
+class Dispatcher;
+
+/**
+ * Applies a procedure to partitions of an index range in parallel
+ *
+ * The range is divided in to contiguous partitions which are processed concurrently on Dispatcher threads. Each
+ * partition runs in a private World with its own clone of the procedure. This gives every partition its own copy of
+ * any mutable state captured by the procedure. Once all partitions have finished their heaps are spliced in to the
+ * calling World so any cells they created can be used directly without further copying.
+ *
+ * The calling World is blocked while the partitions run. This allows the partitions to safely read cells from the
+ * calling World, such as the elements of an input vector, as long as they don't modify them.
+ */
+class WorldPartitioner
+{
+public:
+	/**
+	 * Function called to process a partition
+	 *
+	 * @param  partitionWorld  World to apply the procedure in and allocate any results in
+	 * @param  partitionProc   Procedure to apply. This is a clone of the procedure passed to run() unless the range
+	 *                         was processed in a single partition in the calling World.
+	 * @param  partitionIndex  Index of the partition starting from zero
+	 * @param  start           Index of the first item in the partition
+	 * @param  end             Index one past the last item in the partition
+	 */
+	using PartitionFunction = std::function<void(World &partitionWorld, AnyCell *partitionProc,
+			std::size_t partitionIndex, std::size_t start, std::size_t end)>;
+
+	/**
+	 * Minimum number of items in a partition to process in parallel
+	 *
+	 * Smaller partitions aren't worth the overhead of cloning the procedure and dispatching
+	 */
+	static const std::size_t MinimumPartitionItems = 128;
+
+	/**
+	 * Creates a new partitioner
+	 *
+	 * @param  world           World to splice the partition results in to
+	 * @param  dispatcher      Dispatcher to run parallel partitions on
+	 * @param  partitionLimit  Maximum number of partitions to run concurrently. If this is 0 the number of hardware
+	 *                         threads is used.
+	 */
+	WorldPartitioner(World &world, Dispatcher &dispatcher, std::size_t partitionLimit = 0);
+
+	/**
+	 * Returns the number of partitions a range of the passed size will be divided in to
+	 */
+	std::size_t partitionCount(std::size_t itemCount) const;
+
+	/**
+	 * Calls the partition function for every partition of the range [0, itemCount)
+	 *
+	 * Ranges too small to benefit from parallelism are processed in a single partition on the calling thread in the
+	 * calling World without cloning the procedure.
+	 *
+	 * If the procedure cannot be cloned then actor::UnclonableCellException is thrown before any partitions are
+	 * processed. If any partition function throws then the exception from the lowest numbered partition is rethrown
+	 * once every partition has finished.
+	 *
+	 * @param  proc            Procedure to clone for each partition
+	 * @param  itemCount       Number of items in the range
+	 * @param  partitionFunc   Function to call for each partition. This may be called concurrently from multiple
+	 *                         threads.
+	 */
+	void run(AnyCell *proc, std::size_t itemCount, const PartitionFunction &partitionFunc);
+
+private:
+	World &m_world;
+	Dispatcher &m_dispatcher;
+	std::size_t m_partitionLimit;
+};
+
+}
+}
+
+#endif
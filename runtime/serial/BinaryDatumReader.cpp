@@ -0,0 +1,444 @@
+#include "serial/BinaryDatumReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "serial/BinaryFormat.h"
+
+#include "alloc/Heap.h"
+#include "alloc/RangeAlloc.h"
+
+#include "binding/UnitCell.h"
+#include "binding/EmptyListCell.h"
+#include "binding/BooleanCell.h"
+#include "binding/EofObjectCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
+#include "binding/CharCell.h"
+#include "binding/StringCell.h"
+#include "binding/SymbolCell.h"
+#include "binding/BytevectorCell.h"
+#include "binding/VectorCell.h"
+#include "binding/PairCell.h"
+
+#include "reader/ReadErrorException.h"
+
+namespace lliby
+{
+namespace serial
+{
+
+namespace
+{
+	// Bodies are read in chunks of this size so a corrupt length can't force a large allocation before EOF is reached
+	const std::size_t BodyReadChunkSize = 64 * 1024;
+
+	// 64bit values need at most 10 base 128 digits
+	const int MaximumVarintBytes = 10;
+}
+
+// Declared in BinaryDatumReader.h
+const unsigned int BinaryDatumReader::MaximumNestingDepth;
+
+BinaryDatumReader::BinaryDatumReader(alloc::Heap &heap, std::istream &inStream) :
+	m_heap(heap),
+	m_inStream(inStream)
+{
+}
+
+AnyCell *BinaryDatumReader::parse()
+{
+	m_headerLength = 0;
+
+	// Distinguish a clean EOF from a truncated header
+	if (m_inStream.peek() == std::istream::traits_type::eof())
+	{
+		return EofObjectCell::instance();
+	}
+
+	for(std::uint8_t magicByte : BinaryMagic)
+	{
+		if (takeHeaderByte() != magicByte)
+		{
+			throw MalformedDatumException(m_headerLength - 1, "Invalid binary datum magic");
+		}
+	}
+
+	if (takeHeaderByte() != BinaryVersion)
+	{
+		throw MalformedDatumException(m_headerLength - 1, "Unsupported binary datum version");
+	}
+
+	const std::uint64_t bodyLength = takeHeaderVarint();
+	const std::uint64_t cellCount = takeHeaderVarint();
+
+	// Every allocated cell needs at least a tag byte
+	if (cellCount > bodyLength)
+	{
+		throw MalformedDatumException(m_headerLength, "Binary datum cell count exceeds body length");
+	}
+
+	readBody(bodyLength);
+
+	// Reserve all of our cells up front and stub them so the heap can be safely collected if we fail part way through
+	m_cellCount = cellCount;
+	m_nextCell = 0;
+	m_cells = nullptr;
+	m_depth = 0;
+
+	m_nodes.clear();
+	m_nodes.reserve(cellCount);
+
+	if (cellCount > 0)
+	{
+		m_cells = static_cast<alloc::AllocCell*>(m_heap.allocate(cellCount));
+
+		for(void *placement : alloc::RangeAlloc(m_cells, m_cells + cellCount))
+		{
+			new (placement) IntegerCell(0);
+		}
+	}
+
+	AnyCell *root = parseNode();
+
+	if (m_bodyOffset != m_body.size())
+	{
+		throwMalformed("Trailing data in binary datum body");
+	}
+
+	if (m_nextCell != m_cellCount)
+	{
+		throwMalformed("Binary datum cell count mismatch");
+	}
+
+	return root;
+}
+
+AnyCell *BinaryDatumReader::parseNode()
+{
+	if (m_depth >= MaximumNestingDepth)
+	{
+		throwMalformed("Binary datum nested too deeply");
+	}
+
+	m_depth++;
+	AnyCell *node = parseNodeBody();
+	m_depth--;
+
+	return node;
+}
+
+AnyCell *BinaryDatumReader::parseNodeBody()
+{
+	const auto tag = static_cast<BinaryTag>(takeByte());
+
+	switch(tag)
+	{
+	case BinaryTag::Unit:
+		return UnitCell::instance();
+
+	case BinaryTag::EmptyList:
+		return EmptyListCell::instance();
+
+	case BinaryTag::False:
+		return BooleanCell::falseInstance();
+
+	case BinaryTag::True:
+		return BooleanCell::trueInstance();
+
+	case BinaryTag::Integer:
+		{
+			const std::uint64_t zigzagValue = takeVarint();
+			const auto value = static_cast<std::int64_t>((zigzagValue >> 1) ^ -(zigzagValue & 1));
+
+			return new (takePlacement()) IntegerCell(value);
+		}
+
+	case BinaryTag::Flonum:
+		{
+			const std::uint8_t *data = takeBytes(8);
+			std::uint64_t bits = 0;
+
+			for(int i = 0; i < 8; i++)
+			{
+				bits |= static_cast<std::uint64_t>(data[i]) << (i * 8);
+			}
+
+			double value;
+			memcpy(&value, &bits, sizeof(value));
+
+			return new (takePlacement()) FlonumCell(value);
+		}
+
+	case BinaryTag::Ratnum:
+		{
+			const std::uint64_t zigzagNumerator = takeVarint();
+			const auto numerator = static_cast<std::int64_t>((zigzagNumerator >> 1) ^ -(zigzagNumerator & 1));
+			const std::uint64_t denominator = takeVarint();
+
+			if ((denominator > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) ||
+				!RatnumCell::isReducedFraction(numerator, denominator))
+			{
+				throwMalformed("Ratnum not in lowest terms");
+			}
+
+			return new (takePlacement()) RatnumCell(numerator, denominator);
+		}
+
+	case BinaryTag::Char:
+		{
+			const std::uint64_t codePoint = takeVarint();
+
+			if ((codePoint > UnicodeChar::LastCodePoint) || !UnicodeChar(codePoint).isValid())
+			{
+				throwMalformed("Invalid Unicode code point");
+			}
+
+			return new (takePlacement()) CharCell(UnicodeChar(codePoint));
+		}
+
+	case BinaryTag::String:
+		{
+			const std::uint64_t byteLength = takeVarint();
+
+			if (byteLength > StringCell::maximumByteLength())
+			{
+				throwMalformed("String exceeds maximum length");
+			}
+
+			const std::uint8_t *data = takeBytes(byteLength);
+			return StringCell::fromUtf8Data(takePlacement(), data, byteLength);
+		}
+
+	case BinaryTag::Symbol:
+		{
+			const std::uint64_t byteLength = takeVarint();
+
+			if (byteLength > SymbolCell::maximumByteLength())
+			{
+				throwMalformed("Symbol exceeds maximum length");
+			}
+
+			const std::uint8_t *data = takeBytes(byteLength);
+			return SymbolCell::fromUtf8Data(takePlacement(), data, byteLength);
+		}
+
+	case BinaryTag::Bytevector:
+		{
+			const std::uint64_t length = takeVarint();
+
+			if (length > BytevectorCell::maximumLength())
+			{
+				throwMalformed("Bytevector exceeds maximum length");
+			}
+
+			const std::uint8_t *data = takeBytes(length);
+
+			SharedByteArray *byteArray = SharedByteArray::createUninitialised(length);
+			memcpy(byteArray->data(), data, length);
+
+			return new (takePlacement()) BytevectorCell(byteArray, length);
+		}
+
+	case BinaryTag::Vector:
+		{
+			const std::uint64_t length = takeVarint();
+
+			// Every element needs at least a tag byte
+			if (length > (m_body.size() - m_bodyOffset))
+			{
+				throwMalformed("Vector length exceeds remaining input");
+			}
+
+			if (length > VectorCell::maximumLength())
+			{
+				throwMalformed("Vector exceeds maximum length");
+			}
+
+			// Short vectors store their elements inline after the vector cell so they can't be built in our reserved
+			// range. The reserved cell is still taken to keep the node numbering but is left as a stub.
+			takePlacement();
+
+			auto vectorCell = VectorCell::createUninitialised(m_heap, length);
+
+			if (vectorCell == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			// Stub and register the vector before parsing its elements so they can refer back to it
+			std::fill(vectorCell->elements(), vectorCell->elements() + length, EmptyListCell::instance());
+			m_nodes.back() = vectorCell;
+
+			for(std::uint64_t i = 0; i < length; i++)
+			{
+				vectorCell->elements()[i] = parseNode();
+			}
+
+			return vectorCell;
+		}
+
+	case BinaryTag::List:
+		{
+			const std::uint64_t pairCount = takeVarint();
+
+			// Every car and the tail need at least a tag byte
+			if ((pairCount == 0) || (pairCount >= (m_body.size() - m_bodyOffset)))
+			{
+				throwMalformed("Invalid list length");
+			}
+
+			// Link the pairs together before parsing the cars so they can refer back to any of them
+			const std::uint64_t firstPairIndex = m_nextCell;
+			PairCell *lastPair = nullptr;
+
+			for(std::uint64_t i = 0; i < pairCount; i++)
+			{
+				auto pairCell = new (takePlacement()) PairCell(EmptyListCell::instance(), EmptyListCell::instance());
+
+				if (lastPair)
+				{
+					lastPair->setCdr(pairCell);
+				}
+
+				lastPair = pairCell;
+			}
+
+			auto headPair = reinterpret_cast<PairCell*>(&m_cells[firstPairIndex]);
+
+			for(std::uint64_t i = 0; i < pairCount; i++)
+			{
+				reinterpret_cast<PairCell*>(&m_cells[firstPairIndex + i])->setCar(parseNode());
+			}
+
+			lastPair->setCdr(parseNode());
+			return headPair;
+		}
+
+	case BinaryTag::BackReference:
+		{
+			const std::uint64_t nodeNumber = takeVarint();
+
+			if (nodeNumber >= m_nodes.size())
+			{
+				throwMalformed("Back-reference to unread node");
+			}
+
+			return m_nodes[nodeNumber];
+		}
+	}
+
+	m_bodyOffset--;
+	throwMalformed("Unknown binary datum tag");
+}
+
+void *BinaryDatumReader::takePlacement()
+{
+	if (m_nextCell >= m_cellCount)
+	{
+		throwMalformed("Binary datum cell count mismatch");
+	}
+
+	alloc::AllocCell *placement = &m_cells[m_nextCell++];
+	m_nodes.push_back(reinterpret_cast<AnyCell*>(placement));
+
+	return placement;
+}
+
+std::uint8_t BinaryDatumReader::takeByte()
+{
+	return *takeBytes(1);
+}
+
+std::uint64_t BinaryDatumReader::takeVarint()
+{
+	std::uint64_t value = 0;
+
+	for(int i = 0; i < MaximumVarintBytes; i++)
+	{
+		const std::uint8_t byte = takeByte();
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << (i * 7);
+
+		if (!(byte & 0x80))
+		{
+			return value;
+		}
+	}
+
+	throwMalformed("Varint too long");
+}
+
+const std::uint8_t *BinaryDatumReader::takeBytes(std::uint64_t byteCount)
+{
+	if (byteCount > (m_body.size() - m_bodyOffset))
+	{
+		throw UnexpectedEofException(m_headerLength + m_body.size(), "Unexpected end of binary datum body");
+	}
+
+	const std::uint8_t *data = m_body.data() + m_bodyOffset;
+	m_bodyOffset += byteCount;
+
+	return data;
+}
+
+std::uint8_t BinaryDatumReader::takeHeaderByte()
+{
+	const auto value = m_inStream.get();
+
+	if (value == std::istream::traits_type::eof())
+	{
+		throw UnexpectedEofException(m_headerLength, "Unexpected end of input in binary datum header");
+	}
+
+	m_headerLength++;
+	return value;
+}
+
+std::uint64_t BinaryDatumReader::takeHeaderVarint()
+{
+	std::uint64_t value = 0;
+
+	for(int i = 0; i < MaximumVarintBytes; i++)
+	{
+		const std::uint8_t byte = takeHeaderByte();
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << (i * 7);
+
+		if (!(byte & 0x80))
+		{
+			return value;
+		}
+	}
+
+	throw MalformedDatumException(m_headerLength, "Varint too long");
+}
+
+void BinaryDatumReader::readBody(std::uint64_t bodyLength)
+{
+	m_body.clear();
+	m_bodyOffset = 0;
+
+	while(m_body.size() < bodyLength)
+	{
+		const std::size_t oldSize = m_body.size();
+		const std::size_t chunkSize = std::min<std::uint64_t>(BodyReadChunkSize, bodyLength - oldSize);
+
+		m_body.resize(oldSize + chunkSize);
+		m_inStream.read(reinterpret_cast<char*>(&m_body[oldSize]), chunkSize);
+
+		if (static_cast<std::size_t>(m_inStream.gcount()) != chunkSize)
+		{
+			throw UnexpectedEofException(m_headerLength + oldSize + m_inStream.gcount(), "Unexpected end of input in binary datum body");
+		}
+	}
+}
+
+void BinaryDatumReader::throwMalformed(const char *errorType)
+{
+	throw MalformedDatumException(m_headerLength + m_bodyOffset, errorType);
+}
+
+}
+}
@@ -0,0 +1,88 @@
+#ifndef _LLIBY_SERIAL_BINARYDATUMREADER_H
+#define _LLIBY_SERIAL_BINARYDATUMREADER_H
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include "binding/generated/declaretypes.h"
+#include "alloc/AllocCell.h"
+
+namespace lliby
+{
+namespace alloc
+{
+class Heap;
+}
+
+namespace serial
+{
+
+/**
+ * Reads datums in the binary format described in BinaryFormat.h
+ *
+ * All the cells for a datum are reserved from the destination heap as a single contiguous range once the header has
+ * been read. Vectors are the exception as their elements may be stored inline; they're allocated directly from the
+ * destination heap. Neither allocation can trigger a garbage collection.
+ */
+class BinaryDatumReader
+{
+public:
+	/**
+	 * Maximum depth of nested nodes
+	 *
+	 * Nodes are parsed recursively. Deeper input throws MalformedDatumException instead of exhausting the stack.
+	 */
+	static const unsigned int MaximumNestingDepth = 1024;
+
+	BinaryDatumReader(alloc::Heap &heap, std::istream &inStream);
+
+	/**
+	 * Reads the next datum from the input stream
+	 *
+	 * If the stream is at end-of-file before the start of the datum the EOF object is returned. Malformed or truncated
+	 * input throws a ReadErrorException subclass and invalid UTF-8 throws utf8::InvalidByteSequenceException. The
+	 * destination heap is left in a state that is safe to garbage collect in either case.
+	 */
+	AnyCell *parse();
+
+private:
+	AnyCell *parseNode();
+	AnyCell *parseNodeBody();
+
+	/**
+	 * Returns the next reserved cell and registers it as the next node
+	 */
+	void *takePlacement();
+
+	std::uint8_t takeByte();
+	std::uint64_t takeVarint();
+	const std::uint8_t *takeBytes(std::uint64_t byteCount);
+
+	std::uint8_t takeHeaderByte();
+	std::uint64_t takeHeaderVarint();
+	void readBody(std::uint64_t bodyLength);
+
+	[[noreturn]]
+	void throwMalformed(const char *errorType);
+
+	alloc::Heap &m_heap;
+	std::istream &m_inStream;
+
+	std::vector<std::uint8_t> m_body;
+	std::size_t m_bodyOffset;
+	std::size_t m_headerLength;
+
+	alloc::AllocCell *m_cells;
+	std::uint64_t m_cellCount;
+	std::uint64_t m_nextCell;
+
+	// Every node read so far indexed by node number
+	std::vector<AnyCell*> m_nodes;
+	unsigned int m_depth;
+};
+
+}
+}
+
+#endif
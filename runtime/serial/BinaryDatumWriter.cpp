@@ -0,0 +1,249 @@
+#include "serial/BinaryDatumWriter.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "binding/UnitCell.h"
+#include "binding/EmptyListCell.h"
+#include "binding/BooleanCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
+#include "binding/CharCell.h"
+#include "binding/StringCell.h"
+#include "binding/SymbolCell.h"
+#include "binding/BytevectorCell.h"
+#include "binding/VectorCell.h"
+#include "binding/PairCell.h"
+#include "binding/ErrorCategory.h"
+
+#include "core/error.h"
+
+namespace lliby
+{
+namespace serial
+{
+
+void UnserializableCellException::signalSchemeError(World &world, const char *procName)
+{
+	std::ostringstream msgStream;
+	msgStream << "Unserializable value in " << procName << ": " << message();
+
+	signalError(world, ErrorCategory::InvalidArgument, msgStream.str(), {const_cast<AnyCell*>(cell())});
+}
+
+BinaryDatumWriter::BinaryDatumWriter(std::ostream &outStream) :
+	m_outStream(outStream)
+{
+}
+
+void BinaryDatumWriter::write(const AnyCell *datum)
+{
+	m_body.clear();
+	m_nodeNumbers.clear();
+	m_nextNodeNumber = 0;
+
+	try
+	{
+		writeNode(datum);
+	}
+	catch(const UnserializableCellException &)
+	{
+		m_body.clear();
+		throw;
+	}
+
+	// The header needs the body length so it's written once the body is complete
+	OutputBuffer output(&m_outStream);
+
+	output.append(reinterpret_cast<const char*>(BinaryMagic), sizeof(BinaryMagic));
+	output.append(static_cast<char>(BinaryVersion));
+	appendVarint(output, m_body.size());
+	appendVarint(output, m_nextNodeNumber);
+
+	output.append(m_body.data(), m_body.size());
+	output.flush();
+
+	m_body.clear();
+}
+
+void BinaryDatumWriter::writeNode(const AnyCell *datum)
+{
+	if (UnitCell::isInstance(datum))
+	{
+		writeTag(BinaryTag::Unit);
+	}
+	else if (EmptyListCell::isInstance(datum))
+	{
+		writeTag(BinaryTag::EmptyList);
+	}
+	else if (auto booleanCell = cell_cast<BooleanCell>(datum))
+	{
+		writeTag(booleanCell->value() ? BinaryTag::True : BinaryTag::False);
+	}
+	else if (auto integerCell = cell_cast<IntegerCell>(datum))
+	{
+		// Numbers and characters have no identity to preserve
+		m_nextNodeNumber++;
+
+		const std::int64_t value = integerCell->value();
+		const std::uint64_t zigzagValue = (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+
+		writeTag(BinaryTag::Integer);
+		appendVarint(m_body, zigzagValue);
+	}
+	else if (auto flonumCell = cell_cast<FlonumCell>(datum))
+	{
+		m_nextNodeNumber++;
+
+		const double value = flonumCell->value();
+		std::uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		writeTag(BinaryTag::Flonum);
+
+		for(int i = 0; i < 8; i++)
+		{
+			m_body.append(static_cast<char>(bits >> (i * 8)));
+		}
+	}
+	else if (auto ratnumCell = cell_cast<RatnumCell>(datum))
+	{
+		m_nextNodeNumber++;
+
+		const std::int64_t numerator = ratnumCell->numerator();
+		const std::uint64_t zigzagNumerator = (static_cast<std::uint64_t>(numerator) << 1) ^ static_cast<std::uint64_t>(numerator >> 63);
+
+		writeTag(BinaryTag::Ratnum);
+		appendVarint(m_body, zigzagNumerator);
+		appendVarint(m_body, ratnumCell->denominator());
+	}
+	else if (auto charCell = cell_cast<CharCell>(datum))
+	{
+		m_nextNodeNumber++;
+
+		writeTag(BinaryTag::Char);
+		appendVarint(m_body, charCell->unicodeChar().codePoint());
+	}
+	else if (auto stringCell = cell_cast<StringCell>(datum))
+	{
+		if (!writeBackReferenceOrNumber(stringCell))
+		{
+			writeByteString(BinaryTag::String, stringCell->constUtf8Data(), stringCell->byteLength());
+		}
+	}
+	else if (auto symbolCell = cell_cast<SymbolCell>(datum))
+	{
+		if (!writeBackReferenceOrNumber(symbolCell))
+		{
+			writeByteString(BinaryTag::Symbol, symbolCell->constUtf8Data(), symbolCell->byteLength());
+		}
+	}
+	else if (auto bytevectorCell = cell_cast<BytevectorCell>(datum))
+	{
+		if (!writeBackReferenceOrNumber(bytevectorCell))
+		{
+			writeByteString(BinaryTag::Bytevector, bytevectorCell->byteArray()->data(), bytevectorCell->length());
+		}
+	}
+	else if (auto vectorCell = cell_cast<VectorCell>(datum))
+	{
+		if (!writeBackReferenceOrNumber(vectorCell))
+		{
+			// The vector is numbered before its elements so they can refer back to it
+			writeTag(BinaryTag::Vector);
+			appendVarint(m_body, vectorCell->length());
+
+			for(VectorCell::LengthType i = 0; i < vectorCell->length(); i++)
+			{
+				writeNode(vectorCell->elements()[i]);
+			}
+		}
+	}
+	else if (auto pairCell = cell_cast<PairCell>(datum))
+	{
+		if (!writeBackReferenceOrNumber(pairCell))
+		{
+			writeList(pairCell);
+		}
+	}
+	else
+	{
+		throw UnserializableCellException(datum, "Only readable datums can be serialized");
+	}
+}
+
+void BinaryDatumWriter::writeList(const PairCell *head)
+{
+	// The head has already been numbered; number the rest of the cdr chain until we reach a non-pair or a pair that
+	// has already been written
+	std::uint64_t pairCount = 1;
+	const PairCell *lastPair = head;
+
+	while(auto nextPair = cell_cast<PairCell>(lastPair->cdr()))
+	{
+		if (m_nodeNumbers.count(nextPair))
+		{
+			break;
+		}
+
+		m_nodeNumbers.emplace(nextPair, m_nextNodeNumber++);
+		pairCount++;
+
+		lastPair = nextPair;
+	}
+
+	writeTag(BinaryTag::List);
+	appendVarint(m_body, pairCount);
+
+	const PairCell *pair = head;
+
+	for(std::uint64_t i = 0; i < pairCount; i++)
+	{
+		writeNode(pair->car());
+
+		if (i != (pairCount - 1))
+		{
+			pair = cell_unchecked_cast<PairCell>(pair->cdr());
+		}
+	}
+
+	writeNode(lastPair->cdr());
+}
+
+void BinaryDatumWriter::writeByteString(BinaryTag tag, const std::uint8_t *data, std::size_t byteLength)
+{
+	writeTag(tag);
+	appendVarint(m_body, byteLength);
+	m_body.append(data, byteLength);
+}
+
+bool BinaryDatumWriter::writeBackReferenceOrNumber(const AnyCell *cell)
+{
+	auto result = m_nodeNumbers.emplace(cell, m_nextNodeNumber);
+
+	if (!result.second)
+	{
+		writeTag(BinaryTag::BackReference);
+		appendVarint(m_body, result.first->second);
+
+		return true;
+	}
+
+	m_nextNodeNumber++;
+	return false;
+}
+
+void BinaryDatumWriter::appendVarint(OutputBuffer &buffer, std::uint64_t value)
+{
+	while(value >= 0x80)
+	{
+		buffer.append(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+
+	buffer.append(static_cast<char>(value));
+}
+
+}
+}
@@ -0,0 +1,108 @@
+#ifndef _LLIBY_SERIAL_BINARYDATUMWRITER_H
+#define _LLIBY_SERIAL_BINARYDATUMWRITER_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+
+#include "binding/generated/declaretypes.h"
+#include "serial/BinaryFormat.h"
+#include "writer/OutputBuffer.h"
+
+namespace lliby
+{
+class World;
+
+namespace serial
+{
+
+/**
+ * Thrown by BinaryDatumWriter::write() when a datum contains a cell with no binary representation
+ */
+class UnserializableCellException
+{
+public:
+	UnserializableCellException(const AnyCell *cell, const char *message) :
+		m_cell(cell),
+		m_message(message)
+	{
+	}
+
+	/**
+	 * Returns the unserializable cell
+	 */
+	const AnyCell *cell() const
+	{
+		return m_cell;
+	}
+
+	/**
+	 * Returns a user-readable string describing the reason for serialization failure
+	 */
+	const char *message() const
+	{
+		return m_message;
+	}
+
+	/**
+	 * Converts this exception to a Scheme error
+	 *
+	 * @param  world     World to signal the error in
+	 * @param  procName  Name of the Scheme procedure signalling the error
+	 */
+	[[noreturn]]
+	void signalSchemeError(World &world, const char *procName);
+
+private:
+	const AnyCell *m_cell;
+	const char *m_message;
+};
+
+/**
+ * Writes datums in the binary format described in BinaryFormat.h
+ *
+ * Shared and cyclic structure within a single written datum is preserved. Each call to write() produces an independent
+ * encoding; structure isn't shared between them.
+ */
+class BinaryDatumWriter
+{
+public:
+	explicit BinaryDatumWriter(std::ostream &outStream);
+
+	/**
+	 * Writes the passed datum to the output stream
+	 *
+	 * If the datum cannot be serialized an UnserializableCellException is thrown and nothing is written to the stream
+	 */
+	void write(const AnyCell *datum);
+
+private:
+	void writeNode(const AnyCell *datum);
+	void writeList(const PairCell *head);
+	void writeByteString(BinaryTag tag, const std::uint8_t *data, std::size_t byteLength);
+
+	void writeTag(BinaryTag tag)
+	{
+		m_body.append(static_cast<char>(tag));
+	}
+
+	/**
+	 * Writes a back-reference if the cell has already been written, otherwise assigns it the next node number
+	 *
+	 * @return  True if a back-reference was written
+	 */
+	bool writeBackReferenceOrNumber(const AnyCell *cell);
+
+	static void appendVarint(OutputBuffer &buffer, std::uint64_t value);
+
+	std::ostream &m_outStream;
+
+	OutputBuffer m_body;
+	std::unordered_map<const AnyCell*, std::uint64_t> m_nodeNumbers;
+	std::uint64_t m_nextNodeNumber;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef _LLIBY_SERIAL_BINARYFORMAT_H
+#define _LLIBY_SERIAL_BINARYFORMAT_H
+
+#include <cstdint>
+
+/**
+ * Constants for the binary datum format
+ *
+ * An encoded datum consists of a header followed by a body containing a single root node:
+ *
+ * - 4 byte magic value "LLBD"
+ * - 1 byte format version
+ * - Varint length of the body in bytes
+ * - Varint number of cells allocated by the body
+ *
+ * Each node starts with a one byte tag. Varints are unsigned little-endian base 128. Integers are zigzag encoded before
+ * being written as varints. Every node other than constants and back-references allocates one cell per encoded value,
+ * and is numbered in the order it's encoded starting from zero. Back-references refer to a previous node by this
+ * number, so shared and cyclic structure is preserved.
+ */
+namespace lliby
+{
+namespace serial
+{
+
+const std::uint8_t BinaryMagic[4] = {'L', 'L', 'B', 'D'};
+const std::uint8_t BinaryVersion = 1;
+
+enum class BinaryTag : std::uint8_t
+{
+	// Constants; these don't allocate cells
+	Unit = 0x00,
+	EmptyList = 0x01,
+	False = 0x02,
+	True = 0x03,
+
+	// Zigzag varint value
+	Integer = 0x10,
+	// Raw IEEE 754 double in little-endian byte order
+	Flonum = 0x11,
+	// Varint Unicode code point
+	Char = 0x12,
+	// Varint byte length followed by UTF-8 data
+	String = 0x13,
+	Symbol = 0x14,
+	// Varint byte length followed by data
+	Bytevector = 0x15,
+	// Varint element count followed by element nodes
+	Vector = 0x16,
+	// Varint pair count followed by the car nodes and then a node for the final cdr
+	List = 0x17,
+	// Zigzag varint numerator followed by varint denominator
+	Ratnum = 0x18,
+
+	// Varint node number of a previously encoded node
+	BackReference = 0x20
+};
+
+}
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <thread>
 #include <chrono>
+#include <memory>
 
 #include "binding/MailboxCell.h"
 #include "binding/UnitCell.h"
@@ -70,24 +71,27 @@ void llactor_tell(World &world, MailboxCell *destMailboxCell, AnyCell *messageCe
 {
 	std::shared_ptr<actor::Mailbox> destMailbox(destMailboxCell->lockedMailbox());
 
-	if (destMailbox)
+	if (destMailbox && !destMailbox->tell(createTellMessage(world, "(tell)", messageCell)))
 	{
-		destMailbox->tell(createTellMessage(world, "(tell)", messageCell));
+		signalError(world, ErrorCategory::MailboxFull, "(tell) to full mailbox", {destMailboxCell});
 	}
 }
 
-void llactor_schedule_once(World &world, std::int64_t delayUsecs, MailboxCell *destMailboxCell, AnyCell *messageCell)
+std::int64_t llactor_schedule_once(World &world, std::int64_t delayUsecs, MailboxCell *destMailboxCell, AnyCell *messageCell)
 {
 	std::weak_ptr<actor::Mailbox> mailboxRef = destMailboxCell->mailboxRef();
 
 	if (mailboxRef.expired())
 	{
 		// Already expired; skip the enqueue
-		return;
+		return 0;
 	}
 
 	const std::chrono::microseconds delay(delayUsecs);
-	actor::Message *msg = createTellMessage(world, "(schedule-once)", messageCell);
+
+	// The message is freed along with the work function if the timer is cancelled or the mailbox expires
+	auto msgOwner = std::make_shared<std::unique_ptr<actor::Message>>(
+			createTellMessage(world, "(schedule-once)", messageCell));
 
 	auto workFunction = [=] ()
 	{
@@ -96,14 +100,55 @@ void llactor_schedule_once(World &world, std::int64_t delayUsecs, MailboxCell *d
 		if (!destMailbox)
 		{
 			// Expired while we were sleeping
-			delete msg;
 			return;
 		}
 
-		destMailbox->tell(msg);
+		destMailbox->tell(msgOwner->release());
 	};
 
-	sched::TimerList::defaultInstance().enqueueDelayedWork(workFunction, delay);
+	return sched::TimerList::defaultInstance().enqueueDelayedWork(workFunction, delay);
+}
+
+std::int64_t llactor_schedule_repeatedly(World &world, std::int64_t initialDelayUsecs, std::int64_t intervalUsecs, MailboxCell *destMailboxCell, AnyCell *messageCell)
+{
+	std::weak_ptr<actor::Mailbox> mailboxRef = destMailboxCell->mailboxRef();
+
+	if (intervalUsecs <= 0)
+	{
+		signalError(world, ErrorCategory::Range, "Non-positive interval passed to (schedule-repeatedly)");
+	}
+
+	if (mailboxRef.expired())
+	{
+		// Already expired; skip the enqueue
+		return 0;
+	}
+
+	// Each repeat sends a fresh clone of this prototype message
+	std::shared_ptr<actor::Message> prototypeMsg(createTellMessage(world, "(schedule-repeatedly)", messageCell));
+
+	auto workFunction = [=] ()
+	{
+		std::shared_ptr<actor::Mailbox> destMailbox = mailboxRef.lock();
+
+		if (!destMailbox)
+		{
+			// Stop repeating once the destination has gone away
+			return false;
+		}
+
+		destMailbox->tell(actor::Message::createFromCell(prototypeMsg->messageCell(), prototypeMsg->sender()));
+		return true;
+	};
+
+	return sched::TimerList::defaultInstance().enqueueRepeatingWork(workFunction,
+			std::chrono::microseconds(initialDelayUsecs),
+			std::chrono::microseconds(intervalUsecs));
+}
+
+bool llactor_cancel_schedule(std::int64_t timerId)
+{
+	return sched::TimerList::defaultInstance().cancel(timerId);
 }
 
 void llactor_forward(World &world, MailboxCell *destMailboxCell, AnyCell *messageCell)
@@ -123,15 +168,22 @@ void llactor_forward(World &world, MailboxCell *destMailboxCell, AnyCell *messag
 		signalError(world, ErrorCategory::NoActor, "Attempted (forward) outside actor context");
 	}
 
+	bool enqueued;
+
 	try
 	{
 		actor::Message *msg = actor::Message::createFromCell(messageCell, context->sender());
-		destMailbox->tell(msg);
+		enqueued = destMailbox->tell(msg);
 	}
 	catch(actor::UnclonableCellException &e)
 	{
 		e.signalSchemeError(world, "(forward)");
 	}
+
+	if (!enqueued)
+	{
+		signalError(world, ErrorCategory::MailboxFull, "(forward) to full mailbox", {destMailboxCell});
+	}
 }
 
 AnyCell* llactor_ask(World &world, MailboxCell *destMailboxCell, AnyCell *messageCell, std::int64_t timeoutUsecs)
@@ -224,6 +276,33 @@ bool llactor_mailbox_is_open(World &world, MailboxCell *mailboxCell)
 	return !mailboxCell->mailbox().expired();
 }
 
+void llactor_set_mailbox_capacity(World &world, MailboxCell *mailboxCell, std::int64_t capacity, std::int32_t policy)
+{
+	if (capacity < 1)
+	{
+		signalError(world, ErrorCategory::Range, "Non-positive capacity passed to (set-mailbox-capacity)");
+	}
+
+	std::shared_ptr<actor::Mailbox> mailbox(mailboxCell->lockedMailbox());
+
+	if (mailbox)
+	{
+		mailbox->setCapacity(capacity, static_cast<actor::OverflowPolicy>(policy));
+	}
+}
+
+std::int64_t llactor_mailbox_queue_depth(World &world, MailboxCell *mailboxCell)
+{
+	std::shared_ptr<actor::Mailbox> mailbox(mailboxCell->lockedMailbox());
+
+	if (!mailbox)
+	{
+		return 0;
+	}
+
+	return mailbox->queueDepth();
+}
+
 actor::PoisonPillCell* llactor_poison_pill_object()
 {
 	return actor::PoisonPillCell::instance();
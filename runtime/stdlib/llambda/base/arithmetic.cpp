@@ -1,6 +1,7 @@
 #include "binding/NumberCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/ProperList.h"
 #include "binding/TypedPairCell.h"
 
@@ -11,6 +12,8 @@
 
 #include "core/error.h"
 
+#include "util/binaryGcd.h"
+
 using namespace lliby;
 
 namespace
@@ -37,8 +40,8 @@ namespace
 			}
 			else
 			{
-				auto denomintorFlonum = cell_unchecked_cast<FlonumCell>(denominatorCell);
-				numeratorValue /= denomintorFlonum->value();
+				// Flonums and ratnums are both non-zero or inexact
+				numeratorValue /= denominatorCell->toDouble();
 			}
 		}
 
@@ -58,7 +61,7 @@ namespace
 		std::int64_t quotient = numerator / denominator;
 		std::int64_t remainder = numerator % denominator;
 
-		if ((quotient < 0) && (remainder != 0))
+		if ((remainder != 0) && ((remainder < 0) != (denominator < 0)))
 		{
 			// Fall down to the previous value
 			quotient--;
@@ -68,24 +71,220 @@ namespace
 		return {quotient, remainder};
 	}
 
-	std::int64_t greatestCommonDivisor(std::int64_t a, std::int64_t b)
+	std::uint64_t integerMagnitude(std::int64_t value)
+	{
+		// Negate as unsigned to avoid overflowing on the minimum value
+		return (value < 0) ? (std::uint64_t(0) - static_cast<std::uint64_t>(value)) : static_cast<std::uint64_t>(value);
+	}
+
+	std::uint64_t greatestCommonDivisor(std::uint64_t a, std::int64_t b)
+	{
+		return binaryGcd(a, integerMagnitude(b));
+	}
+
+	/**
+	 * Exact value in lowest terms with a positive denominator
+	 *
+	 * Integers have a denominator of one
+	 */
+	struct ExactFraction
+	{
+		std::int64_t numerator;
+		std::int64_t denominator;
+	};
+
+	/**
+	 * Result of exact arithmetic before it has been narrowed back to 64bit components
+	 *
+	 * Rational arithmetic follows Knuth's algorithms in TAOCP 4.5.1. These divide out common factors before
+	 * multiplying so the result is already in lowest terms and only overflows if the result itself does not fit.
+	 */
+	struct WideFraction
 	{
-		if (b == 0)
+		__int128 numerator;
+		__int128 denominator;
+
+		bool fitsExactFraction() const
 		{
-			return a;
+			return (numerator >= std::numeric_limits<std::int64_t>::min()) &&
+				   (numerator <= std::numeric_limits<std::int64_t>::max()) &&
+				   (denominator <= std::numeric_limits<std::int64_t>::max());
 		}
-		else
+
+		ExactFraction toExactFraction() const
+		{
+			return {static_cast<std::int64_t>(numerator), static_cast<std::int64_t>(denominator)};
+		}
+
+		double toDouble() const
+		{
+			return static_cast<double>(numerator) / static_cast<double>(denominator);
+		}
+	};
+
+	std::uint64_t wideMagnitude(__int128 value)
+	{
+		// Callers only pass values with a magnitude of at most 2^63
+		return (value < 0) ? static_cast<std::uint64_t>(-value) : static_cast<std::uint64_t>(value);
+	}
+
+	/**
+	 * Loads the exact fraction for an integer or ratnum
+	 *
+	 * @return False if the number is a flonum
+	 */
+	bool exactFractionForCell(const NumberCell *number, ExactFraction &result)
+	{
+		if (auto integer = cell_cast<IntegerCell>(number))
+		{
+			result = {integer->value(), 1};
+			return true;
+		}
+		else if (auto ratnum = cell_cast<RatnumCell>(number))
 		{
-			return greatestCommonDivisor(b, a % b);
+			result = {ratnum->numerator(), ratnum->denominator()};
+			return true;
 		}
+
+		return false;
 	}
 
-	std::int64_t leastCommonMultiple(std::int64_t a, std::int64_t b)
+	NumberCell *exactFractionToCell(World &world, const ExactFraction &fraction)
 	{
-		const std::int64_t product = a * b;
-		const std::int64_t gcm = greatestCommonDivisor(a, b);
+		if (fraction.denominator == 1)
+		{
+			return IntegerCell::fromValue(world, fraction.numerator);
+		}
+
+		void *cellPlacement = alloc::allocateCells(world);
+		return new (cellPlacement) RatnumCell(fraction.numerator, fraction.denominator);
+	}
 
-		return product / gcm;
+	double exactFractionToDouble(const ExactFraction &fraction)
+	{
+		return static_cast<double>(fraction.numerator) / static_cast<double>(fraction.denominator);
+	}
+
+	WideFraction addFractions(const ExactFraction &left, const ExactFraction &right, bool subtract = false)
+	{
+		const __int128 rightNumerator = subtract ? -static_cast<__int128>(right.numerator) : right.numerator;
+		const std::uint64_t denominatorGcd = binaryGcd(left.denominator, right.denominator);
+
+		if (denominatorGcd == 1)
+		{
+			return {
+				left.numerator * static_cast<__int128>(right.denominator) + rightNumerator * left.denominator,
+				static_cast<__int128>(left.denominator) * right.denominator
+			};
+		}
+
+		const __int128 t = left.numerator * static_cast<__int128>(right.denominator / denominatorGcd) +
+			rightNumerator * (left.denominator / denominatorGcd);
+
+		if (t == 0)
+		{
+			return {0, 1};
+		}
+
+		// Only factors of the denominator GCD can remain in common with the new numerator
+		const std::uint64_t remainderGcd = binaryGcd(wideMagnitude(t % denominatorGcd), denominatorGcd);
+
+		return {
+			t / remainderGcd,
+			static_cast<__int128>(left.denominator / denominatorGcd) * (right.denominator / remainderGcd)
+		};
+	}
+
+	/**
+	 * Multiplies two fractions in lowest terms with positive denominators
+	 *
+	 * Components may have a magnitude of up to 2^63 to allow the reciprocal of any ExactFraction to be passed
+	 */
+	WideFraction multiplyFractions(__int128 leftNumerator, __int128 leftDenominator, __int128 rightNumerator, __int128 rightDenominator)
+	{
+		if ((leftNumerator == 0) || (rightNumerator == 0))
+		{
+			return {0, 1};
+		}
+
+		const std::uint64_t leftGcd = binaryGcd(wideMagnitude(leftNumerator), wideMagnitude(rightDenominator));
+		const std::uint64_t rightGcd = binaryGcd(wideMagnitude(rightNumerator), wideMagnitude(leftDenominator));
+
+		return {
+			(leftNumerator / leftGcd) * (rightNumerator / rightGcd),
+			(leftDenominator / rightGcd) * (rightDenominator / leftGcd)
+		};
+	}
+
+	WideFraction multiplyFractions(const ExactFraction &left, const ExactFraction &right)
+	{
+		return multiplyFractions(left.numerator, left.denominator, right.numerator, right.denominator);
+	}
+
+	/**
+	 * Divides two fractions
+	 *
+	 * The right fraction must be non-zero
+	 */
+	WideFraction divideFractions(const ExactFraction &left, const ExactFraction &right)
+	{
+		// Multiply by the reciprocal while keeping its denominator positive
+		if (right.numerator < 0)
+		{
+			return multiplyFractions(left.numerator, left.denominator,
+					-static_cast<__int128>(right.denominator), -static_cast<__int128>(right.numerator));
+		}
+
+		return multiplyFractions(left.numerator, left.denominator, right.denominator, right.numerator);
+	}
+
+	std::int64_t leastCommonMultiple(World &world, std::int64_t a, std::int64_t b)
+	{
+		if ((a == 0) || (b == 0))
+		{
+			return 0;
+		}
+
+		// Divide before multiplying so we only overflow if the result itself overflows
+		const std::uint64_t gcd = greatestCommonDivisor(integerMagnitude(a), b);
+		std::uint64_t result;
+
+		if (__builtin_mul_overflow(integerMagnitude(a) / gcd, integerMagnitude(b), &result) ||
+			(result > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())))
+		{
+			signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (lcm)");
+		}
+
+		return result;
+	}
+
+	/**
+	 * Raises an integer to a non-negative integer power by repeated squaring
+	 *
+	 * @return False if the result overflows
+	 */
+	bool exactIntegerPower(std::int64_t base, std::int64_t power, std::int64_t &result)
+	{
+		long long accum = 1;
+		long long square = base;
+
+		while(power != 0)
+		{
+			if ((power & 1) && __builtin_smulll_overflow(accum, square, &accum))
+			{
+				return false;
+			}
+
+			power >>= 1;
+
+			if ((power != 0) && __builtin_smulll_overflow(square, square, &square))
+			{
+				return false;
+			}
+		}
+
+		result = accum;
+		return true;
 	}
 
 	bool integerDivisionWouldOverflow(std::int64_t num, std::int64_t denom)
@@ -128,6 +327,7 @@ extern "C"
 NumberCell *llbase_add(World &world, RestValues<NumberCell> *argList)
 {
 	std::int64_t integerSum = 0;
+	ExactFraction ratnumSum = {0, 1};
 	double flonumSum = 0.0;
 	bool resultIsFlonum = false;
 	bool integerOverflowed = false;
@@ -149,6 +349,20 @@ NumberCell *llbase_add(World &world, RestValues<NumberCell> *argList)
 				integerSum = nonOverflowSum;
 			}
 		}
+		else if (auto ratnum = cell_cast<RatnumCell>(numeric))
+		{
+			const WideFraction wideSum = addFractions(ratnumSum, {ratnum->numerator(), ratnum->denominator()});
+
+			if (wideSum.fitsExactFraction())
+			{
+				ratnumSum = wideSum.toExactFraction();
+			}
+			else
+			{
+				flonumSum += ratnum->toDouble();
+				integerOverflowed = true;
+			}
+		}
 		else
 		{
 			auto flonum = cell_unchecked_cast<FlonumCell>(numeric);
@@ -160,22 +374,23 @@ NumberCell *llbase_add(World &world, RestValues<NumberCell> *argList)
 
 	if (resultIsFlonum)
 	{
-		return FlonumCell::fromValue(world, integerSum + flonumSum);
+		return FlonumCell::fromValue(world, integerSum + exactFractionToDouble(ratnumSum) + flonumSum);
 	}
-	else
-	{
-		if (integerOverflowed)
-		{
-			signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (+)");
-		}
 
-		return IntegerCell::fromValue(world, integerSum);
+	const WideFraction exactSum = addFractions({integerSum, 1}, ratnumSum);
+
+	if (integerOverflowed || !exactSum.fitsExactFraction())
+	{
+		signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (+)");
 	}
+
+	return exactFractionToCell(world, exactSum.toExactFraction());
 }
 
 NumberCell *llbase_mul(World &world, RestValues<NumberCell> *argList)
 {
 	std::int64_t integerProduct = 1;
+	ExactFraction ratnumProduct = {1, 1};
 	double flonumProduct = 1.0;
 	bool resultIsFlonum = false;
 	bool integerOverflowed = false;
@@ -197,6 +412,20 @@ NumberCell *llbase_mul(World &world, RestValues<NumberCell> *argList)
 				integerProduct = nonOverflowProduct;
 			}
 		}
+		else if (auto ratnum = cell_cast<RatnumCell>(numeric))
+		{
+			const WideFraction wideProduct = multiplyFractions(ratnumProduct, {ratnum->numerator(), ratnum->denominator()});
+
+			if (wideProduct.fitsExactFraction())
+			{
+				ratnumProduct = wideProduct.toExactFraction();
+			}
+			else
+			{
+				flonumProduct *= ratnum->toDouble();
+				integerOverflowed = true;
+			}
+		}
 		else
 		{
 			auto flonum = cell_unchecked_cast<FlonumCell>(numeric);
@@ -208,22 +437,23 @@ NumberCell *llbase_mul(World &world, RestValues<NumberCell> *argList)
 
 	if (resultIsFlonum)
 	{
-		return FlonumCell::fromValue(world, integerProduct * flonumProduct);
+		return FlonumCell::fromValue(world, integerProduct * exactFractionToDouble(ratnumProduct) * flonumProduct);
 	}
-	else
-	{
-		if (integerOverflowed)
-		{
-			signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (*)");
-		}
 
-		return IntegerCell::fromValue(world, integerProduct);
+	const WideFraction exactProduct = multiplyFractions({integerProduct, 1}, ratnumProduct);
+
+	if (integerOverflowed || !exactProduct.fitsExactFraction())
+	{
+		signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (*)");
 	}
+
+	return exactFractionToCell(world, exactProduct.toExactFraction());
 }
 
 NumberCell *llbase_sub(World &world, NumberCell *startValue, RestValues<NumberCell> *argList)
 {
 	std::int64_t integerDifference;
+	ExactFraction ratnumDifference = {0, 1};
 	double flonumDifference;
 	bool resultIsFlonum;
 	bool integerOverflowed = false;
@@ -247,6 +477,26 @@ NumberCell *llbase_sub(World &world, NumberCell *startValue, RestValues<NumberCe
 		flonumDifference = 0.0;
 		resultIsFlonum = false;
 	}
+	else if (auto ratnum = cell_cast<RatnumCell>(startValue))
+	{
+		if (argList->empty())
+		{
+			// Return the inverse
+			long long inverseNumerator;
+
+			if (__builtin_ssubll_overflow(0LL, ratnum->numerator(), &inverseNumerator))
+			{
+				signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in inverting (-)");
+			}
+
+			return exactFractionToCell(world, {inverseNumerator, ratnum->denominator()});
+		}
+
+		integerDifference = 0;
+		ratnumDifference = {ratnum->numerator(), ratnum->denominator()};
+		flonumDifference = 0.0;
+		resultIsFlonum = false;
+	}
 	else
 	{
 		auto flonum = cell_unchecked_cast<FlonumCell>(startValue);
@@ -279,6 +529,20 @@ NumberCell *llbase_sub(World &world, NumberCell *startValue, RestValues<NumberCe
 				integerDifference = nonOverflowDifference;
 			}
 		}
+		else if (auto ratnum = cell_cast<RatnumCell>(numeric))
+		{
+			const WideFraction wideDifference = addFractions(ratnumDifference, {ratnum->numerator(), ratnum->denominator()}, true);
+
+			if (wideDifference.fitsExactFraction())
+			{
+				ratnumDifference = wideDifference.toExactFraction();
+			}
+			else
+			{
+				flonumDifference -= ratnum->toDouble();
+				integerOverflowed = true;
+			}
+		}
 		else
 		{
 			auto flonum = cell_unchecked_cast<FlonumCell>(numeric);
@@ -290,91 +554,85 @@ NumberCell *llbase_sub(World &world, NumberCell *startValue, RestValues<NumberCe
 
 	if (resultIsFlonum)
 	{
-		return FlonumCell::fromValue(world, integerDifference + flonumDifference);
+		return FlonumCell::fromValue(world, integerDifference + exactFractionToDouble(ratnumDifference) + flonumDifference);
 	}
-	else
-	{
-		if (integerOverflowed)
-		{
-			signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in subtracting (-)");
-		}
 
-		return IntegerCell::fromValue(world, integerDifference);
+	const WideFraction exactDifference = addFractions({integerDifference, 1}, ratnumDifference);
+
+	if (integerOverflowed || !exactDifference.fitsExactFraction())
+	{
+		signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in subtracting (-)");
 	}
+
+	return exactFractionToCell(world, exactDifference.toExactFraction());
 }
 
 NumberCell* llbase_div(World &world, NumberCell *startValue, RestValues<NumberCell> *argList)
 {
+	ExactFraction exactQuotient;
+
+	if (!exactFractionForCell(startValue, exactQuotient))
+	{
+		double startDouble = cell_unchecked_cast<FlonumCell>(startValue)->value();
+		return flonumDivision(world, startDouble, argList->begin(), argList->end());
+	}
+
 	if (argList->empty())
 	{
 		// Return the reciprocal
-		// This can only be an integer if startValue is an integer 1 or -1
-		if (auto startIntCell = cell_cast<IntegerCell>(startValue))
+		if (exactQuotient.numerator == 0)
 		{
-			std::int64_t startInt = startIntCell->value();
+			signalError(world, ErrorCategory::DivideByZero, "Attempted reciprocal (/) by integer zero");
+		}
 
-			if (startInt == 0)
-			{
-				signalError(world, ErrorCategory::DivideByZero, "Attempted reciprocal (/) by integer zero");
-			}
+		const WideFraction reciprocal = divideFractions({1, 1}, exactQuotient);
 
-			if ((startInt == 1) || (startInt == -1))
-			{
-				return startIntCell;
-			}
+		if (!reciprocal.fitsExactFraction())
+		{
+			// This can only happen for the minimum integer
+			return FlonumCell::fromValue(world, reciprocal.toDouble());
 		}
 
-		// Perform flonum reciprocal
-		return FlonumCell::fromValue(world, 1.0 / startValue->toDouble());
+		return exactFractionToCell(world, reciprocal.toExactFraction());
 	}
 
-	if (auto startIntCell = cell_cast<IntegerCell>(startValue))
+	// Perform exact division until we hit a flonum value
+	for (auto it = argList->begin(); it != argList->end(); it++)
 	{
-		// Perform integer division until we hit a flonum value
-		std::int64_t numeratorInt = startIntCell->value();
+		ExactFraction exactDenominator;
 
-		for (auto it = argList->begin(); it != argList->end(); it++)
+		if (!exactFractionForCell(*it, exactDenominator))
 		{
-			if (auto denomintorInteger = cell_cast<IntegerCell>(*it))
-			{
-				// We have another integer!
-				std::int64_t denominatorInt = denomintorInteger->value();
+			// This is a flonum. Have flonumDivision() handle this value
+			return flonumDivision(world, exactFractionToDouble(exactQuotient), it, argList->end());
+		}
 
-				// Check for divide by zero
-				if (denominatorInt == 0)
-				{
-					signalError(world, ErrorCategory::DivideByZero, "Attempted (/) by integer zero");
-				}
+		if (exactDenominator.numerator == 0)
+		{
+			signalError(world, ErrorCategory::DivideByZero, "Attempted (/) by integer zero");
+		}
 
-				// Does it divide exactly and is not an or overflow?
-				if (!integerDivisionWouldOverflow(numeratorInt, denominatorInt) &&
-					((numeratorInt % denominatorInt) == 0))
-				{
-					// Yes!
-					numeratorInt = numeratorInt / denominatorInt;
-				}
-				else
-				{
-					// No; perform this division as flonum and pass the tail to flonumDivision()
-					double flonumResult = static_cast<double>(numeratorInt) / static_cast<double>(denominatorInt);
-					return flonumDivision(world, flonumResult, ++it, argList->end());
-				}
-			}
-			else
-			{
-				// Nope, this is a flonum. Have flonumDivision() handle this value
-				return flonumDivision(world, static_cast<double>(numeratorInt), it, argList->end());
-			}
+		if ((exactQuotient.denominator == 1) && (exactDenominator.denominator == 1) &&
+			!integerDivisionWouldOverflow(exactQuotient.numerator, exactDenominator.numerator) &&
+			((exactQuotient.numerator % exactDenominator.numerator) == 0))
+		{
+			// Integers dividing exactly don't need a GCD
+			exactQuotient.numerator /= exactDenominator.numerator;
+			continue;
 		}
 
-		// We have an integer result somehow!
-		return IntegerCell::fromValue(world, numeratorInt);
-	}
-	else
-	{
-		double startDouble = cell_unchecked_cast<FlonumCell>(startValue)->value();
-		return flonumDivision(world, startDouble, argList->begin(), argList->end());
+		const WideFraction wideQuotient = divideFractions(exactQuotient, exactDenominator);
+
+		if (!wideQuotient.fitsExactFraction())
+		{
+			// There are no bignums; perform the rest of the division as flonum
+			return flonumDivision(world, wideQuotient.toDouble(), ++it, argList->end());
+		}
+
+		exactQuotient = wideQuotient.toExactFraction();
 	}
+
+	return exactFractionToCell(world, exactQuotient);
 }
 
 TypedPairCell<IntegerCell, IntegerCell>* llbase_truncate_div(World &world, std::int64_t numerator, std::int64_t denominator)
@@ -475,6 +733,44 @@ std::int64_t llbase_floor_remainder(World &world, std::int64_t numerator, std::i
 
 NumberCell* llbase_expt(World &world, NumberCell *base, NumberCell *power)
 {
+	if (RatnumCell::isInstance(power) && !FlonumCell::isInstance(base))
+	{
+		// The result is generally irrational and returning a flonum would break (expt)'s exactness contract
+		signalError(world, ErrorCategory::ImplementationRestriction, "(expt) with exact base and ratnum power", {base, power});
+	}
+
+	if (auto ratnumBase = cell_cast<RatnumCell>(base))
+	{
+		if (auto integerPowerCell = cell_cast<IntegerCell>(power))
+		{
+			// Raise each component separately; they remain coprime
+			const std::int64_t integerPower = integerPowerCell->value();
+			const std::uint64_t powerMagnitude = integerMagnitude(integerPower);
+
+			std::int64_t numeratorResult;
+			std::int64_t denominatorResult;
+
+			// The denominator is at least two so any larger power must overflow
+			NumberCell *result = nullptr;
+
+			if ((powerMagnitude < 64) &&
+				exactIntegerPower(ratnumBase->numerator(), powerMagnitude, numeratorResult) &&
+				exactIntegerPower(ratnumBase->denominator(), powerMagnitude, denominatorResult))
+			{
+				result = (integerPower < 0) ?
+					RatnumCell::fromFraction(world, denominatorResult, numeratorResult) :
+					RatnumCell::fromFraction(world, numeratorResult, denominatorResult);
+			}
+
+			if (result == nullptr)
+			{
+				signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (expt)");
+			}
+
+			return result;
+		}
+	}
+
 	const bool bothInteger = IntegerCell::isInstance(base) && IntegerCell::isInstance(power);
 
 	if (bothInteger)
@@ -482,10 +778,17 @@ NumberCell* llbase_expt(World &world, NumberCell *base, NumberCell *power)
 		auto integerBase = static_cast<IntegerCell*>(base)->value();
 		auto integerPower = static_cast<IntegerCell*>(power)->value();
 
-		// Allow most powers of two to be exactly handled even on platforms with 64bit doubles
-		if ((integerBase == 2) && (integerPower >= 0) && (integerPower <= 62))
+		if (integerPower >= 0)
 		{
-			return IntegerCell::fromValue(world, 1LL << integerPower);
+			// Calculate exactly instead of relying on the precision of powl()
+			std::int64_t integerResult;
+
+			if (!exactIntegerPower(integerBase, integerPower, integerResult))
+			{
+				signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (expt)");
+			}
+
+			return IntegerCell::fromValue(world, integerResult);
 		}
 	}
 
@@ -513,25 +816,64 @@ NumberCell* llbase_expt(World &world, NumberCell *base, NumberCell *power)
 	}
 }
 
-std::int64_t llbase_gcd(std::int64_t a, std::int64_t b, RestValues<IntegerCell> *restInts)
+std::int64_t llbase_ratnum_floor(RatnumCell *value)
+{
+	return floorDivision(value->numerator(), value->denominator()).quotient;
+}
+
+std::int64_t llbase_ratnum_ceiling(RatnumCell *value)
+{
+	// Ratnums are never integral so this is always one above the floor
+	return floorDivision(value->numerator(), value->denominator()).quotient + 1;
+}
+
+std::int64_t llbase_ratnum_truncate(RatnumCell *value)
+{
+	return value->numerator() / value->denominator();
+}
+
+std::int64_t llbase_ratnum_round(RatnumCell *value)
+{
+	const FloorDivisionResult floorResult = floorDivision(value->numerator(), value->denominator());
+
+	// The remainder is less than the denominator so doubling it can't overflow an unsigned value
+	const std::uint64_t doubledRemainder = static_cast<std::uint64_t>(floorResult.remainder) * 2;
+	const std::uint64_t denominator = value->denominator();
+
+	if ((doubledRemainder > denominator) || ((doubledRemainder == denominator) && (floorResult.quotient & 1)))
+	{
+		// Round up; ties go to the even integer
+		return floorResult.quotient + 1;
+	}
+
+	return floorResult.quotient;
+}
+
+std::int64_t llbase_gcd(World &world, std::int64_t a, std::int64_t b, RestValues<IntegerCell> *restInts)
 {
-	std::int64_t result = greatestCommonDivisor(a, b);
+	std::uint64_t result = greatestCommonDivisor(integerMagnitude(a), b);
 
 	for(auto restInt : *restInts)
 	{
 		result = greatestCommonDivisor(result, restInt->value());
 	}
 
-	return (result < 0) ? -result : result;
+	// This can only happen if every argument is either zero or the minimum integer
+	if (result > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+	{
+		signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (gcd)");
+	}
+
+	return result;
 }
 
-std::int64_t llbase_lcm(std::int64_t a, std::int64_t b, RestValues<IntegerCell> *restInts)
+std::int64_t llbase_lcm(World &world, std::int64_t a, std::int64_t b, RestValues<IntegerCell> *restInts)
 {
-	std::int64_t result = leastCommonMultiple(a, b);
+	std::int64_t result = leastCommonMultiple(world, a, b);
 
 	for(auto restInt : *restInts)
 	{
-		result = leastCommonMultiple(result, restInt->value());
+		result = leastCommonMultiple(world, result, restInt->value());
 	}
 
 	return (result < 0) ? -result : result;
@@ -5,38 +5,21 @@
 #include "binding/BooleanCell.h"
 #include "binding/ProperList.h"
 
-#include "dynamic/State.h"
-#include "dynamic/SchemeException.h"
+#include "dynamic/raise.h"
 
 using namespace lliby;
 
 extern "C"
 {
 
-using HandlerProcedureCell = TypedProcedureCell<AnyCell*, AnyCell*>;
-
-AnyCell* llbase_guard_kernel(World &world, HandlerProcedureCell *guardAuxProc, ThunkProcedureCell *thunk)
+AnyCell* llbase_guard_kernel(World &world, dynamic::GuardHandlerProcedureCell *guardAuxProc, ThunkProcedureCell *thunk)
 {
-	dynamic::State *handlerState = world.activeState();
-
-	try
-	{
-		return thunk->apply(world);
-	}
-	catch (dynamic::SchemeException &except)
-	{
-		// Switch to the guard's dynamic state
-		dynamic::State::popUntilState(world, handlerState);
-
-		// Call our guard-aux procedure
-		// This will re-throw if no match is encountered
-		return guardAuxProc->apply(world, except.object());
-	}
+	return dynamic::applyWithGuard(world, thunk, guardAuxProc);
 }
 
 void llbase_raise(World &world, AnyCell *obj)
 {
-	throw dynamic::SchemeException(obj);
+	dynamic::raise(world, obj);
 }
 
 void llbase_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
@@ -1,4 +1,5 @@
 #include <cassert>
+#include <limits>
 
 #include "binding/PairCell.h"
 #include "binding/EmptyListCell.h"
@@ -105,34 +106,51 @@ AnyCell* llbase_append(World &world, RestValues<AnyCell> *argList)
 		return EmptyListCell::instance();
 	}
 
-	std::vector<AnyCell*> appendedElements;
+	// Count the pairs we need to copy so they can be allocated as a single contiguous run
+	std::uint32_t copiedPairs = 0;
 	auto argIt = argList->begin();
 
-	while(--argCount)
+	for(auto i = argCount - 1; i; i--)
 	{
-		auto argDatum = *(argIt++);
+		AnyCell *argDatum = *(argIt++);
 
-		if (auto pair = cell_cast<PairCell>(argDatum))
-		{
-			// Zero means "unknown list length" which will cause this to be a no-op
-			appendedElements.reserve(appendedElements.size() + pair->listLength());
+		std::uint32_t remaining = std::numeric_limits<std::uint32_t>::max();
+		const AnyCell *argTail = PairCell::advance(argDatum, remaining);
 
-			do
-			{
-				appendedElements.insert(appendedElements.end(), pair->car());
-				argDatum = pair->cdr();
-			}
-			while((pair = cell_cast<PairCell>(argDatum)));
+		if (argTail != EmptyListCell::instance())
+		{
+			signalError(world, ErrorCategory::Type, "Non-list passed to (append) in non-terminal position", {argDatum});
 		}
 
-		if (argDatum != EmptyListCell::instance())
+		copiedPairs += std::numeric_limits<std::uint32_t>::max() - remaining;
+	}
+
+	// The last list is shared instead of copied. This is required by R7RS
+	AnyCell *lastArg = *argIt;
+
+	if (copiedPairs == 0)
+	{
+		return lastArg;
+	}
+
+	alloc::RangeAlloc allocation = alloc::allocateRange(world, copiedPairs);
+	auto allocIt = allocation.begin();
+	std::uint32_t pairsLeft = copiedPairs;
+
+	argIt = argList->begin();
+
+	for(auto i = argCount - 1; i; i--)
+	{
+		for(auto car : *cell_unchecked_cast<ProperList<AnyCell>>(*(argIt++)))
 		{
-			signalError(world, ErrorCategory::Type, "Non-list passed to (append) in non-terminal position", {argDatum});
+			void *pairPlacement = *allocIt++;
+			AnyCell *cdr = (--pairsLeft == 0) ? lastArg : static_cast<AnyCell*>(*allocIt);
+
+			new (pairPlacement) PairCell(car, cdr);
 		}
 	}
 
-	// Use createList to append the last list on sharing its structure. This is required by R7RS
-	return ListElementCell::createList(world, appendedElements, *(argIt++));
+	return static_cast<AnyCell*>(*allocation.begin());
 }
 
 ProperList<AnyCell>* llbase_reverse(World &world, ProperList<AnyCell> *sourceList)
@@ -171,23 +189,16 @@ const AnyCell* llbase_assoc(const AnyCell *obj, ProperList<AnyCell> *listHead)
 
 ListElementCell* llbase_list_tail(World &world, ProperList<AnyCell> *initialHead, std::uint32_t count)
 {
-	ListElementCell *head = initialHead;
+	// Our argument is defined to be a proper list on the Scheme side so the result is always a list element
+	std::uint32_t remaining = count;
+	auto head = PairCell::advance(initialHead, remaining);
 
-	while(count--)
+	if (remaining > 0)
 	{
-		auto pairHead = cell_cast<PairCell>(head);
-
-		if (pairHead == nullptr)
-		{
-			signalError(world, ErrorCategory::Range, "(list-tail) on list of insufficient length");
-		}
-
-		// Advance to the next list element
-		// Our argument is defined to be a proper list on the Scheme side so this is safe
-		head = cell_unchecked_cast<ListElementCell>(pairHead->cdr());
+		signalError(world, ErrorCategory::Range, "(list-tail) on list of insufficient length");
 	}
 
-	return head;
+	return const_cast<ListElementCell*>(cell_unchecked_cast<const ListElementCell>(head));
 }
 
 }
@@ -5,6 +5,7 @@
 #include "binding/StringCell.h"
 #include "unicode/UnicodeChar.h"
 #include "binding/ProperList.h"
+#include "binding/RestValuesBuilder.h"
 #include "binding/UnitCell.h"
 
 #include "util/StringCellBuilder.h"
@@ -37,7 +38,9 @@ namespace
 
 		auto container = initFunc(minimumLength);
 
+		RestValuesBuilder restArgBuilder(world, restVectors.size(), minimumLength);
 		std::vector<AnyCell*> restArgVector(restVectors.size());
+
 		for(VectorCell::LengthType i = 0; i < minimumLength; i++)
 		{
 			// Build the rest argument list
@@ -46,7 +49,7 @@ namespace
 				restArgVector[j] = restVectors[j]->elements()[i];
 			}
 
-			RestValues<AnyCell> *restArgList = RestValues<AnyCell>::create(world, restArgVector);
+			RestValues<AnyCell> *restArgList = restArgBuilder.create(restArgVector.data());
 			iterFunc(container, i, firstVector->elements()[i], restArgList);
 		}
 
@@ -71,7 +74,9 @@ namespace
 
 		auto container = initFunc(minimumLength);
 
+		RestValuesBuilder restArgBuilder(world, restLists.size(), minimumLength);
 		std::vector<AnyCell*> restArgVector(restLists.size());
+
 		ListElementCell *firstListHead = firstList;
 		for(ProperList<AnyCell>::size_type i = 0; i < minimumLength; i++)
 		{
@@ -86,7 +91,7 @@ namespace
 			}
 
 			// Create the rest argument list
-			RestValues<AnyCell> *restArgList = RestValues<AnyCell>::create(world, restArgVector);
+			RestValues<AnyCell> *restArgList = restArgBuilder.create(restArgVector.data());
 
 			// Extract the first list value and move it forward
 			auto firstListPair = cell_unchecked_cast<PairCell>(firstListHead);
@@ -118,7 +123,9 @@ namespace
 
 		auto container = initFunc(minimumLength);
 
+		RestValuesBuilder restArgBuilder(world, restCharIts.size(), minimumLength);
 		std::vector<UnicodeChar> restArgVector(restCharIts.size());
+
 		for(std::size_t i = 0; i < minimumLength; i++)
 		{
 			// Build the rest argument list
@@ -128,7 +135,7 @@ namespace
 			}
 
 			// Create the rest argument list
-			RestValues<CharCell> *restArgList = RestValues<CharCell>::emplaceValues(world, restArgVector);
+			RestValues<CharCell> *restArgList = restArgBuilder.emplaceValues<CharCell>(restArgVector.data());
 
 			iterFunc(container, i, firstCharIt.next(), restArgList);
 		}
@@ -1,6 +1,7 @@
 #include "binding/NumberCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/ProperList.h"
 
 #include <cmath>
@@ -11,6 +12,68 @@ using namespace lliby;
 
 namespace
 {
+	/**
+	 * Loads the exact fraction for an integer or ratnum
+	 *
+	 * @return False if the number is a flonum
+	 */
+	bool exactFraction(const NumberCell *number, std::int64_t &numerator, std::int64_t &denominator)
+	{
+		if (auto integer = cell_cast<IntegerCell>(number))
+		{
+			numerator = integer->value();
+			denominator = 1;
+			return true;
+		}
+		else if (auto ratnum = cell_cast<RatnumCell>(number))
+		{
+			numerator = ratnum->numerator();
+			denominator = ratnum->denominator();
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Loads the exact fraction for a number if it can be compared exactly
+	 *
+	 * This includes integral flonums within the range of our integers
+	 */
+	bool comparableFraction(const NumberCell *number, std::int64_t &numerator, std::int64_t &denominator)
+	{
+		if (exactFraction(number, numerator, denominator))
+		{
+			return true;
+		}
+
+		const double flonumValue = cell_unchecked_cast<const FlonumCell>(number)->value();
+
+		if ((flonumValue >= -9223372036854775808.0) && (flonumValue < 9223372036854775808.0) &&
+			(std::trunc(flonumValue) == flonumValue))
+		{
+			numerator = static_cast<std::int64_t>(flonumValue);
+			denominator = 1;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Compares two exact fractions with positive denominators
+	 *
+	 * @return Negative, zero or positive if the left fraction is less than, equal to or greater than the right
+	 */
+	int compareFractions(std::int64_t leftNumerator, std::int64_t leftDenominator, std::int64_t rightNumerator, std::int64_t rightDenominator)
+	{
+		// Cross multiply in 128bit so this can't overflow
+		const __int128 leftProduct = static_cast<__int128>(leftNumerator) * rightDenominator;
+		const __int128 rightProduct = static_cast<__int128>(rightNumerator) * leftDenominator;
+
+		return (leftProduct > rightProduct) - (leftProduct < rightProduct);
+	}
+
 	template<class IntegerCompare, class FlonumCompare>
 	bool numericCompare(NumberCell *value1, NumberCell *value2, RestValues<NumberCell> *argHead, IntegerCompare integerCompare, FlonumCompare flonumCompare)
 	{
@@ -24,45 +87,28 @@ namespace
 				// Both cells are integers
 				return integerCompare(integerNumber1->value(), integerNumber2->value());
 			}
-			else if (!integerNumber1 && !integerNumber2)
+
+			auto flonumNumber1 = cell_cast<FlonumCell>(number1);
+			auto flonumNumber2 = cell_cast<FlonumCell>(number2);
+
+			if (flonumNumber1 && flonumNumber2)
 			{
 				// Both cells are flonums
-				auto flonumNumber1 = cell_unchecked_cast<FlonumCell>(number1);
-				auto flonumNumber2 = cell_unchecked_cast<FlonumCell>(number2);
-
 				return flonumCompare(flonumNumber1->value(), flonumNumber2->value());
 			}
-			else if (!integerNumber1 && integerNumber2)
-			{
-				auto flonumNumber1 = cell_unchecked_cast<FlonumCell>(number1);
 
-				// Try to convert to integer
-				auto flonumNumber1AsInteger = static_cast<std::int64_t>(flonumNumber1->value());
-				if (flonumNumber1->value() == flonumNumber1AsInteger)
-				{
-					// Compare as integer
-					return integerCompare(flonumNumber1AsInteger, integerNumber2->value());
-				}
+			// Compare exactly if the flonum side is integral
+			std::int64_t numerator1, denominator1;
+			std::int64_t numerator2, denominator2;
 
-				// Compare as flonum
-				return flonumCompare(flonumNumber1->value(), integerNumber2->value());
-			}
-			else // if (integerNumber1 && !integerNumber2)
+			if (comparableFraction(number1, numerator1, denominator1) &&
+				comparableFraction(number2, numerator2, denominator2))
 			{
-				auto flonumNumber2 = cell_unchecked_cast<FlonumCell>(number2);
-
-				// Try to convert to integer
-				auto flonumNumber2AsInteger = static_cast<std::int64_t>(flonumNumber2->value());
-
-				if (flonumNumber2->value() == flonumNumber2AsInteger)
-				{
-					// Compare as integer
-					return integerCompare(integerNumber1->value(), flonumNumber2AsInteger);
-				}
-
-				// Compare as flonum
-				return flonumCompare(integerNumber1->value(), flonumNumber2->value());
+				return integerCompare(compareFractions(numerator1, denominator1, numerator2, denominator2), 0);
 			}
+
+			// Compare as flonum
+			return flonumCompare(number1->toDouble(), number2->toDouble());
 		};
 
 		if (!compareCells(value1, value2))
@@ -95,6 +141,9 @@ namespace
 			auto selectedInt = cell_cast<IntegerCell>(selectedNumber);
 			auto otherInt = cell_cast<IntegerCell>(otherNumber);
 
+			std::int64_t selectedNumerator, selectedDenominator;
+			std::int64_t otherNumerator, otherDenominator;
+
 			if (selectedInt && otherInt)
 			{
 				// We can compare these as integers
@@ -104,6 +153,15 @@ namespace
 					selectedNumber = otherInt;
 				}
 			}
+			else if (exactFraction(selectedNumber, selectedNumerator, selectedDenominator) &&
+					 exactFraction(otherNumber, otherNumerator, otherDenominator))
+			{
+				// We can compare these as exact fractions
+				if (integerCompare(compareFractions(otherNumerator, otherDenominator, selectedNumerator, selectedDenominator), 0))
+				{
+					selectedNumber = otherNumber;
+				}
+			}
 			else
 			{
 				if (flonumCompare(otherNumber->toDouble(), selectedNumber->toDouble()))
@@ -128,6 +186,11 @@ std::int64_t llbase_integer(World &world, NumberCell *numeric)
 		return integer->value();
 	}
 
+	if (RatnumCell::isInstance(numeric))
+	{
+		signalError(world, ErrorCategory::InvalidArgument, "Attempted to convert non-integral ratnum to integer", {numeric});
+	}
+
 	// This must be a flonum; we don't need a type check
 	auto flonum = cell_unchecked_cast<FlonumCell>(numeric);
 
@@ -147,11 +210,14 @@ double llbase_flonum(NumberCell *numeric)
 		return flonum->value();
 	}
 
-	// This must be an integer; we don't need a type check
-	auto integer = cell_unchecked_cast<IntegerCell>(numeric);
+	if (auto integer = cell_cast<IntegerCell>(numeric))
+	{
+		// Cast to a double
+		return static_cast<double>(integer->value());
+	}
 
-	// Cast to a double
-	return static_cast<double>(integer->value());
+	// This must be a ratnum
+	return numeric->toDouble();
 }
 
 bool llbase_numeric_equal(NumberCell *value1, NumberCell *value2, RestValues<NumberCell> *argHead)
@@ -3,11 +3,12 @@
 
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/StringCell.h"
 #include "binding/BooleanCell.h"
 #include "binding/EofObjectCell.h"
 
-#include "writer/ExternalFormDatumWriter.h"
+#include "writer/NumberFormat.h"
 #include "reader/DatumReader.h"
 #include "reader/ReadErrorException.h"
 
@@ -25,10 +26,9 @@ StringCell* llbase_number_to_string(World &world, NumberCell *numberCell, std::u
 		signalError(world, ErrorCategory::InvalidArgument, "(number->string) with illegal radix", {numberCell});
 	}
 
-	std::ostringstream strStream;
-	ExternalFormDatumWriter writer(strStream);
+	auto flonumCell = cell_cast<FlonumCell>(numberCell);
 
-	if (auto flonumCell = cell_cast<FlonumCell>(numberCell))
+	if (flonumCell)
 	{
 		const double floatValue = flonumCell->value();
 
@@ -39,8 +39,18 @@ StringCell* llbase_number_to_string(World &world, NumberCell *numberCell, std::u
 		}
 	}
 
-	writer.render(numberCell, radix);
-	return StringCell::fromUtf8StdString(world, strStream.str());
+	auto ratnumCell = cell_cast<RatnumCell>(numberCell);
+
+	const NumberFormat format(flonumCell ?
+			NumberFormat::forFlonum(flonumCell->value()) :
+			(ratnumCell ?
+				NumberFormat::forRatnum(ratnumCell->numerator(), ratnumCell->denominator(), radix) :
+				NumberFormat::forInteger(cell_unchecked_cast<IntegerCell>(numberCell)->value(), radix)));
+
+	// Numbers are always formatted as ASCII so they can be written straight in to the string's storage
+	return StringCell::fromAsciiWriter(world, format.length(), [&] (char *output) {
+		format.write(output);
+	});
 }
 
 AnyCell* llbase_string_to_number(World &world, StringCell *stringCell, std::uint32_t radix)
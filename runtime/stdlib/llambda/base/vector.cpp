@@ -59,11 +59,16 @@ VectorCell *llbase_vector(World &world, RestValues<AnyCell> *argList)
 {
 	const auto length = argList->size();
 
-	auto newElements = new AnyCell*[length];
-	std::copy(argList->begin(), argList->end(), newElements);
+	VectorCell *newVector = VectorCell::createUninitialised(world, length);
 
-	// Return the new vector
-	return VectorCell::fromElements(world, newElements, length);
+	if (newVector == nullptr)
+	{
+		signalError(world, ErrorCategory::OutOfMemory, "Out of memory in (vector)");
+	}
+
+	std::copy(argList->begin(), argList->end(), newVector->elements());
+
+	return newVector;
 }
 
 VectorCell *llbase_vector_append(World &world, RestValues<VectorCell> *argList)
@@ -125,18 +130,46 @@ VectorCell* llbase_string_to_vector(World &world, StringCell *string, std::int64
 	CharRange unboxedChars(string->charRange(start, end));
 	const std::size_t charCount = unboxedChars.size();
 
-	alloc::RangeAlloc allocation = alloc::allocateRange(world, charCount);
+	VectorCell *newVector = VectorCell::createUninitialised(world, charCount);
+
+	if (newVector == nullptr)
+	{
+		signalError(world, ErrorCategory::OutOfMemory, "Out of memory in (string->vector)");
+	}
+
+	// Only characters without a preconstructed cell need to be allocated
+	std::size_t allocatedCount = 0;
+	auto countIt = unboxedChars.begin();
+
+	for(std::size_t i = 0; i < charCount; i++)
+	{
+		if (CharCell::preconstructedInstance(countIt.next()) == nullptr)
+		{
+			allocatedCount++;
+		}
+	}
+
+	alloc::RangeAlloc allocation = alloc::allocateRange(world, allocatedCount);
 	auto allocIt = allocation.begin();
 
-	AnyCell **boxedChars = new AnyCell*[charCount];
+	AnyCell **boxedChars = newVector->elements();
 	auto unboxedIt = unboxedChars.begin();
 
 	for(std::size_t i = 0; i < charCount; i++)
 	{
-		boxedChars[i] = new (*allocIt++) CharCell(unboxedIt.next());
+		const UnicodeChar unboxedChar(unboxedIt.next());
+
+		if (CharCell *preconstructed = CharCell::preconstructedInstance(unboxedChar))
+		{
+			boxedChars[i] = preconstructed;
+		}
+		else
+		{
+			boxedChars[i] = new (*allocIt++) CharCell(unboxedChar);
+		}
 	}
 
-	return VectorCell::fromElements(world, boxedChars, charCount);
+	return newVector;
 }
 
 StringCell *llbase_vector_to_string(World &world, VectorCell *vector, std::int64_t start, std::int64_t end)
@@ -3,7 +3,7 @@
 #include "binding/AnyCell.h"
 #include "binding/ErrorObjectCell.h"
 #include "binding/ErrorCategory.h"
-#include "dynamic/SchemeException.h"
+#include "dynamic/raise.h"
 
 using namespace lliby;
 
@@ -26,12 +26,12 @@ extern "C"
 
 void llerror_raise_file_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::File));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::File));
 }
 
 void llerror_raise_read_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Read));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Read));
 }
 
 bool llerror_is_type_error(AnyCell *obj)
@@ -41,7 +41,7 @@ bool llerror_is_type_error(AnyCell *obj)
 
 void llerror_raise_type_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Type));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Type));
 }
 
 bool llerror_is_arity_error(AnyCell *obj)
@@ -51,7 +51,7 @@ bool llerror_is_arity_error(AnyCell *obj)
 
 void llerror_raise_arity_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Arity));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Arity));
 }
 
 bool llerror_is_range_error(AnyCell *obj)
@@ -61,7 +61,7 @@ bool llerror_is_range_error(AnyCell *obj)
 
 void llerror_raise_range_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Range));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Range));
 }
 
 bool llerror_is_utf8_error(AnyCell *obj)
@@ -71,7 +71,7 @@ bool llerror_is_utf8_error(AnyCell *obj)
 
 void llerror_raise_utf8_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Utf8));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Utf8));
 }
 
 bool llerror_is_divide_by_zero_error(AnyCell *obj)
@@ -81,7 +81,7 @@ bool llerror_is_divide_by_zero_error(AnyCell *obj)
 
 void llerror_raise_divide_by_zero_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::DivideByZero));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::DivideByZero));
 }
 
 bool llerror_is_mutate_literal_error(AnyCell *obj)
@@ -91,7 +91,7 @@ bool llerror_is_mutate_literal_error(AnyCell *obj)
 
 void llerror_raise_mutate_literal_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::MutateLiteral));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::MutateLiteral));
 }
 
 bool llerror_is_undefined_variable_error(AnyCell *obj)
@@ -101,7 +101,7 @@ bool llerror_is_undefined_variable_error(AnyCell *obj)
 
 void llerror_raise_undefined_variable_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::UndefinedVariable));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::UndefinedVariable));
 }
 
 bool llerror_is_out_of_memory_error(AnyCell *obj)
@@ -111,7 +111,7 @@ bool llerror_is_out_of_memory_error(AnyCell *obj)
 
 void llerror_raise_out_of_memory_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::OutOfMemory));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::OutOfMemory));
 }
 
 bool llerror_is_invalid_argument_error(AnyCell *obj)
@@ -121,7 +121,7 @@ bool llerror_is_invalid_argument_error(AnyCell *obj)
 
 void llerror_raise_invalid_argument_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::InvalidArgument));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::InvalidArgument));
 }
 
 bool llerror_is_integer_overflow_error(AnyCell *obj)
@@ -131,7 +131,7 @@ bool llerror_is_integer_overflow_error(AnyCell *obj)
 
 void llerror_raise_integer_overflow_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::IntegerOverflow));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::IntegerOverflow));
 }
 
 bool llerror_is_implementation_restriction_error(AnyCell *obj)
@@ -141,7 +141,7 @@ bool llerror_is_implementation_restriction_error(AnyCell *obj)
 
 void llerror_raise_implementation_restriction_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::ImplementationRestriction));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::ImplementationRestriction));
 }
 
 bool llerror_is_unclonable_value_error(AnyCell *obj)
@@ -151,7 +151,7 @@ bool llerror_is_unclonable_value_error(AnyCell *obj)
 
 void llerror_raise_unclonable_value_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::UnclonableValue));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::UnclonableValue));
 }
 
 bool llerror_is_no_actor_error(AnyCell *obj)
@@ -161,7 +161,7 @@ bool llerror_is_no_actor_error(AnyCell *obj)
 
 void llerror_raise_no_actor_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::NoActor));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::NoActor));
 }
 
 bool llerror_is_expired_escape_procedure_error(AnyCell *obj)
@@ -171,7 +171,7 @@ bool llerror_is_expired_escape_procedure_error(AnyCell *obj)
 
 void llerror_raise_expired_escape_procedure_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::ExpiredEscapeProcedure));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::ExpiredEscapeProcedure));
 }
 
 bool llerror_is_ask_timeout_error(AnyCell *obj)
@@ -181,7 +181,7 @@ bool llerror_is_ask_timeout_error(AnyCell *obj)
 
 void llerror_raise_ask_timeout_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::AskTimeout));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::AskTimeout));
 }
 
 bool llerror_is_match_error(AnyCell *obj)
@@ -191,7 +191,17 @@ bool llerror_is_match_error(AnyCell *obj)
 
 void llerror_raise_match_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
 {
-	throw dynamic::SchemeException(ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Match));
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::Match));
+}
+
+bool llerror_is_mailbox_full_error(AnyCell *obj)
+{
+	return isErrorObjectOfCategory(obj, ErrorCategory::MailboxFull);
+}
+
+void llerror_raise_mailbox_full_error(World &world, StringCell *message, RestValues<AnyCell> *irritants)
+{
+	dynamic::raise(world, ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::MailboxFull));
 }
 
 }
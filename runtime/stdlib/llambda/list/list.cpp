@@ -5,6 +5,7 @@
 #include "binding/ListElementCell.h"
 #include "binding/BooleanCell.h"
 #include "binding/ProperList.h"
+#include "binding/RestValuesBuilder.h"
 #include "binding/TypedProcedureCell.h"
 #include "binding/FlonumCell.h"
 #include "binding/IntegerCell.h"
@@ -93,16 +94,18 @@ namespace
 	 * lists are of type AnyCell to reflect that this function and its callers should be prepared to have its input
 	 * lists mutated to improper lists by the passed procedure.
 	 *
-	 * @param  world      World to apply the procedure in
-	 * @param  firstList  Reference to the first proper list of values. This will be advanced to the next element.
-	 * @param  restLists  Vector of other value proper lists. These will be advanced to their next elements.
-	 * @param  proc       Procedure to apply. This will be passed one argument from each of the input lists.
-	 * @param  result     Pointer to a location to store the result value. If this function returns false then the
-	 *                    result will not be written to.
+	 * @param  world           World to apply the procedure in
+	 * @param  restArgBuilder  Builder for the rest argument list passed to the procedure
+	 * @param  firstList       Reference to the first proper list of values. This will be advanced to the next element.
+	 * @param  restLists       Vector of other value proper lists. These will be advanced to their next elements.
+	 * @param  restValues      Scratch vector with the same size as restLists
+	 * @param  proc            Procedure to apply. This will be passed one argument from each of the input lists.
+	 * @param  result          Pointer to a location to store the result value. If this function returns false then the
+	 *                         result will not be written to.
 	 * @return Boolean indicating if all of the input lists were non-empty and the procedure was invoked.
 	 */
 	template<typename T>
-	bool consumeInputLists(World &world, ProperList<lliby::AnyCell>* &firstList, std::vector<AnyCell*> &restLists, TypedProcedureCell<T, AnyCell*, RestValues<AnyCell>*> *proc, T* result)
+	bool consumeInputLists(World &world, RestValuesBuilder &restArgBuilder, ProperList<lliby::AnyCell>* &firstList, std::vector<AnyCell*> &restLists, std::vector<AnyCell*> &restValues, TypedProcedureCell<T, AnyCell*, RestValues<AnyCell>*> *proc, T* result)
 	{
 		auto firstPair = cell_cast<PairCell>(firstList);
 
@@ -116,8 +119,6 @@ namespace
 		firstList = cell_unchecked_cast<ProperList<AnyCell>>(firstPair->cdr());
 		AnyCell *firstValue = firstPair->car();
 
-		std::vector<AnyCell*> restValues(restLists.size());
-
 		for(std::size_t i = 0; i < restLists.size(); i++)
 		{
 			auto restPair = cell_cast<PairCell>(restLists[i]);
@@ -133,7 +134,7 @@ namespace
 		}
 
 		// Build the rest argument list
-		RestValues<AnyCell> *restArgList = RestValues<AnyCell>::create(world, restValues);
+		RestValues<AnyCell> *restArgList = restArgBuilder.create(restValues.data());
 
 		// Apply the function
 		*result = proc->apply(world, firstValue, restArgList);
@@ -194,7 +195,8 @@ AnyCell* lllist_fold(World &world, FoldProc *foldProc, AnyCell *initialValue, Pr
 	const auto inputListCount = inputLists.size();
 
 	std::vector<AnyCell*> inputVector(inputListCount + 1);
-	std::vector<AnyCell*> restArgVector(inputListCount - 1);
+
+	RestValuesBuilder restArgBuilder(world, inputListCount - 1);
 
 	while(true)
 	{
@@ -217,8 +219,7 @@ AnyCell* lllist_fold(World &world, FoldProc *foldProc, AnyCell *initialValue, Pr
 		inputVector[inputListCount] = accum;
 
 		// Create the rest argument list - the first two input values are passed explicitly
-		std::copy(inputVector.begin() + 2, inputVector.end(), restArgVector.begin());
-		RestValues<AnyCell> *restArgList = RestValues<AnyCell>::create(world, restArgVector);
+		RestValues<AnyCell> *restArgList = restArgBuilder.create(inputVector.data() + 2);
 
 		auto resultValue = foldProc->apply(world, inputVector[0], inputVector[1], restArgList);
 		accum = resultValue;
@@ -323,13 +324,15 @@ PairCell* lllist_break(World &world, PredicateProc *predicateProc, ProperList<An
 AnyCell* lllist_any(World &world, AnyProc *predicateProc, ProperList<AnyCell> *firstList, RestValues<ProperList<AnyCell>> *restListsRaw)
 {
 	std::vector<AnyCell*> restLists(restListsRaw->begin(), restListsRaw->end());
+	std::vector<AnyCell*> restValues(restLists.size());
+	RestValuesBuilder restArgBuilder(world, restLists.size());
 
 	// Run until we get a truth-y value
 	while(true)
 	{
 		AnyCell *resultValue;
 
-		if (!consumeInputLists<AnyCell*>(world, firstList, restLists, predicateProc, &resultValue))
+		if (!consumeInputLists<AnyCell*>(world, restArgBuilder, firstList, restLists, restValues, predicateProc, &resultValue))
 		{
 			// Ran out of lists
 			return BooleanCell::falseInstance();
@@ -346,6 +349,8 @@ AnyCell* lllist_any(World &world, AnyProc *predicateProc, ProperList<AnyCell> *f
 AnyCell* lllist_every(World &world, EveryProc *predicateProc, ProperList<AnyCell> *firstList, RestValues<ProperList<AnyCell>> *restListsRaw)
 {
 	std::vector<AnyCell*> restLists(restListsRaw->begin(), restListsRaw->end());
+	std::vector<AnyCell*> restValues(restLists.size());
+	RestValuesBuilder restArgBuilder(world, restLists.size());
 
 	// If all lists are empty we should return #t
 	AnyCell *resultValue = BooleanCell::trueInstance();
@@ -353,7 +358,7 @@ AnyCell* lllist_every(World &world, EveryProc *predicateProc, ProperList<AnyCell
 	// Run until we get a false value
 	while(true)
 	{
-		if (!consumeInputLists<AnyCell*>(world, firstList, restLists, predicateProc, &resultValue))
+		if (!consumeInputLists<AnyCell*>(world, restArgBuilder, firstList, restLists, restValues, predicateProc, &resultValue))
 		{
 			// Ran out of lists - return the last result value
 			// This depends on consumeInputLists not modifying resultValue when it returns false
@@ -371,6 +376,8 @@ AnyCell* lllist_every(World &world, EveryProc *predicateProc, ProperList<AnyCell
 std::int64_t lllist_count(World &world, CountProc *predicateProc, ProperList<AnyCell> *firstList, RestValues<ProperList<AnyCell>> *restListsRaw)
 {
 	std::vector<AnyCell*> restLists(restListsRaw->begin(), restListsRaw->end());
+	std::vector<AnyCell*> restValues(restLists.size());
+	RestValuesBuilder restArgBuilder(world, restLists.size());
 
 	std::int64_t counter = 0;
 
@@ -378,7 +385,7 @@ std::int64_t lllist_count(World &world, CountProc *predicateProc, ProperList<Any
 	{
 		AnyCell *resultValue;
 
-		if (!consumeInputLists<AnyCell*>(world, firstList, restLists, predicateProc, &resultValue))
+		if (!consumeInputLists<AnyCell*>(world, restArgBuilder, firstList, restLists, restValues, predicateProc, &resultValue))
 		{
 			// Out of lists
 			return counter;
@@ -394,11 +401,13 @@ std::int64_t lllist_count(World &world, CountProc *predicateProc, ProperList<Any
 ProperList<AnyCell>* lllist_append_map(World &world, AppendMapProc *mapProc, ProperList<AnyCell> *firstList, RestValues<ProperList<AnyCell>> *restListsRaw)
 {
 	std::vector<AnyCell*> restLists(restListsRaw->begin(), restListsRaw->end());
+	std::vector<AnyCell*> restValues(restLists.size());
+	RestValuesBuilder restArgBuilder(world, restLists.size());
 
 	std::vector<AnyCell*> resultValues;
 
 	ProperList<AnyCell> *resultList;
-	while(consumeInputLists(world, firstList, restLists, mapProc, &resultList))
+	while(consumeInputLists(world, restArgBuilder, firstList, restLists, restValues, mapProc, &resultList))
 	{
 		// Splice this list on to the results
 		resultValues.insert(resultValues.end(), resultList->begin(), resultList->end());
@@ -410,11 +419,13 @@ ProperList<AnyCell>* lllist_append_map(World &world, AppendMapProc *mapProc, Pro
 ProperList<AnyCell>* lllist_filter_map(World &world, FilterMapProc *mapProc, ProperList<AnyCell> *firstList, RestValues<ProperList<AnyCell>> *restListsRaw)
 {
 	std::vector<AnyCell*> restLists(restListsRaw->begin(), restListsRaw->end());
+	std::vector<AnyCell*> restValues(restLists.size());
+	RestValuesBuilder restArgBuilder(world, restLists.size());
 
 	std::vector<AnyCell*> resultValues;
 
 	AnyCell *resultValue;
-	while(consumeInputLists(world, firstList, restLists, mapProc, &resultValue))
+	while(consumeInputLists(world, restArgBuilder, firstList, restLists, restValues, mapProc, &resultValue))
 	{
 		if (resultValue != BooleanCell::falseInstance())
 		{
@@ -0,0 +1,36 @@
+#include "core/World.h"
+
+#include "binding/HashMapCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/SymbolCell.h"
+
+#include "hash/DatumHashTree.h"
+#include "metrics/Metric.h"
+
+extern "C"
+{
+
+using namespace lliby;
+
+HashMapCell *llmetrics_runtime_metrics(World &world)
+{
+	DatumHashTree *tree = DatumHashTree::createEmpty();
+
+	for(auto metric : metrics::Metric::registeredMetrics())
+	{
+		SymbolCell *name = SymbolCell::fromUtf8StdString(world, metric->name());
+		IntegerCell *value = IntegerCell::fromValue(world, metric->value());
+
+		DatumHashTree *newTree = DatumHashTree::assoc(tree, name, value);
+		DatumHashTree::unref(tree);
+
+		tree = newTree;
+	}
+
+	HashMapCell *hashMap = HashMapCell::createEmptyInstance(world);
+	hashMap->setDatumHashTree(tree);
+
+	return hashMap;
+}
+
+}
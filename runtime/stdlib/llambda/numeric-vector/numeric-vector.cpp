@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <vector>
+
+#include "core/World.h"
+#include "core/error.h"
+
+#include "binding/BytevectorCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/FlonumCell.h"
+#include "binding/NumberCell.h"
+#include "binding/ProperList.h"
+
+#include "numvec/kernels.h"
+
+#include "util/rangeAssertions.h"
+
+using namespace lliby;
+
+namespace
+{
+	/**
+	 * Homogeneous numeric vectors are stored as bytevectors containing unboxed elements in native byte order
+	 *
+	 * The bytevectors are only created by allocateElements() and aren't exposed to Scheme code. Their SharedByteArray
+	 * is always allocated with malloc() and its data directly follows two 32bit fields so elements are 8 byte aligned.
+	 * Compiler-generated bytevector constants are only 4 byte aligned but they can never back a numeric vector.
+	 */
+	static_assert((sizeof(SharedByteArray) % alignof(double)) == 0, "SharedByteArray data isn't 8 byte aligned");
+	static_assert((sizeof(SharedByteArray) % alignof(std::int64_t)) == 0, "SharedByteArray data isn't 8 byte aligned");
+
+	template<typename T>
+	std::int64_t elementCount(const BytevectorCell *bytevector)
+	{
+		return bytevector->length() / sizeof(T);
+	}
+
+	template<typename T>
+	const T *elementData(const BytevectorCell *bytevector)
+	{
+		return reinterpret_cast<const T*>(bytevector->byteArray()->data());
+	}
+
+	/**
+	 * Returns a pointer to the elements of a numeric vector for modification
+	 *
+	 * This will break any sharing of the backing SharedByteArray
+	 */
+	template<typename T>
+	T *writableElementData(BytevectorCell *bytevector)
+	{
+		return reinterpret_cast<T*>(bytevector->writableData());
+	}
+
+	template<typename T>
+	T elementAt(const BytevectorCell *bytevector, std::int64_t index)
+	{
+		return elementData<T>(bytevector)[index];
+	}
+
+	template<typename T>
+	BytevectorCell *allocateElements(World &world, const char *procName, std::int64_t length)
+	{
+		assertLengthValid(world, procName, "numeric vector length", BytevectorCell::maximumLength() / sizeof(T), length);
+
+		auto bytevector = BytevectorCell::fromFill(world, length * sizeof(T));
+
+		if (bytevector == nullptr)
+		{
+			signalError(world, ErrorCategory::OutOfMemory, std::string("Out of memory in ") + procName);
+		}
+
+		return bytevector;
+	}
+
+	template<typename T, typename Iterator, typename Convert>
+	BytevectorCell *fromElements(World &world, const char *procName, Iterator begin, Iterator end, std::int64_t length, Convert convert)
+	{
+		BytevectorCell *bytevector = allocateElements<T>(world, procName, length);
+		T *data = writableElementData<T>(bytevector);
+
+		for(auto it = begin; it != end; it++)
+		{
+			*(data++) = convert(*it);
+		}
+
+		return bytevector;
+	}
+
+	template<typename T>
+	BytevectorCell *makeFilled(World &world, const char *procName, std::int64_t length, T fill)
+	{
+		BytevectorCell *bytevector = allocateElements<T>(world, procName, length);
+		std::fill_n(writableElementData<T>(bytevector), length, fill);
+
+		return bytevector;
+	}
+
+	template<typename T>
+	void setElement(World &world, const char *procName, BytevectorCell *bytevector, std::int64_t index, T value)
+	{
+		assertIndexValid(world, procName, bytevector, elementCount<T>(bytevector), index);
+
+		writableElementData<T>(bytevector)[index] = value;
+	}
+
+	void assertSameLength(World &world, const char *procName, BytevectorCell *left, BytevectorCell *right)
+	{
+		if (left->length() != right->length())
+		{
+			signalError(world, ErrorCategory::InvalidArgument, std::string("Vector lengths differ in ") + procName, {left, right});
+		}
+	}
+
+	void assertNonEmpty(World &world, const char *procName, BytevectorCell *bytevector)
+	{
+		if (bytevector->length() == 0)
+		{
+			signalError(world, ErrorCategory::Range, std::string("Empty vector in ") + procName, {bytevector});
+		}
+	}
+
+	template<typename Kernel>
+	BytevectorCell *elementWise(World &world, const char *procName, BytevectorCell *left, BytevectorCell *right, Kernel kernel)
+	{
+		assertSameLength(world, procName, left, right);
+
+		const std::int64_t length = elementCount<double>(left);
+		BytevectorCell *result = allocateElements<double>(world, procName, length);
+
+		kernel(writableElementData<double>(result), elementData<double>(left), elementData<double>(right), length);
+		return result;
+	}
+
+	BytevectorCell *compareMask(World &world, const char *procName, BytevectorCell *bytevector, numvec::Comparison comparison, double operand)
+	{
+		const std::int64_t length = elementCount<double>(bytevector);
+		BytevectorCell *mask = allocateElements<std::uint8_t>(world, procName, length);
+
+		numvec::compareMask(mask->writableData(), elementData<double>(bytevector), length, comparison, operand);
+		return mask;
+	}
+}
+
+extern "C"
+{
+
+BytevectorCell *llnumvec_make_f64vector(World &world, std::int64_t length, double fill)
+{
+	return makeFilled<double>(world, "(make-f64vector)", length, fill);
+}
+
+BytevectorCell *llnumvec_f64vector(World &world, RestValues<NumberCell> *argList)
+{
+	return fromElements<double>(world, "(f64vector)", argList->begin(), argList->end(), argList->size(), [] (NumberCell *number) {
+		return number->toDouble();
+	});
+}
+
+BytevectorCell *llnumvec_list_to_f64vector(World &world, ProperList<NumberCell> *list)
+{
+	return fromElements<double>(world, "(list->f64vector)", list->begin(), list->end(), list->size(), [] (NumberCell *number) {
+		return number->toDouble();
+	});
+}
+
+std::int64_t llnumvec_f64vector_length(BytevectorCell *bytevector)
+{
+	return elementCount<double>(bytevector);
+}
+
+double llnumvec_f64vector_ref(World &world, BytevectorCell *bytevector, std::int64_t index)
+{
+	assertIndexValid(world, "(f64vector-ref)", bytevector, elementCount<double>(bytevector), index);
+	return elementAt<double>(bytevector, index);
+}
+
+void llnumvec_f64vector_set(World &world, BytevectorCell *bytevector, std::int64_t index, double value)
+{
+	setElement<double>(world, "(f64vector-set!)", bytevector, index, value);
+}
+
+ProperList<FlonumCell> *llnumvec_f64vector_to_list(World &world, BytevectorCell *bytevector)
+{
+	std::vector<FlonumCell*> elements;
+	elements.reserve(elementCount<double>(bytevector));
+
+	for(std::int64_t i = 0; i < elementCount<double>(bytevector); i++)
+	{
+		elements.push_back(FlonumCell::fromValue(world, elementAt<double>(bytevector, i)));
+	}
+
+	return ProperList<FlonumCell>::create(world, elements);
+}
+
+double llnumvec_f64vector_sum(BytevectorCell *bytevector)
+{
+	return numvec::sum(elementData<double>(bytevector), elementCount<double>(bytevector));
+}
+
+double llnumvec_f64vector_dot(World &world, BytevectorCell *left, BytevectorCell *right)
+{
+	assertSameLength(world, "(f64vector-dot)", left, right);
+	return numvec::dot(elementData<double>(left), elementData<double>(right), elementCount<double>(left));
+}
+
+double llnumvec_f64vector_min(World &world, BytevectorCell *bytevector)
+{
+	assertNonEmpty(world, "(f64vector-min)", bytevector);
+	return numvec::minimum(elementData<double>(bytevector), elementCount<double>(bytevector));
+}
+
+double llnumvec_f64vector_max(World &world, BytevectorCell *bytevector)
+{
+	assertNonEmpty(world, "(f64vector-max)", bytevector);
+	return numvec::maximum(elementData<double>(bytevector), elementCount<double>(bytevector));
+}
+
+BytevectorCell *llnumvec_f64vector_scale(World &world, BytevectorCell *bytevector, double factor)
+{
+	const std::int64_t length = elementCount<double>(bytevector);
+	BytevectorCell *result = allocateElements<double>(world, "(f64vector-scale)", length);
+
+	numvec::scale(writableElementData<double>(result), elementData<double>(bytevector), length, factor);
+	return result;
+}
+
+BytevectorCell *llnumvec_f64vector_add(World &world, BytevectorCell *left, BytevectorCell *right)
+{
+	return elementWise(world, "(f64vector-add)", left, right, numvec::add);
+}
+
+BytevectorCell *llnumvec_f64vector_multiply(World &world, BytevectorCell *left, BytevectorCell *right)
+{
+	return elementWise(world, "(f64vector-multiply)", left, right, numvec::multiply);
+}
+
+BytevectorCell *llnumvec_f64vector_prefix_sum(World &world, BytevectorCell *bytevector)
+{
+	const std::int64_t length = elementCount<double>(bytevector);
+	BytevectorCell *result = allocateElements<double>(world, "(f64vector-prefix-sum)", length);
+
+	numvec::prefixSum(writableElementData<double>(result), elementData<double>(bytevector), length);
+	return result;
+}
+
+BytevectorCell *llnumvec_f64vector_less_than_mask(World &world, BytevectorCell *bytevector, double operand)
+{
+	return compareMask(world, "(f64vector-mask<)", bytevector, numvec::Comparison::LessThan, operand);
+}
+
+BytevectorCell *llnumvec_f64vector_greater_than_mask(World &world, BytevectorCell *bytevector, double operand)
+{
+	return compareMask(world, "(f64vector-mask>)", bytevector, numvec::Comparison::GreaterThan, operand);
+}
+
+BytevectorCell *llnumvec_f64vector_equal_mask(World &world, BytevectorCell *bytevector, double operand)
+{
+	return compareMask(world, "(f64vector-mask=)", bytevector, numvec::Comparison::Equal, operand);
+}
+
+BytevectorCell *llnumvec_make_s64vector(World &world, std::int64_t length, std::int64_t fill)
+{
+	return makeFilled<std::int64_t>(world, "(make-s64vector)", length, fill);
+}
+
+BytevectorCell *llnumvec_s64vector(World &world, RestValues<IntegerCell> *argList)
+{
+	return fromElements<std::int64_t>(world, "(s64vector)", argList->begin(), argList->end(), argList->size(), [] (IntegerCell *integer) {
+		return integer->value();
+	});
+}
+
+BytevectorCell *llnumvec_list_to_s64vector(World &world, ProperList<IntegerCell> *list)
+{
+	return fromElements<std::int64_t>(world, "(list->s64vector)", list->begin(), list->end(), list->size(), [] (IntegerCell *integer) {
+		return integer->value();
+	});
+}
+
+std::int64_t llnumvec_s64vector_length(BytevectorCell *bytevector)
+{
+	return elementCount<std::int64_t>(bytevector);
+}
+
+std::int64_t llnumvec_s64vector_ref(World &world, BytevectorCell *bytevector, std::int64_t index)
+{
+	assertIndexValid(world, "(s64vector-ref)", bytevector, elementCount<std::int64_t>(bytevector), index);
+	return elementAt<std::int64_t>(bytevector, index);
+}
+
+void llnumvec_s64vector_set(World &world, BytevectorCell *bytevector, std::int64_t index, std::int64_t value)
+{
+	setElement<std::int64_t>(world, "(s64vector-set!)", bytevector, index, value);
+}
+
+ProperList<IntegerCell> *llnumvec_s64vector_to_list(World &world, BytevectorCell *bytevector)
+{
+	std::vector<IntegerCell*> elements;
+	elements.reserve(elementCount<std::int64_t>(bytevector));
+
+	for(std::int64_t i = 0; i < elementCount<std::int64_t>(bytevector); i++)
+	{
+		elements.push_back(IntegerCell::fromValue(world, elementAt<std::int64_t>(bytevector, i)));
+	}
+
+	return ProperList<IntegerCell>::create(world, elements);
+}
+
+std::int64_t llnumvec_s64vector_sum(World &world, BytevectorCell *bytevector)
+{
+	std::int64_t result;
+
+	if (!numvec::sum(elementData<std::int64_t>(bytevector), elementCount<std::int64_t>(bytevector), result))
+	{
+		signalError(world, ErrorCategory::IntegerOverflow, "Integer overflow in (s64vector-sum)", {bytevector});
+	}
+
+	return result;
+}
+
+std::int64_t llnumvec_s64vector_min(World &world, BytevectorCell *bytevector)
+{
+	assertNonEmpty(world, "(s64vector-min)", bytevector);
+	return numvec::minimum(elementData<std::int64_t>(bytevector), elementCount<std::int64_t>(bytevector));
+}
+
+std::int64_t llnumvec_s64vector_max(World &world, BytevectorCell *bytevector)
+{
+	assertNonEmpty(world, "(s64vector-max)", bytevector);
+	return numvec::maximum(elementData<std::int64_t>(bytevector), elementCount<std::int64_t>(bytevector));
+}
+
+}
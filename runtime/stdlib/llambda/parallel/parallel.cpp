@@ -0,0 +1,112 @@
+#include "core/World.h"
+#include "core/error.h"
+
+#include <vector>
+
+#include "binding/VectorCell.h"
+#include "binding/TypedProcedureCell.h"
+
+#include "actor/cloneCell.h"
+
+#include "sched/Dispatcher.h"
+#include "sched/WorldPartitioner.h"
+
+using namespace lliby;
+
+namespace
+{
+	using MapProc = TypedProcedureCell<AnyCell*, AnyCell*>;
+	using FoldProc = TypedProcedureCell<AnyCell*, AnyCell*, AnyCell*>;
+}
+
+extern "C"
+{
+
+VectorCell* llparallel_vector_map(World &world, MapProc *mapProc, VectorCell *vector)
+{
+	const VectorCell::LengthType length = vector->length();
+	VectorCell *newVector = VectorCell::createUninitialised(world, length);
+
+	if (newVector == nullptr)
+	{
+		signalError(world, ErrorCategory::OutOfMemory, "Out of memory in (parallel-vector-map)");
+	}
+
+	AnyCell **inputElements = vector->elements();
+	AnyCell **outputElements = newVector->elements();
+
+	sched::WorldPartitioner partitioner(world, sched::Dispatcher::defaultInstance());
+
+	try
+	{
+		partitioner.run(mapProc, length, [=] (World &partitionWorld, AnyCell *partitionProc, std::size_t, std::size_t start, std::size_t end)
+		{
+			auto partitionMapProc = static_cast<MapProc*>(partitionProc);
+
+			// Each partition writes to a disjoint range of the output vector
+			for(std::size_t i = start; i < end; i++)
+			{
+				outputElements[i] = partitionMapProc->apply(partitionWorld, inputElements[i]);
+			}
+		});
+	}
+	catch(actor::UnclonableCellException &e)
+	{
+		e.signalSchemeError(world, "(parallel-vector-map)");
+	}
+
+	return newVector;
+}
+
+AnyCell* llparallel_vector_fold(World &world, FoldProc *foldProc, FoldProc *combineProc, AnyCell *initialValue, VectorCell *vector)
+{
+	const VectorCell::LengthType length = vector->length();
+	AnyCell **inputElements = vector->elements();
+
+	sched::WorldPartitioner partitioner(world, sched::Dispatcher::defaultInstance());
+	std::vector<AnyCell*> partitionResults(partitioner.partitionCount(length));
+
+	try
+	{
+		partitioner.run(foldProc, length, [&] (World &partitionWorld, AnyCell *partitionProc, std::size_t partitionIndex, std::size_t start, std::size_t end)
+		{
+			auto partitionFoldProc = static_cast<FoldProc*>(partitionProc);
+
+			// Give each partition its own copy of the initial value in case the procedure mutates it
+			AnyCell *accum = initialValue;
+
+			if (&partitionWorld != &world)
+			{
+				accum = actor::cloneCell(partitionWorld.cellHeap, initialValue, world.activeState());
+			}
+
+			for(std::size_t i = start; i < end; i++)
+			{
+				accum = partitionFoldProc->apply(partitionWorld, inputElements[i], accum);
+			}
+
+			partitionResults[partitionIndex] = accum;
+		});
+	}
+	catch(actor::UnclonableCellException &e)
+	{
+		e.signalSchemeError(world, "(parallel-vector-fold)");
+	}
+
+	if (length == 0)
+	{
+		return initialValue;
+	}
+
+	// Combine the partition results in order in our world
+	AnyCell *accum = partitionResults[0];
+
+	for(std::size_t i = 1; i < partitionResults.size(); i++)
+	{
+		accum = combineProc->apply(world, partitionResults[i], accum);
+	}
+
+	return accum;
+}
+
+}
@@ -3,11 +3,23 @@
 
 #include "unicode/utf8/InvalidByteSequenceException.h"
 
+#include "reader/BulkDatumReader.h"
 #include "reader/DatumReader.h"
+#include "reader/IncrementalDatumReader.h"
 #include "reader/ReadErrorException.h"
 
+#include "serial/BinaryDatumReader.h"
+
+#include "port/FeedPort.h"
+
+#include "sched/Dispatcher.h"
+
+#include "core/World.h"
 #include "core/error.h"
 
+#include <iterator>
+#include <string>
+
 using namespace lliby;
 
 extern "C"
@@ -19,6 +31,19 @@ AnyCell *llread_read(World &world, PortCell *portCell)
 
 	try
 	{
+		if (auto feedPort = dynamic_cast<FeedPort*>(portCell->port()))
+		{
+			// Never block or consume a partial datum from a feed port
+			AnyCell *datum = feedPort->incrementalReader().parse(world);
+
+			if (datum == nullptr)
+			{
+				signalError(world, ErrorCategory::Default, "(read) from feed port without a complete datum", {portCell});
+			}
+
+			return datum;
+		}
+
 		DatumReader reader(world, *portStream);
 		return reader.parse();
 	}
@@ -32,4 +57,63 @@ AnyCell *llread_read(World &world, PortCell *portCell)
 	}
 }
 
+ProperList<AnyCell> *llread_read_all(World &world, PortCell *portCell)
+{
+	std::istream *portStream = portCellToInputStream(world, portCell);
+
+	// Buffer the remainder of the port so it can be divided between threads
+	const std::string inputData((std::istreambuf_iterator<char>(*portStream)), std::istreambuf_iterator<char>());
+	portStream->setstate(std::ios::eofbit);
+
+	try
+	{
+		BulkDatumReader reader(world, inputData.data(), inputData.size(), sched::Dispatcher::defaultInstance());
+		return reader.parseAll();
+	}
+	catch(const ReadErrorException &e)
+	{
+		signalError(world, ErrorCategory::Read, e.message());
+	}
+	catch(const utf8::InvalidByteSequenceException &e)
+	{
+		utf8ExceptionToSchemeError(world, "(read-all)", e);
+	}
+}
+
+AnyCell *llread_read_binary(World &world, PortCell *portCell)
+{
+	std::istream *portStream = portCellToInputStream(world, portCell);
+
+	try
+	{
+		serial::BinaryDatumReader reader(world.cellHeap, *portStream);
+		return reader.parse();
+	}
+	catch(const ReadErrorException &e)
+	{
+		signalError(world, ErrorCategory::Read, e.message());
+	}
+	catch(const utf8::InvalidByteSequenceException &e)
+	{
+		utf8ExceptionToSchemeError(world, "(read-binary)", e);
+	}
+}
+
+PortCell *llread_open_feed_port(World &world)
+{
+	return PortCell::createInstance(world, new FeedPort);
+}
+
+bool llread_feed_port_datum_ready(World &world, PortCell *portCell)
+{
+	auto feedPort = dynamic_cast<FeedPort*>(portCell->port());
+
+	if (feedPort == nullptr)
+	{
+		signalError(world, ErrorCategory::InvalidArgument, "(feed-port-datum-ready?) on non-feed port", {portCell});
+	}
+
+	return feedPort->incrementalReader().datumReady();
+}
+
 }
@@ -3,6 +3,8 @@
 #include "writer/DisplayDatumWriter.h"
 #include "writer/ExternalFormDatumWriter.h"
 
+#include "serial/BinaryDatumWriter.h"
+
 using namespace lliby;
 
 extern "C"
@@ -24,4 +26,19 @@ void llwrite_display(World &world, AnyCell *datum, PortCell *portCell)
 	writer.render(datum);
 }
 
+void llwrite_write_binary(World &world, AnyCell *datum, PortCell *portCell)
+{
+	std::ostream *portStream = portCellToOutputStream(world, portCell);
+
+	try
+	{
+		serial::BinaryDatumWriter writer(*portStream);
+		writer.write(datum);
+	}
+	catch(serial::UnserializableCellException &e)
+	{
+		e.signalSchemeError(world, "(write-binary)");
+	}
+}
+
 }
@@ -0,0 +1,187 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+#include "binding/StringCell.h"
+
+#include "alloc/allocator.h"
+#include "alloc/AllocationSampler.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using alloc::AllocationSampler;
+
+const std::size_t SampleIntervalCells = 16;
+const std::int64_t AllocationCount = 4096;
+
+std::string profileFilename()
+{
+	std::ostringstream filenameStream;
+	filenameStream << "/tmp/llambda-test-alloc-profile-" << getpid() << ".folded";
+
+	return filenameStream.str();
+}
+
+/**
+ * Returns the total weight of the folded profile lines for the passed cell type
+ */
+std::int64_t cellTypeWeight(const std::string &profile, const std::string &typeName)
+{
+	std::istringstream profileStream(profile);
+	std::string line;
+	std::int64_t totalWeight = 0;
+
+	const std::string typeSuffix = ";" + typeName + " ";
+
+	while(std::getline(profileStream, line))
+	{
+		const std::size_t typeOffset = line.rfind(typeSuffix);
+
+		if (typeOffset != std::string::npos)
+		{
+			totalWeight += std::stoll(line.substr(typeOffset + typeSuffix.size()));
+		}
+	}
+
+	return totalWeight;
+}
+
+std::string foldedProfile()
+{
+	std::ostringstream profileStream;
+	AllocationSampler::writeFoldedProfile(profileStream);
+
+	return profileStream.str();
+}
+
+void testDisabled(World &world)
+{
+	ASSERT_FALSE(AllocationSampler::enabled());
+
+	for(std::int64_t i = 0; i < AllocationCount; i++)
+	{
+		IntegerCell::fromValue(world, i);
+	}
+
+	alloc::forceCollection(world);
+	ASSERT_TRUE(foldedProfile().empty());
+}
+
+void testSampling()
+{
+	setenv("LLAMBDA_ALLOC_PROFILE", profileFilename().c_str(), 1);
+	setenv("LLAMBDA_ALLOC_PROFILE_INTERVAL", "16", 1);
+	AllocationSampler::init();
+
+	ASSERT_TRUE(AllocationSampler::enabled());
+	ASSERT_EQUAL(AllocationSampler::sampleIntervalCells(), SampleIntervalCells);
+
+	{
+		World sampledWorld;
+
+		for(std::int64_t i = 0; i < AllocationCount; i++)
+		{
+			ASSERT_EQUAL(IntegerCell::fromValue(sampledWorld, i)->value(), i);
+		}
+
+		// Collection resolves the sampled types
+		alloc::forceCollection(sampledWorld);
+
+		const std::string profile = foldedProfile();
+		const std::int64_t integerWeight = cellTypeWeight(profile, "integer");
+
+		// The estimated count should be in the right ballpark
+		ASSERT_TRUE(integerWeight >= AllocationCount / 2);
+		ASSERT_TRUE(integerWeight <= AllocationCount * 2);
+
+		ASSERT_EQUAL(cellTypeWeight(profile, "string"), 0);
+
+		for(std::int64_t i = 0; i < AllocationCount; i++)
+		{
+			StringCell::fromUtf8StdString(sampledWorld, u8"Sampled");
+		}
+
+		// Destroying the world should resolve its remaining samples
+	}
+
+	const std::string profile = foldedProfile();
+
+	ASSERT_TRUE(cellTypeWeight(profile, "string") >= AllocationCount / 2);
+	ASSERT_TRUE(cellTypeWeight(profile, "string") <= AllocationCount * 2);
+}
+
+void testProfileOnExit()
+{
+	// Our child will have a different PID
+	const std::string filename = profileFilename();
+
+	const pid_t childPid = fork();
+	ASSERT_TRUE(childPid >= 0);
+
+	if (childPid == 0)
+	{
+		setenv("LLAMBDA_ALLOC_PROFILE", filename.c_str(), 1);
+		setenv("LLAMBDA_ALLOC_PROFILE_INTERVAL", "16", 1);
+		AllocationSampler::init();
+
+		World sampledWorld;
+
+		for(std::int64_t i = 0; i < AllocationCount; i++)
+		{
+			IntegerCell::fromValue(sampledWorld, i);
+		}
+
+		alloc::forceCollection(sampledWorld);
+
+		// This is how (exit) leaves the program; llcore_run() never returns
+		exit(3);
+	}
+
+	int status;
+	ASSERT_EQUAL(waitpid(childPid, &status, 0), childPid);
+	ASSERT_TRUE(WIFEXITED(status));
+	ASSERT_EQUAL(WEXITSTATUS(status), 3);
+
+	std::ostringstream profileStream;
+	profileStream << std::ifstream(filename).rdbuf();
+	unlink(filename.c_str());
+
+	ASSERT_TRUE(cellTypeWeight(profileStream.str(), "integer") >= AllocationCount / 2);
+}
+
+void removeExitProfile()
+{
+	unlink(profileFilename().c_str());
+}
+
+void testAll(World &world)
+{
+	// This forks so it needs to run before we've started any threads
+	testProfileOnExit();
+	testDisabled(world);
+	testSampling();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	unsetenv("LLAMBDA_ALLOC_PROFILE");
+
+	// Remove the profile written at exit. This is registered first so it runs after the profile has been written.
+	atexit(removeExitProfile);
+
+	llcore_run(testAll, argc, argv);
+}
@@ -9,9 +9,18 @@
 #include "binding/ProperList.h"
 #include "binding/BooleanCell.h"
 #include "binding/EmptyListCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/PairCell.h"
+#include "binding/RecordCell.h"
+#include "binding/StringCell.h"
+
+#include "dynamic/State.h"
+#include "dynamic/ParameterProcedureCell.h"
 
 #include "alloc/allocator.h"
 #include "alloc/RangeAlloc.h"
+#include "alloc/AllocCell.h"
+#include "alloc/Heap.h"
 
 namespace
 {
@@ -61,6 +70,95 @@ void testLargeNumberOfAllocations(World &world)
 	alloc::forceCollection(world);
 }
 
+void testListSpineContiguity(World &world)
+{
+	const std::uint32_t listLength = 100;
+
+	// Build a list with its values interleaved between its pairs
+	AnyCell *listHead = EmptyListCell::instance();
+
+	for(std::uint32_t i = listLength; i > 0; i--)
+	{
+		IntegerCell *value = IntegerCell::fromValue(world, 1000 + i);
+		listHead = PairCell::createInstance(world, value, listHead);
+	}
+
+	ASSERT_EQUAL(cell_unchecked_cast<PairCell>(listHead)->contiguousRunLength(listLength), 1);
+
+	// Root the list through a parameter value so it survives collection
+	auto paramProc = dynamic::ParameterProcedureCell::createInstance(world, EmptyListCell::instance());
+	dynamic::State::pushActiveState(world);
+	world.activeState()->setValueForParameter(world, paramProc, listHead);
+
+	alloc::forceCollection(world);
+
+	ASSERT_EQUAL(world.activeState()->savedValues().size(), 1);
+	paramProc = world.activeState()->savedValues()[0].parameterProc;
+	listHead = paramProc->value();
+
+	// The collector should have moved the spine as a single run
+	ASSERT_EQUAL(cell_unchecked_cast<PairCell>(listHead)->contiguousRunLength(listLength + 1), listLength);
+
+	std::int64_t expectedValue = 1001;
+	for(auto value : *cell_unchecked_cast<ProperList<IntegerCell>>(listHead))
+	{
+		ASSERT_EQUAL(value->value(), expectedValue++);
+	}
+
+	dynamic::State::popActiveState(world);
+}
+
+void testRecordDataAlloc(World &world)
+{
+	// Record with a single cell field followed by 40 bytes of padding
+	const std::size_t totalSize = 48;
+	auto recordClassId = RecordLikeCell::registerRuntimeRecordClass(totalSize, {0});
+
+	// Record data shouldn't be allocated between consecutive cell allocations
+	IntegerCell *firstCell = IntegerCell::fromValue(world, 1000000);
+	void *recordData = RecordLikeCell::allocateRecordData(world.cellHeap, totalSize);
+	IntegerCell *secondCell = IntegerCell::fromValue(world, 1000001);
+
+	ASSERT_EQUAL(reinterpret_cast<alloc::AllocCell*>(secondCell), reinterpret_cast<alloc::AllocCell*>(firstCell) + 1);
+
+	StringCell *fieldValue = StringCell::fromUtf8StdString(world, u8"Hello");
+	*static_cast<AnyCell**>(recordData) = fieldValue;
+
+	RecordCell *recordCell = RecordCell::createInstance(world, recordClassId, false, recordData);
+
+	// The data should be stored in a run of heap cells
+	auto storageCell = alloc::InlineStorageCell::fromData(recordCell->recordData());
+	ASSERT_TRUE(storageCell->gcState() == GarbageState::InlineStorageCell);
+	ASSERT_EQUAL(storageCell->storageCells(), 2);
+
+	// Root the record through a parameter value so it survives collection
+	auto paramProc = dynamic::ParameterProcedureCell::createInstance(world, EmptyListCell::instance());
+	dynamic::State::pushActiveState(world);
+	world.activeState()->setValueForParameter(world, paramProc, recordCell);
+
+	alloc::forceCollection(world);
+
+	paramProc = world.activeState()->savedValues()[0].parameterProc;
+	recordCell = cell_unchecked_cast<RecordCell>(paramProc->value());
+
+	// The data should have been evacuated with the record
+	ASSERT_TRUE(recordCell->recordData() != recordData);
+
+	auto newStorageCell = alloc::InlineStorageCell::fromData(recordCell->recordData());
+	ASSERT_TRUE(newStorageCell->gcState() == GarbageState::InlineStorageCell);
+	ASSERT_EQUAL(newStorageCell->storageCells(), 2);
+
+	// The field should point to the relocated string
+	auto newFieldValue = *static_cast<StringCell**>(recordCell->recordData());
+	ASSERT_TRUE(newFieldValue != fieldValue);
+	ASSERT_UTF8_EQUAL(newFieldValue, u8"Hello");
+
+	dynamic::State::popActiveState(world);
+
+	// Make sure the finalizer can walk over the record data
+	alloc::forceCollection(world);
+}
+
 void testAll(World &world)
 {
 	// Test large allocations
@@ -68,6 +166,12 @@ void testAll(World &world)
 
 	// Test large number of allocations
 	testLargeNumberOfAllocations(world);
+
+	// Test lists remain contiguous after collection
+	testListSpineContiguity(world);
+
+	// Test record data allocation
+	testRecordDataAlloc(world);
 }
 
 }
@@ -0,0 +1,300 @@
+#include <string>
+#include <sstream>
+#include <limits>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "alloc/allocator.h"
+
+#include "binding/PairCell.h"
+#include "binding/VectorCell.h"
+#include "binding/StringCell.h"
+#include "binding/EmptyListCell.h"
+#include "binding/EofObjectCell.h"
+#include "binding/IntegerCell.h"
+
+#include "reader/DatumReader.h"
+#include "reader/ReadErrorException.h"
+#include "writer/ExternalFormDatumWriter.h"
+
+#include "serial/BinaryDatumReader.h"
+#include "serial/BinaryDatumWriter.h"
+
+#include "unicode/utf8/InvalidByteSequenceException.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+std::string externalFormFor(const AnyCell *datum)
+{
+	std::ostringstream outStream;
+
+	ExternalFormDatumWriter writer(outStream);
+	writer.render(datum);
+
+	return outStream.str();
+}
+
+std::string encode(const AnyCell *datum)
+{
+	std::ostringstream outStream;
+
+	serial::BinaryDatumWriter writer(outStream);
+	writer.write(datum);
+
+	return outStream.str();
+}
+
+AnyCell *decode(World &world, const std::string &encoded)
+{
+	std::istringstream inStream(encoded);
+
+	serial::BinaryDatumReader reader(world.cellHeap, inStream);
+	return reader.parse();
+}
+
+void assertRoundTrips(World &world, const std::string &source)
+{
+	std::istringstream sourceStream(source);
+	DatumReader datumReader(world, sourceStream);
+
+	AnyCell *datum = datumReader.parse();
+	AnyCell *decoded = decode(world, encode(datum));
+
+	ASSERT_EQUAL(externalFormFor(decoded), externalFormFor(datum));
+}
+
+template<class T>
+void assertDecodeThrows(World &world, const std::string &encoded)
+{
+	bool threw = false;
+
+	try
+	{
+		decode(world, encoded);
+	}
+	catch(const T &)
+	{
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+}
+
+std::string header(std::uint8_t bodyLength, std::uint8_t cellCount)
+{
+	return std::string("LLBD\x01", 5) + static_cast<char>(bodyLength) + static_cast<char>(cellCount);
+}
+
+void testRoundTrip(World &world)
+{
+	assertRoundTrips(world, "#t");
+	assertRoundTrips(world, "#f");
+	assertRoundTrips(world, "()");
+	assertRoundTrips(world, "#!unit");
+	assertRoundTrips(world, "0");
+	assertRoundTrips(world, "-1");
+	assertRoundTrips(world, "9223372036854775807");
+	assertRoundTrips(world, "-9223372036854775807");
+	assertRoundTrips(world, "1/3");
+	assertRoundTrips(world, "-9223372036854775807/9223372036854775806");
+	assertRoundTrips(world, "-0.0");
+	assertRoundTrips(world, "0.1");
+	assertRoundTrips(world, "+inf.0");
+	assertRoundTrips(world, "+nan.0");
+	assertRoundTrips(world, "#\\x10FFFE");
+	assertRoundTrips(world, "#\\a");
+	assertRoundTrips(world, "\"\"");
+	assertRoundTrips(world, "\"Hello, world!\"");
+	assertRoundTrips(world, "\"A string long enough to be stored out of line on the heap ☃\"");
+	assertRoundTrips(world, "|sym bol|");
+	assertRoundTrips(world, "#u8()");
+	assertRoundTrips(world, "#u8(0 1 2 255)");
+	assertRoundTrips(world, "#()");
+	assertRoundTrips(world, "#(1 #(2 3) \"four\")");
+	assertRoundTrips(world, "(1 2 3)");
+	assertRoundTrips(world, "(1 2 . 3)");
+	assertRoundTrips(world, "((a . b) (c d) #(e (f)) . #u8(1))");
+}
+
+void testEmptyInput(World &world)
+{
+	ASSERT_EQUAL(decode(world, ""), EofObjectCell::instance());
+
+	// Multiple datums can be read back-to-back
+	AnyCell *firstDatum = IntegerCell::fromValue(world, std::numeric_limits<std::int64_t>::min());
+	AnyCell *secondDatum = EmptyListCell::instance();
+
+	std::istringstream inStream(encode(firstDatum) + encode(secondDatum));
+	serial::BinaryDatumReader reader(world.cellHeap, inStream);
+
+	ASSERT_EQUAL(externalFormFor(reader.parse()), "-9223372036854775808");
+	ASSERT_EQUAL(reader.parse(), EmptyListCell::instance());
+	ASSERT_EQUAL(reader.parse(), EofObjectCell::instance());
+}
+
+void testSharedStructure(World &world)
+{
+	StringCell *sharedString = StringCell::fromUtf8StdString(world, "shared");
+	PairCell *sharedPair = PairCell::createInstance(world, sharedString, EmptyListCell::instance());
+	PairCell *outerList = PairCell::createInstance(world, sharedPair, PairCell::createInstance(world, sharedPair, sharedString));
+
+	auto decoded = cell_cast<PairCell>(decode(world, encode(outerList)));
+	ASSERT_TRUE(decoded != nullptr);
+
+	auto decodedSecond = cell_cast<PairCell>(decoded->cdr());
+	ASSERT_TRUE(decodedSecond != nullptr);
+
+	// Both references to the pair and string should be preserved
+	ASSERT_EQUAL(decoded->car(), decodedSecond->car());
+	ASSERT_EQUAL(cell_cast<PairCell>(decoded->car())->car(), decodedSecond->cdr());
+	ASSERT_EQUAL(externalFormFor(decoded), "((\"shared\") (\"shared\") . \"shared\")");
+}
+
+void testCyclicStructure(World &world)
+{
+	// Circular list of three elements
+	PairCell *tailPair = PairCell::createInstance(world, IntegerCell::fromValue(world, 3), EmptyListCell::instance());
+	PairCell *middlePair = PairCell::createInstance(world, IntegerCell::fromValue(world, 2), tailPair);
+	PairCell *headPair = PairCell::createInstance(world, IntegerCell::fromValue(world, 1), middlePair);
+	tailPair->setCdr(headPair);
+
+	auto decodedHead = cell_cast<PairCell>(decode(world, encode(headPair)));
+	ASSERT_TRUE(decodedHead != nullptr);
+
+	auto decodedMiddle = cell_cast<PairCell>(decodedHead->cdr());
+	auto decodedTail = cell_cast<PairCell>(decodedMiddle->cdr());
+
+	ASSERT_EQUAL(externalFormFor(decodedTail->car()), "3");
+	ASSERT_EQUAL(decodedTail->cdr(), decodedHead);
+
+	// Vector containing itself
+	AnyCell **elements = new AnyCell*[2];
+	elements[0] = EmptyListCell::instance();
+	elements[1] = StringCell::fromUtf8StdString(world, "self");
+
+	VectorCell *vectorCell = VectorCell::fromElements(world, elements, 2);
+	vectorCell->elements()[0] = vectorCell;
+
+	auto decodedVector = cell_cast<VectorCell>(decode(world, encode(vectorCell)));
+	ASSERT_TRUE(decodedVector != nullptr);
+	ASSERT_EQUAL(decodedVector->length(), 2);
+	ASSERT_EQUAL(decodedVector->elements()[0], decodedVector);
+	ASSERT_EQUAL(externalFormFor(decodedVector->elements()[1]), "\"self\"");
+
+	// Make sure the decoded cells survive collection
+	alloc::forceCollection(world);
+}
+
+void testUnserializable(World &world)
+{
+	PairCell *listWithEof = PairCell::createInstance(world, EofObjectCell::instance(), EmptyListCell::instance());
+
+	bool threw = false;
+	std::ostringstream outStream;
+
+	try
+	{
+		serial::BinaryDatumWriter writer(outStream);
+		writer.write(listWithEof);
+	}
+	catch(const serial::UnserializableCellException &e)
+	{
+		threw = true;
+		ASSERT_EQUAL(e.cell(), EofObjectCell::instance());
+	}
+
+	ASSERT_TRUE(threw);
+
+	// Nothing should be written on failure
+	ASSERT_EQUAL(outStream.str(), "");
+}
+
+void testMalformed(World &world)
+{
+	// Truncated header
+	assertDecodeThrows<UnexpectedEofException>(world, "LLB");
+
+	// Bad magic and version
+	assertDecodeThrows<MalformedDatumException>(world, std::string("LLBX\x01\x01\x00\x01", 8));
+	assertDecodeThrows<MalformedDatumException>(world, std::string("LLBD\x02\x01\x00\x01", 8));
+
+	// Body shorter than its declared length
+	assertDecodeThrows<UnexpectedEofException>(world, header(4, 0) + "\x01");
+
+	// More cells than body bytes
+	assertDecodeThrows<MalformedDatumException>(world, header(1, 2) + "\x01");
+
+	// Cell count doesn't match the body
+	assertDecodeThrows<MalformedDatumException>(world, header(2, 0) + "\x10\x02");
+	assertDecodeThrows<MalformedDatumException>(world, header(1, 1) + "\x01");
+
+	// Unknown tag
+	assertDecodeThrows<MalformedDatumException>(world, header(1, 0) + "\x7f");
+
+	// Trailing data
+	assertDecodeThrows<MalformedDatumException>(world, header(2, 0) + "\x01\x01");
+
+	// String longer than the body
+	assertDecodeThrows<UnexpectedEofException>(world, header(3, 1) + "\x13\x10" + "a");
+
+	// Invalid UTF-8
+	assertDecodeThrows<utf8::InvalidByteSequenceException>(world, header(3, 1) + "\x13\x01\xff");
+
+	// Back-reference to a node that hasn't been read
+	assertDecodeThrows<MalformedDatumException>(world, header(4, 1) + std::string("\x17\x01\x20\x01", 4));
+
+	// Invalid code point
+	assertDecodeThrows<MalformedDatumException>(world, header(5, 1) + std::string("\x12\x80\x80\xc4\x00", 5));
+
+	// Ratnums not in lowest terms
+	assertDecodeThrows<MalformedDatumException>(world, header(3, 1) + std::string("\x18\x04\x04", 3));
+	assertDecodeThrows<MalformedDatumException>(world, header(3, 1) + std::string("\x18\x02\x01", 3));
+	assertDecodeThrows<MalformedDatumException>(world, header(3, 1) + std::string("\x18\x02\x00", 3));
+
+	// Nesting at the limit is allowed while deeper nesting is rejected
+	const unsigned int maximumDepth = serial::BinaryDatumReader::MaximumNestingDepth;
+
+	std::string maximumNested;
+
+	for(unsigned int i = 0; i < maximumDepth; i++)
+	{
+		maximumNested = "#(" + maximumNested + ")";
+	}
+
+	const std::string tooNested = "(" + maximumNested + ")";
+
+	assertRoundTrips(world, maximumNested);
+
+	{
+		std::istringstream sourceStream(tooNested);
+		DatumReader datumReader(world, sourceStream);
+
+		assertDecodeThrows<MalformedDatumException>(world, encode(datumReader.parse()));
+	}
+
+	// Failed decodes must leave the heap safe to collect
+	alloc::forceCollection(world);
+}
+
+void testAll(World &world)
+{
+	testRoundTrip(world);
+	testEmptyInput(world);
+	testSharedStructure(world);
+	testCyclicStructure(world);
+	testUnserializable(world);
+	testMalformed(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,134 @@
+#include <string>
+#include <sstream>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+#include "binding/StringCell.h"
+#include "binding/SymbolCell.h"
+#include "binding/ProperList.h"
+
+#include "reader/BulkDatumReader.h"
+#include "reader/ReadErrorException.h"
+
+#include "sched/Dispatcher.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+/**
+ * Builds source containing the integers [0, count) in a variety of datum forms
+ */
+std::string buildSource(int count)
+{
+	std::ostringstream source;
+
+	for(int i = 0; i < count; i++)
+	{
+		switch(i % 4)
+		{
+		case 0:
+			source << "(" << i << " \"str)ing\") ; comment (\n";
+			break;
+		case 1:
+			source << "#| block " << i << " |# #(" << i << " #\\))\n";
+			break;
+		case 2:
+			source << "#;(skipped) '" << i << " ";
+			break;
+		case 3:
+			source << "|sym bol| " << i << " ";
+			break;
+		}
+	}
+
+	return source.str();
+}
+
+/**
+ * Checks that parsing in chunks returns the same datums as parsing in a single chunk
+ */
+void testParallelMatchesSequential(World &world)
+{
+	const std::string source(buildSource(40000));
+	ASSERT_TRUE(source.size() > (BulkDatumReader::MinimumChunkBytes * 4));
+
+	BulkDatumReader sequentialReader(world, source.data(), source.size(), sched::Dispatcher::defaultInstance(), 1);
+	ProperList<AnyCell> *sequentialDatums = sequentialReader.parseAll();
+	ASSERT_EQUAL(sequentialReader.chunkCount(), 1);
+
+	BulkDatumReader parallelReader(world, source.data(), source.size(), sched::Dispatcher::defaultInstance(), 4);
+	ProperList<AnyCell> *parallelDatums = parallelReader.parseAll();
+	ASSERT_EQUAL(parallelReader.chunkCount(), 4);
+
+	// Every case produces one datum except the symbol case which produces two
+	ASSERT_EQUAL(sequentialDatums->size(), 50000);
+	ASSERT_EQUAL(parallelDatums->size(), 50000);
+
+	// Compare each datum individually as isEqual() recurses along the spine of the list
+	auto parallelIt = parallelDatums->begin();
+
+	for(AnyCell *sequentialDatum : *sequentialDatums)
+	{
+		ASSERT_TRUE(sequentialDatum->isEqual(*parallelIt));
+		parallelIt++;
+	}
+}
+
+void testSmallInput(World &world)
+{
+	const std::string source("1 2 (3)");
+
+	BulkDatumReader reader(world, source.data(), source.size(), sched::Dispatcher::defaultInstance());
+	ProperList<AnyCell> *datums = reader.parseAll();
+
+	ASSERT_EQUAL(reader.chunkCount(), 1);
+	ASSERT_TRUE(datums->isEqual(ProperList<AnyCell>::create(world, {
+		IntegerCell::fromValue(world, 1),
+		IntegerCell::fromValue(world, 2),
+		ProperList<AnyCell>::create(world, {IntegerCell::fromValue(world, 3)})
+	})));
+
+	BulkDatumReader emptyReader(world, source.data(), 0, sched::Dispatcher::defaultInstance());
+	ASSERT_EQUAL(emptyReader.parseAll()->size(), 0);
+}
+
+void testParallelError(World &world)
+{
+	std::string source(buildSource(40000));
+	source += " (unterminated";
+
+	BulkDatumReader reader(world, source.data(), source.size(), sched::Dispatcher::defaultInstance(), 4);
+
+	bool threw = false;
+
+	try
+	{
+		reader.parseAll();
+	}
+	catch(const UnexpectedEofException &)
+	{
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+}
+
+void testAll(World &world)
+{
+	testParallelMatchesSequential(world);
+	testSmallInput(world);
+	testParallelError(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -95,6 +95,21 @@ void testByteAccess(World &world)
 	ASSERT_EQUAL(testVector->setByteAt(5, 255), false);
 }
 
+void testWritableData(World &world)
+{
+	uint8_t vectorData[5] = { 0, 1, 2, 3, 4 };
+
+	BytevectorCell *testVector = BytevectorCell::fromData(world, vectorData, sizeof(vectorData));
+	BytevectorCell *sharedCopy = testVector->copy(world);
+
+	// Writing through the data pointer must not be visible in the copy
+	std::uint8_t *writableData = testVector->writableData();
+	writableData[0] = 100;
+
+	ASSERT_EQUAL(testVector->byteAt(0), 100);
+	ASSERT_EQUAL(sharedCopy->byteAt(0), 0);
+}
+
 void testCopy(World &world)
 {
 	uint8_t vectorData[5] = { 0, 1, 2, 3, 4 };
@@ -332,6 +347,7 @@ void testAll(World &world)
 	testFromFill(world);
 	testFromAppended(world);
 	testByteAccess(world);
+	testWritableData(world);
 	testCopy(world);
 	testReplace(world);
 	testUtf8ToString(world);
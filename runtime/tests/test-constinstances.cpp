@@ -1,6 +1,8 @@
 #include "binding/BooleanCell.h"
 #include "binding/UnitCell.h"
 #include "binding/EmptyListCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/CharCell.h"
 
 #include "core/init.h"
 #include "assertions.h"
@@ -16,6 +18,34 @@ void testAll(World &world)
 	ASSERT_EQUAL(BooleanCell::trueInstance()->value(), true);
 	ASSERT_EQUAL(BooleanCell::falseInstance()->value(), false);
 	ASSERT_TRUE(EmptyListCell::isInstance(EmptyListCell::instance()));
+
+	// Small integers are shared constants at both ends of their range
+	for(std::int64_t value : {SmallIntegerMinimum, std::int64_t(-1), std::int64_t(0), std::int64_t(15), SmallIntegerMaximum})
+	{
+		IntegerCell *integerCell = IntegerCell::fromValue(world, value);
+
+		ASSERT_EQUAL(integerCell->value(), value);
+		ASSERT_TRUE(integerCell->isGlobalConstant());
+		ASSERT_EQUAL(integerCell, IntegerCell::fromValue(world, value));
+	}
+
+	ASSERT_FALSE(IntegerCell::fromValue(world, SmallIntegerMinimum - 1)->isGlobalConstant());
+	ASSERT_FALSE(IntegerCell::fromValue(world, SmallIntegerMaximum + 1)->isGlobalConstant());
+	ASSERT_EQUAL(IntegerCell::fromValue(world, SmallIntegerMaximum + 1)->value(), SmallIntegerMaximum + 1);
+
+	// Latin-1 characters are shared constants
+	for(std::int32_t codePoint : {0x00, 0x41, 0xFF})
+	{
+		CharCell *charCell = CharCell::createInstance(world, codePoint);
+
+		ASSERT_EQUAL(charCell->unicodeChar().codePoint(), codePoint);
+		ASSERT_TRUE(charCell->isGlobalConstant());
+		ASSERT_EQUAL(charCell, CharCell::createInstance(world, codePoint));
+	}
+
+	CharCell *snowmanCell = CharCell::createInstance(world, 0x2603);
+	ASSERT_FALSE(snowmanCell->isGlobalConstant());
+	ASSERT_EQUAL(snowmanCell->unicodeChar().codePoint(), 0x2603);
 }
 
 }
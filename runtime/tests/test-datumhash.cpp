@@ -11,6 +11,7 @@
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/ProcedureCell.h"
 #include "binding/CharCell.h"
 #include "binding/BytevectorCell.h"
@@ -106,6 +107,11 @@ void testAll(World &world)
 	testValues.push_back(FlonumCell::fromValue(world, 1.0));
 	testValues.push_back(FlonumCell::fromValue(world, std::numeric_limits<double>::max()));
 
+	testValues.push_back(RatnumCell::fromFraction(world, 1, 2));
+	testValues.push_back(RatnumCell::fromFraction(world, -1, 2));
+	testValues.push_back(RatnumCell::fromFraction(world, 2, 3));
+	testValues.push_back(RatnumCell::fromFraction(world, 1, std::numeric_limits<std::int64_t>::max()));
+
 	testValues.push_back(CharCell::createInstance(world, UnicodeChar(0x0)));
 	testValues.push_back(CharCell::createInstance(world, UnicodeChar(0x20)));
 	testValues.push_back(CharCell::createInstance(world, UnicodeChar(0x41)));
@@ -6,6 +6,7 @@
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/EmptyListCell.h"
 #include "binding/EofObjectCell.h"
 #include "binding/SymbolCell.h"
@@ -212,6 +213,29 @@ void testReals(World &world)
 	ASSERT_INVALID_PARSE("1e9223372036854775808");
 }
 
+void testRationals(World &world)
+{
+	ASSERT_PARSES("1/2", RatnumCell::fromFraction(world, 1, 2));
+	ASSERT_PARSES("-3/4", RatnumCell::fromFraction(world, -3, 4));
+	ASSERT_PARSES("+3/4", RatnumCell::fromFraction(world, 3, 4));
+	ASSERT_PARSES("6/8", RatnumCell::fromFraction(world, 3, 4));
+	ASSERT_PARSES("-9/3", IntegerCell::fromValue(world, -3));
+	ASSERT_PARSES("0/5", IntegerCell::fromValue(world, 0));
+
+	ASSERT_PARSES("#b1/10", RatnumCell::fromFraction(world, 1, 2));
+	ASSERT_PARSES("#o-7/10", RatnumCell::fromFraction(world, -7, 8));
+	ASSERT_PARSES("#xa/1b", RatnumCell::fromFraction(world, 10, 27));
+
+	ASSERT_PARSES("9223372036854775807/9223372036854775806",
+			RatnumCell::fromFraction(world, 9223372036854775807LL, 9223372036854775806LL));
+
+	ASSERT_INVALID_PARSE("1/0");
+	ASSERT_INVALID_PARSE("1/");
+	ASSERT_INVALID_PARSE("1/-2");
+	ASSERT_INVALID_PARSE("1/9223372036854775808");
+	ASSERT_INVALID_PARSE("#b1/2");
+}
+
 void testStrings(World &world)
 {
 	ASSERT_STRING_PARSE("", "");
@@ -364,6 +388,15 @@ void testComments(World &world)
 
 	expectedList = ProperList<AnyCell>::create(world, {displaySymbol, lolString});
 	ASSERT_PARSES(multilineTest, expectedList);
+
+	// Comments can be followed by whitespace or the end of a list
+	ASSERT_PARSES("#;(skipped) #t", BooleanCell::trueInstance());
+	ASSERT_PARSES("#| comment |# #t", BooleanCell::trueInstance());
+	ASSERT_PARSES("(#t #| comment |#)", ProperList<AnyCell>::create(world, {BooleanCell::trueInstance()}));
+
+	// Block comment delimiters can directly follow other # and | characters
+	ASSERT_PARSES("#| ||# #t", BooleanCell::trueInstance());
+	ASSERT_PARSES("#| ##| |# |# #t", BooleanCell::trueInstance());
 }
 
 void testSymbolShorthand(World &world, std::string shorthand, std::string expansion)
@@ -551,6 +584,7 @@ void testAll(World &world)
 	testEnclosedSymbols(world);
 	testIntegers(world);
 	testReals(world);
+	testRationals(world);
 	testStrings(world);
 	testProperList(world);
 	testImproperList(world);
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "sched/Dispatcher.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using sched::Dispatcher;
+
+const int WorkerCount = 4;
+
+/**
+ * Starts WorkerCount workers and waits for them all to become idle
+ *
+ * @return Worker IDs of the started workers
+ */
+std::vector<Dispatcher::WorkerId> startIdleWorkers(Dispatcher &dispatcher)
+{
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::vector<Dispatcher::WorkerId> workerIds;
+
+	for(int i = 0; i < WorkerCount; i++)
+	{
+		// Block each work function until all of them are running so they're given distinct workers
+		dispatcher.dispatch([&] {
+			std::unique_lock<std::mutex> lock(mutex);
+			workerIds.push_back(dispatcher.currentWorkerId());
+
+			cond.notify_all();
+			cond.wait(lock, [&] { return workerIds.size() == WorkerCount; });
+		});
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cond.wait(lock, [&] { return workerIds.size() == WorkerCount; });
+	}
+
+	// Give the workers a chance to go idle
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	return workerIds;
+}
+
+Dispatcher::WorkerId workerIdRunningWork(Dispatcher &dispatcher, Dispatcher::WorkerId homeWorker)
+{
+	std::mutex mutex;
+	std::condition_variable cond;
+	bool finished = false;
+
+	Dispatcher::WorkerId runningWorker = Dispatcher::NoWorker;
+
+	dispatcher.dispatch([&] {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		runningWorker = dispatcher.currentWorkerId();
+		finished = true;
+
+		cond.notify_all();
+	}, homeWorker);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	cond.wait(lock, [&] { return finished; });
+
+	return runningWorker;
+}
+
+void testWorkerIds()
+{
+	Dispatcher dispatcher;
+
+	// We're not a worker thread
+	ASSERT_EQUAL(dispatcher.currentWorkerId(), Dispatcher::NoWorker);
+	ASSERT_EQUAL(Dispatcher::defaultInstance().currentWorkerId(), Dispatcher::NoWorker);
+
+	std::vector<Dispatcher::WorkerId> workerIds(startIdleWorkers(dispatcher));
+	std::sort(workerIds.begin(), workerIds.end());
+
+	// IDs should be allocated densely from zero
+	for(int i = 0; i < WorkerCount; i++)
+	{
+		ASSERT_EQUAL(workerIds[i], i);
+	}
+
+	dispatcher.waitForDrain();
+}
+
+void testHomeWorker()
+{
+	Dispatcher dispatcher;
+	std::vector<Dispatcher::WorkerId> workerIds(startIdleWorkers(dispatcher));
+
+	// Each worker should receive work when it's idle and requested as the home worker
+	for(auto workerId : workerIds)
+	{
+		ASSERT_EQUAL(workerIdRunningWork(dispatcher, workerId), workerId);
+
+		// Wait for the worker to go idle again
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	// Work for an unknown home worker should still run
+	ASSERT_TRUE(workerIdRunningWork(dispatcher, WorkerCount + 100) != Dispatcher::NoWorker);
+
+	dispatcher.waitForDrain();
+}
+
+void testPinnedWorkers()
+{
+	Dispatcher dispatcher(true);
+	std::atomic<int> completedWork(0);
+
+	ASSERT_TRUE(dispatcher.pinsWorkers());
+
+	for(int i = 0; i < 100; i++)
+	{
+		dispatcher.dispatch([&] {
+			completedWork++;
+		});
+	}
+
+	dispatcher.waitForDrain();
+	ASSERT_EQUAL(completedWork.load(), 100);
+}
+
+void testAll(World &world)
+{
+	testWorkerIds();
+	testHomeWorker();
+	testPinnedWorkers();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,146 @@
+#include <string>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+#include "binding/StringCell.h"
+
+#include "dynamic/State.h"
+#include "dynamic/ParameterProcedureCell.h"
+
+#include "alloc/allocator.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using dynamic::State;
+using dynamic::ParameterProcedureCell;
+
+std::int64_t integerValue(AnyCell *cell)
+{
+	return cell_unchecked_cast<IntegerCell>(cell)->value();
+}
+
+void testNestedParameterize(World &world)
+{
+	auto param1 = ParameterProcedureCell::createInstance(world, IntegerCell::fromValue(world, 1));
+	auto param2 = ParameterProcedureCell::createInstance(world, IntegerCell::fromValue(world, 2));
+
+	State *rootState = State::activeState(world);
+	ASSERT_EQUAL(integerValue(rootState->valueForParameter(param1)), 1);
+
+	State::pushActiveState(world);
+	State *outerState = State::activeState(world);
+	outerState->setValueForParameter(world, param1, IntegerCell::fromValue(world, 10));
+
+	ASSERT_TRUE(outerState->parent() == rootState);
+	ASSERT_EQUAL(integerValue(outerState->valueForParameter(param1)), 10);
+	ASSERT_EQUAL(integerValue(outerState->valueForParameter(param2)), 2);
+
+	State::pushActiveState(world);
+	State *innerState = State::activeState(world);
+	innerState->setValueForParameter(world, param1, IntegerCell::fromValue(world, 100));
+	innerState->setValueForParameter(world, param2, IntegerCell::fromValue(world, 200));
+
+	// Parameterizing the same parameter twice in one state should restore the original value
+	innerState->setValueForParameter(world, param1, IntegerCell::fromValue(world, 1000));
+
+	ASSERT_EQUAL(integerValue(innerState->valueForParameter(param1)), 1000);
+	ASSERT_EQUAL(integerValue(innerState->valueForParameter(param2)), 200);
+
+	State::popActiveState(world);
+	ASSERT_TRUE(State::activeState(world) == outerState);
+	ASSERT_EQUAL(integerValue(outerState->valueForParameter(param1)), 10);
+	ASSERT_EQUAL(integerValue(outerState->valueForParameter(param2)), 2);
+
+	State::popActiveState(world);
+	ASSERT_TRUE(State::activeState(world) == rootState);
+	ASSERT_EQUAL(integerValue(rootState->valueForParameter(param1)), 1);
+	ASSERT_EQUAL(integerValue(rootState->valueForParameter(param2)), 2);
+}
+
+void testStateReuse(World &world)
+{
+	auto param = ParameterProcedureCell::createInstance(world, IntegerCell::fromValue(world, 1));
+
+	State::pushActiveState(world);
+	State *firstState = State::activeState(world);
+	firstState->setValueForParameter(world, param, IntegerCell::fromValue(world, 2));
+	State::popActiveState(world);
+
+	// The popped state should be reused without its saved values
+	State::pushActiveState(world);
+	ASSERT_TRUE(State::activeState(world) == firstState);
+	ASSERT_TRUE(firstState->savedValues().empty());
+	ASSERT_EQUAL(integerValue(firstState->valueForParameter(param)), 1);
+	State::popActiveState(world);
+}
+
+void testPopUntilState(World &world)
+{
+	auto param = ParameterProcedureCell::createInstance(world, IntegerCell::fromValue(world, 0));
+	State *rootState = State::activeState(world);
+
+	for(std::int64_t i = 1; i <= 5; i++)
+	{
+		State::pushActiveState(world);
+		State::activeState(world)->setValueForParameter(world, param, IntegerCell::fromValue(world, i));
+	}
+
+	ASSERT_EQUAL(integerValue(param->value()), 5);
+
+	State::popUntilState(world, rootState);
+
+	ASSERT_TRUE(State::activeState(world) == rootState);
+	ASSERT_EQUAL(integerValue(param->value()), 0);
+}
+
+std::string stringValue(AnyCell *cell)
+{
+	return cell_unchecked_cast<StringCell>(cell)->toUtf8StdString();
+}
+
+void testGarbageCollection(World &world)
+{
+	auto param = ParameterProcedureCell::createInstance(world, StringCell::fromUtf8StdString(world, u8"Initial"));
+
+	State::pushActiveState(world);
+	State::activeState(world)->setValueForParameter(world, param, StringCell::fromUtf8StdString(world, u8"Outer"));
+
+	State::pushActiveState(world);
+	State::activeState(world)->setValueForParameter(world, param, StringCell::fromUtf8StdString(world, u8"Inner"));
+
+	// The parameter is only rooted through the saved values
+	alloc::forceCollection(world);
+
+	ASSERT_EQUAL(State::activeState(world)->savedValues().size(), 1);
+	param = State::activeState(world)->savedValues()[0].parameterProc;
+
+	ASSERT_EQUAL(stringValue(param->value()), u8"Inner");
+	ASSERT_EQUAL(stringValue(State::activeState(world)->savedValues()[0].value), u8"Outer");
+
+	State::popActiveState(world);
+	ASSERT_EQUAL(stringValue(param->value()), u8"Outer");
+
+	State::popActiveState(world);
+	ASSERT_EQUAL(stringValue(param->value()), u8"Initial");
+}
+
+void testAll(World &world)
+{
+	testNestedParameterize(world);
+	testStateReuse(world);
+	testPopUntilState(world);
+	testGarbageCollection(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -1,15 +1,18 @@
 #include <string>
 #include <sstream>
+#include <limits>
 
 #include "core/init.h"
 #include "core/World.h"
 
 #include "writer/ExternalFormDatumWriter.h"
+#include "writer/NumberFormat.h"
 #include "binding/UnitCell.h"
 #include "binding/EmptyListCell.h"
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/StringCell.h"
 #include "binding/SymbolCell.h"
 #include "binding/PairCell.h"
@@ -43,6 +46,13 @@ std::string externalFormFor(const AnyCell *datum)
 	ExternalFormDatumWriter writer(outputStream);
 	writer.render(datum);
 
+	// Rendering in to memory should produce identical output
+	ExternalFormDatumWriter memoryWriter;
+	memoryWriter.render(datum);
+
+	const OutputBuffer &memoryOutput(memoryWriter.output());
+	ASSERT_EQUAL(std::string(memoryOutput.data(), memoryOutput.size()), outputStream.str());
+
 	return outputStream.str();
 }
 
@@ -99,6 +109,60 @@ void testFlonum(World &world)
 	assertForm(FlonumCell::negativeInfinity(world), "-inf.0");
 }
 
+void testRatnum(World &world)
+{
+	assertForm(RatnumCell::fromFraction(world, 1, 2), "1/2");
+	assertForm(RatnumCell::fromFraction(world, -10, 4), "-5/2");
+	assertForm(RatnumCell::fromFraction(world, 7, -3), "-7/3");
+}
+
+/**
+ * Writes a number format and checks it writes exactly its calculated length
+ */
+std::string formatted(const NumberFormat &format)
+{
+	const char GuardByte = '!';
+	std::string output(format.length() + 1, GuardByte);
+
+	format.write(&output[0]);
+	ASSERT_EQUAL(output.back(), GuardByte);
+
+	output.pop_back();
+	return output;
+}
+
+void testNumberFormat()
+{
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(0)), "0");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(9)), "9");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(10)), "10");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(-99999)), "-99999");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(std::numeric_limits<std::int64_t>::max())), "9223372036854775807");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(std::numeric_limits<std::int64_t>::min())), "-9223372036854775808");
+
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(0, 2)), "#b0");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(-5, 2)), "#b-101");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(64, 8)), "#o100");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(255, 16)), "#xff");
+	ASSERT_EQUAL(formatted(NumberFormat::forInteger(std::numeric_limits<std::int64_t>::min(), 16)), "#x-8000000000000000");
+
+	ASSERT_EQUAL(formatted(NumberFormat::forRatnum(1, 3)), "1/3");
+	ASSERT_EQUAL(formatted(NumberFormat::forRatnum(-22, 7)), "-22/7");
+	ASSERT_EQUAL(formatted(NumberFormat::forRatnum(-5, 16, 2)), "#b-101/10000");
+	ASSERT_EQUAL(formatted(NumberFormat::forRatnum(255, 256, 16)), "#xff/100");
+	ASSERT_EQUAL(formatted(NumberFormat::forRatnum(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max())),
+			"-9223372036854775808/9223372036854775807");
+
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(-0.0)), "-0.0");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(1e20)), "100000000000000000000.0");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(1e21)), "1e21");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(-1.25)), "-1.25");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(0.000001)), "0.000001");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(1e-7)), "1e-7");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(-2.5e-300)), "-2.5e-300");
+	ASSERT_EQUAL(formatted(NumberFormat::forFlonum(1.5e300)), "1.5e300");
+}
+
 void testSymbol(World &world)
 {
 	assertForm(symbolFor(world, u8"Hello"), u8"Hello");
@@ -317,6 +381,30 @@ void testHashMap(World &world)
 	assertForm(HashMapCell::createEmptyInstance(world), "#!hash-map");
 }
 
+void testLargeOutput(World &world)
+{
+	// This needs to be larger than the writer's inline buffer
+	const std::int64_t elementCount = 5000;
+
+	VectorCell *testVector = VectorCell::fromFill(world, elementCount);
+	std::ostringstream expected;
+
+	expected << "#(";
+
+	for(std::int64_t i = 0; i < elementCount; i++)
+	{
+		const std::int64_t value = (i % 2) ? (i * 1000003) : -i;
+		testVector->setElementAt(i, IntegerCell::fromValue(world, value));
+
+		expected << (i ? " " : "") << value;
+	}
+
+	expected << ")";
+	ASSERT_TRUE(expected.str().size() > OutputBuffer::InlineCapacity);
+
+	assertForm(testVector, expected.str());
+}
+
 void testAll(World &world)
 {
 	testUnit();
@@ -324,6 +412,8 @@ void testAll(World &world)
 	testBoolean();
 	testInteger(world);
 	testFlonum(world);
+	testRatnum(world);
+	testNumberFormat();
 	testSymbol(world);
 	testString(world);
 	testPair(world);
@@ -337,6 +427,7 @@ void testAll(World &world)
 	testEofObject();
 	testMailbox(world);
 	testHashMap(world);
+	testLargeOutput(world);
 }
 
 }
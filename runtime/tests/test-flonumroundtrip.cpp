@@ -0,0 +1,243 @@
+#include <string>
+#include <sstream>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/FlonumCell.h"
+
+#include "flonum/shortestDecimal.h"
+#include "flonum/parseDecimal.h"
+
+#include "reader/DatumReader.h"
+#include "writer/ExternalFormDatumWriter.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+const int RandomIterations = 200000;
+
+double doubleFromBits(std::uint64_t bits)
+{
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+std::uint64_t bitsFromDouble(double value)
+{
+	std::uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+std::string externalFormFor(double value)
+{
+	FlonumCell flonumCell(value);
+
+	ExternalFormDatumWriter writer;
+	writer.render(&flonumCell);
+
+	return std::string(writer.output().data(), writer.output().size());
+}
+
+double readFlonum(World &world, const std::string &source)
+{
+	std::istringstream inputStream(source);
+	DatumReader reader(world, inputStream);
+
+	auto flonumCell = cell_cast<FlonumCell>(reader.parse());
+	ASSERT_TRUE(flonumCell != nullptr);
+
+	return flonumCell->value();
+}
+
+/**
+ * Asserts that the value is rendered as the expected string and reads back as the identical value
+ */
+void assertRoundTrips(World &world, double value)
+{
+	const std::string externalForm(externalFormFor(value));
+	const double parsedValue = readFlonum(world, externalForm);
+
+	if (bitsFromDouble(parsedValue) != bitsFromDouble(value))
+	{
+		std::cerr << "Rendering " << externalForm << " did not read back identically" << std::endl;
+	}
+
+	ASSERT_EQUAL(bitsFromDouble(parsedValue), bitsFromDouble(value));
+}
+
+void testShortestForms()
+{
+	ASSERT_EQUAL(externalFormFor(0.0), "0.0");
+	ASSERT_EQUAL(externalFormFor(-0.0), "-0.0");
+	ASSERT_EQUAL(externalFormFor(0.1), "0.1");
+	ASSERT_EQUAL(externalFormFor(-0.3), "-0.3");
+	ASSERT_EQUAL(externalFormFor(1.0 / 3.0), "0.3333333333333333");
+	ASSERT_EQUAL(externalFormFor(12.5), "12.5");
+	ASSERT_EQUAL(externalFormFor(100.0), "100.0");
+	ASSERT_EQUAL(externalFormFor(0.001), "0.001");
+	ASSERT_EQUAL(externalFormFor(1e-7), "1e-7");
+	ASSERT_EQUAL(externalFormFor(1.5e-10), "1.5e-10");
+	ASSERT_EQUAL(externalFormFor(1e20), "100000000000000000000.0");
+	ASSERT_EQUAL(externalFormFor(1e21), "1e21");
+	ASSERT_EQUAL(externalFormFor(1e23), "1e23");
+	ASSERT_EQUAL(externalFormFor(9007199254740993.0), "9007199254740992.0");
+	ASSERT_EQUAL(externalFormFor(5e-324), "5e-324");
+	ASSERT_EQUAL(externalFormFor(1.7976931348623157e308), "1.7976931348623157e308");
+	ASSERT_EQUAL(externalFormFor(2.2250738585072014e-308), "2.2250738585072014e-308");
+}
+
+void testParseDecimal()
+{
+	ASSERT_EQUAL(flonum::parseDecimal("0", 0), 0.0);
+	ASSERT_EQUAL(flonum::parseDecimal("000", 500), 0.0);
+	ASSERT_EQUAL(flonum::parseDecimal("1", 0), 1.0);
+	ASSERT_EQUAL(flonum::parseDecimal("125", -3), 0.125);
+	ASSERT_EQUAL(flonum::parseDecimal("1", 400), INFINITY);
+	ASSERT_EQUAL(flonum::parseDecimal("1", -400), 0.0);
+
+	// These exercise the round-to-even and rounding overflow cases of Eisel-Lemire
+	ASSERT_EQUAL(flonum::parseDecimal("9007199254740993", 0), 9007199254740992.0);
+	ASSERT_EQUAL(flonum::parseDecimal("72057594037927933", 0), 7.2057594037927933e16);
+	ASSERT_EQUAL(flonum::parseDecimal("73177701707893310", -1), 7.3177701707893310e15);
+
+	// Subnormals and long significands fall back to strtod
+	ASSERT_EQUAL(flonum::parseDecimal("49406564584124654", -340), 5e-324);
+	ASSERT_EQUAL(flonum::parseDecimal("100000000000000000000000000000000000001", -38), 1.0);
+}
+
+void testReaderForms(World &world)
+{
+	ASSERT_EQUAL(readFlonum(world, "1e23"), 1e23);
+	ASSERT_EQUAL(readFlonum(world, "1.e2"), 100.0);
+	ASSERT_EQUAL(readFlonum(world, "-.5e-1"), -0.05);
+	ASSERT_EQUAL(readFlonum(world, "123456789012345678901234567890.0"), 123456789012345678901234567890.0);
+	ASSERT_EQUAL(readFlonum(world, "1e999999999999"), INFINITY);
+	ASSERT_EQUAL(readFlonum(world, "-1e-999999999999"), 0.0);
+	ASSERT_TRUE(std::signbit(readFlonum(world, "-0.0")));
+}
+
+/**
+ * Checks that random doubles from across the entire range read back identically
+ */
+void testRandomRoundTrip(World &world)
+{
+	std::mt19937_64 generator(0x5eed);
+
+	for(int i = 0; i < RandomIterations; i++)
+	{
+		const double value = doubleFromBits(generator());
+
+		if (!std::isnan(value) && !std::isinf(value))
+		{
+			assertRoundTrips(world, value);
+		}
+	}
+
+	// Values with few significant digits are more likely to hit edge cases
+	std::uniform_int_distribution<std::int64_t> significandDist(0, 99999);
+	std::uniform_int_distribution<int> exponentDist(-330, 310);
+
+	for(int i = 0; i < RandomIterations; i++)
+	{
+		const std::string source(std::to_string(significandDist(generator)) + "e" + std::to_string(exponentDist(generator)));
+		const double value = strtod(source.c_str(), nullptr);
+
+		if (!std::isinf(value))
+		{
+			assertRoundTrips(world, value);
+		}
+	}
+}
+
+/**
+ * Checks that random doubles can't be represented with fewer digits than shortestDecimal() returns
+ */
+void testRandomShortest()
+{
+	std::mt19937_64 generator(0x5407);
+
+	for(int i = 0; i < RandomIterations / 10; i++)
+	{
+		const double value = std::fabs(doubleFromBits(generator()));
+
+		if (std::isnan(value) || std::isinf(value) || (value == 0.0))
+		{
+			continue;
+		}
+
+		const flonum::DecimalDigits decimal(flonum::shortestDecimal(value));
+
+		if (decimal.length > 1)
+		{
+			// Correctly round to one less digit
+			char shorterForm[32];
+			snprintf(shorterForm, sizeof(shorterForm), "%.*e", decimal.length - 2, value);
+
+			ASSERT_TRUE(strtod(shorterForm, nullptr) != value);
+		}
+	}
+}
+
+/**
+ * Checks that parsing random decimal strings matches strtod()
+ */
+void testRandomParse()
+{
+	std::mt19937_64 generator(0xdec1);
+	std::uniform_int_distribution<int> lengthDist(1, 25);
+	std::uniform_int_distribution<int> digitDist(0, 9);
+	std::uniform_int_distribution<int> exponentDist(-350, 320);
+
+	for(int i = 0; i < RandomIterations; i++)
+	{
+		std::string digits;
+		const int length = lengthDist(generator);
+
+		for(int j = 0; j < length; j++)
+		{
+			digits.push_back('0' + digitDist(generator));
+		}
+
+		const int exponent = exponentDist(generator);
+		const std::string source(digits + "e" + std::to_string(exponent));
+
+		const double expected = strtod(source.c_str(), nullptr);
+		const double parsed = flonum::parseDecimal(digits, exponent);
+
+		if (bitsFromDouble(parsed) != bitsFromDouble(expected))
+		{
+			std::cerr << "Parsing " << source << " did not match strtod()" << std::endl;
+		}
+
+		ASSERT_EQUAL(bitsFromDouble(parsed), bitsFromDouble(expected));
+	}
+}
+
+void testAll(World &world)
+{
+	testShortestForms();
+	testParseDecimal();
+	testReaderForms(world);
+	testRandomRoundTrip(world);
+	testRandomShortest();
+	testRandomParse();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,233 @@
+#include <stdexcept>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+#include "binding/TypedProcedureCell.h"
+
+#include "dynamic/State.h"
+#include "dynamic/SchemeException.h"
+#include "dynamic/raise.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using dynamic::GuardHandlerProcedureCell;
+
+const std::int64_t RaisedValue = 12345;
+const std::int64_t HandledValue = -1;
+
+ThunkProcedureCell *nestedThunk = nullptr;
+bool cleanupRan = false;
+
+ThunkProcedureCell *makeThunk(World &world, ThunkProcedureCell::TypedEntryPoint entryPoint)
+{
+	return ThunkProcedureCell::createInstance(world, ProcedureCell::EmptyRecordLikeClassId, true, nullptr, entryPoint);
+}
+
+GuardHandlerProcedureCell *makeHandler(World &world, GuardHandlerProcedureCell::TypedEntryPoint entryPoint)
+{
+	return GuardHandlerProcedureCell::createInstance(world, ProcedureCell::EmptyRecordLikeClassId, true, nullptr, entryPoint);
+}
+
+AnyCell *returningThunk(World &world, ProcedureCell *)
+{
+	return IntegerCell::fromValue(world, 7);
+}
+
+AnyCell *raisingThunk(World &world, ProcedureCell *)
+{
+	dynamic::raise(world, IntegerCell::fromValue(world, RaisedValue));
+}
+
+AnyCell *parameterizingRaisingThunk(World &world, ProcedureCell *)
+{
+	// Simulate raising from inside nested (parameterize) forms
+	dynamic::State::pushActiveState(world);
+	dynamic::State::pushActiveState(world);
+
+	dynamic::raise(world, IntegerCell::fromValue(world, RaisedValue));
+}
+
+/**
+ * Simulates a native procedure with cleanups calling back in to Scheme
+ */
+struct CleanupOnUnwind
+{
+	~CleanupOnUnwind()
+	{
+		cleanupRan = true;
+	}
+};
+
+AnyCell *nativeCallbackThunk(World &world, ProcedureCell *)
+{
+	CleanupOnUnwind cleanup;
+	return nestedThunk->apply(world);
+}
+
+AnyCell *nonSchemeExceptionThunk(World &world, ProcedureCell *)
+{
+	throw std::runtime_error("Not a Scheme exception");
+}
+
+AnyCell *identityHandler(World &world, ProcedureCell *, AnyCell *raised)
+{
+	return raised;
+}
+
+AnyCell *reraisingHandler(World &world, ProcedureCell *, AnyCell *raised)
+{
+	dynamic::raise(world, raised);
+}
+
+AnyCell *innerGuardThunk(World &world, ProcedureCell *)
+{
+	return dynamic::applyWithGuard(world, makeThunk(world, raisingThunk), makeHandler(world, reraisingHandler));
+}
+
+AnyCell *handledInnerGuardThunk(World &world, ProcedureCell *)
+{
+	AnyCell *innerResult = dynamic::applyWithGuard(world, makeThunk(world, raisingThunk), makeHandler(world, identityHandler));
+	ASSERT_EQUAL(cell_unchecked_cast<IntegerCell>(innerResult)->value(), RaisedValue);
+
+	// The outer guard should be innermost again
+	ASSERT_TRUE(world.innermostGuard() != nullptr);
+	return IntegerCell::fromValue(world, HandledValue);
+}
+
+std::int64_t integerValue(AnyCell *cell)
+{
+	return cell_unchecked_cast<IntegerCell>(cell)->value();
+}
+
+void assertGuardStateClean(World &world)
+{
+	ASSERT_TRUE(world.innermostGuard() == nullptr);
+	ASSERT_EQUAL(world.nativeApplyDepth(), 0);
+}
+
+void testReturn(World &world)
+{
+	AnyCell *result = dynamic::applyWithGuard(world, makeThunk(world, returningThunk), makeHandler(world, identityHandler));
+
+	ASSERT_EQUAL(integerValue(result), 7);
+	assertGuardStateClean(world);
+}
+
+void testDirectRaise(World &world)
+{
+	AnyCell *result = dynamic::applyWithGuard(world, makeThunk(world, raisingThunk), makeHandler(world, identityHandler));
+
+	ASSERT_EQUAL(integerValue(result), RaisedValue);
+	assertGuardStateClean(world);
+}
+
+void testDynamicStateRestored(World &world)
+{
+	dynamic::State *initialState = world.activeState();
+
+	AnyCell *result = dynamic::applyWithGuard(world, makeThunk(world, parameterizingRaisingThunk), makeHandler(world, identityHandler));
+
+	ASSERT_EQUAL(integerValue(result), RaisedValue);
+	ASSERT_TRUE(world.activeState() == initialState);
+	assertGuardStateClean(world);
+}
+
+void testNativeCallback(World &world)
+{
+	// Raises from beneath a native frame must unwind through it so its cleanups run
+	nestedThunk = makeThunk(world, raisingThunk);
+	cleanupRan = false;
+
+	AnyCell *result = dynamic::applyWithGuard(world, makeThunk(world, nativeCallbackThunk), makeHandler(world, identityHandler));
+
+	ASSERT_EQUAL(integerValue(result), RaisedValue);
+	ASSERT_TRUE(cleanupRan);
+	assertGuardStateClean(world);
+}
+
+void testNestedGuards(World &world)
+{
+	// Re-raising from an inner handler reaches the outer guard
+	AnyCell *result = dynamic::applyWithGuard(world, makeThunk(world, innerGuardThunk), makeHandler(world, identityHandler));
+
+	ASSERT_EQUAL(integerValue(result), RaisedValue);
+	assertGuardStateClean(world);
+
+	// Handled raises in an inner guard leave the outer guard in place
+	result = dynamic::applyWithGuard(world, makeThunk(world, handledInnerGuardThunk), makeHandler(world, identityHandler));
+
+	ASSERT_EQUAL(integerValue(result), HandledValue);
+	assertGuardStateClean(world);
+}
+
+void testUnhandled(World &world)
+{
+	// With no guard we should fall back to throwing
+	bool caughtException = false;
+
+	try
+	{
+		dynamic::raise(world, IntegerCell::fromValue(world, RaisedValue));
+	}
+	catch(dynamic::SchemeException &except)
+	{
+		caughtException = true;
+		ASSERT_EQUAL(integerValue(except.object()), RaisedValue);
+	}
+
+	ASSERT_TRUE(caughtException);
+
+	// A re-raise from the handler propagates out of the guard
+	caughtException = false;
+
+	try
+	{
+		dynamic::applyWithGuard(world, makeThunk(world, raisingThunk), makeHandler(world, reraisingHandler));
+	}
+	catch(dynamic::SchemeException &except)
+	{
+		caughtException = true;
+		ASSERT_EQUAL(integerValue(except.object()), RaisedValue);
+	}
+
+	ASSERT_TRUE(caughtException);
+	assertGuardStateClean(world);
+
+	// Non-Scheme exceptions pass through the guard
+	caughtException = false;
+
+	try
+	{
+		dynamic::applyWithGuard(world, makeThunk(world, nonSchemeExceptionThunk), makeHandler(world, identityHandler));
+	}
+	catch(std::runtime_error &)
+	{
+		caughtException = true;
+	}
+
+	ASSERT_TRUE(caughtException);
+	assertGuardStateClean(world);
+}
+
+void testAll(World &world)
+{
+	testReturn(world);
+	testDirectRaise(world);
+	testDynamicStateRestored(world);
+	testNativeCallback(world);
+	testNestedGuards(world);
+	testUnhandled(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,333 @@
+#include <string>
+#include <cstring>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+#include "binding/EofObjectCell.h"
+#include "binding/SymbolCell.h"
+#include "binding/StringCell.h"
+#include "binding/ProperList.h"
+
+#include "reader/DatumBoundaryScanner.h"
+#include "reader/IncrementalDatumReader.h"
+#include "reader/ReadErrorException.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+/**
+ * Returns the offset after the first complete datum in the input or -1 if no datum is complete
+ *
+ * The input is fed to the scanner one byte at a time to exercise resuming
+ */
+long datumEndOffset(const std::string &input, bool finish = false)
+{
+	DatumBoundaryScanner scanner;
+
+	for(std::size_t i = 0; i < input.size(); i++)
+	{
+		const std::size_t consumed = scanner.scan(&input[i], 1);
+
+		if (scanner.datumComplete())
+		{
+			return i + consumed;
+		}
+	}
+
+	if (finish)
+	{
+		scanner.finish();
+
+		if (scanner.datumComplete())
+		{
+			return input.size();
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Returns the offset after the first complete datum when scanning the input as a single chunk
+ */
+long chunkDatumEndOffset(const std::string &input)
+{
+	DatumBoundaryScanner scanner;
+	std::size_t consumed = scanner.scan(input.data(), input.size());
+
+	return scanner.datumComplete() ? consumed : -1;
+}
+
+#define ASSERT_DATUM_END(input, expected) \
+{ \
+	ASSERT_EQUAL(datumEndOffset(input), expected); \
+	ASSERT_EQUAL(chunkDatumEndOffset(input), expected); \
+}
+
+void testScanAtoms()
+{
+	ASSERT_DATUM_END("", -1);
+	ASSERT_DATUM_END("   \n\t", -1);
+
+	// Atoms need a delimiter unless the input is finished
+	ASSERT_DATUM_END("hello", -1);
+	ASSERT_EQUAL(datumEndOffset("hello", true), 5);
+	ASSERT_DATUM_END("hello ", 5);
+	ASSERT_DATUM_END("  123(", 5);
+	ASSERT_DATUM_END("#t)", 2);
+	ASSERT_DATUM_END("#!unit\n", 6);
+
+	// Character literals
+	ASSERT_DATUM_END("#\\(", -1);
+	ASSERT_DATUM_END("#\\( ", 3);
+	ASSERT_DATUM_END("#\\space)", 7);
+	ASSERT_DATUM_END("#\\  ", 3);
+}
+
+void testScanStrings()
+{
+	ASSERT_DATUM_END("\"hello", -1);
+	ASSERT_DATUM_END("\"hello\"", 7);
+	ASSERT_DATUM_END("\"he\\\"llo\"", 9);
+	ASSERT_DATUM_END("\"(\"", 3);
+
+	ASSERT_DATUM_END("|hello", -1);
+	ASSERT_DATUM_END("|hello world|", 13);
+	ASSERT_DATUM_END("|he\\|llo|", 9);
+}
+
+void testScanLists()
+{
+	ASSERT_DATUM_END("(", -1);
+	ASSERT_DATUM_END("(a b", -1);
+	ASSERT_DATUM_END("(a b)", 5);
+	ASSERT_DATUM_END("(a (b [c]) d)", 13);
+	ASSERT_DATUM_END("(a \")\" b", -1);
+	ASSERT_DATUM_END("(a #\\) b)", 9);
+
+	ASSERT_DATUM_END("#(1 2", -1);
+	ASSERT_DATUM_END("#(1 2)", 6);
+	ASSERT_DATUM_END("#u8(1 2", -1);
+	ASSERT_DATUM_END("#u8(1 2)", 8);
+
+	// Unbalanced closes are passed to the reader to report
+	ASSERT_DATUM_END(")", 1);
+}
+
+void testScanPrefixes()
+{
+	ASSERT_DATUM_END("'", -1);
+	ASSERT_DATUM_END("'a ", 2);
+	ASSERT_DATUM_END("'(a b)", 6);
+	ASSERT_DATUM_END("`(a ,b)", 7);
+	ASSERT_DATUM_END(",@", -1);
+	ASSERT_DATUM_END(",@(a)", 5);
+
+	ASSERT_DATUM_END("#0=", -1);
+	ASSERT_DATUM_END("#0=(a b)", 8);
+	ASSERT_DATUM_END("#0# ", 3);
+}
+
+void testScanComments()
+{
+	ASSERT_DATUM_END("; (hello)", -1);
+	ASSERT_DATUM_END("; (hello)\n1 ", 11);
+
+	ASSERT_DATUM_END("#| (hello) |#", -1);
+	ASSERT_DATUM_END("#| #| |# (hello) |# 1 ", 21);
+	ASSERT_DATUM_END("#| ||# 1 ", 8);
+
+	ASSERT_DATUM_END("#;(hello)", -1);
+	ASSERT_DATUM_END("#; (hello) 1 ", 12);
+	ASSERT_DATUM_END("#; #; 1 2 3 ", 11);
+
+	// Datum comments inside lists don't affect the top-level datum
+	ASSERT_DATUM_END("(1 #;2)", 7);
+}
+
+void testIncrementalParse(World &world)
+{
+	IncrementalDatumReader reader;
+
+	ASSERT_NULL(reader.parse(world));
+
+	reader.feed("(1 2", 4);
+	ASSERT_NULL(reader.parse(world));
+
+	reader.feed(" 3) 4", 5);
+
+	AnyCell *datum = reader.parse(world);
+	ASSERT_TRUE(datum != nullptr);
+	ASSERT_TRUE(datum->isEqual(ProperList<AnyCell>::create(world, {
+		IntegerCell::fromValue(world, 1),
+		IntegerCell::fromValue(world, 2),
+		IntegerCell::fromValue(world, 3)
+	})));
+
+	// The 4 may still be continued
+	ASSERT_NULL(reader.parse(world));
+
+	reader.feed("5 \"six\" ", 8);
+
+	datum = reader.parse(world);
+	ASSERT_TRUE(datum->isEqual(IntegerCell::fromValue(world, 45)));
+
+	datum = reader.parse(world);
+	ASSERT_TRUE(datum->isEqual(StringCell::fromUtf8StdString(world, "six")));
+
+	ASSERT_NULL(reader.parse(world));
+
+	reader.feed("seven ; comment", 15);
+	reader.finish();
+
+	datum = reader.parse(world);
+	ASSERT_TRUE(datum->isEqual(SymbolCell::fromUtf8StdString(world, "seven")));
+
+	ASSERT_EQUAL(reader.parse(world), EofObjectCell::instance());
+
+	// Feeding after finishing has no effect
+	reader.feed("8 ", 2);
+	ASSERT_EQUAL(reader.parse(world), EofObjectCell::instance());
+}
+
+void testDatumReady(World &world)
+{
+	IncrementalDatumReader reader;
+
+	ASSERT_FALSE(reader.datumReady());
+
+	reader.feed("(1 2", 4);
+	ASSERT_FALSE(reader.datumReady());
+
+	reader.feed(") 3", 3);
+	ASSERT_TRUE(reader.datumReady());
+
+	// Checking readiness shouldn't consume any input
+	ASSERT_TRUE(reader.datumReady());
+	ASSERT_TRUE(reader.parse(world)->isEqual(ProperList<AnyCell>::create(world, {
+		IntegerCell::fromValue(world, 1),
+		IntegerCell::fromValue(world, 2)
+	})));
+
+	// The 3 may still be continued
+	ASSERT_FALSE(reader.datumReady());
+
+	// Finishing completes the final atom
+	reader.finish();
+	ASSERT_TRUE(reader.datumReady());
+	ASSERT_TRUE(reader.parse(world)->isEqual(IntegerCell::fromValue(world, 3)));
+
+	// The end of input is also ready to be read
+	ASSERT_TRUE(reader.datumReady());
+	ASSERT_EQUAL(reader.parse(world), EofObjectCell::instance());
+}
+
+void testIncrementalParseError(World &world)
+{
+	IncrementalDatumReader reader;
+	reader.feed(") 12 ", 5);
+
+	bool threw = false;
+
+	try
+	{
+		reader.parse(world);
+	}
+	catch(const ReadErrorException &)
+	{
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+
+	// We should resume after the error
+	AnyCell *datum = reader.parse(world);
+	ASSERT_TRUE(datum->isEqual(IntegerCell::fromValue(world, 12)));
+}
+
+void testIncrementalUnterminatedDatum(World &world)
+{
+	IncrementalDatumReader reader;
+
+	reader.feed("(1 2", 4);
+	reader.finish();
+
+	bool threw = false;
+
+	try
+	{
+		reader.parse(world);
+	}
+	catch(const UnexpectedEofException &)
+	{
+		threw = true;
+	}
+
+	ASSERT_TRUE(threw);
+	ASSERT_EQUAL(reader.parse(world), EofObjectCell::instance());
+}
+
+void testIncrementalInputStream(World &world)
+{
+	IncrementalDatumReader reader;
+	reader.feed("abc (1)", 7);
+
+	// Consume part of the symbol directly
+	std::istream &inputStream = reader.inputStream();
+	ASSERT_EQUAL(inputStream.get(), 'a');
+
+	AnyCell *datum = reader.parse(world);
+	ASSERT_TRUE(datum->isEqual(SymbolCell::fromUtf8StdString(world, "bc")));
+
+	datum = reader.parse(world);
+	ASSERT_TRUE(datum->isEqual(ProperList<AnyCell>::create(world, {IntegerCell::fromValue(world, 1)})));
+}
+
+void testManyDatums(World &world)
+{
+	IncrementalDatumReader reader;
+
+	// Feed enough data to cause the buffer to be compacted
+	for(int i = 0; i < 2000; i++)
+	{
+		const std::string datumSource("(" + std::to_string(i) + ") ");
+		reader.feed(datumSource.data(), datumSource.size());
+	}
+
+	for(int i = 0; i < 2000; i++)
+	{
+		AnyCell *datum = reader.parse(world);
+		ASSERT_TRUE(datum->isEqual(ProperList<AnyCell>::create(world, {IntegerCell::fromValue(world, i)})));
+	}
+
+	ASSERT_NULL(reader.parse(world));
+}
+
+void testAll(World &world)
+{
+	testScanAtoms();
+	testScanStrings();
+	testScanLists();
+	testScanPrefixes();
+	testScanComments();
+
+	testIncrementalParse(world);
+	testDatumReady(world);
+	testIncrementalParseError(world);
+	testIncrementalUnterminatedDatum(world);
+	testIncrementalInputStream(world);
+	testManyDatums(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
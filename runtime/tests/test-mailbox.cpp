@@ -0,0 +1,185 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+
+#include "actor/Mailbox.h"
+#include "actor/Message.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using actor::Mailbox;
+using actor::Message;
+using actor::OverflowPolicy;
+
+/**
+ * Mailbox exposing receive() so tests can act as the receiving actor
+ */
+class ReceivingMailbox : public Mailbox
+{
+public:
+	using Mailbox::receive;
+	using Mailbox::ReceiveResult;
+};
+
+Message *integerMessage(World &world, std::int64_t value)
+{
+	return Message::createFromCell(IntegerCell::fromValue(world, value), std::weak_ptr<Mailbox>());
+}
+
+void testUnbounded(World &world)
+{
+	auto mailbox = std::make_shared<Mailbox>();
+
+	for(std::int64_t i = 0; i < 1000; i++)
+	{
+		ASSERT_TRUE(mailbox->tell(integerMessage(world, i)));
+	}
+
+	ASSERT_EQUAL(mailbox->queueDepth(), 1000);
+}
+
+void testDropNewest(World &world)
+{
+	auto mailbox = std::make_shared<Mailbox>();
+	mailbox->setCapacity(2, OverflowPolicy::DropNewest);
+
+	for(std::int64_t i = 0; i < 5; i++)
+	{
+		ASSERT_TRUE(mailbox->tell(integerMessage(world, i)));
+	}
+
+	ASSERT_EQUAL(mailbox->queueDepth(), 2);
+}
+
+void testDropOldest(World &world)
+{
+	auto mailbox = std::make_shared<Mailbox>();
+	mailbox->setCapacity(3, OverflowPolicy::DropOldest);
+
+	for(std::int64_t i = 0; i < 5; i++)
+	{
+		ASSERT_TRUE(mailbox->tell(integerMessage(world, i)));
+	}
+
+	ASSERT_EQUAL(mailbox->queueDepth(), 3);
+}
+
+void testFail(World &world)
+{
+	auto mailbox = std::make_shared<Mailbox>();
+	mailbox->setCapacity(2, OverflowPolicy::Fail);
+
+	ASSERT_TRUE(mailbox->tell(integerMessage(world, 1)));
+	ASSERT_TRUE(mailbox->tell(integerMessage(world, 2)));
+	ASSERT_FALSE(mailbox->tell(integerMessage(world, 3)));
+
+	ASSERT_EQUAL(mailbox->queueDepth(), 2);
+
+	// Raising the capacity should accept new messages
+	mailbox->setCapacity(3, OverflowPolicy::Fail);
+	ASSERT_TRUE(mailbox->tell(integerMessage(world, 3)));
+	ASSERT_EQUAL(mailbox->queueDepth(), 3);
+}
+
+void testBlock(World &world)
+{
+	auto mailbox = std::make_shared<Mailbox>();
+	mailbox->setCapacity(1, OverflowPolicy::Block);
+
+	ASSERT_TRUE(mailbox->tell(integerMessage(world, 1)));
+
+	// Create the message on our thread as our world isn't thread-safe
+	Message *blockedMessage = integerMessage(world, 2);
+	std::atomic<bool> senderFinished(false);
+
+	std::thread sender([&] {
+		mailbox->tell(blockedMessage);
+		senderFinished = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	ASSERT_FALSE(senderFinished.load());
+
+	// Changing the policy should release the sender
+	mailbox->setCapacity(1, OverflowPolicy::DropNewest);
+	sender.join();
+
+	ASSERT_TRUE(senderFinished.load());
+	ASSERT_EQUAL(mailbox->queueDepth(), 1);
+}
+
+void testDropOldestKeepsRequests(World &world)
+{
+	auto mailbox = std::make_shared<ReceivingMailbox>();
+	mailbox->setCapacity(2, OverflowPolicy::DropOldest);
+
+	// Create the cells on our thread as our world isn't thread-safe
+	AnyCell *requestCell = IntegerCell::fromValue(world, 1);
+	Message *replyMessage = integerMessage(world, 2);
+	std::atomic<std::int64_t> replyValue(0);
+
+	std::thread asker([&] {
+		World askerWorld;
+		AnyCell *replyCell = mailbox->ask(askerWorld, requestCell, 10 * 1000 * 1000);
+
+		if (auto replyInteger = cell_cast<IntegerCell>(replyCell))
+		{
+			replyValue = replyInteger->value();
+		}
+	});
+
+	while(mailbox->queueDepth() == 0)
+	{
+		std::this_thread::yield();
+	}
+
+	// Overflow the mailbox while the request is queued
+	for(std::int64_t i = 3; i < 6; i++)
+	{
+		ASSERT_TRUE(mailbox->tell(integerMessage(world, i)));
+	}
+
+	ASSERT_EQUAL(mailbox->queueDepth(), 2);
+
+	// The request should still be at the front of the queue
+	Message *request = nullptr;
+	actor::LifecycleAction action;
+	ASSERT_TRUE(mailbox->receive(nullptr, &request, &action) == ReceivingMailbox::ReceiveResult::PoppedMessage);
+
+	std::shared_ptr<Mailbox> replyMailbox(request->sender().lock());
+	ASSERT_TRUE(replyMailbox != nullptr);
+	delete request;
+
+	ASSERT_TRUE(replyMailbox->tell(replyMessage));
+	replyMailbox.reset();
+
+	asker.join();
+	ASSERT_EQUAL(replyValue.load(), 2);
+}
+
+void testAll(World &world)
+{
+	testUnbounded(world);
+	testDropNewest(world);
+	testDropOldest(world);
+	testFail(world);
+	testBlock(world);
+	testDropOldestKeepsRequests(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,216 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/StringCell.h"
+
+#include "alloc/allocator.h"
+#include "actor/Mailbox.h"
+
+#include "metrics/Metric.h"
+#include "metrics/dump.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using metrics::Metric;
+using metrics::MetricType;
+using metrics::DumpFormat;
+
+Metric TestCounter("llambda_test_events_total", "Events counted by the metrics test", MetricType::Counter);
+Metric TestGauge("llambda_test_level", "Level tracked by the metrics test", MetricType::Gauge);
+
+const Metric *registeredMetric(const std::string &name)
+{
+	for(auto metric : Metric::registeredMetrics())
+	{
+		if (metric->name() == name)
+		{
+			return metric;
+		}
+	}
+
+	return nullptr;
+}
+
+std::int64_t metricValue(const std::string &name)
+{
+	const Metric *metric = registeredMetric(name);
+	ASSERT_TRUE(metric != nullptr);
+
+	return metric->value();
+}
+
+void testRegistration()
+{
+	ASSERT_TRUE(registeredMetric("llambda_test_events_total") == &TestCounter);
+	ASSERT_TRUE(registeredMetric("llambda_test_level") == &TestGauge);
+
+	// Runtime metrics should be registered statically
+	ASSERT_TRUE(registeredMetric("llambda_gc_collections_total") != nullptr);
+	ASSERT_TRUE(registeredMetric("llambda_dispatcher_threads") != nullptr);
+	ASSERT_TRUE(registeredMetric("llambda_actor_queued_messages") != nullptr);
+}
+
+void testShardedUpdates()
+{
+	const int ThreadCount = 8;
+	const int IncrementsPerThread = 10000;
+
+	std::vector<std::thread> threads;
+
+	for(int i = 0; i < ThreadCount; i++)
+	{
+		threads.emplace_back([] {
+			for(int j = 0; j < IncrementsPerThread; j++)
+			{
+				TestCounter.increment();
+				TestGauge.increment();
+				TestGauge.decrement();
+			}
+		});
+	}
+
+	for(auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	ASSERT_EQUAL(TestCounter.value(), ThreadCount * IncrementsPerThread);
+	ASSERT_EQUAL(TestGauge.value(), 0);
+}
+
+void testDumpFormats()
+{
+	TestGauge.add(42);
+
+	{
+		std::ostringstream jsonStream;
+		metrics::writeMetrics(jsonStream, DumpFormat::Json);
+
+		const std::string json = jsonStream.str();
+
+		ASSERT_TRUE(json.front() == '{');
+		ASSERT_TRUE(json.find("\"llambda_test_level\":42") != std::string::npos);
+		ASSERT_TRUE(json.find(",\"llambda_test_level\":42") != std::string::npos);
+	}
+
+	{
+		std::ostringstream prometheusStream;
+		metrics::writeMetrics(prometheusStream, DumpFormat::Prometheus);
+
+		const std::string prometheus = prometheusStream.str();
+
+		ASSERT_TRUE(prometheus.find("# HELP llambda_test_level Level tracked by the metrics test\n") != std::string::npos);
+		ASSERT_TRUE(prometheus.find("# TYPE llambda_test_level gauge\n") != std::string::npos);
+		ASSERT_TRUE(prometheus.find("# TYPE llambda_test_events_total counter\n") != std::string::npos);
+		ASSERT_TRUE(prometheus.find("\nllambda_test_level 42\n") != std::string::npos);
+	}
+
+	TestGauge.add(-42);
+}
+
+void testGarbageCollectionMetrics(World &world)
+{
+	const std::int64_t initialCollections = metricValue("llambda_gc_collections_total");
+	const std::int64_t initialAllocated = metricValue("llambda_gc_allocated_cells_total");
+
+	for(int i = 0; i < 100; i++)
+	{
+		StringCell::fromUtf8StdString(world, u8"Garbage");
+	}
+
+	alloc::forceCollection(world);
+
+	ASSERT_EQUAL(metricValue("llambda_gc_collections_total"), initialCollections + 1);
+	ASSERT_TRUE(metricValue("llambda_gc_allocated_cells_total") >= initialAllocated + 100);
+}
+
+void testMailboxMetrics(World &world)
+{
+	const std::int64_t initialMailboxes = metricValue("llambda_actor_mailboxes");
+	const std::int64_t initialQueued = metricValue("llambda_actor_queued_messages");
+	const std::int64_t initialRejected = metricValue("llambda_actor_rejected_messages_total");
+
+	{
+		auto mailbox = std::make_shared<actor::Mailbox>();
+		mailbox->setCapacity(2, actor::OverflowPolicy::Fail);
+
+		ASSERT_EQUAL(metricValue("llambda_actor_mailboxes"), initialMailboxes + 1);
+
+		for(int i = 0; i < 3; i++)
+		{
+			mailbox->tell(actor::Message::createFromCell(StringCell::fromUtf8StdString(world, u8"Message"), std::weak_ptr<actor::Mailbox>()));
+		}
+
+		ASSERT_EQUAL(metricValue("llambda_actor_queued_messages"), initialQueued + 2);
+		ASSERT_EQUAL(metricValue("llambda_actor_rejected_messages_total"), initialRejected + 1);
+	}
+
+	// Destroying the mailbox should release its queued messages
+	ASSERT_EQUAL(metricValue("llambda_actor_mailboxes"), initialMailboxes);
+	ASSERT_EQUAL(metricValue("llambda_actor_queued_messages"), initialQueued);
+}
+
+void testDumpOnExit()
+{
+	std::ostringstream filenameStream;
+	filenameStream << "/tmp/llambda-test-metrics-" << getpid() << ".json";
+	const std::string filename = filenameStream.str();
+
+	const pid_t childPid = fork();
+	ASSERT_TRUE(childPid >= 0);
+
+	if (childPid == 0)
+	{
+		setenv("LLAMBDA_METRICS_DUMP", "json", 1);
+		setenv("LLAMBDA_METRICS_DUMP_FILE", filename.c_str(), 1);
+		metrics::initDumping();
+
+		TestGauge.add(7);
+
+		// This is how (exit) leaves the program; llcore_run() never returns
+		exit(3);
+	}
+
+	int status;
+	ASSERT_EQUAL(waitpid(childPid, &status, 0), childPid);
+	ASSERT_TRUE(WIFEXITED(status));
+	ASSERT_EQUAL(WEXITSTATUS(status), 3);
+
+	std::ostringstream dumpStream;
+	dumpStream << std::ifstream(filename).rdbuf();
+	unlink(filename.c_str());
+
+	ASSERT_TRUE(dumpStream.str().find("\"llambda_test_level\":7") != std::string::npos);
+}
+
+void testAll(World &world)
+{
+	// This forks so it needs to run before we've started any threads
+	testDumpOnExit();
+	testRegistration();
+	testShardedUpdates();
+	testDumpFormats();
+	testGarbageCollectionMetrics(world);
+	testMailboxMetrics(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/BytevectorCell.h"
+
+#include "numvec/kernels.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+const std::size_t MaximumTestLength = 67;
+
+std::vector<double> randomDoubles(std::mt19937_64 &generator, std::size_t count)
+{
+	std::uniform_real_distribution<double> valueDist(-1000.0, 1000.0);
+	std::vector<double> values;
+
+	for(std::size_t i = 0; i < count; i++)
+	{
+		values.push_back(valueDist(generator));
+	}
+
+	return values;
+}
+
+void testElementAlignment(World &world)
+{
+	// The bulk kernels rely on numeric vector storage being aligned to the element size
+	for(std::size_t length = 0; length < 64; length += 8)
+	{
+		BytevectorCell *bytevector = BytevectorCell::fromFill(world, length);
+		ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(bytevector->byteArray()->data()) % sizeof(double), 0);
+	}
+}
+
+void testFlonumReductions()
+{
+	std::mt19937_64 generator(0x5113);
+
+	for(std::size_t count = 0; count < MaximumTestLength; count++)
+	{
+		const std::vector<double> left(randomDoubles(generator, count));
+		const std::vector<double> right(randomDoubles(generator, count));
+
+		double expectedSum = 0.0;
+		double expectedDot = 0.0;
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			expectedSum += left[i];
+			expectedDot += left[i] * right[i];
+		}
+
+		// Lane summation reorders additions so allow for rounding differences
+		ASSERT_TRUE(std::fabs(numvec::sum(left.data(), count) - expectedSum) < 1e-9);
+		ASSERT_TRUE(std::fabs(numvec::dot(left.data(), right.data(), count) - expectedDot) < 1e-6);
+
+		if (count > 0)
+		{
+			double expectedMin = left[0];
+			double expectedMax = left[0];
+
+			for(double value : left)
+			{
+				expectedMin = std::min(expectedMin, value);
+				expectedMax = std::max(expectedMax, value);
+			}
+
+			ASSERT_TRUE(numvec::minimum(left.data(), count) == expectedMin);
+			ASSERT_TRUE(numvec::maximum(left.data(), count) == expectedMax);
+		}
+	}
+
+	// Sums of negative zero should stay negative
+	const double negativeZeros[5] = {-0.0, -0.0, -0.0, -0.0, -0.0};
+	ASSERT_TRUE(std::signbit(numvec::sum(negativeZeros, 5)));
+	ASSERT_TRUE(std::signbit(numvec::sum(negativeZeros, 0)));
+}
+
+void testFlonumNaN()
+{
+	for(std::size_t count = 1; count < 12; count++)
+	{
+		for(std::size_t nanIndex = 0; nanIndex < count; nanIndex++)
+		{
+			std::vector<double> values(count, 1.0);
+			values[nanIndex] = std::numeric_limits<double>::quiet_NaN();
+
+			ASSERT_TRUE(std::isnan(numvec::minimum(values.data(), count)));
+			ASSERT_TRUE(std::isnan(numvec::maximum(values.data(), count)));
+		}
+	}
+}
+
+void testFlonumElementWise()
+{
+	std::mt19937_64 generator(0xe1e);
+
+	for(std::size_t count = 0; count < MaximumTestLength; count++)
+	{
+		const std::vector<double> left(randomDoubles(generator, count));
+		const std::vector<double> right(randomDoubles(generator, count));
+
+		std::vector<double> scaled(count);
+		std::vector<double> added(count);
+		std::vector<double> multiplied(count);
+		std::vector<double> prefixSums(count);
+		std::vector<std::uint8_t> lessMask(count);
+		std::vector<std::uint8_t> greaterMask(count);
+		std::vector<std::uint8_t> equalMask(count);
+
+		numvec::scale(scaled.data(), left.data(), count, 2.5);
+		numvec::add(added.data(), left.data(), right.data(), count);
+		numvec::multiply(multiplied.data(), left.data(), right.data(), count);
+		numvec::prefixSum(prefixSums.data(), left.data(), count);
+		numvec::compareMask(lessMask.data(), left.data(), count, numvec::Comparison::LessThan, 0.0);
+		numvec::compareMask(greaterMask.data(), left.data(), count, numvec::Comparison::GreaterThan, 0.0);
+		numvec::compareMask(equalMask.data(), left.data(), count, numvec::Comparison::Equal, left.empty() ? 0.0 : left[0]);
+
+		double runningSum = 0.0;
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			runningSum += left[i];
+
+			ASSERT_TRUE(scaled[i] == (left[i] * 2.5));
+			ASSERT_TRUE(added[i] == (left[i] + right[i]));
+			ASSERT_TRUE(multiplied[i] == (left[i] * right[i]));
+			ASSERT_TRUE(prefixSums[i] == runningSum);
+			ASSERT_TRUE(lessMask[i] == (left[i] < 0.0));
+			ASSERT_TRUE(greaterMask[i] == (left[i] > 0.0));
+			ASSERT_TRUE(equalMask[i] == (left[i] == left[0]));
+		}
+	}
+
+	// Outputs may alias inputs
+	std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0};
+	numvec::add(values.data(), values.data(), values.data(), values.size());
+	ASSERT_TRUE(values[4] == 10.0);
+}
+
+void testIntegerKernels()
+{
+	std::mt19937_64 generator(0x164);
+	std::uniform_int_distribution<std::int64_t> valueDist(-1000000, 1000000);
+
+	for(std::size_t count = 0; count < MaximumTestLength; count++)
+	{
+		std::vector<std::int64_t> values;
+		std::int64_t expectedSum = 0;
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			values.push_back(valueDist(generator));
+			expectedSum += values.back();
+		}
+
+		std::int64_t sum;
+		ASSERT_TRUE(numvec::sum(values.data(), count, sum));
+		ASSERT_EQUAL(sum, expectedSum);
+
+		if (count > 0)
+		{
+			ASSERT_EQUAL(numvec::minimum(values.data(), count), *std::min_element(values.begin(), values.end()));
+			ASSERT_EQUAL(numvec::maximum(values.data(), count), *std::max_element(values.begin(), values.end()));
+		}
+	}
+
+	const std::int64_t maxValue = std::numeric_limits<std::int64_t>::max();
+	const std::int64_t minValue = std::numeric_limits<std::int64_t>::min();
+
+	// Partial sums overflow in each lane but the total fits
+	const std::int64_t cancelling[8] = {maxValue, maxValue, maxValue, maxValue, -maxValue, -maxValue, -maxValue, -maxValue};
+	const std::int64_t cancellingReordered[8] = {maxValue, 1, 1, 1, maxValue, -1, -1, minValue};
+
+	std::int64_t sum;
+
+	ASSERT_TRUE(numvec::sum(cancelling, 8, sum));
+	ASSERT_EQUAL(sum, 0);
+
+	ASSERT_TRUE(numvec::sum(cancellingReordered, 8, sum));
+	ASSERT_EQUAL(sum, maxValue);
+
+	// Actual overflow
+	const std::int64_t overflowing[5] = {maxValue, 0, 0, 0, 1};
+	ASSERT_FALSE(numvec::sum(overflowing, 5, sum));
+
+	const std::int64_t underflowing[2] = {minValue, -1};
+	ASSERT_FALSE(numvec::sum(underflowing, 2, sum));
+}
+
+void testAll(World &world)
+{
+	testElementAlignment(world);
+	testFlonumReductions();
+	testFlonumNaN();
+	testFlonumElementWise();
+	testIntegerKernels();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -2,10 +2,15 @@
 #include "binding/SymbolCell.h"
 #include "binding/ProperList.h"
 #include "binding/IntegerCell.h"
+#include "binding/PairCell.h"
+#include "binding/EmptyListCell.h"
+#include "binding/RestValuesBuilder.h"
 
 #include "core/init.h"
 #include "core/World.h"
 
+#include "alloc/allocator.h"
+
 #include "assertions.h"
 #include "stubdefinitions.h"
 
@@ -14,8 +19,158 @@ namespace
 
 using namespace lliby;
 
+void testContiguousRuns(World &world)
+{
+	StringCell *valueA = StringCell::fromUtf8StdString(world, "A");
+	StringCell *valueB = StringCell::fromUtf8StdString(world, "B");
+	StringCell *valueC = StringCell::fromUtf8StdString(world, "C");
+
+	{
+		ProperList<AnyCell> *properList = ProperList<AnyCell>::create(world, {valueA, valueB, valueC});
+		auto headPair = cell_cast<PairCell>(properList);
+
+		ASSERT_EQUAL(headPair->contiguousRunLength(100), 3);
+		ASSERT_EQUAL(headPair->contiguousRunLength(2), 2);
+	}
+
+	{
+		ProperList<IntegerCell> *properList = ProperList<IntegerCell>::emplaceValues(world, {1, 2, 3, 4});
+		auto headPair = cell_cast<PairCell>(properList);
+
+		ASSERT_EQUAL(headPair->contiguousRunLength(100), 4);
+	}
+
+	{
+		// Prepend pairs allocated separately to a contiguous run
+		AnyCell *runList = ListElementCell::createList(world, {valueB, valueC, valueA}, EmptyListCell::instance());
+		PairCell *secondPair = PairCell::createInstance(world, valueB, runList);
+		PairCell *firstPair = PairCell::createInstance(world, valueA, secondPair);
+
+		ASSERT_EQUAL(firstPair->contiguousRunLength(100), 1);
+
+		// No list length hint so this will have to walk the list
+		ASSERT_EQUAL(cell_unchecked_cast<ProperList<AnyCell>>(firstPair)->size(), 5);
+
+		std::uint32_t count = 3;
+		auto tail = cell_cast<PairCell>(PairCell::advance(firstPair, count));
+
+		ASSERT_EQUAL(count, 0);
+		ASSERT_TRUE(tail != nullptr);
+		ASSERT_EQUAL(tail->car(), valueC);
+
+		count = 5;
+		ASSERT_EQUAL(PairCell::advance(firstPair, count), EmptyListCell::instance());
+		ASSERT_EQUAL(count, 0);
+
+		count = 7;
+		ASSERT_EQUAL(PairCell::advance(firstPair, count), EmptyListCell::instance());
+		ASSERT_EQUAL(count, 2);
+	}
+
+	{
+		// Improper lists stop at their tail
+		AnyCell *improperList = ListElementCell::createList(world, {valueA, valueB}, valueC);
+
+		std::uint32_t count = 3;
+		ASSERT_EQUAL(PairCell::advance(improperList, count), valueC);
+		ASSERT_EQUAL(count, 1);
+	}
+}
+
+void testRestValuesBuilder(World &world)
+{
+	StringCell *valueA = StringCell::fromUtf8StdString(world, "A");
+	StringCell *valueB = StringCell::fromUtf8StdString(world, "B");
+
+	{
+		RestValuesBuilder builder(world, 0, 5);
+		AnyCell *values[1] = {nullptr};
+
+		ASSERT_TRUE(builder.create(values) == EmptyListCell::asProperList<AnyCell>());
+	}
+
+	{
+		RestValuesBuilder builder(world, 2, 3);
+		std::vector<RestValues<AnyCell>*> restLists;
+
+		// Build more lists than expected to make sure another batch is allocated
+		for(int i = 0; i < 4; i++)
+		{
+			AnyCell *values[2] = {valueA, (i % 2) ? valueA : valueB};
+			restLists.push_back(builder.create(values));
+		}
+
+		for(int i = 0; i < 4; i++)
+		{
+			RestValues<AnyCell> *restList = restLists[i];
+
+			ASSERT_EQUAL(restList->size(), 2);
+			ASSERT_EQUAL(cell_unchecked_cast<PairCell>(restList)->contiguousRunLength(10), 2);
+
+			auto it = restList->begin();
+			ASSERT_EQUAL(*(it++), valueA);
+			StringCell *expectedValue = (i % 2) ? valueA : valueB;
+			ASSERT_EQUAL(*(it++), expectedValue);
+			ASSERT_TRUE(it == restList->end());
+		}
+
+		// Each list must be distinct as the procedure may retain it
+		ASSERT_TRUE(restLists[0] != restLists[1]);
+		ASSERT_TRUE(restLists[2] != restLists[3]);
+	}
+
+	{
+		RestValuesBuilder builder(world, 3, 1);
+		const std::int64_t values[3] = {1, 2, 3};
+
+		RestValues<IntegerCell> *restList = builder.emplaceValues<IntegerCell>(values);
+
+		ASSERT_EQUAL(restList->size(), 3);
+
+		std::int64_t expectedValue = 1;
+		for(auto integerCell : *restList)
+		{
+			ASSERT_EQUAL(integerCell->value(), expectedValue++);
+		}
+	}
+
+	{
+		RestValuesBuilder builder(world, 2);
+		const std::int64_t values[2] = {1, 2};
+
+		// The second batch has room for two lists; only use the first one
+		builder.emplaceValues<IntegerCell>(values);
+		builder.emplaceValues<IntegerCell>(values);
+	}
+
+	{
+		RestValuesBuilder builder(world, 1);
+		std::vector<RestValues<IntegerCell>*> restLists;
+
+		// This should span a number of batches including some at the maximum size
+		const std::int64_t listCount = RestValuesBuilder::MaximumBatchLists * 4;
+
+		for(std::int64_t i = 0; i < listCount; i++)
+		{
+			restLists.push_back(builder.emplaceValues<IntegerCell>(&i));
+		}
+
+		for(std::int64_t i = 0; i < listCount; i++)
+		{
+			ASSERT_EQUAL(restLists[i]->size(), 1);
+			ASSERT_EQUAL((*restLists[i]->begin())->value(), i);
+		}
+	}
+
+	// The unused remainder of the batch must be safe to collect
+	alloc::forceCollection(world);
+}
+
 void testAll(World &world)
 {
+	testContiguousRuns(world);
+	testRestValuesBuilder(world);
+
 	StringCell *valueA = StringCell::fromUtf8StdString(world, "A");
 	StringCell *valueB = StringCell::fromUtf8StdString(world, "B");
 	StringCell *valueC = StringCell::fromUtf8StdString(world, "C");
@@ -0,0 +1,101 @@
+#include <limits>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/RatnumCell.h"
+#include "binding/IntegerCell.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+const std::int64_t Int64Min = std::numeric_limits<std::int64_t>::min();
+const std::int64_t Int64Max = std::numeric_limits<std::int64_t>::max();
+
+void assertRatnum(NumberCell *value, std::int64_t numerator, std::int64_t denominator)
+{
+	auto ratnum = cell_cast<RatnumCell>(value);
+
+	ASSERT_TRUE(ratnum != nullptr);
+	ASSERT_EQUAL(ratnum->numerator(), numerator);
+	ASSERT_EQUAL(ratnum->denominator(), denominator);
+}
+
+void assertInteger(NumberCell *value, std::int64_t expected)
+{
+	auto integer = cell_cast<IntegerCell>(value);
+
+	ASSERT_TRUE(integer != nullptr);
+	ASSERT_EQUAL(integer->value(), expected);
+}
+
+void testFromFraction(World &world)
+{
+	assertRatnum(RatnumCell::fromFraction(world, 1, 2), 1, 2);
+	assertRatnum(RatnumCell::fromFraction(world, 6, 8), 3, 4);
+	assertRatnum(RatnumCell::fromFraction(world, 6, -8), -3, 4);
+	assertRatnum(RatnumCell::fromFraction(world, -6, -8), 3, 4);
+	assertRatnum(RatnumCell::fromFraction(world, Int64Min, Int64Max), Int64Min, Int64Max);
+
+	assertInteger(RatnumCell::fromFraction(world, 0, 5), 0);
+	assertInteger(RatnumCell::fromFraction(world, 0, -5), 0);
+	assertInteger(RatnumCell::fromFraction(world, 10, 5), 2);
+	assertInteger(RatnumCell::fromFraction(world, 10, -5), -2);
+	assertInteger(RatnumCell::fromFraction(world, Int64Min, 1), Int64Min);
+
+	// The denominator's magnitude doesn't fit in a positive integer
+	ASSERT_TRUE(RatnumCell::fromFraction(world, 1, Int64Min) == nullptr);
+	// The numerator's magnitude doesn't fit once made positive
+	ASSERT_TRUE(RatnumCell::fromFraction(world, Int64Min, -1) == nullptr);
+}
+
+void testIsReducedFraction()
+{
+	ASSERT_TRUE(RatnumCell::isReducedFraction(1, 2));
+	ASSERT_TRUE(RatnumCell::isReducedFraction(-3, 4));
+	ASSERT_TRUE(RatnumCell::isReducedFraction(Int64Min, Int64Max));
+
+	ASSERT_FALSE(RatnumCell::isReducedFraction(2, 4));
+	ASSERT_FALSE(RatnumCell::isReducedFraction(1, 1));
+	ASSERT_FALSE(RatnumCell::isReducedFraction(0, 2));
+	ASSERT_FALSE(RatnumCell::isReducedFraction(1, 0));
+	ASSERT_FALSE(RatnumCell::isReducedFraction(1, -2));
+}
+
+void testEqv(World &world)
+{
+	NumberCell *oneHalf = RatnumCell::fromFraction(world, 1, 2);
+	NumberCell *otherOneHalf = RatnumCell::fromFraction(world, 2, 4);
+	NumberCell *negativeOneHalf = RatnumCell::fromFraction(world, -1, 2);
+	NumberCell *oneThird = RatnumCell::fromFraction(world, 1, 3);
+
+	ASSERT_TRUE(oneHalf->isEqv(otherOneHalf));
+	ASSERT_FALSE(oneHalf->isEqv(negativeOneHalf));
+	ASSERT_FALSE(oneHalf->isEqv(oneThird));
+}
+
+void testToDouble(World &world)
+{
+	ASSERT_EQUAL(RatnumCell::fromFraction(world, 1, 2)->toDouble(), 0.5);
+	ASSERT_EQUAL(RatnumCell::fromFraction(world, -3, 4)->toDouble(), -0.75);
+	ASSERT_EQUAL(RatnumCell::fromFraction(world, 1, 3)->toDouble(), 1.0 / 3.0);
+}
+
+void testAll(World &world)
+{
+	testFromFraction(world);
+	testIsReducedFraction();
+	testEqv(world);
+	testToDouble(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,235 @@
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "sched/Dispatcher.h"
+#include "sched/TimerList.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+using sched::TimerList;
+using std::chrono::milliseconds;
+
+/**
+ * Records work completion from dispatcher threads
+ */
+class CompletionLog
+{
+public:
+	void record(int value)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_values.push_back(value);
+		m_cond.notify_all();
+	}
+
+	std::vector<int> waitForCount(std::size_t count)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		m_cond.wait_for(lock, std::chrono::seconds(10), [&] {
+			return m_values.size() >= count;
+		});
+
+		return m_values;
+	}
+
+	std::size_t size()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_values.size();
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::vector<int> m_values;
+};
+
+void testOrdering(TimerList &timerList)
+{
+	CompletionLog log;
+	const auto startTime = TimerList::Clock::now();
+
+	for(int value : {5, 1, 3, 2, 4, 0})
+	{
+		timerList.enqueueDelayedWork([&log, value, startTime] {
+			// Timers must never fire early
+			ASSERT_TRUE((TimerList::Clock::now() - startTime) >= milliseconds(value * 20));
+			log.record(value);
+		}, milliseconds(value * 20));
+	}
+
+	const std::vector<int> expected = {0, 1, 2, 3, 4, 5};
+	ASSERT_TRUE(log.waitForCount(6) == expected);
+	ASSERT_EQUAL(timerList.pendingCount(), 0);
+}
+
+void testCancellation(TimerList &timerList)
+{
+	CompletionLog log;
+
+	const TimerList::TimerId cancelledId = timerList.enqueueDelayedWork([&log] {
+		log.record(1);
+	}, milliseconds(10));
+
+	timerList.enqueueDelayedWork([&log] {
+		log.record(2);
+	}, milliseconds(30));
+
+	ASSERT_EQUAL(timerList.pendingCount(), 2);
+	ASSERT_TRUE(timerList.cancel(cancelledId));
+	ASSERT_FALSE(timerList.cancel(cancelledId));
+	ASSERT_EQUAL(timerList.pendingCount(), 1);
+
+	const std::vector<int> expected = {2};
+	ASSERT_TRUE(log.waitForCount(1) == expected);
+	ASSERT_EQUAL(timerList.pendingCount(), 0);
+
+	// Unknown timers can't be cancelled
+	ASSERT_FALSE(timerList.cancel(0));
+}
+
+void testRepeating(TimerList &timerList)
+{
+	CompletionLog log;
+	std::atomic<int> callCount(0);
+
+	timerList.enqueueRepeatingWork([&] {
+		// A late call can overlap the next repeat so ignore anything past the third call
+		const int callNumber = ++callCount;
+
+		if (callNumber <= 3)
+		{
+			log.record(callNumber);
+		}
+
+		// Stop after the third call
+		return callNumber < 3;
+	}, milliseconds(0), milliseconds(5));
+
+	std::vector<int> calls = log.waitForCount(3);
+	std::sort(calls.begin(), calls.end());
+
+	const std::vector<int> expected = {1, 2, 3};
+	ASSERT_TRUE(calls == expected);
+
+	// Wait for the cancel from the final call to be processed
+	for(int i = 0; (i < 100) && (timerList.pendingCount() != 0); i++)
+	{
+		std::this_thread::sleep_for(milliseconds(1));
+	}
+
+	ASSERT_EQUAL(timerList.pendingCount(), 0);
+
+	// Cancelling a repeating timer stops further calls
+	CompletionLog cancelledLog;
+
+	const TimerList::TimerId repeatingId = timerList.enqueueRepeatingWork([&cancelledLog] {
+		cancelledLog.record(0);
+		return true;
+	}, milliseconds(20), milliseconds(20));
+
+	ASSERT_TRUE(timerList.cancel(repeatingId));
+
+	std::this_thread::sleep_for(milliseconds(50));
+	ASSERT_EQUAL(cancelledLog.size(), 0);
+}
+
+void testLongDelays(TimerList &timerList)
+{
+	// These land on higher wheel levels and beyond the range of the top level
+	const TimerList::TimerId minutesId = timerList.enqueueDelayedWork([] {
+		ASSERT_TRUE(false);
+	}, std::chrono::minutes(10));
+
+	const TimerList::TimerId daysId = timerList.enqueueDelayedWork([] {
+		ASSERT_TRUE(false);
+	}, std::chrono::hours(24 * 100));
+
+	CompletionLog log;
+
+	timerList.enqueueDelayedWork([&log] {
+		log.record(0);
+	}, milliseconds(300));
+
+	// Cross a level 1 cascade boundary with the long timers pending
+	ASSERT_EQUAL(log.waitForCount(1).size(), 1);
+
+	ASSERT_EQUAL(timerList.pendingCount(), 2);
+	ASSERT_TRUE(timerList.cancel(minutesId));
+	ASSERT_TRUE(timerList.cancel(daysId));
+	ASSERT_EQUAL(timerList.pendingCount(), 0);
+}
+
+void testManyTimers(TimerList &timerList)
+{
+	const int timerCount = 20000;
+
+	std::mt19937 generator(0x71);
+	std::uniform_int_distribution<int> delayDistribution(0, 50);
+
+	CompletionLog log;
+	std::vector<TimerList::TimerId> timerIds;
+
+	for(int i = 0; i < timerCount; i++)
+	{
+		timerIds.push_back(timerList.enqueueDelayedWork([&log, i] {
+			log.record(i);
+		}, milliseconds(delayDistribution(generator))));
+	}
+
+	// Cancel every odd timer
+	int cancelledCount = 0;
+
+	for(int i = 1; i < timerCount; i += 2)
+	{
+		if (timerList.cancel(timerIds[i]))
+		{
+			cancelledCount++;
+		}
+	}
+
+	const std::size_t expectedCount = timerCount - cancelledCount;
+	ASSERT_EQUAL(log.waitForCount(expectedCount).size(), expectedCount);
+
+	std::this_thread::sleep_for(milliseconds(60));
+	ASSERT_EQUAL(log.size(), expectedCount);
+	ASSERT_EQUAL(timerList.pendingCount(), 0);
+}
+
+void testAll(World &world)
+{
+	sched::Dispatcher dispatcher;
+
+	{
+		TimerList timerList(dispatcher);
+
+		testOrdering(timerList);
+		testCancellation(timerList);
+		testRepeating(timerList);
+		testLongDelays(timerList);
+		testManyTimers(timerList);
+	}
+
+	dispatcher.waitForDrain();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
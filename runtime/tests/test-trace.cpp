@@ -0,0 +1,191 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/StringCell.h"
+
+#include "alloc/allocator.h"
+#include "sched/Dispatcher.h"
+
+#include "trace/Trace.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+std::string traceFilename(const char *extension)
+{
+	std::ostringstream filenameStream;
+	filenameStream << "/tmp/llambda-test-trace-" << getpid() << extension;
+
+	return filenameStream.str();
+}
+
+std::string readFile(const std::string &filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+
+	std::ostringstream contentStream;
+	contentStream << file.rdbuf();
+
+	return contentStream.str();
+}
+
+void testDisabled()
+{
+	ASSERT_FALSE(trace::enabled());
+
+	// Spans should be no-ops while tracing is disabled
+	trace::Span span(trace::EventType::ActorRun, nullptr);
+	span.setArgs(1, 2);
+}
+
+void testChromeTrace(World &world)
+{
+	const std::string filename = traceFilename(".json");
+
+	setenv("LLAMBDA_TRACE", "chrome", 1);
+	setenv("LLAMBDA_TRACE_FILE", filename.c_str(), 1);
+	trace::initTracing();
+
+	ASSERT_TRUE(trace::enabled());
+
+	for(int i = 0; i < 100; i++)
+	{
+		StringCell::fromUtf8StdString(world, u8"Garbage");
+	}
+
+	alloc::forceCollection(world);
+
+	{
+		trace::Span span(trace::EventType::ActorMessage, &world);
+		span.setArgs(7);
+	}
+
+	// Wait for the background finalization
+	sched::Dispatcher::defaultInstance().waitForDrain();
+
+	trace::writeTraceIfEnabled();
+	const std::string trace = readFile(filename);
+	unlink(filename.c_str());
+
+	ASSERT_TRUE(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") == 0);
+	ASSERT_TRUE(trace.find("\"name\":\"garbage-collection\",\"ph\":\"X\"") != std::string::npos);
+	ASSERT_TRUE(trace.find("\"cellsAllocated\":") != std::string::npos);
+	ASSERT_TRUE(trace.find("\"name\":\"finalization\"") != std::string::npos);
+	ASSERT_TRUE(trace.find("\"segmentsFreed\":1,") != std::string::npos);
+	ASSERT_TRUE(trace.find("\"actor\":false,\"messageType\":7}") != std::string::npos);
+}
+
+void testBinaryTrace()
+{
+	const std::string filename = traceFilename(".bin");
+
+	setenv("LLAMBDA_TRACE", "binary", 1);
+	setenv("LLAMBDA_TRACE_FILE", filename.c_str(), 1);
+	trace::initTracing();
+
+	const std::uint64_t startNs = trace::timestampNs();
+	trace::record(trace::EventType::ActorRun, startNs, 1234, trace::Subject{0, 0}, 5);
+
+	trace::writeTraceIfEnabled();
+	const std::string trace = readFile(filename);
+
+	const std::size_t headerSize = 8 + sizeof(std::uint32_t);
+
+	ASSERT_TRUE(trace.compare(0, 8, "LLTRACE1") == 0);
+	ASSERT_EQUAL((trace.size() - headerSize) % sizeof(trace::Event), 0);
+
+	// Our event should be the last one recorded by this thread
+	bool foundEvent = false;
+
+	for(std::size_t offset = headerSize; offset < trace.size(); offset += sizeof(trace::Event))
+	{
+		trace::Event event;
+		memcpy(&event, trace.data() + offset, sizeof(event));
+
+		if ((event.type == trace::EventType::ActorRun) && (event.startNs == startNs))
+		{
+			ASSERT_EQUAL(event.durationNs, 1234);
+			ASSERT_EQUAL(event.args[0], 5);
+			foundEvent = true;
+		}
+	}
+
+	ASSERT_TRUE(foundEvent);
+}
+
+void testTraceOnExit()
+{
+	const std::string filename = traceFilename("-exit.bin");
+
+	const pid_t childPid = fork();
+	ASSERT_TRUE(childPid >= 0);
+
+	if (childPid == 0)
+	{
+		setenv("LLAMBDA_TRACE", "binary", 1);
+		setenv("LLAMBDA_TRACE_FILE", filename.c_str(), 1);
+		trace::initTracing();
+
+		trace::record(trace::EventType::ActorRun, trace::timestampNs(), 4321, trace::Subject{0, 0});
+
+		// This is how (exit) leaves the program; llcore_run() never returns
+		exit(3);
+	}
+
+	int status;
+	ASSERT_EQUAL(waitpid(childPid, &status, 0), childPid);
+	ASSERT_TRUE(WIFEXITED(status));
+	ASSERT_EQUAL(WEXITSTATUS(status), 3);
+
+	const std::string trace = readFile(filename);
+	unlink(filename.c_str());
+
+	const std::size_t headerSize = 8 + sizeof(std::uint32_t);
+	ASSERT_TRUE(trace.compare(0, 8, "LLTRACE1") == 0);
+	ASSERT_EQUAL(trace.size(), headerSize + sizeof(trace::Event));
+
+	trace::Event event;
+	memcpy(&event, trace.data() + headerSize, sizeof(event));
+
+	ASSERT_TRUE(event.type == trace::EventType::ActorRun);
+	ASSERT_EQUAL(event.durationNs, 4321);
+}
+
+void removeExitTrace()
+{
+	unlink(traceFilename(".bin").c_str());
+}
+
+void testAll(World &world)
+{
+	testDisabled();
+	// This forks so it needs to run before we've started any threads
+	testTraceOnExit();
+	testChromeTrace(world);
+	testBinaryTrace();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	unsetenv("LLAMBDA_TRACE");
+
+	// Remove the trace written at exit. This is registered first so it runs after the trace has been written.
+	atexit(removeExitTrace);
+
+	llcore_run(testAll, argc, argv);
+}
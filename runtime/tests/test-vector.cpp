@@ -1,7 +1,12 @@
+#include <cstring>
+
 #include "binding/VectorCell.h"
 #include "binding/StringCell.h"
 #include "binding/UnitCell.h"
 
+#include "alloc/allocator.h"
+#include "alloc/AllocCell.h"
+
 #include "core/init.h"
 #include "core/World.h"
 
@@ -388,6 +393,62 @@ void testFill(World &world)
 	}
 }
 
+void testInlineElements(World &world)
+{
+	StringCell *element = StringCell::fromUtf8StdString(world, u8"Hello");
+
+	{
+		VectorCell *inlineVector = VectorCell::fromFill(world, VectorCell::MaximumInlineLength, element);
+
+		ASSERT_TRUE(inlineVector->elementsAreInline());
+		ASSERT_EQUAL(inlineVector->elementAt(0), element);
+		ASSERT_EQUAL(inlineVector->elementAt(VectorCell::MaximumInlineLength - 1), element);
+
+		// The elements should directly follow the vector cell
+		auto storageCell = reinterpret_cast<alloc::AllocCell*>(inlineVector) + 1;
+		ASSERT_TRUE(storageCell->gcState() == GarbageState::InlineStorageCell);
+	}
+
+	{
+		VectorCell *outOfLineVector = VectorCell::fromFill(world, VectorCell::MaximumInlineLength + 1, element);
+
+		ASSERT_FALSE(outOfLineVector->elementsAreInline());
+		ASSERT_EQUAL(outOfLineVector->elementAt(VectorCell::MaximumInlineLength), element);
+	}
+
+	{
+		// Simulate the collector moving the vector with its storage
+		VectorCell *inlineVector = VectorCell::fromFill(world, 3, element);
+		const std::size_t cellCount = 1 + VectorCell::inlineStorageCells(3);
+
+		ASSERT_EQUAL(cellCount, 2);
+
+		alignas(alloc::AllocCell) std::uint8_t movedCells[sizeof(alloc::AllocCell) * 2];
+		memcpy(movedCells, inlineVector, sizeof(alloc::AllocCell) * cellCount);
+
+		auto movedVector = reinterpret_cast<VectorCell*>(movedCells);
+		ASSERT_FALSE(movedVector->elementsAreInline());
+
+		movedVector->relocateInlineElements();
+		ASSERT_TRUE(movedVector->elementsAreInline());
+		ASSERT_EQUAL(movedVector->length(), 3);
+		ASSERT_EQUAL(movedVector->elementAt(2), element);
+	}
+
+	{
+		// Creating a slice of an inline vector should also be inline
+		VectorCell *sourceVector = VectorCell::fromFill(world, 40, element);
+		VectorCell *sliceVector = sourceVector->copy(world, 10, 20);
+
+		ASSERT_TRUE(sliceVector->elementsAreInline());
+		ASSERT_EQUAL(sliceVector->length(), 10);
+		ASSERT_EQUAL(sliceVector->elementAt(9), element);
+	}
+
+	// Make sure the collector and finalizer can walk over the inline storage
+	alloc::forceCollection(world);
+}
+
 void testAll(World &world)
 {
 	testFromFill(world);
@@ -396,6 +457,7 @@ void testAll(World &world)
 	testCopy(world);
 	testReplace(world);
 	testFill(world);
+	testInlineElements(world);
 }
 
 }
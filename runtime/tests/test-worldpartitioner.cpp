@@ -0,0 +1,157 @@
+#include <vector>
+#include <mutex>
+
+#include "core/init.h"
+#include "core/World.h"
+
+#include "binding/IntegerCell.h"
+#include "binding/TypedProcedureCell.h"
+
+#include "dynamic/SchemeException.h"
+
+#include "sched/Dispatcher.h"
+#include "sched/WorldPartitioner.h"
+
+#include "assertions.h"
+#include "stubdefinitions.h"
+
+namespace
+{
+using namespace lliby;
+
+using MapProc = TypedProcedureCell<AnyCell*, AnyCell*>;
+
+const std::int64_t FailingValue = 700;
+
+AnyCell* doubleEntryPoint(World &world, ProcedureCell *, AnyCell *value)
+{
+	const std::int64_t intValue = cell_unchecked_cast<IntegerCell>(value)->value();
+
+	if (intValue == FailingValue)
+	{
+		throw dynamic::SchemeException(value);
+	}
+
+	return IntegerCell::fromValue(world, intValue * 2);
+}
+
+std::vector<AnyCell*> buildInputs(World &world, std::int64_t count)
+{
+	std::vector<AnyCell*> inputs;
+
+	for(std::int64_t i = 0; i < count; i++)
+	{
+		inputs.push_back(IntegerCell::fromValue(world, i));
+	}
+
+	return inputs;
+}
+
+void testParallelMap(World &world)
+{
+	const std::size_t itemCount = sched::WorldPartitioner::MinimumPartitionItems * 4 + 3;
+
+	auto proc = MapProc::createInstance(world, ProcedureCell::EmptyRecordLikeClassId, true, nullptr, doubleEntryPoint);
+	const std::vector<AnyCell*> inputs(buildInputs(world, itemCount));
+	std::vector<AnyCell*> outputs(itemCount, nullptr);
+
+	sched::WorldPartitioner partitioner(world, sched::Dispatcher::defaultInstance(), 4);
+	ASSERT_EQUAL(partitioner.partitionCount(itemCount), 4);
+
+	std::mutex seenMutex;
+	std::vector<std::size_t> seenPartitions;
+
+	partitioner.run(proc, itemCount, [&] (World &partitionWorld, AnyCell *partitionProc, std::size_t partitionIndex, std::size_t start, std::size_t end)
+	{
+		// Each partition should have its own world and procedure
+		ASSERT_TRUE(&partitionWorld != &world);
+		ASSERT_TRUE(partitionProc != proc);
+
+		for(std::size_t i = start; i < end; i++)
+		{
+			outputs[i] = static_cast<MapProc*>(partitionProc)->apply(partitionWorld, inputs[i]);
+		}
+
+		std::lock_guard<std::mutex> lock(seenMutex);
+		seenPartitions.push_back(partitionIndex);
+	});
+
+	ASSERT_EQUAL(seenPartitions.size(), 4);
+
+	for(std::size_t i = 0; i < itemCount; i++)
+	{
+		// The output cells were allocated in the partition worlds and now belong to our world
+		ASSERT_TRUE(outputs[i] != nullptr);
+		ASSERT_EQUAL(cell_unchecked_cast<IntegerCell>(outputs[i])->value(), static_cast<std::int64_t>(i * 2));
+	}
+}
+
+void testSmallRange(World &world)
+{
+	auto proc = MapProc::createInstance(world, ProcedureCell::EmptyRecordLikeClassId, true, nullptr, doubleEntryPoint);
+
+	sched::WorldPartitioner partitioner(world, sched::Dispatcher::defaultInstance(), 4);
+	ASSERT_EQUAL(partitioner.partitionCount(10), 1);
+	ASSERT_EQUAL(partitioner.partitionCount(0), 1);
+
+	std::size_t calls = 0;
+
+	partitioner.run(proc, 10, [&] (World &partitionWorld, AnyCell *partitionProc, std::size_t partitionIndex, std::size_t start, std::size_t end)
+	{
+		// Small ranges are run directly in our world
+		ASSERT_TRUE(&partitionWorld == &world);
+		ASSERT_TRUE(partitionProc == proc);
+		ASSERT_EQUAL(partitionIndex, 0);
+		ASSERT_EQUAL(start, 0);
+		ASSERT_EQUAL(end, 10);
+
+		calls++;
+	});
+
+	ASSERT_EQUAL(calls, 1);
+}
+
+void testPartitionError(World &world)
+{
+	const std::size_t itemCount = sched::WorldPartitioner::MinimumPartitionItems * 8;
+	ASSERT_TRUE(itemCount > static_cast<std::size_t>(FailingValue));
+
+	auto proc = MapProc::createInstance(world, ProcedureCell::EmptyRecordLikeClassId, true, nullptr, doubleEntryPoint);
+	const std::vector<AnyCell*> inputs(buildInputs(world, itemCount));
+
+	sched::WorldPartitioner partitioner(world, sched::Dispatcher::defaultInstance(), 4);
+
+	bool threw = false;
+
+	try
+	{
+		partitioner.run(proc, itemCount, [&] (World &partitionWorld, AnyCell *partitionProc, std::size_t, std::size_t start, std::size_t end)
+		{
+			for(std::size_t i = start; i < end; i++)
+			{
+				static_cast<MapProc*>(partitionProc)->apply(partitionWorld, inputs[i]);
+			}
+		});
+	}
+	catch(dynamic::SchemeException &e)
+	{
+		threw = true;
+		ASSERT_TRUE(e.object() == inputs[FailingValue]);
+	}
+
+	ASSERT_TRUE(threw);
+}
+
+void testAll(World &world)
+{
+	testParallelMap(world);
+	testSmallRange(world);
+	testPartitionError(world);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(testAll, argc, argv);
+}
@@ -0,0 +1,353 @@
+#include "tools/benchmark/Harness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace lliby
+{
+namespace benchmark
+{
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	 * Minimum time for a sample of an iterated benchmark
+	 *
+	 * This keeps clock resolution and call overhead from dominating the measurement
+	 */
+	const double MinimumSampleNs = 10e6;
+
+	/**
+	 * Prevents the result of iterated benchmarks from being optimised away
+	 */
+	volatile std::uint64_t resultSink;
+
+	/**
+	 * Returns the two-tailed 95% critical value of Student's t-distribution
+	 */
+	double tCriticalValue(double degreesOfFreedom)
+	{
+		static const double criticalValues[] = {
+			12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+			2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+			2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+		};
+
+		const int tableSize = sizeof(criticalValues) / sizeof(criticalValues[0]);
+		const int index = static_cast<int>(std::floor(degreesOfFreedom)) - 1;
+
+		if (index < 0)
+		{
+			return criticalValues[0];
+		}
+		else if (index >= tableSize)
+		{
+			return 1.960;
+		}
+
+		return criticalValues[index];
+	}
+
+	/**
+	 * Returns true if two sets of samples have significantly different means by Welch's t-test
+	 */
+	bool significantlyDifferent(const SampleStatistics &a, const SampleStatistics &b)
+	{
+		if ((a.sampleCount < 2) || (b.sampleCount < 2))
+		{
+			return false;
+		}
+
+		const double aVariance = (a.stddevNs * a.stddevNs) / a.sampleCount;
+		const double bVariance = (b.stddevNs * b.stddevNs) / b.sampleCount;
+		const double combinedVariance = aVariance + bVariance;
+
+		if (combinedVariance == 0.0)
+		{
+			return a.meanNs != b.meanNs;
+		}
+
+		const double t = (a.meanNs - b.meanNs) / std::sqrt(combinedVariance);
+
+		// Welch-Satterthwaite approximation of the degrees of freedom
+		const double degreesOfFreedom = (combinedVariance * combinedVariance) /
+			((aVariance * aVariance) / (a.sampleCount - 1) + (bVariance * bVariance) / (b.sampleCount - 1));
+
+		return std::fabs(t) > tCriticalValue(degreesOfFreedom);
+	}
+
+	std::map<std::string, SampleStatistics> loadBaseline(const std::string &path)
+	{
+		std::map<std::string, SampleStatistics> baseline;
+		std::ifstream baselineFile(path);
+
+		if (!baselineFile)
+		{
+			std::cerr << "Unable to open baseline \"" << path << "\"" << std::endl;
+			exit(-1);
+		}
+
+		std::string line;
+
+		while(std::getline(baselineFile, line))
+		{
+			std::istringstream lineStream(line);
+
+			std::string name;
+			SampleStatistics stats;
+
+			if (std::getline(lineStream, name, '\t') &&
+				(lineStream >> stats.sampleCount >> stats.meanNs >> stats.medianNs >> stats.stddevNs))
+			{
+				stats.confidenceNs = 0.0;
+				baseline[name] = stats;
+			}
+		}
+
+		return baseline;
+	}
+
+	std::string formatNs(double ns)
+	{
+		std::ostringstream formatStream;
+		formatStream << std::fixed << std::setprecision(1);
+
+		if (ns >= 1e6)
+		{
+			formatStream << (ns / 1e6) << " ms";
+		}
+		else if (ns >= 1e3)
+		{
+			formatStream << (ns / 1e3) << " us";
+		}
+		else
+		{
+			formatStream << ns << " ns";
+		}
+
+		return formatStream.str();
+	}
+}
+
+SampleStatistics SampleStatistics::fromSamples(std::vector<double> samples)
+{
+	SampleStatistics stats;
+	stats.sampleCount = samples.size();
+
+	std::sort(samples.begin(), samples.end());
+
+	const std::size_t middle = samples.size() / 2;
+	stats.medianNs = (samples.size() % 2) ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+
+	double sum = 0.0;
+
+	for(double sample : samples)
+	{
+		sum += sample;
+	}
+
+	stats.meanNs = sum / samples.size();
+
+	double squaredDeviations = 0.0;
+
+	for(double sample : samples)
+	{
+		squaredDeviations += (sample - stats.meanNs) * (sample - stats.meanNs);
+	}
+
+	if (samples.size() > 1)
+	{
+		stats.stddevNs = std::sqrt(squaredDeviations / (samples.size() - 1));
+		stats.confidenceNs = tCriticalValue(samples.size() - 1) * stats.stddevNs / std::sqrt(samples.size());
+	}
+	else
+	{
+		stats.stddevNs = 0.0;
+		stats.confidenceNs = 0.0;
+	}
+
+	return stats;
+}
+
+Harness::Harness(int argc, char **argv)
+{
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = (i + 1) < argc;
+
+		if (!strcmp(argv[i], "--samples") && hasValue)
+		{
+			m_sampleCount = std::max(2, atoi(argv[++i]));
+		}
+		else if (!strcmp(argv[i], "--filter") && hasValue)
+		{
+			m_filter = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--baseline") && hasValue)
+		{
+			m_baselinePath = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--save-baseline") && hasValue)
+		{
+			m_saveBaselinePath = argv[++i];
+		}
+		else
+		{
+			m_positionalArguments.push_back(argv[i]);
+		}
+	}
+}
+
+void Harness::addIterated(const std::string &name, IterationFunction function)
+{
+	m_benchmarks.push_back(Benchmark{name, calibratedSampler(function)});
+}
+
+void Harness::addSampled(const std::string &name, SampleFunction function)
+{
+	m_benchmarks.push_back(Benchmark{name, function});
+}
+
+Harness::SampleFunction Harness::calibratedSampler(IterationFunction function)
+{
+	auto iterations = std::make_shared<std::uint64_t>(0);
+
+	auto timeIterations = [=] (std::uint64_t count) {
+		const auto startTime = Clock::now();
+		resultSink = function(count);
+		const auto endTime = Clock::now();
+
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+	};
+
+	return [=] {
+		if (*iterations == 0)
+		{
+			// Double the iterations until a sample takes long enough
+			std::uint64_t count = 1;
+
+			while(timeIterations(count) < MinimumSampleNs)
+			{
+				count *= 2;
+			}
+
+			*iterations = count;
+		}
+
+		return timeIterations(*iterations) / *iterations;
+	};
+}
+
+int Harness::run()
+{
+	std::map<std::string, SampleStatistics> baseline;
+	std::map<std::string, SampleStatistics> results;
+
+	if (!m_baselinePath.empty())
+	{
+		baseline = loadBaseline(m_baselinePath);
+	}
+
+	int regressionCount = 0;
+
+	std::cout << std::left << std::setw(40) << "benchmark"
+		<< std::right << std::setw(12) << "median"
+		<< std::setw(12) << "mean"
+		<< std::setw(12) << "+/- 95%";
+
+	if (!baseline.empty())
+	{
+		std::cout << std::setw(12) << "change";
+	}
+
+	std::cout << std::endl;
+
+	for(const Benchmark &benchmark : m_benchmarks)
+	{
+		if (benchmark.name.find(m_filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		// Take an untimed sample to warm caches and calibrate
+		benchmark.takeSample();
+
+		std::vector<double> samples;
+
+		for(std::size_t i = 0; i < m_sampleCount; i++)
+		{
+			samples.push_back(benchmark.takeSample());
+		}
+
+		const SampleStatistics stats(SampleStatistics::fromSamples(samples));
+		results[benchmark.name] = stats;
+
+		std::cout << std::left << std::setw(40) << benchmark.name
+			<< std::right << std::setw(12) << formatNs(stats.medianNs)
+			<< std::setw(12) << formatNs(stats.meanNs)
+			<< std::setw(12) << formatNs(stats.confidenceNs);
+
+		auto baselineIt = baseline.find(benchmark.name);
+
+		if (baselineIt != baseline.end())
+		{
+			const SampleStatistics &baselineStats(baselineIt->second);
+			const double change = (stats.meanNs - baselineStats.meanNs) / baselineStats.meanNs;
+
+			std::ostringstream changeStream;
+			changeStream << std::showpos << std::fixed << std::setprecision(1) << (change * 100.0) << "%";
+
+			std::cout << std::setw(12) << changeStream.str();
+
+			if ((std::fabs(change) > RegressionThreshold) && significantlyDifferent(stats, baselineStats))
+			{
+				if (change > 0.0)
+				{
+					std::cout << "  REGRESSED";
+					regressionCount++;
+				}
+				else
+				{
+					std::cout << "  improved";
+				}
+			}
+		}
+
+		std::cout << std::endl;
+	}
+
+	if (!m_saveBaselinePath.empty())
+	{
+		std::ofstream baselineFile(m_saveBaselinePath, std::ios::out | std::ios::trunc);
+		baselineFile << std::setprecision(17);
+
+		for(const auto &result : results)
+		{
+			const SampleStatistics &stats(result.second);
+
+			baselineFile << result.first << "\t" << stats.sampleCount << " " << stats.meanNs << " "
+				<< stats.medianNs << " " << stats.stddevNs << "\n";
+		}
+	}
+
+	if (regressionCount > 0)
+	{
+		std::cout << regressionCount << " benchmark(s) regressed against the baseline" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+}
+}
@@ -0,0 +1,111 @@
+#ifndef _LLIBY_TOOLS_BENCHMARK_HARNESS_H
+#define _LLIBY_TOOLS_BENCHMARK_HARNESS_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lliby
+{
+namespace benchmark
+{
+
+/**
+ * Summary statistics for a benchmark's samples
+ */
+struct SampleStatistics
+{
+	std::size_t sampleCount;
+	double meanNs;
+	double medianNs;
+	double stddevNs;
+
+	/**
+	 * Half-width of the 95% confidence interval for the mean
+	 */
+	double confidenceNs;
+
+	static SampleStatistics fromSamples(std::vector<double> samples);
+};
+
+/**
+ * Runs benchmarks and compares them against a stored baseline
+ *
+ * The following command line options are accepted:
+ *   --samples N            Number of timed samples per benchmark. Defaults to 15.
+ *   --filter SUBSTRING     Only run benchmarks whose name contains SUBSTRING
+ *   --baseline FILE        Compare results against a baseline previously saved to FILE
+ *   --save-baseline FILE   Save results to FILE for later comparison
+ *
+ * Any other arguments are returned by positionalArguments().
+ *
+ * A benchmark is reported as a regression if it's both significantly slower by Welch's t-test and more than
+ * RegressionThreshold slower than its baseline.
+ */
+class Harness
+{
+public:
+	/**
+	 * Function running a benchmark for a number of iterations
+	 *
+	 * This should return a value depending on the work performed to prevent it being optimised away
+	 */
+	using IterationFunction = std::function<std::uint64_t(std::uint64_t iterations)>;
+
+	/**
+	 * Function taking a single sample and returning its time in nanoseconds
+	 */
+	using SampleFunction = std::function<double()>;
+
+	static constexpr double RegressionThreshold = 0.03;
+
+	Harness(int argc, char **argv);
+
+	/**
+	 * Adds a micro-benchmark reported as the time per iteration
+	 *
+	 * The number of iterations per sample is calibrated so each sample takes at least MinimumSampleNs
+	 */
+	void addIterated(const std::string &name, IterationFunction function);
+
+	/**
+	 * Adds a benchmark where each sample is timed by the passed function
+	 */
+	void addSampled(const std::string &name, SampleFunction function);
+
+	/**
+	 * Runs all added benchmarks matching the filter
+	 *
+	 * @return Process exit code. This is non-zero if a benchmark regressed against the baseline.
+	 */
+	int run();
+
+	const std::vector<std::string> &positionalArguments() const
+	{
+		return m_positionalArguments;
+	}
+
+private:
+	struct Benchmark
+	{
+		std::string name;
+		SampleFunction takeSample;
+	};
+
+	static SampleFunction calibratedSampler(IterationFunction function);
+
+	std::size_t m_sampleCount = 15;
+	std::string m_filter;
+	std::string m_baselinePath;
+	std::string m_saveBaselinePath;
+	std::vector<std::string> m_positionalArguments;
+
+	std::vector<Benchmark> m_benchmarks;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "tools/benchmark/Harness.h"
+
+/**
+ * Times compiled Scheme programs
+ *
+ * Each positional argument is the path to a program to benchmark. A sample is the wall time of a single run of the
+ * program including process startup. The program's output is discarded and any unsuccessful exit aborts the run.
+ */
+namespace
+{
+	using namespace lliby;
+	using benchmark::Harness;
+
+	typedef std::chrono::steady_clock Clock;
+
+	double runProgram(const std::string &path)
+	{
+		const auto startTime = Clock::now();
+		const pid_t childPid = fork();
+
+		if (childPid == 0)
+		{
+			// Discard the program's output
+			freopen("/dev/null", "w", stdout);
+			execl(path.c_str(), path.c_str(), static_cast<char*>(nullptr));
+
+			_exit(127);
+		}
+		else if (childPid < 0)
+		{
+			perror("fork");
+			exit(-1);
+		}
+
+		int status;
+
+		if ((waitpid(childPid, &status, 0) < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+		{
+			std::cerr << "Benchmark program \"" << path << "\" failed" << std::endl;
+			exit(-1);
+		}
+
+		const auto endTime = Clock::now();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+	}
+
+	std::string programName(const std::string &path)
+	{
+		const std::size_t lastSlash = path.rfind('/');
+		return "program/" + ((lastSlash == std::string::npos) ? path : path.substr(lastSlash + 1));
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	Harness harness(argc, argv);
+
+	if (harness.positionalArguments().empty())
+	{
+		std::cerr << "Usage: " << argv[0] << " [--samples N] [--filter SUBSTRING] [--baseline FILE] "
+			"[--save-baseline FILE] PROGRAM..." << std::endl;
+		return -1;
+	}
+
+	for(const std::string &path : harness.positionalArguments())
+	{
+		harness.addSampled(programName(path), [=] {
+			return runProgram(path);
+		});
+	}
+
+	return harness.run();
+}
@@ -0,0 +1,400 @@
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "core/init.h"
+#include "core/World.h"
+#include "tests/stubdefinitions.h"
+
+#include "binding/EmptyListCell.h"
+#include "binding/EofObjectCell.h"
+#include "binding/IntegerCell.h"
+#include "binding/PairCell.h"
+#include "binding/ProperList.h"
+#include "binding/StringCell.h"
+
+#include "alloc/allocator.h"
+#include "dynamic/State.h"
+#include "dynamic/ParameterProcedureCell.h"
+
+#include "hash/DatumHash.h"
+#include "hash/DatumHashTree.h"
+
+#include "reader/DatumReader.h"
+#include "writer/ExternalFormDatumWriter.h"
+#include "unicode/utf8.h"
+
+#include "actor/ActorBehaviourCell.h"
+#include "actor/ActorClosureCell.h"
+#include "actor/ActorContext.h"
+#include "actor/Mailbox.h"
+#include "actor/Message.h"
+#include "actor/Runner.h"
+
+#include "tools/benchmark/Harness.h"
+
+/**
+ * Micro-benchmarks for the runtime's hot paths
+ *
+ * Benchmarks that allocate without bound use their own world which is periodically collected. Everything else shares
+ * the root world which is never collected so cells referenced from outside the heap remain valid.
+ */
+namespace
+{
+	using namespace lliby;
+	using benchmark::Harness;
+
+	const std::size_t HashTreeSize = 1024;
+	const std::size_t CollectedListLength = 10000;
+
+	/**
+	 * Number of allocating iterations between collections of a benchmark's private world
+	 */
+	const std::uint64_t CollectionInterval = 16 * 1024;
+
+	const char *ReaderSource =
+		"(define (fact n) (if (< n 2) 1 (* n (fact (- n 1))))) "
+		"#(1 -2.5 \"a string\\n\" #\\x #u8(1 2 3) symbol |quoted symbol| (nested (list) . pair)) "
+		"(#t #f 12345678901234 3.14159 \"caf\xc3\xa9 \xe2\x82\xac\xf0\x9f\x98\x80\")";
+
+	int exitCode = 0;
+
+	/**
+	 * Stream buffer discarding its output
+	 */
+	class NullStreamBuf : public std::streambuf
+	{
+	protected:
+		std::streamsize xsputn(const char *, std::streamsize count) override
+		{
+			return count;
+		}
+
+		int overflow(int c) override
+		{
+			return c;
+		}
+	};
+
+	/**
+	 * Mailbox exposing the receive side used by actor runners
+	 */
+	class BenchmarkMailbox : public actor::Mailbox
+	{
+	public:
+		using actor::Mailbox::ReceiveResult;
+		using actor::Mailbox::receive;
+	};
+
+	/**
+	 * Behaviour for an actor replying to every message with the message itself
+	 */
+	void echoBehaviour(World &world, ProcedureCell *, AnyCell *request)
+	{
+		actor::ActorContext *context = world.actorContext();
+
+		if (std::shared_ptr<actor::Mailbox> sender = context->sender().lock())
+		{
+			sender->tell(actor::Message::createFromCell(request, context->mailbox()));
+		}
+	}
+
+	actor::ActorBehaviourCell *echoClosure(World &world, ProcedureCell *)
+	{
+		return actor::ActorBehaviourCell::createInstance(world, 0, true, nullptr, &echoBehaviour);
+	}
+
+	std::vector<AnyCell*> integerCells(World &world, std::size_t count)
+	{
+		std::vector<AnyCell*> cells;
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			// Avoid preconstructed instances
+			cells.push_back(IntegerCell::fromValue(world, (std::int64_t(1) << 40) + i));
+		}
+
+		return cells;
+	}
+
+	void addAllocationBenchmarks(Harness &harness)
+	{
+		auto allocWorld = std::make_shared<World>();
+
+		harness.addIterated("heap/allocate-integer", [=] (std::uint64_t iterations) {
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				if ((i % CollectionInterval) == 0)
+				{
+					alloc::forceCollection(*allocWorld);
+				}
+
+				checksum += reinterpret_cast<std::uintptr_t>(IntegerCell::fromValue(*allocWorld, (std::int64_t(1) << 40) + i));
+			}
+
+			return checksum;
+		});
+
+		// Root a list through a parameter value so each collection copies it
+		auto gcWorld = std::make_shared<World>();
+
+		std::vector<AnyCell*> listValues(integerCells(*gcWorld, CollectedListLength));
+		ProperList<AnyCell> *list = ProperList<AnyCell>::create(*gcWorld, listValues);
+
+		auto paramProc = dynamic::ParameterProcedureCell::createInstance(*gcWorld, EmptyListCell::instance());
+		dynamic::State::pushActiveState(*gcWorld);
+		gcWorld->activeState()->setValueForParameter(*gcWorld, paramProc, list);
+
+		harness.addIterated("gc/collect-10000-pair-list", [=] (std::uint64_t iterations) {
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				checksum += alloc::forceCollection(*gcWorld);
+			}
+
+			return checksum;
+		});
+	}
+
+	void addHashBenchmarks(World &world, Harness &harness)
+	{
+		std::vector<AnyCell*> keys(integerCells(world, HashTreeSize * 2));
+
+		std::vector<AnyCell*> stringKeys;
+
+		for(std::size_t i = 0; i < HashTreeSize; i++)
+		{
+			stringKeys.push_back(StringCell::fromUtf8StdString(world, "string key " + std::to_string(i)));
+		}
+
+		// Only half of the keys are in the tree so both hits and misses are measured
+		DatumHashTree *tree = DatumHashTree::createEmpty();
+
+		for(std::size_t i = 0; i < HashTreeSize; i++)
+		{
+			DatumHashTree *newTree = DatumHashTree::assoc(tree, keys[i], keys[i]);
+			DatumHashTree::unref(tree);
+			tree = newTree;
+		}
+
+		std::shared_ptr<DatumHashTree> treeOwner(tree, [] (DatumHashTree *ownedTree) {
+			DatumHashTree::unref(ownedTree);
+		});
+
+		harness.addIterated("datumhashtree/assoc", [=] (std::uint64_t iterations) {
+			DatumHashTree *currentTree = DatumHashTree::ref(treeOwner.get());
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				AnyCell *key = keys[i % keys.size()];
+
+				DatumHashTree *newTree = DatumHashTree::assoc(currentTree, key, key);
+				DatumHashTree::unref(currentTree);
+				currentTree = newTree;
+			}
+
+			const std::uint64_t checksum = DatumHashTree::size(currentTree);
+			DatumHashTree::unref(currentTree);
+
+			return checksum;
+		});
+
+		harness.addIterated("datumhashtree/find", [=] (std::uint64_t iterations) {
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				checksum += (DatumHashTree::find(treeOwner.get(), keys[i % keys.size()]) != nullptr);
+			}
+
+			return checksum;
+		});
+
+		harness.addIterated("datumhash/integer", [=] (std::uint64_t iterations) {
+			DatumHash hasher;
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				checksum += hasher(keys[i % keys.size()]);
+			}
+
+			return checksum;
+		});
+
+		harness.addIterated("datumhash/string", [=] (std::uint64_t iterations) {
+			DatumHash hasher;
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				checksum += hasher(stringKeys[i % stringKeys.size()]);
+			}
+
+			return checksum;
+		});
+	}
+
+	void addTextBenchmarks(World &world, Harness &harness)
+	{
+		// Mix ASCII with two, three and four byte sequences
+		std::string utf8Text;
+
+		while(utf8Text.size() < 64 * 1024)
+		{
+			utf8Text += "Hello, world! caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 ";
+		}
+
+		harness.addIterated("utf8/validate-64k", [=] (std::uint64_t iterations) {
+			auto start = reinterpret_cast<const std::uint8_t*>(utf8Text.data());
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				checksum += utf8::validateData(start, start + utf8Text.size());
+			}
+
+			return checksum;
+		});
+
+		auto readerWorld = std::make_shared<World>();
+		const std::string readerSource(ReaderSource);
+
+		harness.addIterated("datumreader/parse", [=] (std::uint64_t iterations) {
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				if ((i % CollectionInterval) == 0)
+				{
+					alloc::forceCollection(*readerWorld);
+				}
+
+				std::istringstream inputStream(readerSource);
+				DatumReader reader(*readerWorld, inputStream);
+
+				AnyCell *datum;
+
+				while((datum = reader.parse()) != EofObjectCell::instance())
+				{
+					checksum += reinterpret_cast<std::uintptr_t>(datum);
+				}
+			}
+
+			return checksum;
+		});
+
+		std::istringstream inputStream(readerSource);
+		DatumReader reader(world, inputStream);
+		std::vector<AnyCell*> data;
+		AnyCell *datum;
+
+		while((datum = reader.parse()) != EofObjectCell::instance())
+		{
+			data.push_back(datum);
+		}
+
+		harness.addIterated("externalformdatumwriter/render", [=] (std::uint64_t iterations) {
+			NullStreamBuf nullBuf;
+			std::ostream nullStream(&nullBuf);
+			ExternalFormDatumWriter writer(nullStream);
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				for(AnyCell *datum : data)
+				{
+					writer.render(datum);
+				}
+			}
+
+			return iterations;
+		});
+	}
+
+	void addMailboxBenchmarks(World &world, Harness &harness)
+	{
+		std::vector<AnyCell*> payloadValues(integerCells(world, 4));
+		AnyCell *payload = ProperList<AnyCell>::create(world, payloadValues);
+
+		harness.addIterated("mailbox/tell-receive", [=] (std::uint64_t iterations) {
+			BenchmarkMailbox mailbox;
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				mailbox.tell(actor::Message::createFromCell(payload, std::weak_ptr<actor::Mailbox>()));
+
+				actor::Message *msg;
+				actor::LifecycleAction action;
+
+				if (mailbox.receive(nullptr, &msg, &action) == BenchmarkMailbox::ReceiveResult::PoppedMessage)
+				{
+					checksum += reinterpret_cast<std::uintptr_t>(msg->messageCell());
+					delete msg;
+				}
+			}
+
+			return checksum;
+		});
+
+		auto askWorld = std::make_shared<World>();
+
+		harness.addIterated("mailbox/ask", [=] (std::uint64_t iterations) {
+			// Start an actor replying from native code so this measures (ask) itself
+			auto closure = actor::ActorClosureCell::createInstance(*askWorld, 0, true, nullptr, &echoClosure);
+			std::shared_ptr<actor::Mailbox> echoMailbox(actor::Runner::start(*askWorld, closure));
+
+			const std::int64_t timeoutUsecs = 5 * 1000 * 1000;
+			std::uint64_t checksum = 0;
+
+			for(std::uint64_t i = 0; i < iterations; i++)
+			{
+				if ((i % CollectionInterval) == 0)
+				{
+					alloc::forceCollection(*askWorld);
+				}
+
+				AnyCell *reply = echoMailbox->ask(*askWorld, payload, timeoutUsecs);
+
+				if (reply == nullptr)
+				{
+					std::cerr << "mailbox/ask timed out" << std::endl;
+					exit(-1);
+				}
+
+				checksum += reinterpret_cast<std::uintptr_t>(reply);
+			}
+
+			echoMailbox->requestLifecycleAction(actor::LifecycleAction::Stop);
+			echoMailbox->waitForStop();
+
+			return checksum;
+		});
+	}
+
+	void runBenchmarks(World &world)
+	{
+		const CommandLineArguments args(commandLineArguments());
+		Harness harness(args.argc, args.argv);
+
+		addAllocationBenchmarks(harness);
+		addHashBenchmarks(world, harness);
+		addTextBenchmarks(world, harness);
+		addMailboxBenchmarks(world, harness);
+
+		exitCode = harness.run();
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	llcore_run(runBenchmarks, argc, argv);
+	return exitCode;
+}
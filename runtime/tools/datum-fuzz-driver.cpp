@@ -9,6 +9,7 @@
 #include "binding/EofObjectCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/SymbolCell.h"
 #include "binding/StringCell.h"
 #include "binding/PairCell.h"
@@ -79,6 +80,14 @@ namespace
 				return (ratio > 0.99) && (ratio < 1.01);
 			}
 		}
+		else if (auto leftRatnum = cell_cast<RatnumCell>(left))
+		{
+			if (auto rightRatnum = cell_cast<RatnumCell>(right))
+			{
+				return (leftRatnum->numerator() == rightRatnum->numerator()) &&
+					   (leftRatnum->denominator() == rightRatnum->denominator());
+			}
+		}
 		else if (auto leftSymbol = cell_cast<SymbolCell>(left))
 		{
 			if (auto rightSymbol = cell_cast<SymbolCell>(right))
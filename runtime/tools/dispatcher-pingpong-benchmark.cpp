@@ -0,0 +1,141 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "sched/Dispatcher.h"
+
+/**
+ * Measures message round trips between two simulated actors with and without home worker affinity
+ *
+ * Each actor owns a working set standing in for its heap. Every hop reads and writes the working set before
+ * dispatching the next hop to the other actor.
+ */
+namespace
+{
+	using namespace lliby;
+	using sched::Dispatcher;
+
+	const int HopCount = 50000;
+	const std::size_t WorkingSetWords = 16 * 1024;
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct PingPongActor
+	{
+		std::vector<std::uint64_t> workingSet = std::vector<std::uint64_t>(WorkingSetWords, 1);
+		Dispatcher::WorkerId homeWorker = Dispatcher::NoWorker;
+		int migrations = 0;
+	};
+
+	class PingPong
+	{
+	public:
+		PingPong(Dispatcher &dispatcher, bool useHomeWorkers) :
+			m_dispatcher(dispatcher),
+			m_useHomeWorkers(useHomeWorkers)
+		{
+		}
+
+		void run()
+		{
+			deliver(0, HopCount);
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_finishedCond.wait(lock, [=] { return m_finished; });
+		}
+
+		int migrations() const
+		{
+			return m_actors[0].migrations + m_actors[1].migrations;
+		}
+
+		std::uint64_t checksum() const
+		{
+			return m_checksum;
+		}
+
+	private:
+		void deliver(int actorIndex, int remainingHops)
+		{
+			const Dispatcher::WorkerId homeWorker = m_useHomeWorkers ? m_actors[actorIndex].homeWorker : Dispatcher::NoWorker;
+
+			m_dispatcher.dispatch([=] {
+				receive(actorIndex, remainingHops);
+			}, homeWorker);
+		}
+
+		void receive(int actorIndex, int remainingHops)
+		{
+			PingPongActor &actor(m_actors[actorIndex]);
+			const Dispatcher::WorkerId currentWorker = m_dispatcher.currentWorkerId();
+
+			if (actor.homeWorker != currentWorker)
+			{
+				actor.homeWorker = currentWorker;
+				actor.migrations++;
+			}
+
+			std::uint64_t sum = 0;
+
+			for(auto &word : actor.workingSet)
+			{
+				sum += word;
+				word = sum;
+			}
+
+			m_checksum += sum;
+
+			if (remainingHops == 0)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_finished = true;
+				m_finishedCond.notify_all();
+
+				return;
+			}
+
+			deliver(1 - actorIndex, remainingHops - 1);
+		}
+
+		Dispatcher &m_dispatcher;
+		const bool m_useHomeWorkers;
+
+		PingPongActor m_actors[2];
+		std::uint64_t m_checksum = 0;
+
+		std::mutex m_mutex;
+		std::condition_variable m_finishedCond;
+		bool m_finished = false;
+	};
+
+	void timePingPong(const char *name, bool pinWorkers, bool useHomeWorkers)
+	{
+		Dispatcher dispatcher(pinWorkers);
+		PingPong pingPong(dispatcher, useHomeWorkers);
+
+		const auto startTime = Clock::now();
+		pingPong.run();
+		const auto endTime = Clock::now();
+
+		dispatcher.waitForDrain();
+
+		const double elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+		std::cout << std::left << std::setw(40) << name
+			<< std::right << std::setw(10) << std::fixed << std::setprecision(1) << (elapsedNs / HopCount) << " ns/hop"
+			<< std::setw(10) << pingPong.migrations() << " migrations"
+			<< "  (checksum " << pingPong.checksum() << ")" << std::endl;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	timePingPong("unpinned, no home worker", false, false);
+	timePingPong("unpinned, home worker", false, true);
+	timePingPong("pinned, no home worker", true, false);
+	timePingPong("pinned, home worker", true, true);
+}
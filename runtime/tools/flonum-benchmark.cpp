@@ -0,0 +1,148 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include "flonum/shortestDecimal.h"
+#include "flonum/parseDecimal.h"
+
+/**
+ * Compares our flonum conversions against the stream and C library conversions they replaced
+ */
+namespace
+{
+	using namespace lliby;
+
+	const int ValueCount = 1000000;
+
+	typedef std::chrono::steady_clock Clock;
+
+	template<class F>
+	void timeConversion(const char *name, F conversion)
+	{
+		const auto startTime = Clock::now();
+		const std::size_t checksum = conversion();
+		const auto endTime = Clock::now();
+
+		const double elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+		std::cout << std::left << std::setw(40) << name
+			<< std::right << std::setw(10) << std::fixed << std::setprecision(1) << (elapsedNs / ValueCount) << " ns/value"
+			<< "  (checksum " << checksum << ")" << std::endl;
+	}
+
+	std::vector<double> randomDoubles()
+	{
+		std::mt19937_64 generator(0xbe4c);
+		std::vector<double> values;
+
+		while(values.size() < ValueCount)
+		{
+			std::uint64_t bits = generator();
+
+			double value;
+			memcpy(&value, &bits, sizeof(value));
+
+			if (std::isfinite(value) && (value != 0.0))
+			{
+				values.push_back(std::fabs(value));
+			}
+		}
+
+		return values;
+	}
+
+	struct DecimalString
+	{
+		std::string digits;
+		std::int64_t exponent;
+		std::string text;
+	};
+
+	std::vector<DecimalString> shortDecimals(const std::vector<double> &values)
+	{
+		std::vector<DecimalString> decimals;
+
+		for(double value : values)
+		{
+			const flonum::DecimalDigits decimal(flonum::shortestDecimal(value));
+			const std::string digits(decimal.digits, decimal.length);
+
+			decimals.push_back(DecimalString{digits, decimal.exponent, digits + "e" + std::to_string(decimal.exponent)});
+		}
+
+		return decimals;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	const std::vector<double> values(randomDoubles());
+	const std::vector<DecimalString> decimals(shortDecimals(values));
+
+	timeConversion("ostream setprecision(1024)", [&] {
+		std::size_t totalLength = 0;
+
+		for(double value : values)
+		{
+			std::ostringstream outStream;
+			outStream << std::setprecision(1024) << value;
+			totalLength += outStream.str().size();
+		}
+
+		return totalLength;
+	});
+
+	timeConversion("snprintf %.17g", [&] {
+		std::size_t totalLength = 0;
+
+		for(double value : values)
+		{
+			char buffer[32];
+			totalLength += snprintf(buffer, sizeof(buffer), "%.17g", value);
+		}
+
+		return totalLength;
+	});
+
+	timeConversion("flonum::shortestDecimal", [&] {
+		std::size_t totalLength = 0;
+
+		for(double value : values)
+		{
+			totalLength += flonum::shortestDecimal(value).length;
+		}
+
+		return totalLength;
+	});
+
+	timeConversion("strtod", [&] {
+		std::size_t checksum = 0;
+
+		for(const auto &decimal : decimals)
+		{
+			checksum += strtod(decimal.text.c_str(), nullptr) > 1.0;
+		}
+
+		return checksum;
+	});
+
+	timeConversion("flonum::parseDecimal", [&] {
+		std::size_t checksum = 0;
+
+		for(const auto &decimal : decimals)
+		{
+			checksum += flonum::parseDecimal(decimal.digits, decimal.exponent) > 1.0;
+		}
+
+		return checksum;
+	});
+
+	return 0;
+}
@@ -0,0 +1,344 @@
+#include "trace/Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "core/World.h"
+#include "sched/Dispatcher.h"
+
+namespace lliby
+{
+namespace trace
+{
+
+namespace detail
+{
+	bool tracingEnabled = false;
+}
+
+namespace
+{
+	enum class TraceFormat
+	{
+		Chrome,
+		Binary
+	};
+
+	TraceFormat traceFormat;
+	std::string traceFilename;
+
+	const char BinaryMagic[8] = {'L', 'L', 'T', 'R', 'A', 'C', 'E', '1'};
+
+	/**
+	 * Ring buffer of events recorded by a single thread
+	 *
+	 * Only the owning thread writes to the buffer so no locking is required to record an event. Buffers are returned
+	 * to a free list when their thread exits and are reused by later threads.
+	 */
+	struct ThreadBuffer
+	{
+		static const std::size_t Capacity = 16 * 1024;
+
+		std::atomic<std::uint64_t> nextEventIndex;
+		Event events[Capacity];
+	};
+
+	struct BufferRegistry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> allBuffers;
+		std::vector<ThreadBuffer*> freeBuffers;
+	};
+
+	BufferRegistry &bufferRegistry()
+	{
+		// This is intentionally leaked as detached threads can exit during static destruction
+		static auto registry = new BufferRegistry;
+		return *registry;
+	}
+
+	std::atomic<std::uint32_t> nextThreadId(1);
+
+	/**
+	 * Owns the current thread's buffer and returns it to the free list on thread exit
+	 */
+	struct ThreadBufferLease
+	{
+		~ThreadBufferLease()
+		{
+			if (buffer != nullptr)
+			{
+				BufferRegistry &registry(bufferRegistry());
+
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				registry.freeBuffers.push_back(buffer);
+			}
+		}
+
+		ThreadBuffer *buffer = nullptr;
+		std::uint32_t threadId = 0;
+	};
+
+	thread_local ThreadBufferLease threadBufferLease;
+
+	ThreadBufferLease &currentLease()
+	{
+		if (threadBufferLease.buffer == nullptr)
+		{
+			BufferRegistry &registry(bufferRegistry());
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			if (registry.freeBuffers.empty())
+			{
+				registry.allBuffers.emplace_back(new ThreadBuffer);
+				registry.allBuffers.back()->nextEventIndex.store(0, std::memory_order_relaxed);
+
+				threadBufferLease.buffer = registry.allBuffers.back().get();
+			}
+			else
+			{
+				threadBufferLease.buffer = registry.freeBuffers.back();
+				registry.freeBuffers.pop_back();
+			}
+
+			threadBufferLease.threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return threadBufferLease;
+	}
+
+	const char *eventName(EventType type)
+	{
+		switch(type)
+		{
+		case EventType::GarbageCollection:
+			return "garbage-collection";
+		case EventType::Finalization:
+			return "finalization";
+		case EventType::ActorRun:
+			return "actor-run";
+		case EventType::ActorMessage:
+			return "actor-message";
+		}
+
+		return "unknown";
+	}
+
+	void writeChromeArgs(std::ostream &out, const Event &event)
+	{
+		out << "{";
+
+		if (event.subject != 0)
+		{
+			out << "\"world\":\"0x" << std::hex << event.subject << std::dec << "\",";
+			out << "\"actor\":" << ((event.flags & Event::SubjectIsActor) ? "true" : "false") << ",";
+		}
+
+		switch(event.type)
+		{
+		case EventType::GarbageCollection:
+			out << "\"cellsAllocated\":" << event.args[0] << ",\"cellsCopied\":" << event.args[1];
+			break;
+		case EventType::Finalization:
+			out << "\"segmentsFreed\":" << event.args[0] << ",\"bytesReclaimed\":" << event.args[1];
+			break;
+		case EventType::ActorRun:
+			out << "\"messagesProcessed\":" << event.args[0];
+			break;
+		case EventType::ActorMessage:
+			out << "\"messageType\":" << event.args[0];
+			break;
+		}
+
+		out << "}";
+	}
+
+	void writeChromeTrace(std::ostream &out, const std::vector<Event> &events)
+	{
+		const pid_t pid = getpid();
+		bool first = true;
+
+		out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		out << std::fixed << std::setprecision(3);
+
+		for(const Event &event : events)
+		{
+			if (!first)
+			{
+				out << ",\n";
+			}
+
+			// Chrome trace timestamps are in microseconds
+			out << "{\"name\":\"" << eventName(event.type) << "\",\"ph\":\"X\""
+				<< ",\"ts\":" << (event.startNs / 1000.0)
+				<< ",\"dur\":" << (event.durationNs / 1000.0)
+				<< ",\"pid\":" << pid
+				<< ",\"tid\":" << event.threadId
+				<< ",\"args\":";
+
+			writeChromeArgs(out, event);
+			out << "}";
+
+			first = false;
+		}
+
+		out << "\n]}\n";
+	}
+
+	void writeBinaryTrace(std::ostream &out, const std::vector<Event> &events)
+	{
+		const std::uint32_t eventSize = sizeof(Event);
+
+		out.write(BinaryMagic, sizeof(BinaryMagic));
+		out.write(reinterpret_cast<const char*>(&eventSize), sizeof(eventSize));
+
+		out.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(Event));
+	}
+
+	void writeTraceAtExit()
+	{
+		sched::Dispatcher &dispatcher(sched::Dispatcher::defaultInstance());
+
+		// Let any background finalization finish so it's included in the trace. We can't wait for ourselves if exit()
+		// was called from a worker.
+		if (dispatcher.currentWorkerId() == sched::Dispatcher::NoWorker)
+		{
+			dispatcher.waitForDrain();
+		}
+
+		writeTraceIfEnabled();
+	}
+}
+
+Subject Subject::forWorld(World *world)
+{
+	if (world == nullptr)
+	{
+		return Subject{0, 0};
+	}
+
+	const std::uint16_t flags = world->actorContext() ? Event::SubjectIsActor : 0;
+	return Subject{reinterpret_cast<std::uintptr_t>(world), flags};
+}
+
+std::uint64_t timestampNs()
+{
+	using namespace std::chrono;
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void record(EventType type, std::uint64_t startNs, std::uint64_t durationNs, Subject subject, std::uint64_t arg0, std::uint64_t arg1)
+{
+	ThreadBufferLease &lease(currentLease());
+	ThreadBuffer *buffer = lease.buffer;
+
+	const std::uint64_t eventIndex = buffer->nextEventIndex.load(std::memory_order_relaxed);
+	Event &event(buffer->events[eventIndex % ThreadBuffer::Capacity]);
+
+	event.startNs = startNs;
+	event.durationNs = durationNs;
+	event.subject = subject.world;
+	event.args[0] = arg0;
+	event.args[1] = arg1;
+	event.threadId = lease.threadId;
+	event.flags = subject.flags;
+	event.type = type;
+
+	// Publish the event to writeTraceIfEnabled()
+	buffer->nextEventIndex.store(eventIndex + 1, std::memory_order_release);
+}
+
+void initTracing()
+{
+	const char *formatName = getenv("LLAMBDA_TRACE");
+
+	if (formatName == nullptr)
+	{
+		return;
+	}
+	else if (!strcmp(formatName, "chrome"))
+	{
+		traceFormat = TraceFormat::Chrome;
+		traceFilename = "llambda-trace.json";
+	}
+	else if (!strcmp(formatName, "binary"))
+	{
+		traceFormat = TraceFormat::Binary;
+		traceFilename = "llambda-trace.bin";
+	}
+	else
+	{
+		std::cerr << "Unknown LLAMBDA_TRACE format \"" << formatName << "\"; expected \"chrome\" or \"binary\"" << std::endl;
+		return;
+	}
+
+	if (const char *filename = getenv("LLAMBDA_TRACE_FILE"))
+	{
+		traceFilename = filename;
+	}
+
+	if (!detail::tracingEnabled)
+	{
+		// Write from exit() so programs that call (exit) or die from an unhandled exception are covered
+		atexit(writeTraceAtExit);
+	}
+
+	detail::tracingEnabled = true;
+}
+
+void writeTraceIfEnabled()
+{
+	if (!enabled())
+	{
+		return;
+	}
+
+	std::vector<Event> events;
+
+	{
+		BufferRegistry &registry(bufferRegistry());
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		for(auto &buffer : registry.allBuffers)
+		{
+			const std::uint64_t endIndex = buffer->nextEventIndex.load(std::memory_order_acquire);
+			const std::uint64_t startIndex = (endIndex > ThreadBuffer::Capacity) ? (endIndex - ThreadBuffer::Capacity) : 0;
+
+			for(std::uint64_t i = startIndex; i < endIndex; i++)
+			{
+				events.push_back(buffer->events[i % ThreadBuffer::Capacity]);
+			}
+		}
+	}
+
+	std::ofstream traceFile(traceFilename, std::ios::out | std::ios::trunc | std::ios::binary);
+
+	if (!traceFile)
+	{
+		std::cerr << "Unable to open trace file \"" << traceFilename << "\"" << std::endl;
+		return;
+	}
+
+	if (traceFormat == TraceFormat::Chrome)
+	{
+		writeChromeTrace(traceFile, events);
+	}
+	else
+	{
+		writeBinaryTrace(traceFile, events);
+	}
+}
+
+}
+}
@@ -0,0 +1,173 @@
+#ifndef _LLIBY_TRACE_TRACE_H
+#define _LLIBY_TRACE_TRACE_H
+
+#include <cstdint>
+
+namespace lliby
+{
+class World;
+
+namespace trace
+{
+
+enum class EventType : std::uint8_t
+{
+	/**
+	 * Garbage collection of a world's heap
+	 *
+	 * The first argument is the number of cells allocated since the last collection and the second is the number of
+	 * reachable cells copied in to the new heap
+	 */
+	GarbageCollection,
+
+	/**
+	 * Finalization of a collected heap
+	 *
+	 * The first argument is the number of segments freed and the second is the number of bytes reclaimed
+	 */
+	Finalization,
+
+	/**
+	 * Actor running on a thread from being woken until it goes to sleep or stops
+	 *
+	 * The first argument is the number of messages processed
+	 */
+	ActorRun,
+
+	/**
+	 * Actor processing a single message
+	 *
+	 * The first argument is the actor::Message::Type of the message
+	 */
+	ActorMessage
+};
+
+/**
+ * Trace event as stored in the ring buffers and written to binary traces
+ */
+struct Event
+{
+	static const std::uint16_t SubjectIsActor = 1 << 0;
+
+	std::uint64_t startNs;
+	std::uint64_t durationNs;
+	std::uint64_t subject;
+	std::uint64_t args[2];
+	std::uint32_t threadId;
+	std::uint16_t flags;
+	EventType type;
+};
+
+/**
+ * World an event relates to
+ *
+ * This is captured when the event starts as the world may be destroyed before the event is recorded
+ */
+struct Subject
+{
+	static Subject forWorld(World *world);
+
+	std::uint64_t world;
+	std::uint16_t flags;
+};
+
+namespace detail
+{
+	extern bool tracingEnabled;
+}
+
+/**
+ * Returns true if tracing has been enabled by initTracing()
+ *
+ * This is intended to be checked before doing any work to prepare a trace event
+ */
+inline bool enabled()
+{
+	return detail::tracingEnabled;
+}
+
+/**
+ * Returns the current trace timestamp in nanoseconds
+ */
+std::uint64_t timestampNs();
+
+/**
+ * Records an event in the current thread's ring buffer
+ *
+ * If the ring buffer is full the oldest event is overwritten. This must only be called if tracing is enabled.
+ *
+ * @param  type        Type of the event
+ * @param  startNs     Start timestamp as returned by timestampNs()
+ * @param  durationNs  Duration of the event in nanoseconds
+ * @param  subject     World triggering the event
+ * @param  arg0        First event argument
+ * @param  arg1        Second event argument
+ */
+void record(EventType type, std::uint64_t startNs, std::uint64_t durationNs, Subject subject, std::uint64_t arg0 = 0, std::uint64_t arg1 = 0);
+
+/**
+ * Records an event spanning the lifetime of the Span instance
+ *
+ * This does nothing if tracing is disabled
+ */
+class Span
+{
+public:
+	Span(EventType type, Subject subject) :
+		m_type(type),
+		m_subject(subject),
+		m_startNs(enabled() ? timestampNs() : 0)
+	{
+	}
+
+	Span(EventType type, World *world) :
+		Span(type, enabled() ? Subject::forWorld(world) : Subject{0, 0})
+	{
+	}
+
+	~Span()
+	{
+		if (enabled())
+		{
+			record(m_type, m_startNs, timestampNs() - m_startNs, m_subject, m_args[0], m_args[1]);
+		}
+	}
+
+	Span(const Span &) = delete;
+	Span& operator=(const Span &) = delete;
+
+	void setArgs(std::uint64_t arg0, std::uint64_t arg1 = 0)
+	{
+		m_args[0] = arg0;
+		m_args[1] = arg1;
+	}
+
+private:
+	EventType m_type;
+	Subject m_subject;
+	std::uint64_t m_startNs;
+	std::uint64_t m_args[2] = {0, 0};
+};
+
+/**
+ * Configures tracing from the environment
+ *
+ * If LLAMBDA_TRACE is set to "chrome" or "binary" tracing is enabled and the trace is written in that format at exit.
+ * The trace is written to LLAMBDA_TRACE_FILE if set or "llambda-trace.json" or "llambda-trace.bin" otherwise.
+ *
+ * The trace is written by an atexit() handler after waiting for the default dispatcher to drain. This includes programs
+ * that call exit() directly.
+ */
+void initTracing();
+
+/**
+ * Writes the buffered trace events if tracing has been enabled
+ *
+ * Threads still recording events should be stopped before this is called.
+ */
+void writeTraceIfEnabled();
+
+}
+}
+
+#endif
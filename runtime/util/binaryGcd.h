@@ -0,0 +1,49 @@
+#ifndef _LLIBY_UTIL_BINARYGCD_H
+#define _LLIBY_UTIL_BINARYGCD_H
+
+#include <cstdint>
+#include <utility>
+
+namespace lliby
+{
+
+/**
+ * Calculates the greatest common divisor of two unsigned integers using Stein's algorithm
+ *
+ * This replaces division with shifts and subtraction which are considerably cheaper than the divisions required by
+ * Euclid's algorithm. The GCD of zero and zero is zero.
+ */
+inline std::uint64_t binaryGcd(std::uint64_t a, std::uint64_t b)
+{
+	if (a == 0)
+	{
+		return b;
+	}
+	else if (b == 0)
+	{
+		return a;
+	}
+
+	// Factor out the common powers of two
+	const int commonShift = __builtin_ctzll(a | b);
+	a >>= __builtin_ctzll(a);
+
+	do
+	{
+		b >>= __builtin_ctzll(b);
+
+		if (a > b)
+		{
+			std::swap(a, b);
+		}
+
+		b -= a;
+	}
+	while(b != 0);
+
+	return a << commonShift;
+}
+
+}
+
+#endif
@@ -14,6 +14,10 @@ public:
 	{
 	}
 
+	DisplayDatumWriter()
+	{
+	}
+
 protected:
 	virtual void renderStringLike(const std::uint8_t *utf8Data, std::uint32_t byteLength, std::uint8_t quoteChar, bool needsQuotes) override;
 	virtual void renderCharacter(const CharCell *value) override;
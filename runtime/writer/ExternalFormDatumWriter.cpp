@@ -2,7 +2,6 @@
 
 #include <cassert>
 #include <strings.h>
-#include <iomanip>
 #include <cmath>
 
 #include "binding/AnyCell.h"
@@ -10,6 +9,7 @@
 #include "binding/BooleanCell.h"
 #include "binding/IntegerCell.h"
 #include "binding/FlonumCell.h"
+#include "binding/RatnumCell.h"
 #include "binding/SymbolCell.h"
 #include "binding/StringCell.h"
 #include "binding/PairCell.h"
@@ -27,6 +27,8 @@
 
 #include "dynamic/ParameterProcedureCell.h"
 
+#include "writer/NumberFormat.h"
+
 namespace
 {
 	bool stringLikeByteIsDirectlyPrintable(std::uint8_t byteValue)
@@ -175,6 +177,14 @@ namespace lliby
 {
 
 void ExternalFormDatumWriter::render(const AnyCell *datum, int defaultRadix)
+{
+	renderDatum(datum, defaultRadix);
+
+	// Hand our output to the stream in a single block
+	m_output.flush();
+}
+
+void ExternalFormDatumWriter::renderDatum(const AnyCell *datum, int defaultRadix)
 {
 	if (auto value = cell_cast<UnitCell>(datum))
 	{
@@ -196,6 +206,10 @@ void ExternalFormDatumWriter::render(const AnyCell *datum, int defaultRadix)
 	{
 		renderFlonum(value);
 	}
+	else if (auto value = cell_cast<RatnumCell>(datum))
+	{
+		renderRatnum(value, defaultRadix);
+	}
 	else if (auto value = cell_cast<SymbolCell>(datum))
 	{
 		renderStringLike(value->constUtf8Data(), value->byteLength(), static_cast<std::uint8_t>('|'), false);
@@ -256,130 +270,39 @@ void ExternalFormDatumWriter::render(const AnyCell *datum, int defaultRadix)
 
 void ExternalFormDatumWriter::renderUnit(const UnitCell *)
 {
-	m_outStream << "#!unit";
+	m_output.append("#!unit");
 }
 
 void ExternalFormDatumWriter::renderEmptyList(const EmptyListCell *)
 {
-	m_outStream << "()";
+	m_output.append("()");
 }
 
 void ExternalFormDatumWriter::renderBoolean(const BooleanCell *value)
 {
 	if (value->value())
 	{
-		m_outStream << "#t";
+		m_output.append("#t");
 	}
 	else
 	{
-		m_outStream << "#f";
+		m_output.append("#f");
 	}
 }
 
 void ExternalFormDatumWriter::renderInteger(const IntegerCell *value, int defaultRadix)
 {
-	// Non-decimal bases don't work with negative numbers
-	const std::int64_t signedNumber = value->value();
-	bool negative = (signedNumber < 0);
-	std::uint64_t absoluteNumber = negative ? -signedNumber : signedNumber;
-
-	switch(defaultRadix)
-	{
-	case 2:
-		{
-			// Space for 64bit + #b + sign + NULL terminator
-			char outputBuffer[68];
-			char *outPtr = &outputBuffer[sizeof(outputBuffer)];
-
-			*(--outPtr) = 0;
-
-			if (absoluteNumber == 0)
-			{
-				// Need at least one number
-				*(--outPtr) = '0';
-			}
-			else
-			{
-				while(absoluteNumber)
-				{
-					*(--outPtr) = (absoluteNumber & 0x1) ? '1' : '0';
-					absoluteNumber = absoluteNumber >> 1;
-				}
-
-				if (negative)
-				{
-					*(--outPtr) = '-';
-				}
-			}
-
-			*(--outPtr) = 'b';
-			*(--outPtr) = '#';
-
-			m_outStream << outPtr;
-		}
-		break;
-
-	case 8:
-		m_outStream << "#o";
-
-		if (negative)
-		{
-			m_outStream << "-";
-		}
-
-		m_outStream << std::oct << absoluteNumber;
-		break;
-	case 16:
-		m_outStream << "#x";
-
-		if (negative)
-		{
-			m_outStream << "-";
-		}
-
-		m_outStream << std::hex << absoluteNumber;
-		break;
-	default:
-		if (negative)
-		{
-			m_outStream << "-";
-		}
-
-		m_outStream << std::dec << absoluteNumber;
-		break;
-	}
+	m_output.append(NumberFormat::forInteger(value->value(), defaultRadix));
 }
 
 void ExternalFormDatumWriter::renderFlonum(const FlonumCell *value)
 {
-	const double number = value->value();
-
-	if (std::isnan(number))
-	{
-		m_outStream << "+nan.0";
-	}
-	else if (std::isinf(number))
-	{
-		if (number < 0.0)
-		{
-			m_outStream << "-inf.0";
-		}
-		else
-		{
-			m_outStream << "+inf.0";
-		}
-	}
-	else
-	{
-		m_outStream << std::setprecision(1024) << number;
+	m_output.append(NumberFormat::forFlonum(value->value()));
+}
 
-		double unused;
-		if (std::modf(number, &unused) == 0.0)
-		{
-			// Add on ".0" to indicate a flonum
-			m_outStream << ".0";
-		}
-	}
+void ExternalFormDatumWriter::renderRatnum(const RatnumCell *value, int defaultRadix)
+{
+	m_output.append(NumberFormat::forRatnum(value->numerator(), value->denominator(), defaultRadix));
 }
 
 void ExternalFormDatumWriter::renderStringLike(const std::uint8_t *utf8Data, std::uint32_t byteLength, std::uint8_t quoteChar, bool needsQuotes)
@@ -392,11 +315,11 @@ void ExternalFormDatumWriter::renderStringLike(const std::uint8_t *utf8Data, std
 	if (!needsQuotes)
 	{
 		// We can print this directly without any transformation
-		m_outStream.write(reinterpret_cast<const char *>(utf8Data), byteLength);
+		m_output.append(utf8Data, byteLength);
 		return;
 	}
 
-	m_outStream << static_cast<char>(quoteChar);
+	m_output.append(static_cast<char>(quoteChar));
 
 	for(std::uint32_t i = 0; i < byteLength; i++)
 	{
@@ -404,31 +327,34 @@ void ExternalFormDatumWriter::renderStringLike(const std::uint8_t *utf8Data, std
 
 		if (byteValue == quoteChar)
 		{
-			m_outStream << "\\" << static_cast<char>(byteValue);
+			m_output.append('\\');
+			m_output.append(static_cast<char>(byteValue));
 		}
 		else if (stringLikeByteIsDirectlyPrintable(byteValue))
 		{
-			m_outStream << static_cast<char>(byteValue);
+			m_output.append(static_cast<char>(byteValue));
 		}
 		else
 		{
 			switch(byteValue)
 			{
-			case 0x07: m_outStream << "\\a";  break;
-			case 0x08: m_outStream << "\\b";  break;
-			case 0x09: m_outStream << "\\t";  break;
-			case 0x0a: m_outStream << "\\n";  break;
-			case 0x0d: m_outStream << "\\r";  break;
-			case 0x20: m_outStream << " ";    break;
-			case 0x5c: m_outStream << "\\\\"; break;
-			case 0x22: m_outStream << "\"";   break;
+			case 0x07: m_output.append("\\a");  break;
+			case 0x08: m_output.append("\\b");  break;
+			case 0x09: m_output.append("\\t");  break;
+			case 0x0a: m_output.append("\\n");  break;
+			case 0x0d: m_output.append("\\r");  break;
+			case 0x20: m_output.append(" ");    break;
+			case 0x5c: m_output.append("\\\\"); break;
+			case 0x22: m_output.append('"');   break;
 			default:
-				m_outStream << "\\x" << std::hex << static_cast<int>(byteValue) << ";";
+				m_output.append("\\x", 2);
+				m_output.appendUnsigned(byteValue, 16);
+				m_output.append(';');
 			}
 		}
 	}
 
-	m_outStream << static_cast<char>(quoteChar);
+	m_output.append(static_cast<char>(quoteChar));
 }
 
 void ExternalFormDatumWriter::renderPair(const PairCell *value, bool inList)
@@ -436,18 +362,18 @@ void ExternalFormDatumWriter::renderPair(const PairCell *value, bool inList)
 renderPairEntry:
 	if (!inList)
 	{
-		m_outStream << '(';
+		m_output.append('(');
 	}
 
-	render(value->car());
+	renderDatum(value->car());
 
 	if (EmptyListCell::isInstance(value->cdr()))
 	{
-		m_outStream << ')';
+		m_output.append(')');
 	}
 	else if (auto rest = cell_cast<PairCell>(value->cdr()))
 	{
-		m_outStream << ' ';
+		m_output.append(' ');
 
 		// Force tail recursion here for the cdr so we can render deep lists
 		value = rest;
@@ -456,52 +382,52 @@ renderPairEntry:
 	}
 	else
 	{
-		m_outStream << " . ";
-		render(value->cdr());
-		m_outStream << ')';
+		m_output.append(" . ");
+		renderDatum(value->cdr());
+		m_output.append(')');
 	}
 }
 	
 void ExternalFormDatumWriter::renderBytevector(const BytevectorCell *value)
 {
 	bool printedByte = false;
-	m_outStream << "#u8(";
+	m_output.append("#u8(");
 
 	for(BytevectorCell::LengthType i = 0; i < value->length(); i++)
 	{
 		if (printedByte)
 		{
 			// Pad with a space
-			m_outStream << " ";
+			m_output.append(' ');
 		}
 
-		m_outStream << std::dec << value->byteAt(i);
+		m_output.appendUnsigned(value->byteAt(i));
 
 		printedByte = true;
 	}
 
-	m_outStream << ")";
+	m_output.append(')');
 }
 
 void ExternalFormDatumWriter::renderVector(const VectorCell *value)
 {
 	bool printedElement = false;
-	m_outStream << "#(";
+	m_output.append("#(");
 
 	for(VectorCell::LengthType i = 0; i < value->length(); i++)
 	{
 		if (printedElement)
 		{
 			// Pad with a space
-			m_outStream << " ";
+			m_output.append(' ');
 		}
 
-		render(value->elementAt(i));
+		renderDatum(value->elementAt(i));
 
 		printedElement = true;
 	}
 
-	m_outStream << ")";
+	m_output.append(')');
 }
 
 void ExternalFormDatumWriter::renderProcedure(const ProcedureCell *proc)
@@ -510,16 +436,24 @@ void ExternalFormDatumWriter::renderProcedure(const ProcedureCell *proc)
 	{
 		if (dynamic::ParameterProcedureCell::isInstance(proc))
 		{
-			m_outStream << "#!procedure(parameter:" << proc << ")";
+			m_output.append("#!procedure(parameter:");
+			m_output.appendPointer(proc);
+			m_output.append(')');
 		}
 		else
 		{
-			m_outStream << "#!procedure(closure:" << proc << "/" << reinterpret_cast<void*>(proc->entryPoint()) << ")";
+			m_output.append("#!procedure(closure:");
+			m_output.appendPointer(proc);
+			m_output.append('/');
+			m_output.appendPointer(reinterpret_cast<void*>(proc->entryPoint()));
+			m_output.append(')');
 		}
 	}
 	else
 	{
-		m_outStream << "#!procedure(emptyclosure/" << reinterpret_cast<void*>(proc->entryPoint()) << ")";
+		m_output.append("#!procedure(emptyclosure/");
+		m_output.appendPointer(reinterpret_cast<void*>(proc->entryPoint()));
+		m_output.append(')');
 	}
 
 }
@@ -530,23 +464,25 @@ void ExternalFormDatumWriter::renderCharacter(const CharCell *value)
 
 	if ((codePoint >= 0x21) && (codePoint <= 0x7e))
 	{
-		m_outStream << "#\\" << static_cast<char>(codePoint);
+		m_output.append("#\\", 2);
+		m_output.append(static_cast<char>(codePoint));
 	}
 	else
 	{
 		switch(codePoint)
 		{
-		case 0x07: m_outStream << "#\\alarm";     break;
-		case 0x08: m_outStream << "#\\backspace"; break;
-		case 0x7f: m_outStream << "#\\delete";    break;
-		case 0x1b: m_outStream << "#\\escape";    break;
-		case 0x0a: m_outStream << "#\\newline";   break;
-		case 0x00: m_outStream << "#\\null";      break;
-		case 0x0d: m_outStream << "#\\return";    break;
-		case 0x20: m_outStream << "#\\space";     break;
-		case 0x09: m_outStream << "#\\tab";       break;
+		case 0x07: m_output.append("#\\alarm");     break;
+		case 0x08: m_output.append("#\\backspace"); break;
+		case 0x7f: m_output.append("#\\delete");    break;
+		case 0x1b: m_output.append("#\\escape");    break;
+		case 0x0a: m_output.append("#\\newline");   break;
+		case 0x00: m_output.append("#\\null");      break;
+		case 0x0d: m_output.append("#\\return");    break;
+		case 0x20: m_output.append("#\\space");     break;
+		case 0x09: m_output.append("#\\tab");       break;
 		default:
-			m_outStream << "#\\x" << std::hex << codePoint;
+			m_output.append("#\\x", 3);
+			m_output.appendUnsigned(codePoint, 16);
 		}
 	}
 
@@ -555,39 +491,42 @@ void ExternalFormDatumWriter::renderCharacter(const CharCell *value)
 void ExternalFormDatumWriter::renderRecord(const RecordCell *)
 {
 	// XXX: Can codegen give us enough type information to render record contents?
-	m_outStream << "#!record";
+	m_output.append("#!record");
 }
 
 void ExternalFormDatumWriter::renderErrorObject(const ErrorObjectCell *errObj)
 {
-	m_outStream << "#!error(";
+	m_output.append("#!error(");
 
 	if (errObj->category() != ErrorCategory::Default)
 	{
-		m_outStream << schemeNameForErrorCategory(errObj->category()) << "/";
+		m_output.append(schemeNameForErrorCategory(errObj->category()));
+		m_output.append('/');
 	}
 
-	m_outStream << errObj->message() << ")";
+	const StringCell *message = errObj->message();
+	m_output.append(message->constUtf8Data(), message->byteLength());
+	m_output.append(')');
 }
 
 void ExternalFormDatumWriter::renderPort(const PortCell *value)
 {
-	m_outStream << "#!port";
+	m_output.append("#!port");
 }
 
 void ExternalFormDatumWriter::renderEofObject(const EofObjectCell *value)
 {
-	m_outStream << "#!eof";
+	m_output.append("#!eof");
 }
 
 void ExternalFormDatumWriter::renderMailbox(const MailboxCell *value)
 {
-	m_outStream << "#!mailbox";
+	m_output.append("#!mailbox");
 }
 
 void ExternalFormDatumWriter::renderHashMap(const HashMapCell *value)
 {
-	m_outStream << "#!hash-map";
+	m_output.append("#!hash-map");
 }
 
 }
@@ -4,6 +4,7 @@
 #include <ostream>
 
 #include "DatumWriter.h"
+#include "OutputBuffer.h"
 
 namespace lliby
 {
@@ -11,19 +12,50 @@ namespace lliby
 class ExternalFormDatumWriter : public DatumWriter
 {
 public:
+	/**
+	 * Creates a writer rendering to the passed stream
+	 *
+	 * Output is buffered internally and written to the stream at the end of each call to render()
+	 */
 	explicit ExternalFormDatumWriter(std::ostream &outStream) :
-		m_outStream(outStream)
+		m_output(&outStream)
+	{
+	}
+
+	/**
+	 * Creates a writer rendering in to memory
+	 *
+	 * The rendered output can be retrieved with output()
+	 */
+	ExternalFormDatumWriter() :
+		m_output(nullptr)
 	{
 	}
 
 	virtual void render(const AnyCell *datum, int defaultRadix = 10);
 
+	/**
+	 * Returns the buffered output for writers rendering in to memory
+	 */
+	const OutputBuffer& output() const
+	{
+		return m_output;
+	}
+
 protected:
+	/**
+	 * Renders a datum without flushing the output buffer
+	 *
+	 * This should be used when rendering datums nested inside another datum
+	 */
+	void renderDatum(const AnyCell *datum, int defaultRadix = 10);
+
 	virtual void renderUnit(const UnitCell *value);
 	virtual void renderEmptyList(const EmptyListCell *value);
 	virtual void renderBoolean(const BooleanCell *value);
 	virtual void renderInteger(const IntegerCell *value, int defaultRadix = 10);
 	virtual void renderFlonum(const FlonumCell *value);
+	virtual void renderRatnum(const RatnumCell *value, int defaultRadix = 10);
 	virtual void renderStringLike(const std::uint8_t *utf8Data, std::uint32_t byteLength, std::uint8_t quoteChar, bool needsQuotes);
 	virtual void renderPair(const PairCell *value, bool inList = false);
 	virtual void renderBytevector(const BytevectorCell *value);
@@ -37,7 +69,7 @@ protected:
 	virtual void renderMailbox(const MailboxCell *value);
 	virtual void renderHashMap(const HashMapCell *value);
 
-	std::ostream &m_outStream;
+	OutputBuffer m_output;
 };
 
 }
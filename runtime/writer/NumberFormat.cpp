@@ -0,0 +1,376 @@
+#include "NumberFormat.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace lliby
+{
+
+namespace
+{
+	/**
+	 * Largest number of integral digits to render a flonum with before switching to scientific notation
+	 */
+	const int MaximumFixedPointDigits = 21;
+
+	/**
+	 * Largest number of zeros after the decimal point to render a flonum with before switching to scientific notation
+	 */
+	const int MaximumLeadingFractionZeros = 6;
+
+	// Pairs of decimal digits for 00 through 99
+	const char DecimalDigitPairs[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	const char HexDigits[] = "0123456789abcdef";
+
+	std::size_t signedDigitCount(std::int64_t value)
+	{
+		if (value < 0)
+		{
+			// Negate as unsigned so INT64_MIN doesn't overflow
+			return 1 + NumberFormat::unsignedDigitCount(-static_cast<std::uint64_t>(value));
+		}
+
+		return NumberFormat::unsignedDigitCount(value);
+	}
+
+	char *writeSigned(char *output, std::int64_t value)
+	{
+		std::uint64_t absoluteValue = value;
+
+		if (value < 0)
+		{
+			*(output++) = '-';
+			absoluteValue = -static_cast<std::uint64_t>(value);
+		}
+
+		const std::size_t digitCount = NumberFormat::unsignedDigitCount(absoluteValue);
+		NumberFormat::writeUnsignedDigits(output, digitCount, absoluteValue);
+
+		return output + digitCount;
+	}
+
+	char *writeChars(char *output, const char *data, std::size_t length)
+	{
+		memcpy(output, data, length);
+		return output + length;
+	}
+
+	char *writeZeros(char *output, int count)
+	{
+		for(int i = 0; i < count; i++)
+		{
+			*(output++) = '0';
+		}
+
+		return output;
+	}
+}
+
+std::size_t NumberFormat::unsignedDigitCount(std::uint64_t value, int radix)
+{
+	if (value == 0)
+	{
+		return 1;
+	}
+
+	if (radix != 10)
+	{
+		const int bitsPerDigit = (radix == 2) ? 1 : ((radix == 8) ? 3 : 4);
+		const int significantBits = 64 - __builtin_clzll(value);
+
+		return (significantBits + bitsPerDigit - 1) / bitsPerDigit;
+	}
+
+	std::size_t digitCount = 1;
+
+	// Count four digits per division
+	while(value >= 10000)
+	{
+		value /= 10000;
+		digitCount += 4;
+	}
+
+	if (value >= 1000)
+	{
+		return digitCount + 3;
+	}
+	else if (value >= 100)
+	{
+		return digitCount + 2;
+	}
+	else if (value >= 10)
+	{
+		return digitCount + 1;
+	}
+
+	return digitCount;
+}
+
+void NumberFormat::writeUnsignedDigits(char *output, std::size_t digitCount, std::uint64_t value, int radix)
+{
+	// Write backwards from the least significant digit
+	char *digitPtr = output + digitCount;
+
+	switch(radix)
+	{
+	case 2:
+		do
+		{
+			*(--digitPtr) = '0' + (value & 0x1);
+			value >>= 1;
+		}
+		while(value);
+		break;
+
+	case 8:
+		do
+		{
+			*(--digitPtr) = '0' + (value & 0x7);
+			value >>= 3;
+		}
+		while(value);
+		break;
+
+	case 16:
+		do
+		{
+			*(--digitPtr) = HexDigits[value & 0xf];
+			value >>= 4;
+		}
+		while(value);
+		break;
+
+	default:
+		assert(radix == 10);
+
+		// Produce two digits per division
+		while(value >= 100)
+		{
+			const std::size_t pairIndex = (value % 100) * 2;
+			value /= 100;
+
+			*(--digitPtr) = DecimalDigitPairs[pairIndex + 1];
+			*(--digitPtr) = DecimalDigitPairs[pairIndex];
+		}
+
+		if (value >= 10)
+		{
+			const std::size_t pairIndex = value * 2;
+
+			*(--digitPtr) = DecimalDigitPairs[pairIndex + 1];
+			*(--digitPtr) = DecimalDigitPairs[pairIndex];
+		}
+		else
+		{
+			*(--digitPtr) = '0' + value;
+		}
+	}
+
+	assert(digitPtr == output);
+}
+
+NumberFormat NumberFormat::forInteger(std::int64_t value, int radix)
+{
+	NumberFormat format;
+
+	if ((radix != 2) && (radix != 8) && (radix != 16))
+	{
+		radix = 10;
+	}
+
+	format.m_layout = Layout::Integer;
+	format.m_negative = (value < 0);
+	format.m_absoluteValue = format.m_negative ? -static_cast<std::uint64_t>(value) : value;
+	format.m_radix = radix;
+	format.m_digitCount = unsignedDigitCount(format.m_absoluteValue, radix);
+
+	const std::size_t prefixLength = (radix == 10) ? 0 : 2;
+	format.m_length = prefixLength + format.m_negative + format.m_digitCount;
+
+	return format;
+}
+
+NumberFormat NumberFormat::forRatnum(std::int64_t numerator, std::int64_t denominator, int radix)
+{
+	NumberFormat format(forInteger(numerator, radix));
+
+	format.m_layout = Layout::Ratio;
+	format.m_denominator = denominator;
+	format.m_denominatorDigitCount = unsignedDigitCount(format.m_denominator, format.m_radix);
+
+	// Separating slash followed by the denominator
+	format.m_length += 1 + format.m_denominatorDigitCount;
+
+	return format;
+}
+
+NumberFormat NumberFormat::forFlonum(double value)
+{
+	NumberFormat format;
+	format.m_negative = std::signbit(value);
+
+	if (std::isnan(value) || std::isinf(value) || (value == 0.0))
+	{
+		format.m_layout = Layout::Literal;
+
+		if (std::isnan(value))
+		{
+			format.m_literal = "+nan.0";
+		}
+		else if (std::isinf(value))
+		{
+			format.m_literal = format.m_negative ? "-inf.0" : "+inf.0";
+		}
+		else
+		{
+			format.m_literal = format.m_negative ? "-0.0" : "0.0";
+		}
+
+		format.m_length = strlen(format.m_literal);
+		return format;
+	}
+
+	format.m_decimal = flonum::shortestDecimal(std::fabs(value));
+
+	const int length = format.m_decimal.length;
+
+	// Position of the decimal point relative to the start of our digits
+	const int pointPosition = length + format.m_decimal.exponent;
+	format.m_pointPosition = pointPosition;
+
+	std::size_t unsignedLength;
+
+	if ((pointPosition > 0) && (pointPosition <= MaximumFixedPointDigits))
+	{
+		format.m_layout = Layout::FixedPoint;
+
+		if (pointPosition >= length)
+		{
+			// Integral value padded with zeros and suffixed with ".0" to indicate a flonum
+			unsignedLength = pointPosition + 2;
+		}
+		else
+		{
+			unsignedLength = length + 1;
+		}
+	}
+	else if ((pointPosition <= 0) && (pointPosition > -MaximumLeadingFractionZeros))
+	{
+		format.m_layout = Layout::LeadingZeros;
+		unsignedLength = 2 - pointPosition + length;
+	}
+	else
+	{
+		format.m_layout = Layout::Scientific;
+
+		// Leading digit, optional fraction and exponent
+		unsignedLength = 1 + ((length > 1) ? length : 0) + 1 + signedDigitCount(pointPosition - 1);
+	}
+
+	format.m_length = format.m_negative + unsignedLength;
+	return format;
+}
+
+void NumberFormat::write(char *output) const
+{
+	char *const outputEnd = output + m_length;
+
+	if (m_layout == Layout::Literal)
+	{
+		memcpy(output, m_literal, m_length);
+		return;
+	}
+	else if ((m_layout == Layout::Integer) || (m_layout == Layout::Ratio))
+	{
+		switch(m_radix)
+		{
+		case 2:
+			output = writeChars(output, "#b", 2);
+			break;
+		case 8:
+			output = writeChars(output, "#o", 2);
+			break;
+		case 16:
+			output = writeChars(output, "#x", 2);
+			break;
+		}
+
+		if (m_negative)
+		{
+			*(output++) = '-';
+		}
+
+		writeUnsignedDigits(output, m_digitCount, m_absoluteValue, m_radix);
+
+		if (m_layout == Layout::Ratio)
+		{
+			output += m_digitCount;
+			*(output++) = '/';
+			writeUnsignedDigits(output, m_denominatorDigitCount, m_denominator, m_radix);
+		}
+
+		return;
+	}
+
+	if (m_negative)
+	{
+		*(output++) = '-';
+	}
+
+	const char *digits = m_decimal.digits;
+	const int length = m_decimal.length;
+
+	switch(m_layout)
+	{
+	case Layout::FixedPoint:
+		if (m_pointPosition >= length)
+		{
+			output = writeChars(output, digits, length);
+			output = writeZeros(output, m_pointPosition - length);
+			output = writeChars(output, ".0", 2);
+		}
+		else
+		{
+			output = writeChars(output, digits, m_pointPosition);
+			*(output++) = '.';
+			output = writeChars(output, &digits[m_pointPosition], length - m_pointPosition);
+		}
+		break;
+
+	case Layout::LeadingZeros:
+		output = writeChars(output, "0.", 2);
+		output = writeZeros(output, -m_pointPosition);
+		output = writeChars(output, digits, length);
+		break;
+
+	default:
+		*(output++) = digits[0];
+
+		if (length > 1)
+		{
+			*(output++) = '.';
+			output = writeChars(output, &digits[1], length - 1);
+		}
+
+		*(output++) = 'e';
+		output = writeSigned(output, m_pointPosition - 1);
+		break;
+	}
+
+	assert(output == outputEnd);
+	(void)outputEnd;
+}
+
+}
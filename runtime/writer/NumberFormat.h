@@ -0,0 +1,113 @@
+#ifndef _LLIBY_WRITER_NUMBERFORMAT_H
+#define _LLIBY_WRITER_NUMBERFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flonum/shortestDecimal.h"
+
+namespace lliby
+{
+
+/**
+ * Number formatted in external form
+ *
+ * The length of the output is calculated when the format is created. This allows the number to be written directly
+ * in to its final storage without an intermediate buffer.
+ */
+class NumberFormat
+{
+public:
+	/**
+	 * Formats an integer
+	 *
+	 * @param  value  Integer to format
+	 * @param  radix  Radix to format the value in. Non-decimal values are prefixed with #b, #o or #x. Unsupported
+	 *                radixes are treated as decimal.
+	 */
+	static NumberFormat forInteger(std::int64_t value, int radix = 10);
+
+	/**
+	 * Formats an exact rational
+	 *
+	 * @param  numerator    Numerator of the rational
+	 * @param  denominator  Positive denominator of the rational
+	 * @param  radix        Radix to format the value in. This is handled identically to forInteger().
+	 */
+	static NumberFormat forRatnum(std::int64_t numerator, std::int64_t denominator, int radix = 10);
+
+	/**
+	 * Formats a flonum in its shortest round-trip form
+	 */
+	static NumberFormat forFlonum(double value);
+
+	/**
+	 * Returns the length of the formatted number in bytes
+	 */
+	std::size_t length() const
+	{
+		return m_length;
+	}
+
+	/**
+	 * Writes the formatted number
+	 *
+	 * @param  output  Buffer to write exactly length() ASCII bytes to. This is not NULL terminated.
+	 */
+	void write(char *output) const;
+
+	/**
+	 * Returns the number of digits required to format an unsigned value
+	 *
+	 * @param  value  Value to format
+	 * @param  radix  Radix to format the value in. This must be 2, 8, 10 or 16.
+	 */
+	static std::size_t unsignedDigitCount(std::uint64_t value, int radix = 10);
+
+	/**
+	 * Writes the digits of an unsigned value without a radix prefix
+	 *
+	 * @param  output      Buffer to write exactly digitCount bytes to
+	 * @param  digitCount  Number of digits as returned by unsignedDigitCount()
+	 * @param  value       Value to format
+	 * @param  radix       Radix to format the value in. This must be 2, 8, 10 or 16.
+	 */
+	static void writeUnsignedDigits(char *output, std::size_t digitCount, std::uint64_t value, int radix = 10);
+
+private:
+	enum class Layout
+	{
+		Literal,
+		Integer,
+		Ratio,
+		FixedPoint,
+		LeadingZeros,
+		Scientific
+	};
+
+	NumberFormat() = default;
+
+	Layout m_layout;
+	std::size_t m_length;
+	bool m_negative;
+
+	// Literal
+	const char *m_literal;
+
+	// Integer and Ratio
+	std::uint64_t m_absoluteValue;
+	int m_radix;
+	std::size_t m_digitCount;
+
+	// Ratio
+	std::uint64_t m_denominator;
+	std::size_t m_denominatorDigitCount;
+
+	// FixedPoint, LeadingZeros and Scientific
+	flonum::DecimalDigits m_decimal;
+	int m_pointPosition;
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+#include "OutputBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "NumberFormat.h"
+
+namespace lliby
+{
+
+OutputBuffer::OutputBuffer(std::ostream *sink) :
+	m_sink(sink),
+	m_begin(m_inlineData),
+	m_cursor(m_inlineData),
+	m_end(m_inlineData + InlineCapacity)
+{
+}
+
+OutputBuffer::~OutputBuffer()
+{
+	flush();
+}
+
+void OutputBuffer::appendUnsigned(std::uint64_t value, int radix)
+{
+	const std::size_t digitCount = NumberFormat::unsignedDigitCount(value, radix);
+
+	if (digitCount > static_cast<std::size_t>(m_end - m_cursor))
+	{
+		makeRoom(digitCount);
+	}
+
+	NumberFormat::writeUnsignedDigits(m_cursor, digitCount, value, radix);
+	m_cursor += digitCount;
+}
+
+void OutputBuffer::append(const NumberFormat &number)
+{
+	const std::size_t length = number.length();
+
+	if (length > static_cast<std::size_t>(m_end - m_cursor))
+	{
+		makeRoom(length);
+	}
+
+	number.write(m_cursor);
+	m_cursor += length;
+}
+
+void OutputBuffer::appendSigned(std::int64_t value)
+{
+	if (value < 0)
+	{
+		append('-');
+
+		// Negate as unsigned so INT64_MIN doesn't overflow
+		appendUnsigned(-static_cast<std::uint64_t>(value));
+	}
+	else
+	{
+		appendUnsigned(value);
+	}
+}
+
+void OutputBuffer::appendPointer(const void *pointer)
+{
+	if (pointer == nullptr)
+	{
+		append('0');
+		return;
+	}
+
+	append("0x", 2);
+	appendUnsigned(reinterpret_cast<std::uintptr_t>(pointer), 16);
+}
+
+void OutputBuffer::flush()
+{
+	if (!m_sink || (m_cursor == m_begin))
+	{
+		return;
+	}
+
+	m_sink->write(m_begin, m_cursor - m_begin);
+	m_cursor = m_begin;
+}
+
+void OutputBuffer::makeRoom(std::size_t bytes)
+{
+	if (m_sink)
+	{
+		flush();
+
+		// append() writes anything larger than our inline buffer directly to the sink
+		assert(bytes <= static_cast<std::size_t>(m_end - m_cursor));
+		return;
+	}
+
+	// Grow on the heap
+	const std::size_t usedBytes = m_cursor - m_begin;
+	const std::size_t newCapacity = std::max<std::size_t>((m_end - m_begin) * 2, usedBytes + bytes);
+
+	char *newData = new char[newCapacity];
+	memcpy(newData, m_begin, usedBytes);
+
+	m_heapData.reset(newData);
+
+	m_begin = newData;
+	m_cursor = newData + usedBytes;
+	m_end = newData + newCapacity;
+}
+
+}
@@ -0,0 +1,159 @@
+#ifndef _LLIBY_WRITER_OUTPUTBUFFER_H
+#define _LLIBY_WRITER_OUTPUTBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <memory>
+
+namespace lliby
+{
+
+class NumberFormat;
+
+/**
+ * Contiguous buffer for building writer output
+ *
+ * Output is accumulated in an inline buffer to avoid per-token stream calls. If the buffer has a sink stream it is
+ * written to the sink in large blocks whenever it fills and when flush() is called. Buffers without a sink grow on the
+ * heap as required so their entire output can be retrieved with data() and size().
+ */
+class OutputBuffer
+{
+public:
+	/**
+	 * Size of the inline buffer in bytes
+	 */
+	static const std::size_t InlineCapacity = 4096;
+
+	/**
+	 * Creates a new output buffer
+	 *
+	 * @param  sink  Stream to flush output to. If this is null the output is retained in memory.
+	 */
+	explicit OutputBuffer(std::ostream *sink = nullptr);
+
+	/**
+	 * Flushes any pending output to the sink
+	 */
+	~OutputBuffer();
+
+	// Our cursor points in to our own inline storage
+	OutputBuffer(const OutputBuffer &) = delete;
+	OutputBuffer& operator=(const OutputBuffer &) = delete;
+
+	void append(char c)
+	{
+		if (m_cursor == m_end)
+		{
+			makeRoom(1);
+		}
+
+		*(m_cursor++) = c;
+	}
+
+	void append(const char *data, std::size_t length)
+	{
+		if (length > static_cast<std::size_t>(m_end - m_cursor))
+		{
+			if (m_sink && (length >= InlineCapacity))
+			{
+				// Don't bother copying large writes through the buffer
+				flush();
+				m_sink->write(data, length);
+				return;
+			}
+
+			makeRoom(length);
+		}
+
+		memcpy(m_cursor, data, length);
+		m_cursor += length;
+	}
+
+	void append(const std::uint8_t *data, std::size_t length)
+	{
+		append(reinterpret_cast<const char*>(data), length);
+	}
+
+	void append(const char *cString)
+	{
+		append(cString, strlen(cString));
+	}
+
+	/**
+	 * Appends an unsigned integer without a radix prefix
+	 *
+	 * @param  value  Value to append
+	 * @param  radix  Radix to format the value in. This must be 2, 8, 10 or 16.
+	 */
+	void appendUnsigned(std::uint64_t value, int radix = 10);
+
+	/**
+	 * Appends a formatted number
+	 */
+	void append(const NumberFormat &number);
+
+	/**
+	 * Appends a signed decimal integer
+	 */
+	void appendSigned(std::int64_t value);
+
+	/**
+	 * Appends a pointer value in hexadecimal
+	 */
+	void appendPointer(const void *pointer);
+
+	/**
+	 * Writes any buffered output to the sink
+	 *
+	 * This has no effect for buffers without a sink
+	 */
+	void flush();
+
+	/**
+	 * Discards any buffered output without writing it to the sink
+	 */
+	void clear()
+	{
+		m_cursor = m_begin;
+	}
+
+	/**
+	 * Returns a pointer to the buffered output
+	 *
+	 * For buffers without a sink this is the entire output
+	 */
+	const char* data() const
+	{
+		return m_begin;
+	}
+
+	/**
+	 * Returns the size of the buffered output in bytes
+	 */
+	std::size_t size() const
+	{
+		return m_cursor - m_begin;
+	}
+
+private:
+	/**
+	 * Ensures there is space for at least the passed number of bytes after the cursor
+	 */
+	void makeRoom(std::size_t bytes);
+
+	std::ostream *m_sink;
+
+	std::unique_ptr<char[]> m_heapData;
+	char *m_begin;
+	char *m_cursor;
+	char *m_end;
+
+	char m_inlineData[InlineCapacity];
+};
+
+}
+
+#endif
@@ -32,7 +32,8 @@
   (error-category "no-actor-error" "no_actor_error" "NoActor" #f)
   (error-category "expired-escape-procedure-error" "expired_escape_procedure_error" "ExpiredEscapeProcedure" #f)
   (error-category "ask-timeout-error" "ask_timeout_error" "AskTimeout" #f)
-  (error-category "match-error" "match_error" "Match" #f)))
+  (error-category "match-error" "match_error" "Match" #f)
+  (error-category "mailbox-full-error" "mailbox_full_error" "MailboxFull" #f)))
 
 (define (error-category-pred-name [cat : <error-category>])
   (string-append (error-category-scheme-name cat) "?"))
@@ -233,7 +234,7 @@
   (display "#include \"binding/AnyCell.h\"\n")
   (display "#include \"binding/ErrorObjectCell.h\"\n")
   (display "#include \"binding/ErrorCategory.h\"\n")
-  (display "#include \"dynamic/SchemeException.h\"\n")
+  (display "#include \"dynamic/raise.h\"\n")
   (newline)
   (display "using namespace lliby;\n")
   (newline)
@@ -284,7 +285,7 @@
 
       (display "{\n")
 
-      (display "\tthrow dynamic::SchemeException(")
+      (display "\tdynamic::raise(world, ")
       (display "ErrorObjectCell::createInstance(world, message, irritants, ErrorCategory::")
       (display enum-name)
       (display "));\n")